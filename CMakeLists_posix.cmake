@@ -133,15 +133,23 @@ set(FUJINET_NIO_SOURCES
         src/lib/disk/image_probers/fat_bpb_probe.cpp
         src/lib/disk/image_probers/image_probe.cpp
         src/lib/disk/image_registry.cpp
+        src/lib/disk/prefetch_file.cpp
         src/lib/disk/raw_image.cpp
+        src/lib/disk/sector_cache.cpp
         src/lib/disk/ssd_image.cpp
         src/lib/disk_device.cpp
         src/lib/disk_device_init.cpp
         src/lib/file_device.cpp
         src/lib/file_device_init.cpp
+        src/lib/fs/directory_listing_cache.cpp
+        src/lib/fs/file_handle_cache.cpp
         src/lib/fs/http_filesystem.cpp
+        src/lib/fs/metadata_index.cpp
         src/lib/fs/tnfs_filesystem.cpp
+        src/lib/fs/tnfs_session_pool.cpp
         src/lib/fs_stdio.cpp
+        src/lib/fuji_bus_frame_decoder.cpp
+        src/lib/fuji_bus_frame_encoder.cpp
         src/lib/fuji_bus_packet.cpp
         src/lib/fuji_config_yaml_store.cpp
         src/lib/fuji_device.cpp
@@ -175,11 +183,13 @@ set(FUJINET_NIO_SOURCES
         src/lib/path_resolvers/tnfs_relative_resolver.cpp
         src/lib/path_resolvers/tnfs_uri_resolver.cpp
         src/lib/routing_manager.cpp
+        src/lib/slip_kernels.cpp
         src/lib/storage_manager.cpp
         src/lib/tcp_channel.cpp
         src/lib/tcp_network_protocol_common.cpp
         src/lib/time_formatter.cpp
         src/lib/time_platform.cpp
+        src/lib/tnfs/tnfs_client.cpp
         src/lib/tnfs/tnfs_tcp_client.cpp
         src/lib/tnfs/tnfs_udp_client.cpp
         src/lib/transport/atari_sio_fujibus_framer.cpp
@@ -195,11 +205,13 @@ set(FUJINET_NIO_SOURCES
         src/lib/uri_display_formatter.cpp
         src/lib/uri_parser.cpp
         src/lib/utils.cpp
+        src/lib/xml_content_translator.cpp
         src/platform/posix/atari_netsio_fujibus_channel.cpp
         src/platform/posix/channel_factory.cpp
         src/platform/posix/console_transport_default.cpp
         src/platform/posix/console_transport_pty.cpp
         src/platform/posix/console_transport_stdio.cpp
+        src/platform/posix/curl_http_engine.cpp
         src/platform/posix/disk_registry.cpp
         src/platform/posix/fs_factory.cpp
         src/platform/posix/fuji_config_store_factory.cpp
@@ -211,6 +223,7 @@ set(FUJINET_NIO_SOURCES
         src/platform/posix/legacy/sio_bus_hardware.cpp
         src/platform/posix/logging.cpp
         src/platform/posix/network_registry.cpp
+        src/platform/posix/poll_reactor.cpp
         src/platform/posix/pty_channel.cpp
         src/platform/posix/serial_channel.cpp
         src/platform/posix/tcp_channel.cpp
@@ -34,6 +34,7 @@ struct MountConfig {
     std::string mode{"r"};          // "r", "rw", etc.
     bool        enabled{true};      // Whether this mount is active
     std::uint16_t sectorSizeHint{0}; // Optional hint for raw images; 0 uses image default.
+    std::string prefetch;           // "", "off", "stream" or "snapshot" (whole-image prefetch)
 
     // Get effective runtime/wire slot index (0-7) or -1 if unassigned/invalid.
     int effective_slot() const {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "fujinet/diag/diagnostic_registry.h"
+#include "fujinet/io/core/wait_set.h"
 
 #include <cstdint>
 #include <functional>
@@ -57,6 +58,9 @@ public:
     virtual void write(std::string_view s) = 0;
 
     virtual void write_line(std::string_view s) = 0;
+
+    // Optional: register the input fd so typing wakes the main loop.
+    virtual void add_wait_sources(io::WaitSet& ws) { (void)ws; }
 };
 
 // Platform-provided default transport.
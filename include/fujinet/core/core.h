@@ -28,6 +28,10 @@ public:
     bool hasWaitableWorkSource() const;
     bool waitForWork(std::chrono::milliseconds timeout);
 
+    // Collect every fd/deadline (transports and devices) the next tick could
+    // be woken by. Used by reactor-driven loops such as the POSIX app.
+    void addWaitSources(io::WaitSet& ws);
+
     // How many ticks have been executed so far.
     std::uint64_t tick_count() const noexcept { return _tickCount; }
 
@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <string_view>
 
 namespace fujinet::core {
 
@@ -11,4 +12,9 @@ void format_hex_prefix(const std::uint8_t* buffer, std::size_t len, char* out, s
 // tag: log tag for FN_LOGI; max_bytes: cap at 256 by default.
 void log_hexdump(const char* tag, const std::uint8_t* data, std::size_t size, std::size_t max_bytes = 512);
 
+// Wildcard match for directory name filters: '*' matches any run, '?' one
+// character, ASCII letters compare case-insensitively. Used for TNFS
+// listing patterns and FileDevice ListDirectory filters alike.
+bool glob_match(std::string_view pattern, std::string_view name);
+
 }  // namespace fujinet::core
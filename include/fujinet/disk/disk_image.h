@@ -1,8 +1,10 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "fujinet/disk/disk_types.h"
 #include "fujinet/fs/filesystem.h"
@@ -44,8 +46,52 @@ public:
     virtual DiskResult read_sector(std::uint32_t lba, std::uint8_t* dst, std::size_t dstBytes) = 0;
     virtual DiskResult write_sector(std::uint32_t lba, const std::uint8_t* src, std::size_t srcBytes) = 0;
 
+    // Vectored I/O over `count` consecutive sectors starting at `lba`.
+    // Sectors are packed back to back in the buffer, each sector_size(lba)
+    // bytes (so an ATR boot sector takes 128), and the packed total must fit
+    // DiskResult::bytes. Formats whose sectors are contiguous in the file
+    // override these with one seek and one read/write; the defaults go
+    // sector by sector.
+    virtual DiskResult read_sectors(std::uint32_t lba, std::uint16_t count, std::uint8_t* dst, std::size_t dstBytes)
+    {
+        if (count == 0 || !dst) return DiskResult{DiskError::InvalidRequest};
+        std::vector<std::uint8_t> sector(geometry().sectorSize);
+        std::size_t bytes = 0;
+        for (std::uint16_t i = 0; i < count; ++i) {
+            const std::size_t size = sector_size(lba + i);
+            if (dstBytes - bytes < size) return DiskResult{DiskError::InvalidRequest};
+            DiskResult r = read_sector(lba + i, sector.data(), sector.size());
+            if (!r.ok()) return r;
+            std::copy(sector.begin(), sector.begin() + static_cast<std::ptrdiff_t>(size), dst + bytes);
+            bytes += size;
+        }
+        return DiskResult{DiskError::None, static_cast<std::uint16_t>(bytes)};
+    }
+
+    virtual DiskResult write_sectors(std::uint32_t lba, std::uint16_t count, const std::uint8_t* src, std::size_t srcBytes)
+    {
+        if (count == 0 || !src) return DiskResult{DiskError::InvalidRequest};
+        std::size_t bytes = 0;
+        for (std::uint16_t i = 0; i < count; ++i) {
+            const std::size_t size = sector_size(lba + i);
+            if (srcBytes - bytes < size) return DiskResult{DiskError::InvalidRequest};
+            DiskResult r = write_sector(lba + i, src + bytes, size);
+            if (!r.ok()) return r;
+            bytes += size;
+        }
+        return DiskResult{DiskError::None, static_cast<std::uint16_t>(bytes)};
+    }
+
     virtual DiskResult flush() = 0;
 
+    // Bytes actually stored for `lba`. Formats with short boot sectors (ATR
+    // double density) override this; everything else is uniform.
+    virtual std::uint16_t sector_size(std::uint32_t lba) const noexcept
+    {
+        (void)lba;
+        return geometry().sectorSize;
+    }
+
     virtual DiskImageStats image_stats() const noexcept { return {}; }
     virtual void reset_image_stats() noexcept {}
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <optional>
@@ -8,6 +9,8 @@
 
 #include "fujinet/disk/disk_types.h"
 #include "fujinet/disk/image_registry.h"
+#include "fujinet/disk/prefetch_file.h"
+#include "fujinet/disk/sector_cache.h"
 #include "fujinet/fs/storage_manager.h"
 
 namespace fujinet::disk {
@@ -18,6 +21,7 @@ struct PendingMountInfo {
     std::string mode;     // Requested mode (r, rw)
     bool enabled;         // Whether this mount is active
     std::uint16_t sectorSizeHint{0}; // Optional hint for raw images; 0 uses image default.
+    PrefetchMode prefetch{PrefetchMode::Off};
 };
 
 // Forward declaration
@@ -36,6 +40,8 @@ struct DiskServiceSlotStats {
     std::uint64_t sequentialWriteRequests{0};
     std::uint64_t failedRequests{0};
     DiskImageStats image{};
+    SectorCacheStats cache{};
+    std::size_t cacheDirtySectors{0};
 };
 
 class DiskService {
@@ -64,8 +70,32 @@ public:
         bool overwrite
     );
 
+    // Fails, leaving the image mounted, if cached writes can't be written
+    // back (a remount through mount() does the same).
     DiskResult unmount(std::size_t slotIndex);
 
+    // Write back cached dirty sectors and flush the image.
+    DiskResult flush(std::size_t slotIndex);
+
+    // Background work: streams prefetching images and flushes slots whose
+    // writes have settled.
+    void poll();
+
+    // True while some slot still has image data to prefetch.
+    bool prefetch_pending() const;
+
+    // Time until poll() has write-back due on some slot, if any.
+    bool next_write_back(std::chrono::milliseconds& in) const;
+
+    // Applies to every slot; takes effect on the next mount.
+    void set_cache_config(const SectorCacheConfig& config);
+    const SectorCacheConfig& cache_config() const noexcept { return _cacheConfig; }
+
+    // Largest image MountOptions::prefetch will copy into RAM; bigger images
+    // (and any image while this is 0) mount without prefetch.
+    void set_prefetch_limit(std::size_t bytes) noexcept { _prefetchLimit = bytes; }
+    std::size_t prefetch_limit() const noexcept { return _prefetchLimit; }
+
     DiskResult read_sector(std::size_t slotIndex, std::uint32_t lba, std::uint8_t* dst, std::size_t dstBytes);
     DiskResult write_sector(std::size_t slotIndex, std::uint32_t lba, const std::uint8_t* src, std::size_t srcBytes);
     DiskResult read_sectors(std::size_t slotIndex, std::uint32_t lba, std::uint16_t count, std::uint8_t* dst, std::size_t dstBytes);
@@ -90,7 +120,8 @@ public:
         const std::string& uri,
         const std::string& mode,
         bool enabled,
-        std::uint16_t sectorSizeHint = 0
+        std::uint16_t sectorSizeHint = 0,
+        PrefetchMode prefetch = PrefetchMode::Off
     );
 
     // Get the pending mount config for a slot (if any).
@@ -119,6 +150,8 @@ private:
         std::optional<PendingMountInfo> pendingMount;
 
         std::unique_ptr<IDiskImage> image;
+        SectorCache cache;
+        PrefetchFile* prefetch{nullptr}; // owned by image
 
         bool statsReadCursorValid{false};
         bool statsWriteCursorValid{false};
@@ -127,12 +160,15 @@ private:
     };
 
     DiskError set_error(std::size_t slotIndex, DiskError e);
+    DiskResult release_image(std::size_t slotIndex);
     DiskResult activate_pending_mount(std::size_t slotIndex);
     Slot*       slot_ptr(std::size_t slotIndex);
     const Slot* slot_ptr(std::size_t slotIndex) const;
 
     fs::StorageManager& _storage;
     ImageRegistry _registry;
+    SectorCacheConfig _cacheConfig{};
+    std::size_t _prefetchLimit{0};
     std::array<Slot, MAX_SLOTS> _slots{};
     std::array<DiskServiceSlotStats, MAX_SLOTS> _stats{};
 };
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <string>
+#include <string_view>
 
 namespace fujinet::disk {
 
@@ -30,6 +31,7 @@ enum class DiskError : std::uint8_t {
     OutOfRange,
     IoError,
     InternalError,
+    WouldBlock,     // non-blocking filesystem has no answer yet; retry
 };
 
 struct DiskGeometry {
@@ -38,6 +40,32 @@ struct DiskGeometry {
     bool supportsVariableSectorSize{false};
 };
 
+// Whole-image prefetch for slow (network) sources. See PrefetchFile.
+enum class PrefetchMode : std::uint8_t {
+    Off      = 0,
+    Stream   = 1, // stream the image into RAM; writes are journaled and synced back
+    Snapshot = 2, // as Stream, but writes stay in RAM and are dropped on unmount
+};
+
+inline const char* prefetch_mode_name(PrefetchMode m) noexcept
+{
+    switch (m) {
+        case PrefetchMode::Off: return "off";
+        case PrefetchMode::Stream: return "stream";
+        case PrefetchMode::Snapshot: return "snapshot";
+    }
+    return "off";
+}
+
+// Accepts the names above; empty means Off.
+inline bool parse_prefetch_mode(std::string_view s, PrefetchMode& out) noexcept
+{
+    if (s.empty() || s == "off") { out = PrefetchMode::Off; return true; }
+    if (s == "stream") { out = PrefetchMode::Stream; return true; }
+    if (s == "snapshot") { out = PrefetchMode::Snapshot; return true; }
+    return false;
+}
+
 struct MountOptions {
     bool readOnlyRequested{false};
 
@@ -50,6 +78,9 @@ struct MountOptions {
     // Optional geometry supplied by image detection. Image implementations
     // still validate final mount state before accepting it.
     DiskGeometry geometryHint{};
+
+    // Copy the whole image into RAM in the background after mount.
+    PrefetchMode prefetch{PrefetchMode::Off};
 };
 
 struct DiskResult {
@@ -70,6 +101,11 @@ struct DiskSlotInfo {
 
     DiskError lastError{DiskError::None};
 
+    // Whole-image prefetch progress (PrefetchMode::Off: both 0).
+    PrefetchMode prefetch{PrefetchMode::Off};
+    std::uint64_t prefetchLandedBytes{0};
+    std::uint64_t prefetchTotalBytes{0};
+
     // Optional human-friendly info for tooling/debug (may be empty).
     std::string fsName;
     std::string path;
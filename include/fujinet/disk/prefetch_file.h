@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "fujinet/disk/disk_types.h"
+#include "fujinet/fs/filesystem.h"
+
+namespace fujinet::disk {
+
+// In-memory copy of a disk image file, filled in the background.
+//
+// Wraps the image's source file (typically TNFS or HTTP) for mount with
+// PrefetchMode::Stream or ::Snapshot. pump() streams the file front to back
+// into RAM, one block per call; reads of a block that has not landed yet fetch
+// just the missing blocks on demand, so the image is usable immediately.
+//
+// Writes land in the copy. In Stream mode the written ranges are journaled and
+// synced back to the source on flush(); in Snapshot mode they stay local and
+// are dropped with the file.
+class PrefetchFile final : public fs::IFile {
+public:
+    static constexpr std::size_t kBlockSize = 4096;
+
+    PrefetchFile(std::unique_ptr<fs::IFile> source, std::uint64_t sizeBytes, PrefetchMode mode);
+
+    std::size_t read(void* dst, std::size_t maxBytes) override;
+    std::size_t write(const void* src, std::size_t bytes) override;
+    bool seek(std::uint64_t offset) override;
+    std::uint64_t tell() const override { return _pos; }
+    bool flush() override;
+
+    // Stream up to `maxBytes` of not-yet-landed blocks. Returns false on a
+    // source error (prefetch stops; demand reads keep trying).
+    bool pump(std::size_t maxBytes);
+
+    bool complete() const noexcept { return _landedBlocks == _landed.size() || _failed; }
+    std::uint64_t size() const noexcept { return _data.size(); }
+    std::uint64_t landed_bytes() const noexcept;
+    std::size_t journaled_bytes() const noexcept;
+    PrefetchMode mode() const noexcept { return _mode; }
+
+private:
+    bool fetch(std::size_t firstBlock, std::size_t endBlock);
+    bool ensure(std::uint64_t offset, std::size_t bytes);
+    void journal(std::uint64_t offset, std::uint64_t end);
+
+    std::unique_ptr<fs::IFile> _source;
+    PrefetchMode _mode;
+    std::vector<std::uint8_t> _data;
+    std::vector<bool> _landed;
+    std::size_t _landedBlocks{0};
+    std::size_t _nextBlock{0};      // pump() cursor
+    std::uint64_t _sourcePos{0};    // avoids a seek per streamed block
+    bool _sourcePosValid{true};
+    bool _failed{false};
+    std::uint64_t _pos{0};
+    std::map<std::uint64_t, std::uint64_t> _journal; // start -> end, non-overlapping
+};
+
+} // namespace fujinet::disk
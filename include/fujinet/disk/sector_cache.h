@@ -0,0 +1,121 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "fujinet/disk/disk_image.h"
+#include "fujinet/disk/disk_types.h"
+
+namespace fujinet::disk {
+
+struct SectorCacheConfig {
+    // Sectors held per slot (64 x 256 B = 16 KiB). 0 disables caching.
+    std::size_t capacitySectors{64};
+
+    // Sectors fetched on a sequential miss, including the one requested.
+    std::uint16_t readAheadSectors{8};
+
+    // Dirty sectors are written back once no write has arrived for this long.
+    std::chrono::milliseconds writeBackDelay{1000};
+};
+
+struct SectorCacheStats {
+    std::uint64_t hits{0};
+    std::uint64_t misses{0};
+    std::uint64_t readAheadSectors{0};  // fetched speculatively
+    std::uint64_t writeBackSectors{0};  // dirty sectors written to the image
+    std::uint64_t flushes{0};
+    std::uint64_t evictions{0};
+};
+
+// Per-slot sector cache between DiskService and an IDiskImage.
+//
+// Reads are served from memory when possible. Missing sectors are fetched
+// with one IDiskImage::read_sectors() per contiguous run, and a miss during
+// sequential access extends the run with the following sectors, so the image
+// does one seek and one large read (on TNFS/HTTP backends one streamed
+// transfer rather than a round trip per sector). Writes are kept as dirty
+// sectors and written back in LBA order, contiguous runs in one
+// write_sectors(), on flush(), when evicted, or once writes have been idle
+// for writeBackDelay.
+class SectorCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    SectorCache() = default;
+
+    void set_config(const SectorCacheConfig& config);
+    const SectorCacheConfig& config() const noexcept { return _config; }
+
+    // Drop everything (without writing back). Call flush() first if needed.
+    void clear();
+
+    DiskResult read(IDiskImage& image, std::uint32_t lba, std::uint8_t* dst, std::size_t dstBytes, bool sequential);
+    DiskResult write(IDiskImage& image, std::uint32_t lba, const std::uint8_t* src, std::size_t srcBytes);
+
+    // `count` consecutive sectors in IDiskImage's packed layout.
+    DiskResult read_sectors(IDiskImage& image, std::uint32_t lba, std::uint16_t count,
+                            std::uint8_t* dst, std::size_t dstBytes, bool sequential);
+    DiskResult write_sectors(IDiskImage& image, std::uint32_t lba, std::uint16_t count,
+                             const std::uint8_t* src, std::size_t srcBytes);
+
+    // Write all dirty sectors back, then flush the image.
+    DiskResult flush(IDiskImage& image);
+
+    // flush() if dirty and writes have been idle for writeBackDelay. After a
+    // failed write-back the next attempt is pushed out, doubling up to
+    // MAX_WRITE_BACK_RETRY, so a vanished image doesn't keep the caller busy.
+    DiskResult flush_if_idle(IDiskImage& image, Clock::time_point now = Clock::now());
+
+    // Time until flush_if_idle() would write back, if anything is dirty.
+    bool next_write_back(Clock::duration& in, Clock::time_point now = Clock::now()) const;
+
+    std::size_t dirty_count() const noexcept { return _dirty; }
+    std::size_t size() const noexcept { return _entries.size(); }
+    const SectorCacheStats& stats() const noexcept { return _stats; }
+    void reset_stats() noexcept { _stats = {}; }
+
+    static constexpr std::chrono::milliseconds MIN_WRITE_BACK_RETRY{1000};
+    static constexpr std::chrono::milliseconds MAX_WRITE_BACK_RETRY{60000};
+
+private:
+    struct Entry {
+        std::uint32_t lba;
+        std::uint16_t bytes;
+        bool dirty;
+        std::vector<std::uint8_t> data;
+    };
+
+    using List = std::list<Entry>; // front = most recently used
+
+    Entry* find(std::uint32_t lba);
+    DiskResult insert(IDiskImage& image, Entry entry);
+    DiskResult write_back(IDiskImage& image, Entry& e);
+    DiskResult write_back_run(IDiskImage& image, std::vector<Entry*>::const_iterator first,
+                              std::vector<Entry*>::const_iterator last);
+
+    // Read `count` uncached sectors plus up to `ahead` more with as few image
+    // calls as DiskResult::bytes allows, cache them all, and copy the first
+    // `count` to `dst` (packed).
+    DiskResult fetch(IDiskImage& image, std::uint32_t lba, std::uint32_t count, std::uint32_t ahead,
+                     std::uint8_t* dst);
+
+    // Uncached sectors following `lba` worth reading ahead.
+    std::uint32_t read_ahead_after(const IDiskImage& image, std::uint32_t lba) const;
+
+    SectorCacheConfig _config;
+    SectorCacheStats _stats{};
+    List _entries;
+    std::unordered_map<std::uint32_t, List::iterator> _index;
+    std::size_t _dirty{0};
+    Clock::time_point _lastWrite{};
+    Clock::duration _retryDelay{};  // zero unless the last write-back failed
+    Clock::time_point _retryAt{};
+    std::vector<std::uint8_t> _scratch;
+};
+
+} // namespace fujinet::disk
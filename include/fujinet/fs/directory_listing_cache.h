@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fujinet/fs/filesystem.h"
+
+namespace fujinet::fs {
+
+// One directory as returned by IFileSystem::listDirectory(), plus the
+// orderings ListDirectory pages through. Indices are computed once when the
+// snapshot is cached, so a sorted page is a slice rather than a re-sort.
+struct DirectoryListing {
+    std::vector<FileInfo> entries;       // filesystem order
+    std::vector<std::uint32_t> byName;   // indices into entries, by basename
+};
+
+// Small LRU of directory snapshots for paged listing.
+//
+// Hosts page through a directory with one ListDirectory request per screen,
+// and often flip between a few directories. Listing a TNFS or HTTP directory
+// is a round trip per page (and a STAT per entry on older servers), so the
+// snapshot is kept for Config::ttl after its last use.
+//
+// Keyed by filesystem + resolved path. Anything that creates, writes, renames
+// or removes a path should call invalidate() (usually via
+// StorageManager::invalidatePath()) so the next listing is fresh.
+class DirectoryListingCache {
+public:
+    struct Config {
+        std::size_t maxEntries{4};
+        std::chrono::milliseconds ttl{120000};
+    };
+
+    struct Stats {
+        std::size_t hits{0};
+        std::size_t misses{0};
+        std::size_t evictions{0};
+        std::size_t invalidations{0};
+    };
+
+    DirectoryListingCache() = default;
+    explicit DirectoryListingCache(Config config) : _config(config)
+    {
+        if (_config.maxEntries == 0) {
+            _config.maxEntries = 1;
+        }
+    }
+
+    DirectoryListingCache(const DirectoryListingCache&) = delete;
+    DirectoryListingCache& operator=(const DirectoryListingCache&) = delete;
+
+    // Cached snapshot for (fs, path), or nullptr. A hit refreshes the TTL.
+    std::shared_ptr<const DirectoryListing> find(
+        const IFileSystem& fs,
+        const std::string& path,
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    // Build the sorted indices for `entries` and cache the snapshot,
+    // evicting the least recently used one if full.
+    std::shared_ptr<const DirectoryListing> insert(
+        const IFileSystem& fs,
+        const std::string& path,
+        std::vector<FileInfo> entries,
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    // `path` changed: drop its own listing, its parent's, and any below it.
+    void invalidate(const IFileSystem& fs, const std::string& path);
+
+    // Drop every listing belonging to `fs` (unmount/unregister).
+    void invalidate(const IFileSystem& fs);
+
+    void clear() { _entries.clear(); }
+
+    std::size_t size() const noexcept { return _entries.size(); }
+    const Stats& stats() const noexcept { return _stats; }
+    const Config& config() const noexcept { return _config; }
+
+private:
+    struct Entry {
+        const IFileSystem* fs;
+        std::string path;
+        std::shared_ptr<const DirectoryListing> listing;
+        std::chrono::steady_clock::time_point expiresAt;
+    };
+
+    using List = std::list<Entry>; // front = most recently used
+
+    Config _config{};
+    Stats _stats{};
+    List _entries;
+};
+
+} // namespace fujinet::fs
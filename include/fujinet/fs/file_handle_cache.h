@@ -0,0 +1,101 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "fujinet/fs/filesystem.h"
+
+namespace fujinet::fs {
+
+// Small LRU of open IFile handles for chunked, stateless file access.
+//
+// The FujiBus file protocol carries (uri, offset, length) in every ReadFile /
+// WriteFile request, so without this each chunk would re-open and seek the
+// file. On TNFS that is an OPEN/LSEEK/CLOSE round trip per chunk, and on HTTP
+// a fresh download. Handles are keyed by filesystem + resolved path + mode.
+// A chunk whose offset matches the handle's tell() continues where the last
+// one stopped.
+//
+// Anything that modifies a path through a filesystem should call
+// invalidate(): cached read handles could otherwise serve stale data and
+// cached write handles would keep writing to a renamed or removed file.
+class FileHandleCache {
+public:
+    enum class Mode : std::uint8_t {
+        Read,
+        Write,
+    };
+
+    struct Config {
+        std::size_t maxEntries{4};
+        std::chrono::milliseconds idleTimeout{5000};
+    };
+
+    struct Stats {
+        std::size_t hits{0};    // reused at the requested offset
+        std::size_t misses{0};  // caller had to open the file
+        std::size_t evictions{0};
+    };
+
+    FileHandleCache() = default;
+    explicit FileHandleCache(Config config) : _config(config)
+    {
+        if (_config.maxEntries == 0) {
+            _config.maxEntries = 1;
+        }
+    }
+
+    FileHandleCache(const FileHandleCache&) = delete;
+    FileHandleCache& operator=(const FileHandleCache&) = delete;
+
+    // Cached handle for (fs, path, mode) positioned at `offset`, or nullptr.
+    // A handle at a different offset is re-seeked; if that fails it is
+    // dropped. The returned pointer stays valid until the next call that
+    // inserts, invalidates or expires entries.
+    IFile* acquire(const IFileSystem& fs, const std::string& path, Mode mode, std::uint64_t offset);
+
+    // Take ownership of a freshly opened handle, replacing any existing
+    // entry for the same key and evicting the least recently used one if full.
+    IFile* insert(const IFileSystem& fs, const std::string& path, Mode mode, std::unique_ptr<IFile> file);
+
+    // Drop handles for `path` and anything below it (all modes).
+    void invalidate(const IFileSystem& fs, const std::string& path);
+
+    // Drop one (fs, path, mode) handle, e.g. after an I/O error.
+    void invalidate(const IFileSystem& fs, const std::string& path, Mode mode);
+
+    // Drop every handle belonging to `fs` (unmount/unregister).
+    void invalidate(const IFileSystem& fs);
+
+    // Close handles idle for longer than Config::idleTimeout.
+    void expire(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    void clear() { _entries.clear(); }
+
+    std::size_t size() const noexcept { return _entries.size(); }
+    const Stats& stats() const noexcept { return _stats; }
+    const Config& config() const noexcept { return _config; }
+
+private:
+    struct Entry {
+        const IFileSystem* fs;
+        std::string path;
+        Mode mode;
+        std::unique_ptr<IFile> file;
+        std::chrono::steady_clock::time_point lastUsed;
+    };
+
+    using List = std::list<Entry>; // front = most recently used
+
+    List::iterator find(const IFileSystem& fs, const std::string& path, Mode mode);
+
+    Config _config{};
+    Stats _stats{};
+    List _entries;
+};
+
+} // namespace fujinet::fs
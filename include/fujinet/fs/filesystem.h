@@ -96,6 +96,15 @@ public:
         const std::string& path,
         std::vector<FileInfo>& outEntries
     ) = 0;
+
+    // Background housekeeping (keep-alives, idle unmounts, deferred
+    // writes). Called from the main loop via StorageManager::poll().
+    virtual void poll() {}
+
+    // The last call failed only because a non-blocking filesystem has no
+    // answer yet (TNFS non-blocking mode). Repeating the same call later
+    // resumes it; devices report NotReady meanwhile.
+    virtual bool wouldBlock() const { return false; }
 };
 
 
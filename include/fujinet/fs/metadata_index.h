@@ -0,0 +1,133 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fujinet/fs/filesystem.h"
+
+namespace fujinet::fs {
+
+struct MetadataIndexConfig {
+    // Keep the index in a file on the indexed filesystem itself so it
+    // survives reboots. Network filesystems leave this off.
+    bool persist{false};
+    std::string storePath{"/.fujinet/metadata-index.tsv"};
+
+    std::size_t maxDirectories{256};
+
+    // A directory validated this recently is trusted without another
+    // directory stat (a menu refresh stats every entry in quick succession).
+    std::chrono::milliseconds trustWindow{2000};
+
+    // Trust a directory for this long after it was listed even without a
+    // usable directory mtime, and remember single stat() results. 0 keeps
+    // the index purely mtime-validated (local filesystems).
+    std::chrono::milliseconds maxAge{0};
+
+    // Directory mtime resolution (FAT: 2 s). A listing taken within this of
+    // the directory's mtime cannot be revalidated by mtime and is relisted.
+    std::chrono::milliseconds mtimeGranularity{2000};
+
+    // Coalesce saves caused only by newly listed directories.
+    std::chrono::milliseconds saveDelay{5000};
+};
+
+// Settings for TNFS/HTTP: memory only, results trusted for 30 s and then
+// revalidated by directory mtime where the server reports one.
+inline MetadataIndexConfig network_metadata_index()
+{
+    MetadataIndexConfig cfg;
+    cfg.maxDirectories = 32;
+    cfg.maxAge = std::chrono::milliseconds(30000);
+    return cfg;
+}
+
+struct MetadataIndexStats {
+    std::size_t statHits{0};
+    std::size_t statMisses{0};
+    std::size_t listHits{0};
+    std::size_t listMisses{0};
+    std::size_t revalidations{0};   // directory stats that confirmed a record
+    std::size_t staleDirectories{0}; // records dropped because the directory changed
+    std::size_t evictions{0};
+    std::size_t loads{0};
+    std::size_t saves{0};
+};
+
+// IFileSystem decorator that keeps a per-directory metadata index
+// (name, size, mtime, isDirectory) in front of another filesystem.
+//
+// listDirectory() on an indexed directory costs one directory stat instead
+// of a readdir plus a stat per entry. A record is used while it is inside
+// trustWindow/maxAge, or after a stat of the directory shows an unchanged
+// mtime; otherwise the directory is listed again.
+//
+// stat() of an entry is answered from memory only inside trustWindow/maxAge.
+// After that it stats the file itself and patches the record: a file
+// rewritten in place leaves its directory's mtime alone.
+//
+// Writes made through this filesystem (create/remove/rename, and files
+// opened for writing when they are closed) update the index in place.
+// Directories with files open for writing are left out of the persisted
+// copy, so a reset mid-write never leaves a stale size behind. Changes made
+// behind its back are caught by the directory mtime check, or can be
+// reported with invalidate().
+//
+// Negative lookups are never answered from the index (FAT names are
+// case-insensitive), so a miss always falls through to the filesystem.
+class IndexedFileSystem final : public IFileSystem {
+public:
+    IndexedFileSystem(std::unique_ptr<IFileSystem> inner, MetadataIndexConfig config);
+    ~IndexedFileSystem() override;
+
+    IndexedFileSystem(const IndexedFileSystem&) = delete;
+    IndexedFileSystem& operator=(const IndexedFileSystem&) = delete;
+
+    FileSystemKind kind() const override;
+    std::string name() const override;
+
+    bool exists(const std::string& path) override;
+    bool isDirectory(const std::string& path) override;
+
+    bool createDirectory(const std::string& path) override;
+    bool removeFile(const std::string& path) override;
+    bool removeDirectory(const std::string& path) override;
+    bool rename(const std::string& from, const std::string& to) override;
+
+    std::unique_ptr<IFile> open(const std::string& path, const char* mode) override;
+
+    bool stat(const std::string& path, FileInfo& outInfo) override;
+    bool listDirectory(const std::string& path, std::vector<FileInfo>& outEntries) override;
+
+    // Polls the inner filesystem and writes a delayed save once it is due.
+    void poll() override;
+    bool wouldBlock() const override;
+
+    IFileSystem& inner();
+
+    // `path` (file or directory) changed outside this filesystem: drop the
+    // records that could describe it.
+    void invalidate(const std::string& path);
+
+    // Drop every record (and the persisted copy on the next save).
+    void clear();
+
+    // Write pending index changes now. Returns false if persistence is on
+    // and the store could not be written.
+    bool save();
+
+    std::size_t directoryCount() const;
+    const MetadataIndexStats& stats() const;
+    const MetadataIndexConfig& config() const;
+
+private:
+    struct State;
+    class WriteTrackingFile;
+
+    std::shared_ptr<State> _state; // shared with files opened for writing
+};
+
+} // namespace fujinet::fs
@@ -5,7 +5,10 @@
 #include <unordered_map>
 #include <vector>
 
+#include "fujinet/fs/directory_listing_cache.h"
+#include "fujinet/fs/file_handle_cache.h"
 #include "fujinet/fs/filesystem.h"
+#include "fujinet/fs/metadata_index.h"
 #include "fujinet/fs/uri_parser.h"
 
 namespace fujinet::fs {
@@ -23,7 +26,12 @@ public:
     // Returns false if that name already exists or fs is null.
     bool registerFileSystem(std::unique_ptr<IFileSystem> fs);
 
-    // Remove a filesystem by name. Returns false if not found.
+    // Same, but serve stat/listDirectory through a metadata index
+    // (IndexedFileSystem) wrapped around `fs`.
+    bool registerFileSystem(std::unique_ptr<IFileSystem> fs, const MetadataIndexConfig& index);
+
+    // Remove a filesystem by name (closing any cached handles on it).
+    // Returns false if not found.
     bool unregisterFileSystem(const std::string& name);
 
     // Lookup by name.
@@ -49,8 +57,32 @@ public:
     // Parse URI and get filesystem and path
     std::pair<IFileSystem*, std::string> resolveUri(const std::string& uri);
 
+    // Open handles shared by chunked file transfers. Code that removes,
+    // renames or rewrites files should invalidate the affected paths here.
+    FileHandleCache&       fileHandles() { return _fileHandles; }
+    const FileHandleCache& fileHandles() const { return _fileHandles; }
+
+    // Directory snapshots shared by paged ListDirectory requests.
+    DirectoryListingCache&       listings() { return _listings; }
+    const DirectoryListingCache& listings() const { return _listings; }
+
+    // `path` on `fs` was created, removed, renamed or rewritten: drop cached
+    // handles and listings that could now be stale. (A metadata index sees
+    // writes made through its filesystem and needs no help.)
+    void invalidatePath(const IFileSystem& fs, const std::string& path);
+
+    // Metadata index of a filesystem registered with one, or nullptr. Use
+    // its invalidate() for changes made behind the filesystem's back.
+    IndexedFileSystem* metadataIndex(const std::string& name);
+
+    // Give every registered filesystem a chance to do background work.
+    void poll();
+
 private:
     std::unordered_map<std::string, std::unique_ptr<IFileSystem>> _fileSystems;
+    std::unordered_map<const IFileSystem*, IndexedFileSystem*> _indexes;
+    FileHandleCache _fileHandles; // destroyed before the filesystems it points into
+    DirectoryListingCache _listings;
 };
 
 } // namespace fujinet::fs
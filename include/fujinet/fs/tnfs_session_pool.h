@@ -0,0 +1,155 @@
+#pragma once
+
+#include "fujinet/tnfs/tnfs_protocol.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace fujinet::fs {
+
+struct TnfsEndpoint {
+    std::string host;
+    std::uint16_t port{tnfs::DEFAULT_PORT};
+    std::string mountPath{"/"};
+    std::string user;
+    std::string password;
+    bool useTcp{false};
+};
+
+// Creates an unmounted client for `endpoint`. Returning the same client
+// again (a fixed client) is fine; it is simply mounted again.
+using TnfsSessionFactory = std::function<std::shared_ptr<tnfs::ITnfsClient>(const TnfsEndpoint&)>;
+
+struct TnfsSessionPoolConfig {
+    // Unmount a session nobody holds after this long without use.
+    std::chrono::milliseconds idleTimeout{60000};
+
+    // Ping a session that is still held (open file, mounted disk image)
+    // after this much silence, so NAT mappings and the server's session
+    // stay alive. 0 disables pings.
+    std::chrono::milliseconds keepAlive{30000};
+
+    // Put clients in TNFS non-blocking mode: a server that misses its RTO
+    // makes requests (and mounts) fail with would_block() instead of
+    // stalling the core loop; see ITnfsClient::set_nonblocking().
+    bool nonBlocking{false};
+};
+
+struct TnfsSessionPoolStats {
+    std::size_t mounts{0};
+    std::size_t reuses{0};
+    std::size_t remounts{0};
+    std::size_t pings{0};
+    std::size_t unmounts{0};
+};
+
+// One mounted TNFS session, shared by every user of an endpoint. Holding
+// the shared_ptr keeps it mounted.
+class TnfsSession {
+public:
+    TnfsSession(const TnfsSession&) = delete;
+    TnfsSession& operator=(const TnfsSession&) = delete;
+
+    // False only while the first mount of a non-blocking session is still
+    // waiting for the server; recover() carries it on.
+    bool ready() const noexcept { return static_cast<bool>(_client); }
+
+    // The mounted client (requires ready()); counts as activity for
+    // keep-alive purposes.
+    tnfs::ITnfsClient& client();
+
+    const TnfsEndpoint& endpoint() const noexcept { return _endpoint; }
+
+    // Bumped by every remount. File handles opened under an older
+    // generation no longer exist on the server.
+    std::uint32_t generation() const noexcept { return _generation; }
+
+    // Call after a request failed. If the client reports the session lost
+    // (or the session isn't mounted yet), mount a fresh one and return true
+    // so the caller can retry once; ordinary failures (file not found, ...)
+    // return false at no cost.
+    bool recover();
+
+    // The last request or mount was parked by a non-blocking client:
+    // repeat the same call later.
+    bool would_block() const;
+
+private:
+    friend class TnfsSessionPool;
+
+    TnfsSession(TnfsEndpoint endpoint,
+                TnfsSessionFactory factory,
+                std::shared_ptr<TnfsSessionPoolStats> stats,
+                bool nonBlocking);
+
+    bool remount();
+    bool ping();
+    bool ping_step();
+    void poll_clients();
+
+    TnfsEndpoint _endpoint;
+    std::shared_ptr<tnfs::ITnfsClient> _client;
+    std::shared_ptr<tnfs::ITnfsClient> _mounting; // fresh client whose MOUNT is parked
+    TnfsSessionFactory _factory;
+    std::shared_ptr<TnfsSessionPoolStats> _stats;
+    bool _nonBlocking;
+    bool _mountBlocked{false};
+    bool _pingParked{false}; // keep-alive STAT the server hasn't answered yet
+    std::uint32_t _generation{0};
+    std::chrono::steady_clock::time_point _lastUsed;
+};
+
+// Mounted TNFS sessions keyed by (host, port, mount path, user, password,
+// transport), so URI access from FileDevice, DiskService and the console to
+// the same server shares one CMD_MOUNT and one server-side session.
+//
+// poll() pings held sessions that have gone quiet and unmounts idle ones.
+// At most MAX_PINGS_PER_POLL pings go out per call, and never to a session
+// with a request of its own outstanding.
+// A session that turns out to be lost (server restart) is remounted by
+// TnfsSession::recover() or by the keep-alive ping.
+class TnfsSessionPool {
+public:
+    static constexpr std::size_t MAX_PINGS_PER_POLL = 1;
+
+    explicit TnfsSessionPool(TnfsSessionFactory factory, TnfsSessionPoolConfig config = {});
+
+    TnfsSessionPool(const TnfsSessionPool&) = delete;
+    TnfsSessionPool& operator=(const TnfsSessionPool&) = delete;
+
+    // Mounted session for `endpoint`, mounting one if needed; nullptr if
+    // the client can't be created or the mount fails. In non-blocking mode
+    // a mount the server hasn't answered yet still returns the session,
+    // not ready().
+    std::shared_ptr<TnfsSession> acquire(const TnfsEndpoint& endpoint);
+
+    void poll(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    std::size_t size() const noexcept { return _sessions.size(); }
+    const TnfsSessionPoolStats& stats() const noexcept { return *_stats; }
+    const TnfsSessionPoolConfig& config() const noexcept { return _config; }
+
+private:
+    struct Key {
+        std::string host;
+        std::uint16_t port{tnfs::DEFAULT_PORT};
+        std::string mountPath;
+        std::string user;
+        std::string password;
+        bool useTcp{false};
+
+        bool operator<(const Key& other) const;
+    };
+
+    TnfsSessionFactory _factory;
+    TnfsSessionPoolConfig _config;
+    std::shared_ptr<TnfsSessionPoolStats> _stats;
+    std::map<Key, std::shared_ptr<TnfsSession>> _sessions;
+};
+
+} // namespace fujinet::fs
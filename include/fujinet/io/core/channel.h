@@ -7,6 +7,8 @@
 #include <memory>
 #include <string>
 
+#include "fujinet/io/core/wait_set.h"
+
 namespace fujinet::io {
 
 // Abstract byte-level I/O channel (ACM, TTY, UART, etc.).
@@ -33,6 +35,10 @@ public:
         (void)timeout;
         return false;
     }
+
+    // Add the fd(s) whose readiness means read() may return data.
+    // Default: none; the channel is picked up on the idle heartbeat.
+    virtual void add_wait_sources(WaitSet& ws) { (void)ws; }
 };
 
 } // namespace fujinet::io
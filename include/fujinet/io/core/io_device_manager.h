@@ -32,11 +32,15 @@ public:
 
     // IRequestHandler implementation.
     IOResponse handleRequest(const IORequest& request) override;
+    bool takeCompletedResponse(IOResponse& out) override;
 
     // Called periodically by higher-level code (e.g. IOService)
     // to let devices do background work.
     void pollDevices();
 
+    // Collect wake-up sources from every device.
+    void addWaitSources(WaitSet& ws);
+
     std::size_t device_count() const noexcept { return _devices.size(); }
 
 private:
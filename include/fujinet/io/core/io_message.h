@@ -64,6 +64,11 @@ struct IORequest
     // Raw payload from host to device.
     // Interpretation is device- and protocol-specific.
     std::vector<std::uint8_t>  payload;
+
+    // Set by the transport when the host can wait for a late answer
+    // (e.g. FujiBus tagged requests). A device may then return
+    // StatusCode::Pending instead of NotReady and finish the request later.
+    bool deferrable{false};
 };
 
 
@@ -79,6 +84,10 @@ enum class StatusCode : std::uint8_t
     Timeout,
     InternalError,
     Unsupported,
+
+    // Internal only, never sent to the host: the device accepted a
+    // deferrable request and will complete it later (see VirtualDevice).
+    Pending,
 };
 
 
@@ -12,6 +12,10 @@ public:
     // Handle a single request and return a response.
     // Implementations may route to devices, modes, etc.
     virtual IOResponse handleRequest(const IORequest& request) = 0;
+
+    // Pop one response for a request that previously returned
+    // StatusCode::Pending. Default: handler never defers.
+    virtual bool takeCompletedResponse(IOResponse& out) { (void)out; return false; }
 };
 
 } // namespace fujinet::io
@@ -48,6 +48,7 @@ public:
 
     // IRequestHandler implementation.
     IOResponse handleRequest(const IORequest& request) override;
+    bool takeCompletedResponse(IOResponse& out) override;
 
     // Access to the underlying device manager, in case you need to
     // register/unregister devices, or call pollDevices() from elsewhere.
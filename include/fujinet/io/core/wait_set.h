@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace fujinet::io {
+
+// Everything the core loop could wake up for, collected once per tick.
+//
+// Transports, devices, network backends and the console add the file
+// descriptors that would give them new work, plus a deadline if they have
+// timer-driven work or data already buffered. A platform reactor (POSIX:
+// PollReactor) then sleeps until any of them is ready. Sources that cannot
+// name an fd add nothing and are served by the loop's idle heartbeat.
+//
+// Plain ints are used so the set stays platform-neutral; on ESP32 these are
+// lwIP socket numbers.
+class WaitSet {
+public:
+    struct Entry {
+        int  fd;
+        bool readable;
+        bool writable;
+    };
+
+    void clear()
+    {
+        _entries.clear();
+        _deadline.reset();
+    }
+
+    void add_readable(int fd) { add(fd, true, false); }
+    void add_writable(int fd) { add(fd, false, true); }
+
+    // Work will be due within `t` even if no fd becomes ready.
+    void limit_timeout(std::chrono::milliseconds t)
+    {
+        if (t.count() < 0) {
+            t = std::chrono::milliseconds(0);
+        }
+        if (!_deadline || t < *_deadline) {
+            _deadline = t;
+        }
+    }
+
+    // Work is already pending (e.g. a decoded frame is queued).
+    void wake_now() { limit_timeout(std::chrono::milliseconds(0)); }
+
+    const std::vector<Entry>& entries() const { return _entries; }
+
+    // How long the reactor may sleep, given the loop's idle heartbeat.
+    std::chrono::milliseconds timeout(std::chrono::milliseconds idle) const
+    {
+        return _deadline ? std::min(*_deadline, idle) : idle;
+    }
+
+private:
+    void add(int fd, bool readable, bool writable)
+    {
+        if (fd < 0) {
+            return;
+        }
+        for (auto& e : _entries) {
+            if (e.fd == fd) {
+                e.readable = e.readable || readable;
+                e.writable = e.writable || writable;
+                return;
+            }
+        }
+        _entries.push_back(Entry{fd, readable, writable});
+    }
+
+    std::vector<Entry> _entries;
+    std::optional<std::chrono::milliseconds> _deadline;
+};
+
+} // namespace fujinet::io
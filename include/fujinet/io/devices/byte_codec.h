@@ -92,9 +92,59 @@ private:
     const std::uint8_t* _end{};
 };
 
+// Builds a response directly in its payload vector (IOResponse::payload),
+// so nothing is copied once the response is complete.
+//
+// Fixed-size fields whose value isn't known yet are written as placeholders
+// and filled in with patch_*(). Bulk data goes straight into the payload:
+// reserve_tail(n) grows it by n bytes and returns where they start, the
+// backend reads into that, and commit_tail(used) trims to what it produced.
+// The pointer is only valid until the next write.
+class Writer {
+public:
+    explicit Writer(std::vector<std::uint8_t>& out, std::size_t capacity = 0)
+        : _out(out) {
+        _out.clear();
+        _out.reserve(capacity);
+    }
+
+    void put(std::uint8_t b) { _out.push_back(b); }
+
+    void put(const void* data, std::size_t n) {
+        const auto* p = static_cast<const std::uint8_t*>(data);
+        _out.insert(_out.end(), p, p + n);
+    }
+
+    std::uint8_t* reserve_tail(std::size_t n) {
+        _tail = _out.size();
+        _out.resize(_tail + n);
+        return _out.data() + _tail;
+    }
+
+    void commit_tail(std::size_t used) {
+        if (_tail + used < _out.size()) _out.resize(_tail + used);
+    }
+
+    void patch_u8(std::size_t pos, std::uint8_t v) { _out[pos] = v; }
+
+    void patch_u16le(std::size_t pos, std::uint16_t v) {
+        _out[pos + 0] = static_cast<std::uint8_t>(v & 0xFF);
+        _out[pos + 1] = static_cast<std::uint8_t>((v >> 8) & 0xFF);
+    }
+
+    // Drops everything written, e.g. when the request fails after all.
+    void discard() { _out.clear(); }
+
+    std::size_t size() const { return _out.size(); }
+
+private:
+    std::vector<std::uint8_t>& _out;
+    std::size_t _tail{0};
+};
+
 // -----------------------------
 // Writer helpers
-// (works with std::string and std::vector<uint8_t>)
+// (works with std::string, std::vector<uint8_t> and Writer)
 // -----------------------------
 namespace detail {
 inline void push_byte(std::string& out, std::uint8_t b) {
@@ -103,10 +153,18 @@ inline void push_byte(std::string& out, std::uint8_t b) {
 inline void push_byte(std::vector<std::uint8_t>& out, std::uint8_t b) {
     out.push_back(b);
 }
-template <typename Buf>
-inline void push_bytes(Buf& out, const void* data, std::size_t n) {
+inline void push_byte(Writer& out, std::uint8_t b) {
+    out.put(b);
+}
+inline void push_bytes(std::string& out, const void* data, std::size_t n) {
+    out.append(static_cast<const char*>(data), n);
+}
+inline void push_bytes(std::vector<std::uint8_t>& out, const void* data, std::size_t n) {
     const auto* p = static_cast<const std::uint8_t*>(data);
-    for (std::size_t i = 0; i < n; ++i) push_byte(out, p[i]);
+    out.insert(out.end(), p, p + n);
+}
+inline void push_bytes(Writer& out, const void* data, std::size_t n) {
+    out.put(data, n);
 }
 } // namespace detail
 
@@ -5,6 +5,8 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <string>
+#include <string_view>
 
 namespace fujinet::io {
 
@@ -30,6 +32,31 @@ public:
                             std::size_t maxBytes,
                             std::uint16_t& actual,
                             bool& eof) const = 0;
+
+    // Evaluates another selector over `body`, the complete body this
+    // translator was last fed and finalized with, without changing the
+    // active view. `found` tells a missing value from an empty one.
+    // Unsupported means the translator can't; feed the body again instead.
+    virtual StatusCode query(std::string_view body,
+                             const std::string& selector,
+                             std::string& out,
+                             bool& found) const
+    {
+        (void)body;
+        (void)selector;
+        out.clear();
+        found = false;
+        return StatusCode::Unsupported;
+    }
+
+    // Switches the active view to `config.selector` as if the translator had
+    // been configured with it and fed `body` again. Same contract as query().
+    virtual StatusCode reselect(std::string_view body, const TranslationConfig& config)
+    {
+        (void)body;
+        (void)config;
+        return StatusCode::Unsupported;
+    }
 };
 
 } // namespace fujinet::io
@@ -22,7 +22,8 @@ public:
     explicit DiskDevice(fs::StorageManager& storage);
 
     IOResponse handle(const IORequest& request) override;
-    void poll() override {}
+    void poll() override;
+    void add_wait_sources(WaitSet& ws) override;
 
     void configure_boot_mount(std::string configUri, bool readOnly);
     std::vector<std::size_t> restore_runtime_mounts();
@@ -41,6 +42,7 @@ private:
         std::string uri;
         std::string mode;
         std::uint16_t sectorSizeHint{0};
+        disk::PrefetchMode prefetch{disk::PrefetchMode::Off};
     };
 
     bool save_runtime_mounts();
@@ -23,10 +23,17 @@ enum class FileCommand : std::uint8_t {
 // Bit 1: sort by basename (full directory is collected before paging).
 // Bit 2: formatted — entries blob is UTF-8 text lines (newline-terminated, whole lines only).
 //   Incompatible with bit 0.
+// Bit 3: name filter — u8 len + glob ("*.atr|*.xex") follows listFlags.
+// Bit 4: search — u8 len + case-insensitive substring follows (after the filter, if any).
+// Bit 5: apply bits 3/4 to directories too (by default directories are always listed).
+// startIndex and `more` count matching entries only.
 namespace list_directory {
 inline constexpr std::uint8_t kListFlagCompactOmitMetadata = 0x01U;
 inline constexpr std::uint8_t kListFlagSortByName        = 0x02U;
 inline constexpr std::uint8_t kListFlagFormattedLines    = 0x04U;
+inline constexpr std::uint8_t kListFlagNameFilter        = 0x08U;
+inline constexpr std::uint8_t kListFlagNameSearch        = 0x10U;
+inline constexpr std::uint8_t kListFlagFilterDirectories = 0x20U;
 inline constexpr std::uint8_t kListResponseFlagFormatted = 0x04U;
 } // namespace list_directory
 
@@ -3,6 +3,11 @@
 #include "fujinet/io/devices/virtual_device.h"
 #include "fujinet/fs/storage_manager.h"
 
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
 namespace fujinet::io {
 
 class FileDevice : public VirtualDevice {
@@ -10,11 +15,38 @@ public:
     explicit FileDevice(fs::StorageManager& storage);
 
     IOResponse handle(const IORequest& request) override;
-    void poll() override {}
+    void poll() override;
+    bool take_completed(IOResponse& out) override;
+    void add_wait_sources(WaitSet& ws) override;
+
+    // How long a deferred request may stay parked before the host gets
+    // NotReady back.
+    void set_deferred_timeout(std::chrono::milliseconds t) noexcept { _deferredTimeout = t; }
 
 private:
+    // Deferred Stat/ListDirectory/ReadFile: when a non-blocking filesystem
+    // (TNFS) has no answer yet, a deferrable request is parked and re-run
+    // from poll(), which resumes the same filesystem call. After the
+    // timeout the host gets NotReady and can retry itself.
+    static constexpr std::size_t MAX_DEFERRED = 8;
+    static constexpr std::chrono::milliseconds DEFAULT_DEFERRED_TIMEOUT{5000};
+    // The filesystem's sockets aren't in the wait set; re-check this often.
+    static constexpr std::chrono::milliseconds DEFERRED_RETRY_INTERVAL{10};
+
+    struct DeferredRequest {
+        IORequest request;
+        std::chrono::steady_clock::time_point deadline{};
+    };
+
     fs::StorageManager& _storage;
 
+    std::vector<DeferredRequest> _deferred;
+    std::deque<IOResponse> _completed;
+    std::chrono::milliseconds _deferredTimeout{DEFAULT_DEFERRED_TIMEOUT};
+
+    IOResponse handle_now(const IORequest& request);
+    void service_deferred();
+
     IOResponse handle_stat(const IORequest& request);
     IOResponse handle_list_directory(const IORequest& request);
     IOResponse handle_read_file(const IORequest& request);
@@ -2,14 +2,42 @@
 
 #include "fujinet/io/devices/content_translator.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace fujinet::io {
 
+// Streaming JSON Pointer translator.
+//
+// The body is scanned as it arrives and never stored: the scanner keeps one
+// small frame per open object/array and only copies out the value the
+// selector points at. Memory is O(nesting depth + selected value), however
+// large the document is.
+//
+// Selection follows cJSONUtils_GetPointer(): keys compare ASCII
+// case-insensitively, the first matching key wins, and array indices are
+// plain decimal without leading zeros. A selector that doesn't start with
+// '/' selects the whole document. A missing value or a malformed document
+// translates to empty output; anything after the top-level value is ignored.
+//
+// While scanning it also records where each object/array begins and ends
+// (8 bytes per container, up to MAX_INDEX_ENTRIES). query() and reselect()
+// use that index to walk straight down a new selector's path in the body,
+// skipping sibling containers without scanning them, so pulling many fields
+// from one response doesn't re-parse it for each one.
 class JsonContentTranslator final : public IContentTranslator {
 public:
     StatusCode configure(const TranslationConfig& config) override;
     void reset() override;
+
+    [[nodiscard]] bool needs_full_body() const override
+    {
+        return false;
+    }
+
     StatusCode append_body(const std::uint8_t* data, std::size_t len) override;
     StatusCode finalize() override;
     std::uint64_t translated_size() const override;
@@ -19,9 +47,109 @@ public:
                     std::uint16_t& actual,
                     bool& eof) const override;
 
+    StatusCode query(std::string_view body,
+                     const std::string& selector,
+                     std::string& out,
+                     bool& found) const override;
+    StatusCode reselect(std::string_view body, const TranslationConfig& config) override;
+
 private:
+    enum class State : std::uint8_t {
+        Value,          // expecting a value
+        ArrayFirst,     // after '[': a value or ']'
+        ObjectFirst,    // after '{': a key or '}'
+        ObjectKey,      // after ',' in an object: a key
+        Colon,          // after a key
+        AfterValue,     // ',' or the container's closing bracket
+        String,
+        Escape,
+        Unicode,        // \uXXXX
+        LowSurrogate,   // expecting "\u" of the second half of a pair
+        Number,
+        Literal,
+        Done,
+        Error,
+    };
+
+    struct Token {
+        std::string key;        // with ~0 and ~1 decoded
+        bool keyValid{true};    // false after a bad '~' escape: matches no key
+        bool hasIndex{false};
+        std::uint32_t index{0};
+    };
+
+    struct Frame {
+        bool array{false};
+        bool onPath{false};     // on the way to the selected value
+        bool childTaken{false}; // a member already matched the next token
+        std::uint32_t count{0}; // members seen so far
+        std::uint32_t slot{NO_SLOT}; // entry in _containers
+    };
+
+    // Body offsets of an object/array, from its bracket to one past the
+    // closing one.
+    struct Span {
+        std::uint32_t begin{0};
+        std::uint32_t end{0};
+    };
+
+    static constexpr std::size_t MAX_DEPTH = 1000; // cJSON's nesting limit
+    static constexpr std::size_t MAX_NUMBER = 63;  // cJSON's number buffer
+    static constexpr std::size_t MAX_INDEX_ENTRIES = 1024;
+    static constexpr std::uint32_t NO_SLOT = 0xFFFFFFFFu;
+
+    static void parse_pointer(const std::string& selector, std::vector<Token>& tokens);
+    static std::string translate_whole(std::string_view json, bool& valid);
+
+    bool child(std::string_view body, const Token& token, std::size_t& begin, std::size_t& end) const;
+    std::size_t value_end(std::string_view body, std::size_t pos) const;
+
+    bool step(std::uint8_t c);
+    void begin_value(std::uint8_t c);
+    void begin_key();
+    void end_key();
+    void close_container();
+    void end_value();
+    void put(std::uint8_t c);
+    void put_codepoint(std::uint32_t cp);
+    void finish_number();
+    void fail();
+
+    bool emitting() const noexcept { return _emitDepth >= 0; }
+
     TranslationConfig _config{};
-    std::string _body;
+    std::vector<Token> _tokens;
+
+    State _state{State::Value};
+    std::vector<Frame> _stack;
+    bool _started{false};
+    std::uint8_t _bomSeen{0};
+
+    bool _inKey{false};
+    bool _keyMatches{false};
+    std::size_t _keyPos{0};
+
+    std::uint32_t _unicode{0};
+    std::uint32_t _highSurrogate{0};
+    std::uint8_t _hexDigits{0};
+
+    char _number[MAX_NUMBER + 1]{};
+    std::size_t _numberLen{0};
+
+    const char* _literal{nullptr};
+    std::size_t _literalPos{0};
+
+    long _emitDepth{-1}; // stack depth of the selected value while inside it
+    bool _found{false};
+
+    std::uint32_t _offset{0}; // body bytes consumed before this chunk
+    std::uint32_t _pos{0};    // body offset of the byte being consumed
+    std::uint32_t _docBegin{0};
+    std::uint32_t _docEnd{0};
+    bool _indexEnabled{true};
+    bool _indexValid{true};
+    std::vector<Span> _containers; // in document order
+
     std::string _translated;
 };
 
@@ -6,6 +6,7 @@
 #include "fujinet/net/tcp_socket_ops.h"
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <string>
@@ -25,6 +26,7 @@ public:
 
     IOResponse handle(const IORequest& request) override;
     void poll() override;
+    void add_wait_sources(WaitSet& ws) override;
 
 private:
     // Allow out-of-band diagnostics (console) without polluting the on-wire API surface.
@@ -36,10 +38,13 @@ private:
     static constexpr std::size_t HOST_RX_BUF = 4096; // modem -> host
     static constexpr std::size_t NET_TX_BUF  = 1024; // host -> network (when backpressured)
 
-    // Poll-based timers (assuming ~20-50ms tick, but exact rate is platform-defined)
-    static constexpr std::uint64_t RING_INTERVAL_TICKS = 40; // ~2s at 50ms
-    static constexpr std::uint64_t RING_TIMEOUT_TICKS  = 40 * 30; // ~60s
-    static constexpr std::uint64_t ANSWER_DELAY_TICKS  = 20; // ~1s at 50ms
+    // Wall-clock timers. poll() runs whenever the core wakes (socket
+    // readiness, host traffic), so they are deadlines rather than tick
+    // counts, and add_wait_sources() wakes the loop when one is due.
+    static constexpr std::chrono::milliseconds RING_INTERVAL{2000};
+    static constexpr std::chrono::milliseconds RING_TIMEOUT{60000};
+    static constexpr std::chrono::milliseconds ANSWER_DELAY{1000};
+    static constexpr std::chrono::milliseconds ESCAPE_GUARD_TIME{1000}; // silence after "+++"
 
     struct ByteRing {
         std::vector<std::uint8_t> buf;
@@ -142,15 +147,15 @@ private:
     int _listenFd{-1};
     int _pendingFd{-1}; // accepted but not yet answered
 
-    std::uint64_t _tickNow{0};
-    std::uint64_t _lastRingTick{0};
-    std::uint64_t _pendingSinceTick{0};
-    std::uint64_t _answerAtTick{0};
+    // A default-constructed time_point means "not armed".
+    std::chrono::steady_clock::time_point _lastRing{};
+    std::chrono::steady_clock::time_point _pendingSince{};
+    std::chrono::steady_clock::time_point _answerAt{};
     bool _answered{false};
 
     // escape sequence tracking ("+++")
     int _plusCount{0};
-    std::uint64_t _plusTick{0};
+    std::chrono::steady_clock::time_point _plusAt{};
 
     // AT command buffer
     std::string _cmdBuf;
@@ -9,6 +9,7 @@
 namespace fujinet::io::netproto {
 
 using Reader = fujinet::io::bytecodec::Reader;
+using Writer = fujinet::io::bytecodec::Writer;
 
 using fujinet::io::bytecodec::write_u8;
 using fujinet::io::bytecodec::write_u16le;
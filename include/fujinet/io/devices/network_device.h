@@ -7,7 +7,9 @@
 #include "fujinet/io/devices/network_translation.h"
 
 #include <array>
+#include <chrono>
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -23,6 +25,20 @@ public:
 
     IOResponse handle(const IORequest& request) override;
     void poll() override;
+    bool take_completed(IOResponse& out) override;
+    void add_wait_sources(WaitSet& ws) override;
+
+    // How long a deferred request may stay parked before the host gets
+    // NotReady back. Wall-clock, since poll() may run more often than the
+    // loop's heartbeat when the core is woken by socket readiness.
+    void set_deferred_timeout(std::chrono::milliseconds t) noexcept { _deferredTimeout = t; }
+
+    // Idle reaping of sessions (see DEFAULT_IDLE_TIMEOUT); wall-clock too.
+    void set_session_timeouts(std::chrono::milliseconds idle, std::chrono::milliseconds bodyUpload) noexcept
+    {
+        _idleTimeout = idle;
+        _bodyUploadTimeout = bodyUpload;
+    }
 
 private:
     // Allow out-of-band diagnostics (console) without polluting the on-wire API surface.
@@ -31,9 +47,27 @@ private:
     static constexpr std::uint8_t NETPROTO_VERSION = 1;
     static constexpr std::size_t MAX_SESSIONS = 4;
 
-    // Timeouts expressed in "device poll ticks".
-    // With a 50ms tick, 20 ticks = 1s.
-    static constexpr std::uint64_t IDLE_TIMEOUT_TICKS = 20ull * 60ull * 20ull; // ~20m
+    // Sessions nobody has touched for this long are reaped by poll(). One
+    // still waiting for its request body gets the shorter timeout, so a host
+    // that dies mid-upload doesn't wedge the session table.
+    static constexpr std::chrono::milliseconds DEFAULT_IDLE_TIMEOUT{20 * 60 * 1000};
+    static constexpr std::chrono::milliseconds DEFAULT_BODY_UPLOAD_TIMEOUT{10 * 1000};
+
+    // Deferred Info/InfoRead/Read: a deferrable request that would answer
+    // NotReady is parked and retried from poll() until data arrives. After
+    // the timeout the host gets the NotReady it would have had, so it can
+    // fall back to polling.
+    static constexpr std::size_t MAX_DEFERRED = 8;
+    static constexpr std::chrono::milliseconds DEFAULT_DEFERRED_TIMEOUT{5000};
+
+    // Streaming translators see the body once, as it is read. A copy is kept
+    // up to this size so a later selector (TranslateConfigure) can be run
+    // over the same response; larger bodies are translated in constant
+    // memory and can only be queried once.
+    static constexpr std::size_t MAX_RETAINED_TRANSLATION_BODY = 16 * 1024;
+
+    // Selectors one TranslateQuery may evaluate.
+    static constexpr std::size_t MAX_QUERY_SELECTORS = 32;
 
     struct Session {
         bool active{false};
@@ -46,8 +80,8 @@ private:
         std::unique_ptr<INetworkProtocol> proto;
 
         // New: bookkeeping for reaping
-        std::uint64_t createdTick{0};
-        std::uint64_t lastActivityTick{0};
+        std::chrono::steady_clock::time_point createdAt{};
+        std::chrono::steady_clock::time_point lastActivity{};
 
         // Optional: mark "completed" once response is fully readable
         // (useful when you later do async backends)
@@ -65,15 +99,28 @@ private:
         std::string responseBodyCache;
         bool responseBodyCached{false};
         bool responseBodyBuffering{false};
+        std::uint32_t responseBodyRead{0};   // body bytes pulled for translation
+        bool responseBodyComplete{false};    // ... up to EOF
+        bool responseBodyDropped{false};     // cache gave up; the body can't be translated again
+        bool translatorPrimed{false};        // translator has seen the retained body
         bool translationReady{false};
         std::uint64_t translatedResultSize{0};
     };
 
+    struct DeferredRequest {
+        IORequest request;
+        std::chrono::steady_clock::time_point deadline{};
+    };
+
     std::array<Session, MAX_SESSIONS> _sessions{};
     ProtocolRegistry _registry;
-    
-    // local monotonic tick counter incremented from poll()
-    std::uint64_t _tickNow{0};
+
+    // Kept in arrival order so deferred Reads on one handle complete in order.
+    std::vector<DeferredRequest> _deferred;
+    std::deque<IOResponse> _completed;
+    std::chrono::milliseconds _deferredTimeout{DEFAULT_DEFERRED_TIMEOUT};
+    std::chrono::milliseconds _idleTimeout{DEFAULT_IDLE_TIMEOUT};
+    std::chrono::milliseconds _bodyUploadTimeout{DEFAULT_BODY_UPLOAD_TIMEOUT};
 
     static std::uint16_t make_handle(std::uint8_t idx, std::uint8_t gen) noexcept
     {
@@ -92,7 +139,13 @@ private:
 
     void touch(Session& s) noexcept
     {
-        s.lastActivityTick = _tickNow;
+        s.lastActivity = std::chrono::steady_clock::now();
+    }
+
+    // When poll() reaps `s` unless something touches it first.
+    std::chrono::steady_clock::time_point expires_at(const Session& s) const noexcept
+    {
+        return s.lastActivity + (s.awaitingBody ? _bodyUploadTimeout : _idleTimeout);
     }
 
     void close_and_free(Session& s) noexcept
@@ -105,14 +158,18 @@ private:
         s.method = 0;
         s.flags = 0;
         s.url.clear();
-        s.createdTick = 0;
-        s.lastActivityTick = 0;
+        s.createdAt = {};
+        s.lastActivity = {};
         s.completed = false;
         s.translation = TranslationConfig{};
         s.translator.reset();
         s.responseBodyCache.clear();
         s.responseBodyCached = false;
         s.responseBodyBuffering = false;
+        s.responseBodyRead = 0;
+        s.responseBodyComplete = false;
+        s.responseBodyDropped = false;
+        s.translatorPrimed = false;
         s.translationReady = false;
         s.translatedResultSize = 0;
     }
@@ -124,20 +181,24 @@ private:
         Session* victim = nullptr;
         for (auto& s : _sessions) {
             if (!s.active) continue;
-            // lower lastActivityTick means it's older
-            if (!victim || s.lastActivityTick < victim->lastActivityTick) {
+            // earlier lastActivity means it's older
+            if (!victim || s.lastActivity < victim->lastActivity) {
                 victim = &s;
             }
         }
         return victim;
     }
 
+    IOResponse handle_now(const IORequest& request);
+    void service_deferred();
+
     static bool translation_enabled(const Session& s) noexcept;
     static std::unique_ptr<IContentTranslator> make_translator(ContentTranslationType type);
     static void reset_translation(Session& s) noexcept;
 
     StatusCode configure_translation(Session& s, const TranslationConfig& config);
     StatusCode buffer_translation_body(Session& s);
+    StatusCode stream_translation_body(Session& s);
     StatusCode finalize_translation(Session& s);
     StatusCode ensure_translation_ready(Session& s);
 
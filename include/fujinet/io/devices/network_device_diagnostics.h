@@ -2,6 +2,7 @@
 
 #include "fujinet/io/devices/network_device.h"
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <string>
@@ -24,8 +25,8 @@ struct NetworkDeviceDiagnosticsAccessor {
         std::uint32_t expectedBodyLen{0};
         std::uint32_t receivedBodyLen{0};
 
-        std::uint64_t createdTick{0};
-        std::uint64_t lastActivityTick{0};
+        std::chrono::steady_clock::time_point createdAt{};
+        std::chrono::steady_clock::time_point lastActivity{};
 
         std::string url;
     };
@@ -51,8 +52,8 @@ struct NetworkDeviceDiagnosticsAccessor {
                 row.awaitingBody = s.awaitingBody;
                 row.expectedBodyLen = s.expectedBodyLen;
                 row.receivedBodyLen = s.receivedBodyLen;
-                row.createdTick = s.createdTick;
-                row.lastActivityTick = s.lastActivityTick;
+                row.createdAt = s.createdAt;
+                row.lastActivity = s.lastActivity;
                 row.url = s.url;
             }
             out.push_back(std::move(row));
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "fujinet/io/core/io_message.h"
+#include "fujinet/io/core/wait_set.h"
 
 namespace fujinet::io {
 
@@ -64,6 +65,10 @@ public:
     virtual StatusCode info(NetworkInfo& out) = 0;
 
     virtual void poll() = 0;
+
+    // Add the backend's socket(s) so the core loop wakes when poll() would
+    // make progress. Default: none.
+    virtual void add_wait_sources(WaitSet& ws) { (void)ws; }
     virtual void close() = 0;
 
     // ========================================================================
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "fujinet/io/core/io_message.h"
+#include "fujinet/io/core/wait_set.h"
 
 namespace fujinet::io {
 
@@ -15,11 +16,23 @@ public:
     virtual ~VirtualDevice() = default;
 
     // Handle a single request from the host.
+    //
+    // If request.deferrable is set and the answer is not available yet, a
+    // device may return StatusCode::Pending and hand the real response out
+    // of take_completed() once it is ready (typically from poll()).
     virtual IOResponse handle(const IORequest& request) = 0;
 
     // Called periodically by IODeviceManager / IOService.
     // Devices that don't need polling can ignore this (default no-op).
     virtual void poll() {}
+
+    // Add sockets (or deadlines) whose readiness means poll() has work, so
+    // the core loop can wake early instead of on the next heartbeat.
+    virtual void add_wait_sources(WaitSet& ws) { (void)ws; }
+
+    // Pop one finished deferred response. The response keeps the id and
+    // deviceId of the request that returned Pending.
+    virtual bool take_completed(IOResponse& out) { (void)out; return false; }
 };
 
 using VirtualService = VirtualDevice;
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "fujinet/io/devices/content_translator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fujinet::io {
+
+// Streaming XML translator for ContentTranslationType::Xml and ::Rss.
+//
+// Like the JSON translator it never stores the body: a small frame per open
+// element (its name, capped at MAX_NAME) is all the scanner keeps besides
+// the output, so feeds of any size translate in constant memory.
+//
+// Xml: the selector is an absolute element path, optionally ending in an
+// attribute, e.g. "/rss/channel/title", "/feed/entry[2]/link/@href".
+// "name[N]" picks the N-th (0-based) child of that name; names compare ASCII
+// case-insensitively, and an unprefixed name also matches a prefixed one
+// ("creator" matches "dc:creator"). An empty selector selects the root. The
+// first match wins; its text content (descendant text with whitespace runs
+// collapsed to one space and trimmed) or the attribute value is the output.
+//
+// Rss: RSS 0.9x/1.0/2.0 <item>s and Atom <entry>s are flattened into
+// "title\nlink\ndate\n" records (Atom links come from href, preferring
+// rel="alternate"). A decimal selector limits the number of records; empty
+// means all. Fields are capped at MAX_FIELD bytes.
+//
+// Markup errors are tolerated rather than rejected: an end tag closes back
+// to its matching start tag, and unknown entities pass through as written.
+class XmlContentTranslator final : public IContentTranslator {
+public:
+    StatusCode configure(const TranslationConfig& config) override;
+    void reset() override;
+
+    [[nodiscard]] bool needs_full_body() const override
+    {
+        return false;
+    }
+
+    StatusCode append_body(const std::uint8_t* data, std::size_t len) override;
+    StatusCode finalize() override;
+    std::uint64_t translated_size() const override;
+    StatusCode read(std::uint32_t offset,
+                    std::uint8_t* out,
+                    std::size_t maxBytes,
+                    std::uint16_t& actual,
+                    bool& eof) const override;
+
+    // Both rescan `body`; XML has no cheap index to keep.
+    StatusCode query(std::string_view body,
+                     const std::string& selector,
+                     std::string& out,
+                     bool& found) const override;
+    StatusCode reselect(std::string_view body, const TranslationConfig& config) override;
+
+private:
+    enum class State : std::uint8_t {
+        Text,
+        TagOpen,      // after '<'
+        StartName,
+        InTag,        // between attributes
+        AttrName,
+        AttrEq,       // expecting '='
+        AttrQuote,    // expecting the opening quote
+        AttrValue,
+        EmptyClose,   // after '/' in a start tag
+        EndName,
+        Bang,         // after "<!"
+        Comment,
+        CData,
+        Declaration,  // <!DOCTYPE ...>, with its internal subset
+        Pi,           // <? ... ?>
+        Entity,
+        Done,
+    };
+
+    struct Step {
+        std::string name;
+        std::uint32_t index{0};
+        bool attribute{false};
+    };
+
+    struct Frame {
+        std::string name;
+        bool onPath{false};
+        bool childTaken{false};
+        std::uint32_t matches{0}; // children named like the next step
+    };
+
+    // Collects text with whitespace runs collapsed and trimmed.
+    struct TextSink {
+        std::string* out{nullptr};
+        std::size_t cap{0};
+        bool pendingSpace{false};
+        bool any{false};
+
+        void start(std::string* target, std::size_t limit);
+        void add(std::uint8_t c);
+        void boundary();
+    };
+
+    enum class Field : std::uint8_t { None, Title, Link, Date };
+
+    static constexpr std::size_t MAX_DEPTH = 256;
+    static constexpr std::size_t MAX_NAME = 64;
+    static constexpr std::size_t MAX_ENTITY = 12;
+    static constexpr std::size_t MAX_FIELD = 256;
+
+    bool step(std::uint8_t c);
+    void text_char(std::uint8_t c);
+    void attr_char(std::uint8_t c);
+    void flush_entity(bool terminated);
+    void start_element();
+    void start_tag_done(bool empty);
+    void end_element(const std::string& name);
+    void pop_frame();
+    void begin_attribute();
+    void end_attribute();
+    void end_item();
+
+    bool name_matches(const std::string& name, const Step& step) const;
+
+    TranslationConfig _config{};
+    bool _rss{false};
+    std::vector<Step> _steps;
+    std::size_t _elementSteps{0}; // steps naming elements (not the @attribute)
+    std::uint32_t _maxItems{0};   // Rss: 0 = all
+
+    State _state{State::Text};
+    State _entityReturn{State::Text};
+    std::vector<Frame> _stack;
+    std::string _name;      // tag or attribute name being read
+    std::string _entity;
+    std::uint8_t _quote{0};
+    std::uint8_t _match{0}; // progress through "--", "[CDATA[", "-->", "]]>", "?>"
+    std::uint32_t _bracketDepth{0};
+
+    // Xml selection
+    long _emitDepth{-1};    // stack depth of the selected element while inside it
+    bool _attrTarget{false}; // the element being opened carries the selected attribute
+    bool _attrSelected{false};
+    bool _found{false};
+    TextSink _text{};
+
+    // Rss records
+    std::size_t _itemDepth{0}; // 0 = not in an item
+    std::size_t _fieldDepth{0};
+    Field _field{Field::None};
+    bool _attrHref{false};
+    bool _attrRel{false};
+    std::string _href;
+    std::string _rel;
+    std::string _title;
+    std::string _link;
+    std::string _date;
+    TextSink _fieldSink{};
+    std::uint32_t _items{0};
+
+    std::string _translated;
+};
+
+} // namespace fujinet::io
@@ -14,4 +14,12 @@ std::string format_list_directory_line(
     const fujinet::fs::FileInfo& entry,
     std::string_view basename);
 
+// ListDirectory name filter: case-insensitive glob where '*' matches any run
+// and '?' one character. '|' separates alternatives, e.g. "*.atr|*.xex".
+// An empty pattern matches everything.
+bool list_name_matches(std::string_view pattern, std::string_view name);
+
+// ListDirectory search: case-insensitive substring. Empty matches everything.
+bool list_name_contains(std::string_view name, std::string_view needle);
+
 } // namespace fujinet::io
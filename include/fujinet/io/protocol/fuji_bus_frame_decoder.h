@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "fujinet/io/protocol/fuji_bus_packet.h"
+#include "fujinet/io/protocol/wire_device_ids.h"
+
+namespace fujinet::io::protocol {
+
+// One fully decoded, checksum-verified FujiBus packet.
+struct FujiBusFrame {
+    WireDeviceId             device{};
+    std::uint8_t             command{};
+    bool                     tagged{false};
+    std::uint8_t             tag{0};
+    std::vector<PacketParam> params;
+    ByteBuffer               payload;
+};
+
+// Incremental SLIP + FujiBus decoder.
+//
+// Bytes are un-escaped as they are fed in, the folded checksum is accumulated
+// on the fly, and header/descriptor/param bytes are split from the payload as
+// soon as the descriptor chain tells us where the payload starts. Payload
+// bytes are written exactly once, straight into the buffer that is later
+// handed to the caller by next().
+//
+// Buffers are recycled: next() swaps the caller's previous payload/params
+// vectors back into the decoder, so a steady stream of requests does not
+// allocate once capacities have warmed up.
+class FujiBusFrameDecoder {
+public:
+    // Header length is a u16, so no valid frame can decode to more than this.
+    static constexpr std::size_t kMaxFrameBytes = 0xFFFF;
+
+    enum class Error : std::uint8_t {
+        None,
+        TooShort,       // fewer bytes than a FujiBus header
+        Truncated,      // descriptor chain or params ran past the frame end
+        LengthMismatch, // header length != decoded length
+        BadChecksum,
+        Oversized,      // exceeded maxFrameBytes (or the header length) mid-frame
+    };
+
+    explicit FujiBusFrameDecoder(std::size_t maxFrameBytes = kMaxFrameBytes)
+        : _maxFrameBytes(maxFrameBytes)
+        , _limit(maxFrameBytes)
+    {}
+
+    // Consume raw wire bytes. Completed valid frames are queued for next().
+    void feed(const std::uint8_t* data, std::size_t len);
+
+    bool hasFrame() const noexcept { return _head != _tail; }
+
+    // Pop the oldest completed frame. The contents of `out` are swapped with
+    // the queued slot so their capacity is reused for later frames.
+    bool next(FujiBusFrame& out);
+
+    // Drop any partial frame and queued frames (e.g. on channel reset).
+    void reset();
+
+    std::uint32_t droppedFrames() const noexcept { return _dropped; }
+    Error lastError() const noexcept { return _lastError; }
+
+    static const char* to_string(Error e) noexcept;
+
+private:
+    enum class State : std::uint8_t {
+        Hunting,   // waiting for the first END
+        Frame,     // inside a frame
+        Escape,    // inside a frame, previous byte was ESC
+        Discard,   // frame already rejected; skip to next END
+    };
+
+    void reserve_payload();
+    void accept(std::uint8_t b);
+    void accept_payload_run(const std::uint8_t* p, std::size_t n);
+    void end_frame();
+    void fail_frame(Error e);
+    void begin_frame();
+
+    bool in_payload() const noexcept
+    {
+        return !_moreDescr && _decoded >= _prefixLen && _decoded >= sizeof(FujiBusHeader);
+    }
+
+    State         _state{State::Hunting};
+    std::size_t   _maxFrameBytes;
+    std::size_t   _limit;          // max decoded bytes for the current frame
+
+    // Current frame progress.
+    std::size_t   _decoded{0};     // decoded bytes so far (header + prefix + payload)
+    std::uint16_t _chk{0};
+    std::uint8_t  _hdr[sizeof(FujiBusHeader)]{};
+    bool          _moreDescr{false};
+    bool          _tagged{false};
+    std::size_t   _paramBytes{0};
+    std::size_t   _prefixLen{0};   // header + extra descriptors + params, once known
+    ByteBuffer    _prefix;         // extra descriptors + param bytes
+    ByteBuffer    _payload;
+
+    // Completed frames, reused as a simple FIFO of slots.
+    std::vector<FujiBusFrame> _frames;
+    std::size_t   _head{0};
+    std::size_t   _tail{0};
+
+    std::uint32_t _dropped{0};
+    Error         _lastError{Error::None};
+};
+
+} // namespace fujinet::io::protocol
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "fujinet/io/protocol/fuji_bus_packet.h"
+#include "fujinet/io/protocol/wire_device_ids.h"
+
+namespace fujinet::io::protocol {
+
+// Largest param list encode_frame() accepts. Descriptors and params are
+// staged on the stack, so this bounds that scratch space.
+inline constexpr std::size_t kMaxEncodeParams = 32;
+
+// Build a complete SLIP-framed FujiBus packet into `out`.
+//
+// The checksum is computed over header, descriptors, params and payload in
+// wire order without concatenating them, and the payload is SLIP-escaped
+// straight from the caller's buffer in a single pass. `out` is cleared but
+// keeps its capacity, so a long-lived buffer makes steady-state encoding
+// allocation-free.
+//
+// If `tag` is set the packet carries FUJI_DESCR_TAGGED and the tag byte.
+//
+// Returns false (and leaves `out` empty) if the packet would not fit the
+// 16-bit length field or has more than kMaxEncodeParams params.
+bool encode_frame(ByteBuffer& out,
+                  WireDeviceId device,
+                  std::uint8_t command,
+                  const PacketParam* params,
+                  std::size_t paramCount,
+                  const std::uint8_t* payload,
+                  std::size_t payloadLen,
+                  std::optional<std::uint8_t> tag = std::nullopt);
+
+} // namespace fujinet::io::protocol
@@ -5,6 +5,7 @@
 #include <string>
 #include <memory>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
 
@@ -25,6 +26,40 @@ namespace fujinet::io::protocol {
 
     using ByteBuffer = std::vector<std::uint8_t>;
 
+    // On-wire header layout (must stay exactly this size/layout)
+    struct FujiBusHeader {
+        std::uint8_t  device;   // Destination Device
+        std::uint8_t  command;  // Command
+        std::uint16_t length;   // Total length of packet including header
+        std::uint8_t  checksum; // Checksum of entire packet
+        std::uint8_t  descr;    // Describes the fields that follow (first descriptor)
+    };
+
+    static_assert(sizeof(FujiBusHeader) == 6, "FujiBusHeader must be 6 bytes");
+    static_assert(offsetof(FujiBusHeader, checksum) == 4, "checksum offset mismatch");
+
+    // Descriptor bit masks
+    inline constexpr std::uint8_t FUJI_DESCR_COUNT_MASK  = 0x07;
+    inline constexpr std::uint8_t FUJI_DESCR_EXCEEDS_U8  = 0x04;
+    inline constexpr std::uint8_t FUJI_DESCR_EXCEEDS_U16 = 0x02;
+    inline constexpr std::uint8_t FUJI_DESCR_ADDTL_MASK  = 0x80;
+    // Only meaningful on the header (first) descriptor: a 1-byte request tag
+    // follows the descriptor chain, ahead of the param fields. Used by
+    // pipelined hosts to correlate responses; the device echoes it back.
+    inline constexpr std::uint8_t FUJI_DESCR_TAGGED      = 0x40;
+    inline constexpr std::uint8_t MAX_BYTES_PER_DESCR    = 4;
+
+    // Tables describing how many fields / what size correspond to a descriptor nibble.
+    // Indexed by (descr & FUJI_DESCR_COUNT_MASK).
+    inline constexpr std::uint8_t FIELD_SIZE_TABLE[8] = {0, 1, 1, 1, 1, 2, 2, 4};
+    inline constexpr std::uint8_t NUM_FIELDS_TABLE[8] = {0, 1, 2, 3, 4, 1, 2, 1};
+
+    // One step of the FujiBus checksum: add and fold the carry back into the low byte.
+    constexpr std::uint16_t checksum_step(std::uint16_t chk, std::uint8_t b) noexcept {
+        chk = static_cast<std::uint16_t>(chk + b);
+        return static_cast<std::uint16_t>((chk >> 8) + (chk & 0xFFU));
+    }
+
     struct PacketParam {
         std::uint32_t value;
         std::uint8_t  size;   // 1, 2, or 4 bytes
@@ -57,12 +92,9 @@ namespace fujinet::io::protocol {
         std::uint8_t _command{};
         std::vector<PacketParam> _params;
         std::optional<ByteBuffer> _data;   // raw payload bytes
+        std::optional<std::uint8_t> _tag;  // pipelined request tag (FUJI_DESCR_TAGGED)
     
-        // Internal helpers now operate on byte buffers
-        ByteBuffer decodeSLIP(const ByteBuffer& input) const;
-        ByteBuffer encodeSLIP(const ByteBuffer& input) const;
         bool parse(const ByteBuffer& input);
-        std::uint8_t calcChecksum(const ByteBuffer& buf) const;
     
         // Variadic constructor helpers for parameters
         void processArg(std::uint8_t v)  { _params.emplace_back(v); }
@@ -90,6 +122,8 @@ namespace fujinet::io::protocol {
         FujiBusPacket& setData(ByteBuffer data) { _data = std::move(data); return *this; }
         FujiBusPacket& clearData()              { _data.reset(); return *this; }
 
+        FujiBusPacket& setTag(std::uint8_t tag) { _tag = tag; return *this; }
+
         template<typename... Args>
         FujiBusPacket(WireDeviceId dev, std::uint8_t cmd, Args&&... args)
             : _device(dev)
@@ -118,6 +152,10 @@ namespace fujinet::io::protocol {
         const std::optional<ByteBuffer>& data() const {
             return _data;
         }
+
+        const std::optional<std::uint8_t>& tag() const {
+            return _tag;
+        }
     
         std::optional<std::string> dataAsString() const
         {
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fujinet::io::protocol {
+
+// Hot loops shared by the FujiBus frame encoder and decoder.
+//
+// Every byte moved over FujiBus is scanned for SLIP specials (END/ESC) and
+// folded into the packet checksum. These kernels do both 16-32 bytes at a
+// time where the CPU allows it, with a portable scalar fallback.
+//
+// The best available kernel is picked once at startup. Tests and the
+// fujibus_bench tool can force a specific one with set_slip_kernel().
+enum class SlipKernel : std::uint8_t {
+    Scalar,
+    Sse2,
+    Avx2,
+    Neon,
+};
+
+const char* to_string(SlipKernel k) noexcept;
+
+// True if the kernel was compiled in and the running CPU supports it.
+bool slip_kernel_available(SlipKernel k) noexcept;
+
+SlipKernel active_slip_kernel() noexcept;
+
+// Returns false (and changes nothing) if `k` is not available.
+bool set_slip_kernel(SlipKernel k) noexcept;
+
+// First END or ESC byte in [p, end), or `end` if the run is escape-free.
+const std::uint8_t* find_slip_special(const std::uint8_t* p, const std::uint8_t* end) noexcept;
+
+// Continue a FujiBus checksum over `n` bytes. Produces exactly the same
+// value as applying checksum_step() to each byte in turn: the end-around
+// carry fold is a sum modulo 255, so bytes can be summed wide and folded
+// once at the end.
+std::uint16_t checksum_update(std::uint16_t chk, const std::uint8_t* p, std::size_t n) noexcept;
+
+// Explicit-kernel variants, for tests and benchmarks. `k` must be available.
+const std::uint8_t* find_slip_special(SlipKernel k, const std::uint8_t* p, const std::uint8_t* end) noexcept;
+std::uint16_t checksum_update(SlipKernel k, std::uint16_t chk, const std::uint8_t* p, std::size_t n) noexcept;
+
+} // namespace fujinet::io::protocol
@@ -1,15 +1,22 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include "fujinet/io/core/channel.h"
 #include "fujinet/io/core/io_message.h"
+#include "fujinet/io/protocol/fuji_bus_frame_decoder.h"
 #include "fujinet/io/transport/transport.h"
 
 namespace fujinet::io {
 
 // Skeleton FujiBus transport.
 //
+// Pipelined mode (opt-in, per request): a host may set FUJI_DESCR_TAGGED and
+// send a 1-byte tag with each request, then queue further requests without
+// waiting. The tag is echoed on the matching response so the host can
+// correlate responses that complete out of order. Untagged requests behave
+// exactly as before (lockstep, untagged responses).
 class FujiBusTransport : public ITransport {
 public:
     explicit FujiBusTransport(Channel& channel)
@@ -20,18 +27,34 @@ public:
     void poll() override;
     bool supports_work_wait() const override;
     bool wait_for_work(std::chrono::milliseconds timeout) override;
+    void add_wait_sources(WaitSet& ws) override;
 
     bool receive(IORequest& outReq) override;
     void send(const IOResponse& resp) override;
 
     // Optional: parse an inbound packet as a response (status in param[0]).
     // Not used by IOService today, but useful for host-side or test harnesses.
+    // Tagged responses report their on-wire tag as outResp.id.
     bool receiveResponse(IOResponse& outResp);
 
+    // Tagged requests received but not yet answered.
+    std::size_t outstanding_tagged() const { return _outstandingTags.size(); }
+
 private:
-    Channel&                _channel;
-    std::vector<std::uint8_t> _rxBuffer;
-    RequestID               _nextRequestId;
+    struct OutstandingTag {
+        RequestID    id;
+        std::uint8_t tag;
+    };
+
+    void log_dropped_frames();
+
+    Channel&                        _channel;
+    protocol::FujiBusFrameDecoder   _decoder;
+    protocol::FujiBusFrame          _frame;          // scratch; buffers recycled via swap
+    protocol::ByteBuffer            _txBuffer;       // reused SLIP-encoded response
+    std::vector<OutstandingTag>     _outstandingTags;
+    std::uint32_t                   _droppedFrames{0};
+    RequestID                       _nextRequestId;
 };
 
 } // namespace fujinet::io
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <vector>
 
 #include "fujinet/io/core/io_message.h"
@@ -25,20 +26,42 @@ public:
 
     // One "tick" of the service loop.
     // - Let transports poll
+    // - Send any deferred responses that completed since the last tick
     // - Pull all available requests
     // - Route them through the handler
     // - Send responses back via the same transport
+    //
+    // A StatusCode::Pending response is not sent; the request is remembered
+    // and its real response goes out from deliverCompletions().
     void serviceOnce();
 
+    // Send responses for deferred requests that have completed. Called from
+    // serviceOnce(), and by the core right after devices are polled so a
+    // completion reaches the host without waiting for the next tick.
+    void deliverCompletions();
+
+    // Requests that returned Pending and have not been answered yet.
+    std::size_t pendingCount() const { return _pending.size(); }
+
     // Wait until any transport can make progress, up to timeout.
     // Returns false when no registered transport has a waitable source or when
     // the wait timed out. Callers own any fallback sleep policy.
     bool hasWaitableWorkSource() const;
     bool waitForWork(std::chrono::milliseconds timeout);
 
+    // Collect wake-up sources from every transport (reactor-driven loops).
+    void addWaitSources(WaitSet& ws);
+
 private:
+    struct PendingRequest {
+        ITransport* transport;
+        RequestID   id;
+        DeviceID    deviceId;
+    };
+
     IRequestHandler&              _handler;
     std::vector<ITransport*>      _transports;
+    std::vector<PendingRequest>   _pending;
 };
 
 } // namespace fujinet::io
@@ -26,6 +26,8 @@ public:
     virtual ~LegacyTransport() = default;
     
     void poll() override;
+
+    void add_wait_sources(WaitSet& ws) override { _channel.add_wait_sources(ws); }
     
     // Derived classes implement receive() and send() based on their protocol style
     bool receive(IORequest& outReq) override = 0;
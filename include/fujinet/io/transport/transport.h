@@ -1,6 +1,7 @@
 #pragma once
 
 #include "fujinet/io/core/io_message.h"
+#include "fujinet/io/core/wait_set.h"
 
 #include <chrono>
 
@@ -29,6 +30,9 @@ public:
         return false;
     }
 
+    // Add what this transport needs to wake for to a reactor wait set.
+    virtual void add_wait_sources(WaitSet& ws) { (void)ws; }
+
     // Try to read and parse one complete request from this transport.
     // Returns true if a full request was produced and stored in outReq.
     // Returns false if no complete request is available right now.
@@ -17,6 +17,9 @@ public:
     bool available() override;
     std::size_t read(std::uint8_t* buffer, std::size_t max_len) override;
     void write(const std::uint8_t* buffer, std::size_t len) override;
+    bool supports_readable_wait() const override { return connected_; }
+    bool wait_for_readable(std::chrono::milliseconds timeout) override;
+    void add_wait_sources(fujinet::io::WaitSet& ws) override;
 
 private:
     ITcpSocketOps& socket_ops_;
@@ -69,6 +69,11 @@ public:
     void poll();
     void close();
 
+    // Connecting: wake on writable (connect done) and at the connect timeout.
+    // Connected: wake on readable while the RX ring has room. A full ring or
+    // a peer-closed socket adds nothing, so unread data can't spin the loop.
+    void add_wait_sources(fujinet::io::WaitSet& ws);
+
     // Accessors for state (for testing/debugging)
     State state() const noexcept { return _state; }
     int last_errno() const noexcept { return _last_errno; }
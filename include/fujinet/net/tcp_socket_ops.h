@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <cstddef>
 
@@ -52,6 +53,16 @@ public:
     // On error, returns false and sets errno.
     virtual bool poll_connect_complete(int fd) = 0;
 
+    // Block until fd is readable (data, EOF or error) or the timeout
+    // passes. Returns true if readable. The default never waits, for ops
+    // without a select/poll primitive.
+    virtual bool wait_readable(int fd, std::chrono::milliseconds timeout)
+    {
+        (void)fd;
+        (void)timeout;
+        return false;
+    }
+
     // Send data (nonblocking). Returns bytes sent (>0), -1 on error (errno set).
     // Platform implementation may apply any required flags (e.g. MSG_DONTWAIT/MSG_NOSIGNAL).
     virtual SSize send(int fd, const void* buf, std::size_t len) = 0;
@@ -22,6 +22,7 @@ public:
     void write(const std::uint8_t* buffer, std::size_t len) override;
     bool supports_readable_wait() const override { return true; }
     bool wait_for_readable(std::chrono::milliseconds timeout) override;
+    void add_wait_sources(fujinet::io::WaitSet& ws) override;
 
 private:
     IUdpSocketOps& socket_ops_;
@@ -0,0 +1,78 @@
+#pragma once
+
+#if FN_WITH_CURL == 1
+
+#include "fujinet/io/core/wait_set.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <curl/curl.h>
+
+namespace fujinet::platform::posix {
+
+// Process-wide libcurl state shared by every HttpNetworkProtocolCurl session.
+//
+// One multi handle drives all transfers, so idle keep-alive connections stay
+// in its pool between sessions and HTTP/2 streams to the same origin can be
+// multiplexed. A CURLSH share adds the DNS cache, connection cache and TLS
+// session cache on top, so a fresh Open against a recently used host skips
+// the lookup and both handshakes.
+//
+// The core loop is single-threaded, so no share locking is installed.
+class CurlHttpEngine {
+public:
+    struct Stats {
+        std::uint64_t transfers{0};        // completed transfers
+        std::uint64_t reusedConnections{0}; // completed without a new connect
+    };
+
+    static CurlHttpEngine& instance();
+
+    CurlHttpEngine(const CurlHttpEngine&) = delete;
+    CurlHttpEngine& operator=(const CurlHttpEngine&) = delete;
+
+    // Apply the shared handle and connection-reuse options to a new easy
+    // handle. Call once after curl_easy_init().
+    void configure(CURL* easy);
+
+    // Start/stop driving a transfer. remove() is safe for handles that were
+    // never added or have already completed.
+    bool add(CURL* easy);
+    void remove(CURL* easy);
+
+    // Advance every transfer once (non-blocking). Cheap to call repeatedly
+    // from several sessions in the same tick.
+    void perform();
+
+    // If `easy` has finished, report its result and forget it.
+    bool take_done(CURL* easy, CURLcode& result);
+
+    // Record that the owner paused (CURL_WRITEFUNC_PAUSE) or resumed `easy`.
+    // A paused transfer has no socket to watch; its owner resumes it from a
+    // host read, which already wakes the loop.
+    void set_paused(CURL* easy, bool paused);
+    std::size_t paused_count() const noexcept { return _paused.size(); }
+
+    // fds and timer for all running transfers.
+    void add_wait_sources(io::WaitSet& ws);
+
+    const Stats& stats() const noexcept { return _stats; }
+
+private:
+    CurlHttpEngine();
+    ~CurlHttpEngine();
+
+    CURLM* _multi{nullptr};
+    CURLSH* _share{nullptr};
+    int _running{0};
+    std::unordered_map<CURL*, CURLcode> _done;
+    std::unordered_set<CURL*> _paused;
+    Stats _stats{};
+};
+
+} // namespace fujinet::platform::posix
+
+#endif // FN_WITH_CURL
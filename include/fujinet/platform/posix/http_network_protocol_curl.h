@@ -4,15 +4,34 @@
 
 #if FN_WITH_CURL == 1
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <curl/curl.h>
 
 namespace fujinet::platform::posix {
 
+// HTTP/HTTPS session backed by an easy handle on the shared CurlHttpEngine,
+// so sessions reuse pooled connections, DNS results and TLS sessions.
 class HttpNetworkProtocolCurl final : public io::INetworkProtocol {
 public:
+    // Response bodies are buffered in a fixed ring of `highWater` bytes.
+    // When curl has more than fits, the transfer is paused (TCP backpressure
+    // does the rest) and resumed once the host has read the buffer down to
+    // `lowWater`. highWater is raised if needed to leave at least one full
+    // curl write (CURL_MAX_WRITE_SIZE) of room above lowWater.
+    struct BufferLimits {
+        std::size_t highWater = 64 * 1024;
+        std::size_t lowWater  = 16 * 1024;
+    };
+
+    HttpNetworkProtocolCurl() : HttpNetworkProtocolCurl(BufferLimits{}) {}
+    explicit HttpNetworkProtocolCurl(BufferLimits limits);
+    ~HttpNetworkProtocolCurl() override { close(); }
+
     io::StatusCode open(const io::NetworkOpenRequest& req) override;
 
     io::StatusCode write_body(std::uint32_t offset,
@@ -31,11 +50,53 @@ public:
 
     void poll() override;
     void close() override;
+    void add_wait_sources(io::WaitSet& ws) override;
+
+    // Diagnostics / tests.
+    std::size_t buffered_bytes() const noexcept { return _body.size(); }
+    std::size_t buffer_capacity() const noexcept { return _limits.highWater; }
+    bool paused() const noexcept { return _paused; }
 
 private:
+    // Fixed-capacity byte ring addressed relative to the oldest unread byte.
+    struct BodyRing {
+        std::vector<std::uint8_t> buf;
+        std::size_t head{0};
+        std::size_t len{0};
+
+        std::size_t size() const noexcept { return len; }
+        std::size_t free_space() const noexcept { return buf.size() - len; }
+        void clear() noexcept { head = 0; len = 0; }
+
+        // Caller checks free_space() first.
+        void push(const std::uint8_t* p, std::size_t n) noexcept
+        {
+            std::size_t tail = (head + len) % buf.size();
+            const std::size_t first = std::min(n, buf.size() - tail);
+            std::memcpy(buf.data() + tail, p, first);
+            std::memcpy(buf.data(), p + first, n - first);
+            len += n;
+        }
+
+        void peek(std::size_t rel, std::uint8_t* out, std::size_t n) const noexcept
+        {
+            const std::size_t start = (head + rel) % buf.size();
+            const std::size_t first = std::min(n, buf.size() - start);
+            std::memcpy(out, buf.data() + start, first);
+            std::memcpy(out + first, buf.data(), n - first);
+        }
+
+        void drop(std::size_t n) noexcept
+        {
+            head = (head + n) % buf.size();
+            len -= n;
+            if (len == 0) head = 0;
+        }
+    };
+
     static std::size_t write_body_cb(char* ptr, std::size_t size, std::size_t nmemb, void* userdata);
     static std::size_t write_header_cb(char* ptr, std::size_t size, std::size_t nmemb, void* userdata);
-    io::StatusCode start_async(); // starts the request via curl_multi, returns immediately
+    io::StatusCode start_async(); // starts the request on the shared engine, returns immediately
     void tick_async();            // advance multi state and collect completion
 
     io::NetworkOpenRequest _req{};
@@ -43,10 +104,12 @@ private:
     bool _hasContentLength{false};
     std::uint64_t _contentLength{0};
     std::string _headersBlock;
-    std::vector<std::uint8_t> _body;
+    BufferLimits _limits;
+    BodyRing _body;
+    bool _paused = false;      // write callback returned CURL_WRITEFUNC_PAUSE
+    bool _bodyStarted = false; // final response's headers are complete
 
     CURL* _curl = nullptr;
-    CURLM* _multi = nullptr;
     curl_slist* _slist = nullptr;
 
     std::vector<std::uint8_t> _requestBody;
@@ -55,11 +118,9 @@ private:
     bool _inProgress = false;  // true while curl transfer is running
     io::StatusCode _finalStatus = io::StatusCode::Ok;
 
-    // Streaming response buffering:
-    // We keep a growing buffer as curl delivers bytes, but we advance a base
-    // offset as the host reads sequentially, so we don't grow without bound.
+    // Body offset of the oldest byte still in _body; advances as the host
+    // reads sequentially.
     std::uint32_t _bodyBaseOffset = 0;
-    std::size_t _bodyStartIndex = 0;
 
 };
 
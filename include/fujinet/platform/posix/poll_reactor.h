@@ -0,0 +1,31 @@
+#pragma once
+
+#include "fujinet/io/core/wait_set.h"
+
+#include <chrono>
+#include <vector>
+
+#include <poll.h>
+
+namespace fujinet::platform::posix {
+
+// Sleeps the POSIX main loop until something in a WaitSet is ready.
+//
+// poll(2) rather than epoll: the set is rebuilt every tick and holds a
+// handful of fds, so registering with the kernel each time is cheaper than
+// keeping an epoll set in sync with sockets that come and go.
+class PollReactor {
+public:
+    // Returns true if an fd became readable/writable before the timeout.
+    //
+    // Hangup-only readiness (a PTY master with no slave, a dropped serial
+    // adapter) doesn't count: those fds stay "ready" until someone reopens
+    // them, so the reactor falls back to sleeping out the timeout rather
+    // than spinning.
+    bool wait(const io::WaitSet& ws, std::chrono::milliseconds idle);
+
+private:
+    std::vector<pollfd> _fds;
+};
+
+} // namespace fujinet::platform::posix
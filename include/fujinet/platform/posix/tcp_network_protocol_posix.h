@@ -32,6 +32,7 @@ public:
     fujinet::io::StatusCode info(fujinet::io::NetworkInfo& out) override;
     void poll() override;
     void close() override;
+    void add_wait_sources(fujinet::io::WaitSet& ws) override { _common.add_wait_sources(ws); }
 
     // Protocol capabilities - TCP is a streaming protocol
     bool is_streaming() const override { return true; }
@@ -2,6 +2,7 @@
 
 #include "fujinet/io/devices/network_protocol.h"
 
+#include <chrono>
 #include <cstdint>
 #include <cstddef>
 #include <string>
@@ -9,13 +10,21 @@
 
 // Forward declarations for OpenSSL types
 typedef struct ssl_st SSL;
-typedef struct ssl_ctx_st SSL_CTX;
+typedef struct ssl_session_st SSL_SESSION;
 
 namespace fujinet::platform::posix {
 
 // TLS stream backend using OpenSSL.
 // Provides secure TCP connections (TLS/SSL) for protocols like IRC over TLS, SMTPS, etc.
 // URL format: tls://host:port
+//
+// open() only resolves the host and starts a non-blocking connect; the TCP
+// connect and the TLS handshake are then stepped from poll() (Read/Write
+// answer NotReady meanwhile), so a slow server never stalls the core loop.
+// All connections share one SSL_CTX per trust policy, built on first use,
+// and a client session cache keyed by host:port lets reconnects resume
+// (TLS 1.2 session IDs/tickets, TLS 1.3 tickets) instead of doing a full
+// handshake.
 class TlsNetworkProtocolPosix final : public fujinet::io::INetworkProtocol {
 public:
     TlsNetworkProtocolPosix();
@@ -35,6 +44,7 @@ public:
     fujinet::io::StatusCode info(fujinet::io::NetworkInfo& out) override;
     void poll() override;
     void close() override;
+    void add_wait_sources(fujinet::io::WaitSet& ws) override;
 
     // Protocol capabilities - TLS is a streaming protocol
     bool is_streaming() const override { return true; }
@@ -53,24 +63,35 @@ private:
     // Initialize OpenSSL (called once globally)
     static void ensure_ssl_init();
 
+    // SSL_CTX new-session callback: files the session under _sessionKey.
+    static int on_new_session(SSL* ssl, SSL_SESSION* session);
+
     // Handle I/O errors
     void handle_error(const char* context, int sslError);
 
+    // Connect/handshake steps, driven from open() and poll().
+    void step_connect();
+    void step_handshake();
+    bool handshake_timed_out();
+
     SSL* _ssl{nullptr};
-    SSL_CTX* _ctx{nullptr};
     int _socket{-1};
     std::string _host;
     std::uint16_t _port{0};
+    std::string _sessionKey; // "host:port"
 
     // Connection state
     enum class State {
         Idle,
-        Connecting,
+        Connecting,   // TCP connect in progress
+        Handshaking,  // TLS handshake in progress
         Connected,
         PeerClosed,
         Error
     };
     State _state{State::Idle};
+    bool _handshakeWantsWrite{false};
+    std::chrono::steady_clock::time_point _deadline{};
 
     // RX buffer for incoming data
     std::vector<std::uint8_t> _rxBuffer;
@@ -1,12 +1,17 @@
 #pragma once
 
 #include "fujinet/tnfs/tnfs_protocol.h"
+#include "fujinet/tnfs/tnfs_rtt.h"
 #include "fujinet/io/core/channel.h"
 #include "fujinet/core/logging.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstring>
+#include <deque>
+#include <map>
 #include <memory>
+#include <optional>
 #include <thread>
 #include <vector>
 
@@ -14,13 +19,47 @@ namespace fujinet::tnfs {
 
 static constexpr const char* TAG = "tnfs";
 
+// TNFS client shared by the UDP and TCP transports.
+//
+// Commands are request/reply, matched by sequence number. Sequential file
+// reads are pipelined: up to `readWindow` CMD_READs per handle are kept in
+// flight and their payloads land in a per-handle read-ahead buffer. TNFS
+// READ has no offset (the server's file pointer advances per request), so
+// replies must be consumed in send order; a lost or out-of-order reply makes
+// the client drain the window and LSEEK back to the last byte it delivered.
+//
+// Pipelining needs one packet per Channel::read(), i.e. a datagram channel.
+// Over TCP replies can coalesce in the stream, so the TCP client uses a
+// window of 1 (plain stop-and-wait).
+//
+// Replies are awaited with Channel::wait_for_readable() where the channel
+// supports it. Requests are retransmitted on an adaptive timer (RttEstimator)
+// until kGiveUpAfter has passed, at which point the session counts as lost.
+//
+// Non-blocking mode (set_nonblocking): a request that starts an operation
+// (MOUNT, STAT, MKDIR, RMDIR, UNLINK, RENAME, OPEN, OPENDIR/X) waits one RTO
+// at most. If it is unanswered by then it is parked and the call fails with
+// would_block(). Repeating the identical call picks up the reply instead of
+// sending a new request. poll() retransmits the parked request meanwhile.
+// Other starting requests fail with would_block() straight away while one
+// is parked: the server has just missed a deadline. Follow-up exchanges
+// (READDIR, CLOSE, ...) and file I/O always wait, so a multi-step operation
+// never stops halfway.
 class CommonTnfsClient : public ITnfsClient {
 public:
-    CommonTnfsClient(std::unique_ptr<fujinet::io::Channel> channel, const char* transportName)
+    static constexpr std::size_t kMaxReadChunk = 512;
+    static constexpr std::size_t kDefaultReadWindow = 4;
+    static constexpr std::size_t kMaxReadWindow = 16; // well inside the 8-bit sequence space
+
+    CommonTnfsClient(std::unique_ptr<fujinet::io::Channel> channel,
+                     const char* transportName,
+                     std::size_t readWindow = 1)
         : _channel(std::move(channel))
         , _transportName(transportName)
+        , _readWindow(std::clamp<std::size_t>(readWindow, 1, kMaxReadWindow))
     {
-        FN_LOGI(TAG, "%s TNFS client created", _transportName);
+        FN_LOGI(TAG, "%s TNFS client created (read window %u)",
+                _transportName, static_cast<unsigned>(_readWindow));
     }
 
     ~CommonTnfsClient() override
@@ -57,6 +96,10 @@ public:
         }
 
         _sessionId = read_u16le(pkt.sessionIdL, pkt.sessionIdH);
+        _handles.clear(); // a remount starts from a clean slate
+        _awaiting.clear();
+        _stash.clear();
+        _parked.reset();
         FN_LOGI(TAG, "Mounted %s session 0x%04X", _transportName, static_cast<unsigned>(_sessionId));
         return true;
     }
@@ -66,6 +109,15 @@ public:
         if (_sessionId == 0) {
             return true;
         }
+        if (_lost) {
+            // Nobody is listening; don't spend another round of timeouts.
+            _sessionId = 0;
+            _handles.clear();
+            _awaiting.clear();
+            _stash.clear();
+            _parked.reset();
+            return true;
+        }
 
         TnfsPacket pkt{};
         fill_session_header(pkt, CMD_UNMOUNT);
@@ -77,6 +129,10 @@ public:
         }
 
         _sessionId = 0;
+        _handles.clear();
+        _awaiting.clear();
+        _stash.clear();
+        _parked.reset();
         return true;
     }
 
@@ -198,6 +254,95 @@ public:
         return entries;
     }
 
+    // OPENDIRX/READDIRX: the server filters and sorts, and each READDIRX
+    // reply carries as many entries (with size/mtime/flags) as fit in one
+    // packet, so a listing costs a handful of round trips instead of one
+    // READDIR plus one STAT per entry. Servers older than protocol 1.2 answer
+    // OPENDIRX with "function unimplemented"; we remember that and use the
+    // generic READDIR+STAT path for the rest of the session. An unanswered
+    // OPENDIRX only fails this listing: on a lossy link the next one should
+    // still get the cheap path.
+    bool listDirectoryEntries(const std::string& path,
+                              const TnfsDirOptions& opts,
+                              std::vector<TnfsDirEntry>& out) override
+    {
+        out.clear();
+        if (_sessionId == 0) {
+            return false;
+        }
+        if (!_dirxSupported) {
+            return ITnfsClient::listDirectoryEntries(path, opts, out);
+        }
+
+        TnfsPacket pkt{};
+        fill_session_header(pkt, CMD_OPENDIRX);
+        pkt.payload[0] = opts.dirOptions;
+        pkt.payload[1] = opts.sortOptions;
+        pkt.payload[2] = static_cast<std::uint8_t>(opts.maxResults & 0xFFU);
+        pkt.payload[3] = static_cast<std::uint8_t>((opts.maxResults >> 8) & 0xFFU);
+
+        std::size_t offset = 4;
+        if (!append_cstring(pkt.payload, sizeof(pkt.payload), offset, opts.pattern) ||
+            !append_cstring(pkt.payload, sizeof(pkt.payload), offset, path)) {
+            return false;
+        }
+
+        if (!send_and_receive(pkt, offset)) {
+            return false;
+        }
+        if (pkt.payload[0] == RESULT_FUNCTION_UNIMPLEMENTED) {
+            FN_LOGI(TAG, "%s server has no OPENDIRX; listing with READDIR+STAT", _transportName);
+            _dirxSupported = false;
+            return ITnfsClient::listDirectoryEntries(path, opts, out);
+        }
+        if (pkt.payload[0] != RESULT_SUCCESS) {
+            return false;
+        }
+
+        const std::uint8_t dirHandle = pkt.payload[1];
+        out.reserve(read_u16le(pkt.payload[2], pkt.payload[3]));
+
+        bool ok = true;
+        while (true) {
+            TnfsPacket readPkt{};
+            fill_session_header(readPkt, CMD_READDIRX);
+            readPkt.payload[0] = dirHandle;
+            readPkt.payload[1] = 0; // as many as fit
+
+            if (!send_and_receive(readPkt, 2)) {
+                ok = false;
+                break;
+            }
+            if (readPkt.payload[0] == RESULT_END_OF_FILE) {
+                break;
+            }
+            if (readPkt.payload[0] != RESULT_SUCCESS) {
+                ok = false;
+                break;
+            }
+
+            const std::size_t count = readPkt.payload[1];
+            const std::uint8_t dirStatus = readPkt.payload[2];
+            if (!parse_dirx_entries(readPkt, count, out)) {
+                ok = false;
+                break;
+            }
+            if (count == 0 || (dirStatus & DIRSTATUS_EOF) != 0) {
+                break;
+            }
+        }
+
+        TnfsPacket closePkt{};
+        fill_session_header(closePkt, CMD_CLOSEDIR);
+        closePkt.payload[0] = dirHandle;
+        send_and_receive(closePkt, 1);
+
+        if (!ok) {
+            out.clear();
+        }
+        return ok;
+    }
+
     int open(const std::string& path, uint16_t openMode, uint16_t createPerms) override
     {
         if (_sessionId == 0) {
@@ -222,7 +367,12 @@ public:
         if (pkt.payload[0] != RESULT_SUCCESS) {
             return -1;
         }
-        return static_cast<int>(pkt.payload[1]);
+
+        const int handle = static_cast<int>(pkt.payload[1]);
+        forget_handle(handle);
+        HandleState& hs = _handles[handle];
+        hs.posKnown = (openMode & OPENMODE_WRITE_APPEND) == 0;
+        return handle;
     }
 
     bool close(int fileHandle) override
@@ -231,6 +381,10 @@ public:
             return false;
         }
 
+        // Outstanding read-ahead replies are simply abandoned; the server
+        // handles them before the CLOSE.
+        forget_handle(fileHandle);
+
         TnfsPacket pkt{};
         fill_session_header(pkt, CMD_CLOSE);
         pkt.payload[0] = static_cast<std::uint8_t>(fileHandle);
@@ -242,33 +396,74 @@ public:
 
     std::size_t read(int fileHandle, void* buffer, std::size_t bytes) override
     {
-        if (_sessionId == 0) {
+        if (_sessionId == 0 || !buffer) {
             return 0;
         }
 
-        const std::size_t req = (bytes > 512) ? 512 : bytes;
-        TnfsPacket pkt{};
-        fill_session_header(pkt, CMD_READ);
-        pkt.payload[0] = static_cast<std::uint8_t>(fileHandle);
-        pkt.payload[1] = static_cast<std::uint8_t>(req & 0xFFU);
-        pkt.payload[2] = static_cast<std::uint8_t>((req >> 8) & 0xFFU);
-        if (!send_and_receive(pkt, 3)) {
-            return 0;
+        HandleState& hs = _handles[fileHandle];
+        if (hs.eof && !hs.ahead()) {
+            hs.eof = false; // ask again; the file may have grown
         }
+        auto* out = static_cast<std::uint8_t*>(buffer);
+        std::size_t done = 0;
+        int resyncs = 0;
+
+        while (done < bytes) {
+            // 1) Serve from read-ahead.
+            const std::size_t have = hs.buf.size() - hs.bufOff;
+            if (have > 0) {
+                const std::size_t n = std::min(have, bytes - done);
+                std::memcpy(out + done, hs.buf.data() + hs.bufOff, n);
+                hs.bufOff += n;
+                done += n;
+                hs.pos += static_cast<std::uint32_t>(n);
+                if (hs.bufOff == hs.buf.size()) {
+                    hs.buf.clear();
+                    hs.bufOff = 0;
+                }
+                continue;
+            }
+            if (hs.eof && hs.inflight.empty()) {
+                break;
+            }
 
-        if (pkt.payload[0] == RESULT_END_OF_FILE) {
-            return 0;
-        }
-        if (pkt.payload[0] != RESULT_SUCCESS) {
-            return 0;
-        }
+            // 2) Keep the window full. The first read after open/seek only
+            // asks for what the caller wants, so random access doesn't
+            // over-fetch; once reads continue sequentially, use the window.
+            const std::size_t need = (bytes - done + kMaxReadChunk - 1) / kMaxReadChunk;
+            const std::size_t want = hs.streak > 0 ? _readWindow : std::min(need, _readWindow);
+            while (!hs.eof && hs.inflight.size() < want) {
+                send_read(fileHandle, hs);
+            }
+            if (hs.inflight.empty()) {
+                break;
+            }
 
-        std::size_t got = static_cast<std::size_t>(read_u16le(pkt.payload[1], pkt.payload[2]));
-        if (got > req) {
-            got = req;
+            // 3) Consume the oldest reply.
+            const ReadOutcome r = collect_read(hs);
+            if (r == ReadOutcome::Data) {
+                continue;
+            }
+            if (r == ReadOutcome::Eof) {
+                hs.eof = true;
+                continue;
+            }
+            if (r == ReadOutcome::Failed) {
+                // Server-side error: report what we have, and don't trust
+                // the server's file pointer any more.
+                resync(fileHandle, hs);
+                break;
+            }
+            // Lost or reordered reply.
+            if (++resyncs > kMaxResyncs || !resync(fileHandle, hs)) {
+                FN_LOGE(TAG, "%s TNFS read on handle %d failed after %d resyncs",
+                        _transportName, fileHandle, resyncs);
+                break;
+            }
         }
-        std::memcpy(buffer, pkt.payload + 3, got);
-        return got;
+
+        ++hs.streak;
+        return done;
     }
 
     std::size_t write(int fileHandle, const void* buffer, std::size_t bytes) override
@@ -277,6 +472,13 @@ public:
             return 0;
         }
 
+        // Read-ahead moved the server's file pointer past our position.
+        HandleState& hs = _handles[fileHandle];
+        if (hs.ahead() && !resync(fileHandle, hs)) {
+            return 0;
+        }
+        hs.streak = 0;
+
         const std::size_t chunk = (bytes > 512) ? 512 : bytes;
         TnfsPacket pkt{};
         fill_session_header(pkt, CMD_WRITE);
@@ -291,24 +493,80 @@ public:
         if (pkt.payload[0] != RESULT_SUCCESS) {
             return 0;
         }
-        return static_cast<std::size_t>(read_u16le(pkt.payload[1], pkt.payload[2]));
+        const std::size_t written = static_cast<std::size_t>(read_u16le(pkt.payload[1], pkt.payload[2]));
+        hs.pos += static_cast<std::uint32_t>(written);
+        return written;
     }
 
     bool seek(int fileHandle, uint32_t offset) override
     {
-        std::uint32_t ignored = 0;
-        return lseek_internal(fileHandle, offset, 0, ignored); // SEEK_SET
+        HandleState& hs = _handles[fileHandle];
+
+        // Seeking to where we already are, or forward inside the read-ahead
+        // buffer, needs no round trip and keeps the window streaming.
+        if (hs.posKnown && offset >= hs.pos) {
+            const std::uint32_t skip = offset - hs.pos;
+            if (skip <= hs.buf.size() - hs.bufOff) {
+                hs.bufOff += skip;
+                hs.pos = offset;
+                return true;
+            }
+        }
+
+        drop_read_ahead(hs);
+        hs.streak = 0;
+
+        std::uint32_t newPos = 0;
+        if (!lseek_internal(fileHandle, offset, 0, newPos)) { // SEEK_SET
+            hs.posKnown = false;
+            return false;
+        }
+        hs.pos = offset;
+        hs.posKnown = true;
+        return true;
     }
 
     uint32_t tell(int fileHandle) override
     {
+        HandleState& hs = _handles[fileHandle];
+        if (hs.posKnown) {
+            return hs.pos;
+        }
+
         std::uint32_t pos = 0;
         if (!lseek_internal(fileHandle, 0, 1, pos)) { // SEEK_CUR
             return 0;
         }
+        hs.pos = pos;
+        hs.posKnown = true;
         return pos;
     }
 
+    // Diagnostics / tests.
+    std::size_t read_window() const noexcept { return _readWindow; }
+    std::size_t resync_count() const noexcept { return _resyncCount; }
+
+    bool session_lost() const override { return _lost; }
+
+    void set_nonblocking(bool enabled) override
+    {
+        _nonBlocking = enabled;
+        if (!enabled) {
+            abandon_parked();
+        }
+    }
+
+    bool would_block() const override { return _wouldBlock; }
+
+    // Drive a parked request: collect its reply, retransmit it when the RTO
+    // expires, or give the session up once kGiveUpAfter has passed.
+    void poll() override
+    {
+        service_parked(std::chrono::steady_clock::now());
+    }
+
+    const RttEstimator& rtt() const noexcept { return _rtt; }
+
 private:
     static std::uint16_t read_u16le(std::uint8_t lo, std::uint8_t hi)
     {
@@ -338,6 +596,42 @@ private:
         return true;
     }
 
+    // READDIRX entries start after status/count/dirstatus/dirpos:
+    // flags(1) size(4) mtime(4) ctime(4) name\0
+    static bool parse_dirx_entries(const TnfsPacket& pkt, std::size_t count, std::vector<TnfsDirEntry>& out)
+    {
+        constexpr std::size_t kFixed = 13;
+        const std::size_t end = sizeof(pkt.payload);
+        std::size_t off = 5;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            if (off + kFixed >= end) {
+                return false;
+            }
+            const std::uint8_t* p = pkt.payload + off;
+            const void* nul = std::memchr(p + kFixed, 0, end - off - kFixed);
+            if (nul == nullptr) {
+                return false;
+            }
+            const char* name = reinterpret_cast<const char*>(p + kFixed);
+            const std::size_t nameLen = static_cast<const char*>(nul) - name;
+
+            TnfsDirEntry e{};
+            e.name.assign(name, nameLen);
+            e.isDir = (p[0] & DIRENTRY_DIR) != 0;
+            e.hidden = (p[0] & DIRENTRY_HIDDEN) != 0;
+            e.filesize = read_u32le(p + 1);
+            e.mTime = read_u32le(p + 5);
+            e.cTime = read_u32le(p + 9);
+            off += kFixed + nameLen + 1;
+
+            if (e.name != "." && e.name != "..") {
+                out.push_back(std::move(e));
+            }
+        }
+        return true;
+    }
+
     void fill_session_header(TnfsPacket& pkt, std::uint8_t command)
     {
         pkt.sessionIdL = static_cast<std::uint8_t>(_sessionId & 0xFFU);
@@ -396,53 +690,370 @@ private:
         return true;
     }
 
-    bool send_and_receive(TnfsPacket& pkt, std::size_t payloadSize)
+    // ---- Pipelined reads ----
+
+    // Total time a request is retransmitted before the session is
+    // considered lost (the old three attempts of 1.5 s).
+    static constexpr std::chrono::milliseconds kGiveUpAfter{4500};
+    // Sleep between reads on channels that can't wait for readability.
+    static constexpr std::chrono::milliseconds kPollDelay{10};
+    static constexpr int kMaxResyncs = 3;
+    static constexpr std::size_t kMinResponseSize = 5;
+
+    struct HandleState {
+        std::uint32_t pos{0};        // next byte the caller will get
+        bool posKnown{true};
+        std::vector<std::uint8_t> buf; // read-ahead, starting at `pos`
+        std::size_t bufOff{0};
+        std::deque<std::uint8_t> inflight; // READ sequence numbers, send order
+        bool eof{false};             // a READ came back END_OF_FILE
+        unsigned streak{0};          // reads since the last open/seek/write
+
+        // Server file pointer is ahead of `pos`. (EOF replies don't move it.)
+        bool ahead() const noexcept { return !inflight.empty() || bufOff < buf.size(); }
+    };
+
+    enum class ReadOutcome { Data, Eof, Failed, Lost };
+
+    void send_read(int fileHandle, HandleState& hs)
     {
-        static constexpr std::chrono::milliseconds kTimeoutPerAttempt(1500);
-        static constexpr std::chrono::milliseconds kPollDelay(10);
-        static constexpr int kMaxAttempts = 3;
-        static constexpr std::size_t kMinResponseSize = 5;
+        TnfsPacket pkt{};
+        fill_session_header(pkt, CMD_READ);
+        pkt.payload[0] = static_cast<std::uint8_t>(fileHandle);
+        pkt.payload[1] = static_cast<std::uint8_t>(kMaxReadChunk & 0xFFU);
+        pkt.payload[2] = static_cast<std::uint8_t>((kMaxReadChunk >> 8) & 0xFFU);
+        _channel->write(reinterpret_cast<const std::uint8_t*>(&pkt), 4 + 3);
 
-        const std::uint8_t expectedSeq = pkt.sequenceNum;
-        std::vector<std::uint8_t> tx(4 + payloadSize);
-        std::memcpy(tx.data(), &pkt, tx.size());
+        hs.inflight.push_back(pkt.sequenceNum);
+        _awaiting.push_back(pkt.sequenceNum);
+    }
 
-        for (int attempt = 0; attempt < kMaxAttempts; ++attempt) {
-            _channel->write(tx.data(), tx.size());
-            const auto deadline = std::chrono::steady_clock::now() + kTimeoutPerAttempt;
+    ReadOutcome collect_read(HandleState& hs)
+    {
+        // Replies queue behind each other at the server, so the oldest may
+        // take one RTO per request in the window.
+        const std::uint8_t seq = hs.inflight.front();
+        const auto wait = std::min<std::chrono::milliseconds>(
+            _rtt.rto() * static_cast<int>(hs.inflight.size()), kGiveUpAfter);
+        TnfsPacket reply{};
+        const bool got = await_reply(seq, reply, std::chrono::steady_clock::now() + wait);
+        hs.inflight.pop_front();
+        if (!got) {
+            stop_awaiting(seq); // already waited a full timeout; don't drain it again
+            return ReadOutcome::Lost;
+        }
 
-            while (std::chrono::steady_clock::now() < deadline) {
-                TnfsPacket response{};
-                const std::size_t bytesRead = _channel->read(reinterpret_cast<std::uint8_t*>(&response), sizeof(response));
-                if (bytesRead < kMinResponseSize) {
-                    std::this_thread::sleep_for(kPollDelay);
-                    continue;
+        // A later READ answered before this one: the server may have
+        // processed them out of order, so neither payload can be placed.
+        for (std::uint8_t later : hs.inflight) {
+            if (_stash.count(later) != 0) {
+                return ReadOutcome::Lost;
+            }
+        }
+
+        if (reply.payload[0] == RESULT_END_OF_FILE) {
+            return ReadOutcome::Eof;
+        }
+        if (reply.payload[0] != RESULT_SUCCESS) {
+            return ReadOutcome::Failed;
+        }
+
+        std::size_t n = static_cast<std::size_t>(read_u16le(reply.payload[1], reply.payload[2]));
+        n = std::min(n, kMaxReadChunk);
+        if (hs.bufOff == hs.buf.size()) {
+            hs.buf.clear();
+            hs.bufOff = 0;
+        }
+        hs.buf.insert(hs.buf.end(), reply.payload + 3, reply.payload + 3 + n);
+        return ReadOutcome::Data;
+    }
+
+    // Throw away read-ahead (let in-flight replies arrive first, so the
+    // server is done moving its pointer) and LSEEK back to `pos`.
+    bool resync(int fileHandle, HandleState& hs)
+    {
+        ++_resyncCount;
+        const std::uint32_t pos = hs.pos;
+        const bool known = hs.posKnown;
+        drop_read_ahead(hs);
+        hs.streak = 0;
+        if (!known) {
+            return false;
+        }
+
+        std::uint32_t newPos = 0;
+        if (!lseek_internal(fileHandle, pos, 0, newPos)) { // SEEK_SET
+            hs.posKnown = false;
+            return false;
+        }
+        return true;
+    }
+
+    void drop_read_ahead(HandleState& hs)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + _rtt.rto();
+        for (std::uint8_t seq : hs.inflight) {
+            TnfsPacket ignored{};
+            if (std::chrono::steady_clock::now() < deadline) {
+                (void)await_reply(seq, ignored, deadline);
+            }
+            stop_awaiting(seq);
+        }
+        hs.inflight.clear();
+        hs.buf.clear();
+        hs.bufOff = 0;
+        hs.eof = false;
+    }
+
+    void forget_handle(int fileHandle)
+    {
+        auto it = _handles.find(fileHandle);
+        if (it == _handles.end()) {
+            return;
+        }
+        for (std::uint8_t seq : it->second.inflight) {
+            stop_awaiting(seq);
+        }
+        _handles.erase(it);
+    }
+
+    void stop_awaiting(std::uint8_t seq)
+    {
+        _awaiting.erase(std::remove(_awaiting.begin(), _awaiting.end(), seq), _awaiting.end());
+        _stash.erase(seq);
+    }
+
+    // Wait for the reply to `seq`. Replies to other outstanding pipelined
+    // requests that show up meanwhile are stashed for their owner; anything
+    // else (stale retransmits, other sessions) is dropped.
+    bool await_reply(std::uint8_t seq, TnfsPacket& out, std::chrono::steady_clock::time_point deadline)
+    {
+        auto stashed = _stash.find(seq);
+        if (stashed != _stash.end()) {
+            out = stashed->second;
+            _stash.erase(stashed);
+            stop_awaiting(seq);
+            return true;
+        }
+
+        // Read before checking the deadline, so a deadline of "now" still
+        // drains whatever has already arrived.
+        for (;;) {
+            TnfsPacket response{};
+            const std::size_t bytesRead = _channel->read(reinterpret_cast<std::uint8_t*>(&response), sizeof(response));
+            if (bytesRead < kMinResponseSize) {
+                if (std::chrono::steady_clock::now() >= deadline) {
+                    return false;
                 }
+                wait_readable(deadline);
+                continue;
+            }
 
-                if (response.sequenceNum != expectedSeq) {
+            if (_sessionId != 0) {
+                const std::uint16_t respSession = read_u16le(response.sessionIdL, response.sessionIdH);
+                if (respSession != _sessionId) {
                     continue;
                 }
-                if (_sessionId != 0) {
-                    const std::uint16_t respSession = read_u16le(response.sessionIdL, response.sessionIdH);
-                    if (respSession != _sessionId) {
-                        continue;
-                    }
+            }
+
+            if (response.sequenceNum == seq) {
+                out = response;
+                stop_awaiting(seq);
+                return true;
+            }
+            if (std::find(_awaiting.begin(), _awaiting.end(), response.sequenceNum) != _awaiting.end()) {
+                _stash[response.sequenceNum] = response;
+            }
+        }
+    }
+
+    void wait_readable(std::chrono::steady_clock::time_point deadline)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return;
+        }
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+        if (_channel->supports_readable_wait()) {
+            (void)_channel->wait_for_readable(left);
+        } else {
+            std::this_thread::sleep_for(std::min(left, kPollDelay));
+        }
+    }
+
+    static bool parkable(std::uint8_t command)
+    {
+        switch (command) {
+        case CMD_MOUNT:
+        case CMD_STAT:
+        case CMD_MKDIR:
+        case CMD_RMDIR:
+        case CMD_UNLINK:
+        case CMD_RENAME:
+        case CMD_OPEN:
+        case CMD_OPENDIR:
+        case CMD_OPENDIRX:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Same request apart from the sequence number (byte 2).
+    static bool same_request(const std::vector<std::uint8_t>& a, const std::vector<std::uint8_t>& b)
+    {
+        return a.size() == b.size() &&
+               std::equal(a.begin(), a.begin() + 2, b.begin()) &&
+               std::equal(a.begin() + 3, a.end(), b.begin() + 3);
+    }
+
+    bool send_and_receive(TnfsPacket& pkt, std::size_t payloadSize)
+    {
+        _wouldBlock = false;
+        std::vector<std::uint8_t> tx(4 + payloadSize);
+        std::memcpy(tx.data(), &pkt, tx.size());
+
+        const bool mayPark = _nonBlocking && parkable(pkt.command);
+        if (mayPark && _parked) {
+            if (same_request(_parked->tx, tx)) {
+                service_parked(std::chrono::steady_clock::now());
+                if (_parked) {
+                    return claim_parked(pkt);
+                }
+                if (_lost) {
+                    return false;
                 }
+                // Its reply expired unclaimed; ask again.
+            } else if (!_parked->answered) {
+                _wouldBlock = true;
+                return false;
+            }
+        }
+
+        const std::uint8_t expectedSeq = pkt.sequenceNum;
+        const auto giveUp = std::chrono::steady_clock::now() + kGiveUpAfter;
+        for (unsigned sends = 1;; ++sends) {
+            _channel->write(tx.data(), tx.size());
+            const auto sentAt = std::chrono::steady_clock::now();
 
+            TnfsPacket response{};
+            if (await_reply(expectedSeq, response, std::min(sentAt + _rtt.rto(), giveUp))) {
+                if (sends == 1) {
+                    _rtt.sample(std::chrono::steady_clock::now() - sentAt); // Karn: first transmission only
+                }
                 pkt = response;
+                _lost = false;
                 return true;
             }
+            _rtt.backoff();
+
+            if (mayPark) {
+                park(std::move(tx), sentAt, giveUp);
+                _wouldBlock = true;
+                return false;
+            }
+            if (std::chrono::steady_clock::now() >= giveUp) {
+                break;
+            }
         }
 
+        _lost = true;
         FN_LOGE(TAG, "%s TNFS timeout for command 0x%02X", _transportName, static_cast<unsigned>(pkt.command));
         return false;
     }
 
+    // ---- Non-blocking mode ----
+
+    struct ParkedRequest {
+        std::vector<std::uint8_t> tx; // as sent; tx[2] is its sequence number
+        std::chrono::steady_clock::time_point lastSent;
+        std::chrono::steady_clock::time_point giveUp;
+        bool answered{false};
+        TnfsPacket reply{};
+    };
+
+    void park(std::vector<std::uint8_t> tx, std::chrono::steady_clock::time_point sentAt,
+              std::chrono::steady_clock::time_point giveUp)
+    {
+        abandon_parked();
+        _awaiting.push_back(tx[2]); // stash its reply if another exchange sees it
+        _parked = ParkedRequest{std::move(tx), sentAt, giveUp};
+    }
+
+    void abandon_parked()
+    {
+        if (_parked) {
+            stop_awaiting(_parked->tx[2]);
+            _parked.reset();
+        }
+    }
+
+    bool claim_parked(TnfsPacket& pkt)
+    {
+        if (!_parked->answered) {
+            _wouldBlock = true;
+            return false;
+        }
+        pkt = _parked->reply;
+        _parked.reset();
+        return true;
+    }
+
+    void service_parked(std::chrono::steady_clock::time_point now)
+    {
+        if (!_parked) {
+            return;
+        }
+        ParkedRequest& p = *_parked;
+        if (p.answered) {
+            // Nobody came back for it.
+            if (now >= p.giveUp) {
+                _parked.reset();
+            }
+            return;
+        }
+
+        // No RTT sample here: the reply may have sat in the socket until
+        // this poll, which says nothing about the network.
+        const std::uint8_t seq = p.tx[2];
+        if (await_reply(seq, p.reply, now)) {
+            p.answered = true;
+            p.giveUp = now + kGiveUpAfter;
+            _lost = false;
+            return;
+        }
+        if (now >= p.giveUp) {
+            FN_LOGE(TAG, "%s TNFS timeout for parked command 0x%02X",
+                    _transportName, static_cast<unsigned>(p.tx[3]));
+            abandon_parked();
+            _lost = true;
+            return;
+        }
+        if (now - p.lastSent >= _rtt.rto()) {
+            _channel->write(p.tx.data(), p.tx.size());
+            p.lastSent = now;
+            _rtt.backoff();
+        }
+    }
+
 private:
     std::unique_ptr<fujinet::io::Channel> _channel;
     const char* _transportName;
     std::uint16_t _sessionId{0};
     std::uint8_t _sequenceNum{0};
+
+    std::size_t _readWindow;
+    std::map<int, HandleState> _handles;
+    std::vector<std::uint8_t> _awaiting;        // pipelined READs not yet answered
+    std::map<std::uint8_t, TnfsPacket> _stash;  // their replies, if they came early
+    std::size_t _resyncCount{0};
+    bool _dirxSupported{true};
+    bool _lost{false}; // last request went unanswered through every retry
+
+    RttEstimator _rtt;
+    bool _nonBlocking{false};
+    bool _wouldBlock{false}; // last request was parked or refused, not failed
+    std::optional<ParkedRequest> _parked;
 };
 
 } // namespace fujinet::tnfs
@@ -50,6 +50,24 @@ static constexpr uint16_t OPENMODE_WRITE_CREATE = 0x0100;
 static constexpr uint16_t OPENMODE_WRITE_TRUNCATE = 0x0200;
 static constexpr uint16_t OPENMODE_CREATE_EXCLUSIVE = 0x0400;
 
+// OPENDIRX options (protocol 1.2)
+static constexpr uint8_t DIROPT_NO_FOLDERSFIRST = 0x01;
+static constexpr uint8_t DIROPT_NO_SKIPHIDDEN = 0x02;
+static constexpr uint8_t DIROPT_NO_SKIPSPECIAL = 0x04;
+static constexpr uint8_t DIROPT_DIR_PATTERN = 0x08;
+
+static constexpr uint8_t SORTOPT_NONE = 0x01;
+static constexpr uint8_t SORTOPT_CASE = 0x02;
+static constexpr uint8_t SORTOPT_DESCENDING = 0x04;
+static constexpr uint8_t SORTOPT_MODIFIED = 0x08;
+static constexpr uint8_t SORTOPT_SIZE = 0x10;
+
+// READDIRX entry flags / directory status
+static constexpr uint8_t DIRENTRY_DIR = 0x01;
+static constexpr uint8_t DIRENTRY_HIDDEN = 0x02;
+static constexpr uint8_t DIRENTRY_SPECIAL = 0x04;
+static constexpr uint8_t DIRSTATUS_EOF = 0x01;
+
 static constexpr uint8_t RESULT_SUCCESS = 0x00;
 static constexpr uint8_t RESULT_NOT_PERMITTED = 0x01;
 static constexpr uint8_t RESULT_FILE_NOT_FOUND = 0x02;
@@ -103,6 +121,25 @@ struct TnfsStat {
     uint16_t mode;
 };
 
+// One listing entry with the metadata OPENDIRX/READDIRX return inline.
+struct TnfsDirEntry {
+    std::string name;
+    bool isDir{false};
+    bool hidden{false};
+    uint32_t filesize{0};
+    uint32_t mTime{0};
+    uint32_t cTime{0};
+};
+
+// Server-side listing options (OPENDIRX). Defaults match tnfsd: folders
+// first, case-insensitive name order, hidden/special entries skipped.
+struct TnfsDirOptions {
+    uint8_t dirOptions{0};   // DIROPT_*
+    uint8_t sortOptions{0};  // SORTOPT_*
+    std::string pattern;     // wildcard ('*', '?'); empty = all
+    uint16_t maxResults{0};  // 0 = no limit
+};
+
 class ITnfsClient {
 public:
     virtual ~ITnfsClient() = default;
@@ -121,6 +158,15 @@ public:
 
     virtual std::vector<std::string> listDirectory(const std::string& path) = 0;
 
+    // Directory listing with per-entry metadata, filtered and sorted per
+    // `opts`. Returns false if `path` isn't a listable directory.
+    //
+    // The default builds it from listDirectory() + stat() per entry and
+    // applies the options locally; clients that speak OPENDIRX override it.
+    virtual bool listDirectoryEntries(const std::string& path,
+                                      const TnfsDirOptions& opts,
+                                      std::vector<TnfsDirEntry>& out);
+
     virtual int open(const std::string& path, uint16_t openMode, uint16_t createPerms) = 0;
     virtual bool close(int fileHandle) = 0;
 
@@ -128,6 +174,19 @@ public:
     virtual std::size_t write(int fileHandle, const void* buffer, std::size_t bytes) = 0;
     virtual bool seek(int fileHandle, uint32_t offset) = 0;
     virtual uint32_t tell(int fileHandle) = 0;
+
+    // The last request failed because the session is gone (the server
+    // stopped answering, e.g. it restarted) rather than with an ordinary
+    // error result. Session pools remount when this is set.
+    virtual bool session_lost() const { return false; }
+
+    // Non-blocking mode: requests that start an operation fail with
+    // would_block() instead of waiting out retransmits, and the identical
+    // call is repeated later to pick up the answer. poll() keeps such a
+    // request moving in between. Clients without it always block.
+    virtual void set_nonblocking(bool enabled) { (void)enabled; }
+    virtual bool would_block() const { return false; }
+    virtual void poll() {}
 };
 
 std::unique_ptr<ITnfsClient> make_udp_tnfs_client(std::unique_ptr<fujinet::io::Channel> channel);
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+namespace fujinet::tnfs {
+
+// Retransmission timer after RFC 6298 (TCP's SRTT/RTTVAR):
+//
+//   first sample R:  SRTT = R, RTTVAR = R/2
+//   later samples:   RTTVAR = 3/4 RTTVAR + 1/4 |SRTT - R|
+//                    SRTT   = 7/8 SRTT   + 1/8 R
+//   RTO = SRTT + 4 * RTTVAR, clamped to [kMinRto, kMaxRto]
+//
+// Every timeout doubles the RTO until the next sample. Callers follow
+// Karn's rule and only sample replies to requests that were sent once.
+//
+// kMinRto is far below TCP's 1 s: TNFS servers answer a retransmitted
+// sequence number from their reply cache, so an early retransmit costs one
+// packet, while waiting a second on a LAN costs the whole core loop.
+class RttEstimator {
+public:
+    static constexpr std::chrono::milliseconds kInitialRto{1000};
+    static constexpr std::chrono::milliseconds kMinRto{100};
+    static constexpr std::chrono::milliseconds kMaxRto{4000};
+
+    std::chrono::milliseconds rto() const noexcept { return _rto; }
+
+    bool has_sample() const noexcept { return _hasSample; }
+
+    std::chrono::microseconds srtt() const noexcept { return std::chrono::microseconds(_srttUs); }
+    std::chrono::microseconds rttvar() const noexcept { return std::chrono::microseconds(_rttvarUs); }
+
+    void sample(std::chrono::steady_clock::duration rtt) noexcept
+    {
+        const std::int64_t r = std::max<std::int64_t>(
+            0, std::chrono::duration_cast<std::chrono::microseconds>(rtt).count());
+        if (!_hasSample) {
+            _srttUs = r;
+            _rttvarUs = r / 2;
+            _hasSample = true;
+        } else {
+            const std::int64_t err = _srttUs > r ? _srttUs - r : r - _srttUs;
+            _rttvarUs = (3 * _rttvarUs + err) / 4;
+            _srttUs = (7 * _srttUs + r) / 8;
+        }
+
+        const std::int64_t rtoUs = _srttUs + 4 * _rttvarUs;
+        _rto = clamp(std::chrono::milliseconds((rtoUs + 999) / 1000));
+    }
+
+    // A request went unanswered for a full RTO.
+    void backoff() noexcept
+    {
+        _rto = clamp(_rto * 2);
+    }
+
+private:
+    static std::chrono::milliseconds clamp(std::chrono::milliseconds v) noexcept
+    {
+        return std::clamp(v, kMinRto, kMaxRto);
+    }
+
+    bool _hasSample{false};
+    std::int64_t _srttUs{0};
+    std::int64_t _rttvarUs{0};
+    std::chrono::milliseconds _rto{kInitialRto};
+};
+
+} // namespace fujinet::tnfs
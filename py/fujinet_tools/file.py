@@ -85,6 +85,8 @@ def cmd_list(args) -> int:
         list_flags |= fp.LIST_FLAG_COMPACT
     elif args.long:
         list_flags |= fp.LIST_FLAG_FORMATTED
+    if args.filter_dirs:
+        list_flags |= fp.LIST_FLAG_FILTER_DIRS
 
     with open_serial(args.port, args.baud, timeout_s=0.01) as ser:
         bus = FujiBusSession().attach(ser, debug=args.debug)
@@ -95,6 +97,8 @@ def cmd_list(args) -> int:
                 start,
                 args.max_payload,
                 list_flags=list_flags,
+                pattern=args.filter,
+                search=args.search,
             )
             pkt = bus.send_command_expect(
                 device=fp.FILE_DEVICE_ID,
@@ -627,6 +631,13 @@ def register_subcommands(subparsers) -> None:
         action="store_true",
         help="Request ls-style formatted lines (variable width, like ls -l)",
     )
+    pl.add_argument("--filter", help='Glob filter applied on the device, e.g. "*.atr|*.xex"')
+    pl.add_argument("--search", help="Case-insensitive substring filter applied on the device")
+    pl.add_argument(
+        "--filter-dirs",
+        action="store_true",
+        help="Apply --filter/--search to directories too (default: always list them)",
+    )
     pl.add_argument("--verbose", action="store_true")
     pl.add_argument("uri", help="URI (e.g., tnfs://host:port/, /path, sd0:/path)")
     pl.set_defaults(fn=cmd_list)
@@ -37,6 +37,9 @@ CMD_APPSTORE_LIST = 0x24
 LIST_FLAG_COMPACT = 0x01
 LIST_FLAG_SORT_BY_NAME = 0x02
 LIST_FLAG_FORMATTED = 0x04
+LIST_FLAG_NAME_FILTER = 0x08
+LIST_FLAG_NAME_SEARCH = 0x10
+LIST_FLAG_FILTER_DIRS = 0x20
 LIST_RESP_FLAG_FORMATTED = 0x04
 
 
@@ -109,6 +112,8 @@ def build_list_req(
     max_payload_bytes: int,
     *,
     list_flags: int = 0,
+    pattern: str | None = None,
+    search: str | None = None,
 ) -> bytes:
     """
     Build a list directory request.
@@ -118,14 +123,25 @@ def build_list_req(
         start: Starting index (entry offset in the directory listing)
         max_payload_bytes: Maximum bytes for the variable entries blob in the response
         list_flags: Optional ListDirectory flags (compact, sort-by-name, formatted)
+        pattern: Optional glob filter ("*.atr|*.xex"); sets LIST_FLAG_NAME_FILTER
+        search: Optional case-insensitive substring; sets LIST_FLAG_NAME_SEARCH
     """
     if not (0 <= start <= 0xFFFF):
         raise ValueError("start must fit u16")
     if not (1 <= max_payload_bytes <= 0xFFFF):
         raise ValueError("max_payload_bytes must fit u16 and be >0")
     req = build_uri_request(uri) + u16le(start) + u16le(max_payload_bytes)
+    tail = b""
+    for flag, text in ((LIST_FLAG_NAME_FILTER, pattern), (LIST_FLAG_NAME_SEARCH, search)):
+        if text is None:
+            continue
+        b = text.encode("utf-8")
+        if len(b) > 0xFF:
+            raise ValueError("filter/search must be <= 255 bytes")
+        list_flags |= flag
+        tail += bytes([len(b)]) + b
     if list_flags:
-        req += bytes([list_flags & 0xFF])
+        req += bytes([list_flags & 0xFF]) + tail
     return req
 
 
@@ -19,6 +19,7 @@ NUM_FIELDS_TABLE = [0, 1, 2, 3, 4, 1, 2, 1]
 FUJI_DESCR_EXCEEDS_U8 = 0x04
 FUJI_DESCR_EXCEEDS_U16 = 0x02
 FUJI_DESCR_ADDTL_MASK = 0x80
+FUJI_DESCR_TAGGED = 0x40  # header descriptor only: 1-byte request tag follows descriptors
 MAX_BYTES_PER_DESCR = 4
 
 
@@ -33,6 +34,7 @@ class FujiPacket:
     descr: int
     params: List[int]
     payload: bytes
+    tag: Optional[int] = None
 
 
 @dataclass
@@ -153,6 +155,13 @@ def parse_fuji_packet_ex(decoded: bytes) -> ParseResult:
         descr_bytes.append(decoded[offset])
         offset += 1
 
+    tag: Optional[int] = None
+    if descr & FUJI_DESCR_TAGGED:
+        if offset >= len(decoded):
+            return ParseResult(status="fail", reason="tag_truncated", packet=None)
+        tag = decoded[offset]
+        offset += 1
+
     params: List[int] = []
     for dbyte in descr_bytes:
         field_desc = dbyte & 0x07
@@ -181,6 +190,7 @@ def parse_fuji_packet_ex(decoded: bytes) -> ParseResult:
             descr=descr,
             params=params,
             payload=payload,
+            tag=tag,
         ),
     )
 
@@ -195,14 +205,17 @@ def build_fuji_packet_decoded(
     command: int,
     payload: bytes = b"",
     params: list[tuple[int, int]] | None = None,
+    tag: Optional[int] = None,
 ) -> bytes:
     """
     Build a decoded FujiBus packet (matches FujiBusPacket::serialize() pre-SLIP).
 
     params: list of (value, byte_width) with byte_width in {1, 2, 4}.
+    tag: optional pipelined request tag (sets FUJI_DESCR_TAGGED).
     """
     params = list(params or [])
     output = bytearray(HEADER_SIZE)
+    extra_descr = 0
 
     if params:
         descr_bytes: list[int] = []
@@ -234,6 +247,11 @@ def build_fuji_packet_decoded(
         if len(descr_bytes) > 1:
             for i, dbyte in enumerate(descr_bytes[1:]):
                 output.insert(HEADER_SIZE + i, dbyte)
+        extra_descr = len(descr_bytes) - 1
+
+    if tag is not None:
+        output[5] |= FUJI_DESCR_TAGGED
+        output.insert(HEADER_SIZE + extra_descr, tag & 0xFF)
 
     if payload:
         output.extend(payload)
@@ -253,9 +271,10 @@ def build_fuji_packet(
     command: int,
     payload: bytes = b"",
     params: list[tuple[int, int]] | None = None,
+    tag: Optional[int] = None,
 ) -> bytes:
     """Build a SLIP-framed FujiBus packet ready for the serial wire."""
-    return slip_encode(build_fuji_packet_decoded(device, command, payload, params))
+    return slip_encode(build_fuji_packet_decoded(device, command, payload, params, tag))
 
 
 def build_fuji_response_wire(
@@ -333,6 +352,8 @@ def print_packet(label: str, raw: bytes, cmd_txt: str = "") -> Optional[FujiPack
         f"{'OK' if pkt.checksum_ok else 'MISMATCH'})"
     )
     print(f" descr    = 0x{pkt.descr:02X}")
+    if pkt.tag is not None:
+        print(f" tag      = 0x{pkt.tag:02X}")
 
     if pkt.params:
         print(" Params:")
@@ -77,6 +77,7 @@ NET_COMMANDS = {
     5: "Info",
     6: "InfoRead",
     7: "TranslateConfigure",
+    8: "TranslateQuery",
 }
 
 
@@ -364,6 +365,44 @@ def cmd_net_translate(args) -> int:
         return 0
 
 
+def cmd_net_query(args) -> int:
+    try:
+        req = np.build_translate_query_req(args.handle, args.selector, max_bytes=args.max_bytes)
+    except ValueError as e:
+        print(str(e))
+        return 2
+
+    with open_serial(args.port, args.baud, timeout_s=0.01) as ser:
+        bus = FujiBusSession().attach(ser, debug=args.debug)
+        pkt = _send_retry_not_ready(
+            bus=bus,
+            device=np.NETWORK_DEVICE_ID,
+            command=np.CMD_TRANSLATE_QUERY,
+            payload=req,
+            timeout=args.timeout,
+            retries=200,
+            sleep_s=0.05,
+        )
+        if pkt is None:
+            print("No response")
+            return 2
+        if not status_ok(pkt):
+            code = _pkt_status_code(pkt)
+            print(f"Device status={code} ({_status_str(code)})")
+            return 1
+
+        try:
+            qr = np.parse_translate_query_resp(pkt.payload)
+        except ValueError as e:
+            print(f"Parse error: {e}")
+            return 2
+
+        for selector, v in zip(args.selector, qr.values):
+            marks = ("" if v.found else " (not found)") + (" (truncated)" if v.truncated else "")
+            print(f"{selector}{marks}: {v.value.decode('utf-8', errors='replace')}")
+        return 0
+
+
 def cmd_net_info(args) -> int:
     # NOTE: response headers (if any) must have been requested in Open().
     req = np.build_info_req(args.handle)
@@ -1253,4 +1292,11 @@ def register_subcommands(subparsers) -> None:
     ptr.add_argument("--timeout", type=float, default=10.0)
     ptr.set_defaults(fn=cmd_net_translate)
 
+    pq = nsub.add_parser("query", help="Evaluate several selectors against a translated handle")
+    pq.add_argument("--handle", type=int, required=True, help="Handle from net open")
+    pq.add_argument("--max-bytes", type=int, default=512, help="Total bytes of values to return")
+    pq.add_argument("--timeout", type=float, default=10.0)
+    pq.add_argument("selector", nargs="+", help="Selectors, e.g. /name /items/0")
+    pq.set_defaults(fn=cmd_net_query)
+
     net_tcp.register_tcp_subcommands(nsub)
@@ -35,6 +35,7 @@ CMD_CLOSE = 0x04
 CMD_INFO = 0x05
 CMD_INFO_READ = 0x06
 CMD_TRANSLATE_CONFIGURE = 0x07
+CMD_TRANSLATE_QUERY = 0x08
 
 TRANSLATION_NONE = 0
 TRANSLATION_JSON = 1
@@ -303,6 +304,59 @@ def parse_translate_configure_resp(payload: bytes) -> TranslateConfigureResp:
     )
 
 
+def build_translate_query_req(handle: int, selectors: list[str], *, max_bytes: int = 512) -> bytes:
+    if not (0 <= handle <= 0xFFFF):
+        raise ValueError("handle must fit u16")
+    if not (0 <= max_bytes <= 0xFFFF):
+        raise ValueError("max_bytes must fit u16")
+    if not (1 <= len(selectors) <= 32):
+        raise ValueError("between 1 and 32 selectors")
+
+    out = bytes([NETPROTO_VERSION]) + u16le(handle) + u16le(max_bytes) + bytes([len(selectors)])
+    for selector in selectors:
+        selector_b = selector.encode("utf-8")
+        if len(selector_b) > 0xFFFF:
+            raise ValueError("selector too long")
+        out += u16le(len(selector_b)) + selector_b
+    return out
+
+
+@dataclass
+class TranslateQueryValue:
+    found: bool
+    truncated: bool
+    value: bytes
+
+
+@dataclass
+class TranslateQueryResp:
+    handle: int
+    values: list[TranslateQueryValue]
+
+
+def parse_translate_query_resp(payload: bytes) -> TranslateQueryResp:
+    off = _check_version(payload, 0)
+    _flags, off = read_u8(payload, off)
+    _reserved, off = read_u16le(payload, off)
+    handle, off = read_u16le(payload, off)
+    count, off = read_u8(payload, off)
+    values = []
+    for _ in range(count):
+        flags, off = read_u8(payload, off)
+        n, off = read_u16le(payload, off)
+        if off + n > len(payload):
+            raise ValueError("truncated translate-query value")
+        values.append(TranslateQueryValue(
+            found=bool(flags & 0x01),
+            truncated=bool(flags & 0x02),
+            value=payload[off:off + n],
+        ))
+        off += n
+    if off != len(payload):
+        raise ValueError("trailing bytes in translate-query response")
+    return TranslateQueryResp(handle=handle, values=values)
+
+
 @dataclass
 class InfoReadResp:
     eof: bool
@@ -59,3 +59,23 @@ class TestFujiBusPacketBuild(unittest.TestCase):
         decoded = build_fuji_packet_decoded(0xFC, 0x03, b"\x01\x02")
         self.assertEqual(len(decoded), 6 + 2)
         self.assertEqual(decoded[2] | (decoded[3] << 8), len(decoded))
+
+    def test_tagged_packet_roundtrip(self) -> None:
+        wire = build_fuji_packet(
+            0x70, 0x05, b"\x01\x02", params=[(0x11, 1), (0x2233, 2)], tag=0xC0
+        )
+        pkt = parse_fuji_packet(slip_decode(wire))
+        self.assertIsNotNone(pkt)
+        assert pkt is not None
+        self.assertTrue(pkt.checksum_ok)
+        self.assertEqual(pkt.tag, 0xC0)
+        self.assertEqual(pkt.params, [0x11, 0x2233])
+        self.assertEqual(pkt.payload, b"\x01\x02")
+
+    def test_tag_sits_between_descriptors_and_params(self) -> None:
+        decoded = build_fuji_packet_decoded(1, 2, b"", params=[(0xAA, 1)], tag=0x07)
+        self.assertEqual(decoded[5], 0x41)
+        self.assertEqual(decoded[6:], bytes([0x07, 0xAA]))
+        pkt = parse_fuji_packet(build_fuji_packet_decoded(1, 2, b"\x09"))
+        assert pkt is not None
+        self.assertIsNone(pkt.tag)
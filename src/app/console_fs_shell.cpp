@@ -668,6 +668,7 @@ bool FsShell::cmd_rm(IConsoleTransport& io, const std::vector<std::string_view>&
                 const std::string leaf = leaf_name(e.path);
                 if (!glob_match(pat, leaf)) continue;
                 matched = true;
+                _storage.invalidatePath(*fs, e.path);
                 if (!delete_tree(*fs, e.path, flags, false, io)) {
                     all_ok = false;
                 }
@@ -679,6 +680,7 @@ bool FsShell::cmd_rm(IConsoleTransport& io, const std::vector<std::string_view>&
             continue;
         }
 
+        _storage.invalidatePath(*fs, target.path);
         if (!delete_tree(*fs, target.path, flags, false, io)) {
             all_ok = false;
         }
@@ -717,6 +719,7 @@ bool FsShell::cmd_rmdir(IConsoleTransport& io, const std::vector<std::string_vie
     }
 
     // rmdir must not delete files.
+    _storage.invalidatePath(*fs, target.path);
     (void)delete_tree(*fs, target.path, flags, true, io);
     return true;
 }
@@ -762,6 +765,8 @@ bool FsShell::cmd_mv(IConsoleTransport& io, const std::vector<std::string_view>&
         dst += base;
     }
 
+    _storage.invalidatePath(*fs, from.path);
+    _storage.invalidatePath(*fs, dst);
     if (!fs->rename(from.path, dst)) {
         io.write_line("error: mv failed");
     }
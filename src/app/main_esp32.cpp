@@ -204,7 +204,9 @@ extern "C" void fujinet_core_task(void* arg)
     }
 
     if (auto sdFs = platform::esp32::create_sdcard_filesystem()) {
-        if (!core.storageManager().registerFileSystem(std::move(sdFs))) {
+        fujinet::fs::MetadataIndexConfig sdIndex;
+        sdIndex.persist = true;
+        if (!core.storageManager().registerFileSystem(std::move(sdFs), sdIndex)) {
             FN_LOGE(TAG, "StorageManager refused to register 'sd0' filesystem");
         } else {
             FN_LOGI(TAG, "SD filesystem registered as 'sd0'");
@@ -213,7 +215,7 @@ extern "C" void fujinet_core_task(void* arg)
 
     // Register TNFS filesystem provider. Endpoint/transport are resolved from URI at access time.
     if (auto tnfsFs = platform::esp32::create_tnfs_filesystem()) {
-        if (!core.storageManager().registerFileSystem(std::move(tnfsFs))) {
+        if (!core.storageManager().registerFileSystem(std::move(tnfsFs), fujinet::fs::network_metadata_index())) {
             FN_LOGE(TAG, "StorageManager refused to register 'tnfs' filesystem");
         } else {
             FN_LOGI(TAG, "TNFS filesystem registered as 'tnfs' (dynamic URI endpoints)");
@@ -256,7 +258,7 @@ extern "C" void fujinet_core_task(void* arg)
     const auto& config = services.fuji ? services.fuji->config() : fujinet::config::FujiConfig{};
 
     if (auto httpFs = platform::esp32::create_http_filesystem()) {
-        if (!core.storageManager().registerFileSystem(std::move(httpFs))) {
+        if (!core.storageManager().registerFileSystem(std::move(httpFs), fujinet::fs::network_metadata_index())) {
             FN_LOGE(TAG, "StorageManager refused to register 'http' filesystem");
         } else {
             FN_LOGI(TAG, "HTTP filesystem registered as 'http' (dynamic URL endpoints)");
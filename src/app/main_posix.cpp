@@ -4,7 +4,6 @@
 #include <iostream>
 #include <string_view>
 #include <memory>
-#include <thread>
 #include <atomic>
 #include <vector>
 #if __has_include(<sysexits.h>)
@@ -30,6 +29,7 @@
 #include "fujinet/platform/channel_factory.h"
 #include "fujinet/platform/fuji_device_factory.h"
 #include "fujinet/platform/posix/fs_factory.h"
+#include "fujinet/platform/posix/poll_reactor.h"
 
 // Quick forward declaration (we’ll make a proper header later).
 namespace fujinet {
@@ -122,7 +122,9 @@ int main()
             return 1;
         }
 
-        if (!core.storageManager().registerFileSystem(std::move(hostFs))) {
+        fujinet::fs::MetadataIndexConfig hostIndex;
+        hostIndex.persist = true;
+        if (!core.storageManager().registerFileSystem(std::move(hostFs), hostIndex)) {
             FN_LOGE(TAG, "StorageManager refused to register 'host' filesystem");
             return 1;
         }
@@ -131,7 +133,7 @@ int main()
 
         // Register TNFS filesystem provider. Host/port are resolved per URI at access time.
         auto tnfsFs = fujinet::platform::posix::create_tnfs_filesystem();
-        if (!core.storageManager().registerFileSystem(std::move(tnfsFs))) {
+        if (!core.storageManager().registerFileSystem(std::move(tnfsFs), fujinet::fs::network_metadata_index())) {
             FN_LOGE(TAG, "StorageManager refused to register 'tnfs' filesystem");
             return 1;
         }
@@ -190,7 +192,7 @@ int main()
 
     {
         auto httpFs = fujinet::platform::posix::create_http_filesystem();
-        if (!core.storageManager().registerFileSystem(std::move(httpFs))) {
+        if (!core.storageManager().registerFileSystem(std::move(httpFs), fujinet::fs::network_metadata_index())) {
             FN_LOGE(TAG, "StorageManager refused to register 'http' filesystem");
             return 1;
         }
@@ -264,11 +266,16 @@ int main()
     }
     core::setup_transports(core, *channel, profile, &config);
 
+    // Between ticks the loop sleeps in poll(2) on every fd that could bring
+    // work (host channel, network sockets, console input). The idle delay is
+    // only the heartbeat for sources that have no fd.
     const auto idleDelay = posix_idle_delay();
     FN_LOGI(TAG,
-            "POSIX idle delay: %lld ms (%s transport wait)",
-            static_cast<long long>(idleDelay.count()),
-            core.hasWaitableWorkSource() ? "using" : "no");
+            "POSIX idle delay: %lld ms (poll reactor)",
+            static_cast<long long>(idleDelay.count()));
+
+    platform::posix::PollReactor reactor;
+    io::WaitSet waits;
 
     // Run core loop until the process is terminated (Ctrl+C, kill, etc.).
     bool running = true;
@@ -287,11 +294,11 @@ int main()
             return 75;
 #endif
         }
-        if (core.hasWaitableWorkSource()) {
-            core.waitForWork(idleDelay);
-        } else {
-            std::this_thread::sleep_for(idleDelay);
-        }
+
+        waits.clear();
+        core.addWaitSources(waits);
+        consoleTransport->add_wait_sources(waits);
+        reactor.wait(waits, idleDelay);
     }
 
     // (Unreachable for now, but kept for future clean shutdown logic.)
@@ -216,6 +216,9 @@ bool AppStore::write(std::string_view ns, std::string_view key, std::uint32_t of
     if (!fs) return false;
     if (!ensure_namespace_dir(ns)) return false;
 
+    // The same file may be open in the FileDevice handle cache (persist: URI).
+    _storage.invalidatePath(*fs, key_path(ns, key));
+
     const char* mode = (offset == 0) ? "wb" : "r+b";
     auto file = fs->open(key_path(ns, key), mode);
     if (!file && offset > 0) {
@@ -239,6 +242,7 @@ bool AppStore::remove(std::string_view ns, std::string_view key, DeleteResult& o
     if (!fs->exists(path)) {
         return true;
     }
+    _storage.invalidatePath(*fs, path);
     out.deleted = fs->removeFile(path);
     return out.deleted;
 }
@@ -288,6 +292,8 @@ bool AppStore::rename(std::string_view ns, std::string_view oldKey, std::string_
     auto* fs = backing_fs();
     if (!fs) return false;
     if (!ensure_namespace_dir(ns)) return false;
+    _storage.invalidatePath(*fs, key_path(ns, oldKey));
+    _storage.invalidatePath(*fs, key_path(ns, newKey));
     return fs->rename(key_path(ns, oldKey), key_path(ns, newKey));
 }
 
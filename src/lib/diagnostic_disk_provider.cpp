@@ -55,6 +55,7 @@ static const char* disk_err_str(fujinet::disk::DiskError e) noexcept
         case DiskError::OutOfRange:         return "out_of_range";
         case DiskError::IoError:            return "io_error";
         case DiskError::InternalError:      return "internal_error";
+        case DiskError::WouldBlock:         return "would_block";
     }
     return "unknown";
 }
@@ -144,6 +145,14 @@ private:
             text += std::to_string(s.geometry.sectorCount);
             text += " last_err=";
             text += disk_err_str(s.lastError);
+            if (s.prefetch != fujinet::disk::PrefetchMode::Off) {
+                text += " prefetch=";
+                text += fujinet::disk::prefetch_mode_name(s.prefetch);
+                text += " landed=";
+                text += std::to_string(s.prefetchLandedBytes);
+                text += "/";
+                text += std::to_string(s.prefetchTotalBytes);
+            }
             if (!s.fsName.empty() || !s.path.empty()) {
                 text += " image=";
                 text += s.fsName;
@@ -164,7 +173,7 @@ private:
         }
 
         std::string text;
-        text.reserve(1024);
+        text.reserve(1536);
 
         for (std::size_t i = 0; i < dev->disk_service().slot_count(); ++i) {
             const auto st = dev->disk_service().stats(i);
@@ -228,6 +237,20 @@ private:
             text += " write=";
             text += std::to_string(st.image.writeBytes);
             text += "\r\n";
+
+            text += "slot=";
+            text += std::to_string(slot1);
+            text += " cache hit=";
+            text += std::to_string(st.cache.hits);
+            text += " miss=";
+            text += std::to_string(st.cache.misses);
+            text += " readahead=";
+            text += std::to_string(st.cache.readAheadSectors);
+            text += " writeback=";
+            text += std::to_string(st.cache.writeBackSectors);
+            text += " dirty=";
+            text += std::to_string(st.cacheDirtySectors);
+            text += "\r\n";
         }
 
         return DiagResult::ok(text);
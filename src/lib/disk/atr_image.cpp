@@ -128,19 +128,9 @@ public:
         if (lba >= _geo.sectorCount) return DiskResult{DiskError::OutOfRange};
         if (dstBytes < _geo.sectorSize) return DiskResult{DiskError::InvalidSlot};
 
-        const std::uint32_t sector1 = lba + 1;
-        const std::uint32_t secSize = sector_size_for(_baseSectorSize, sector1);
+        const std::uint32_t secSize = sector_size_for(_baseSectorSize, lba + 1);
         ++_stats.readOps;
-        if (!_cursorValid || lba != _nextSequentialLba) {
-            const std::uint64_t off = sector_to_offset(_baseSectorSize, sector1);
-            ++_stats.seekOps;
-            if (!_file->seek(off)) {
-                _cursorValid = false;
-                return DiskResult{DiskError::IoError};
-            }
-        } else {
-            ++_stats.sequentialReadHits;
-        }
+        if (!position(lba, _stats.sequentialReadHits)) return DiskResult{DiskError::IoError};
 
         // Zero-fill the destination up to max size, then read actual bytes.
         std::memset(dst, 0, _geo.sectorSize);
@@ -150,7 +140,6 @@ public:
             return DiskResult{DiskError::IoError};
         }
         _stats.readBytes += got;
-        _cursorValid = true;
         _nextSequentialLba = lba + 1;
 
         return DiskResult{DiskError::None, static_cast<std::uint16_t>(secSize)};
@@ -164,21 +153,11 @@ public:
         if (_geo.sectorCount == 0) return DiskResult{DiskError::BadImage};
         if (lba >= _geo.sectorCount) return DiskResult{DiskError::OutOfRange};
 
-        const std::uint32_t sector1 = lba + 1;
-        const std::uint32_t secSize = sector_size_for(_baseSectorSize, sector1);
+        const std::uint32_t secSize = sector_size_for(_baseSectorSize, lba + 1);
         if (srcBytes < secSize) return DiskResult{DiskError::InvalidRequest};
 
         ++_stats.writeOps;
-        if (!_cursorValid || lba != _nextSequentialLba) {
-            const std::uint64_t off = sector_to_offset(_baseSectorSize, sector1);
-            ++_stats.seekOps;
-            if (!_file->seek(off)) {
-                _cursorValid = false;
-                return DiskResult{DiskError::IoError};
-            }
-        } else {
-            ++_stats.sequentialWriteHits;
-        }
+        if (!position(lba, _stats.sequentialWriteHits)) return DiskResult{DiskError::IoError};
 
         const std::size_t wrote = _file->write(src, secSize);
         if (wrote != secSize) {
@@ -186,22 +165,95 @@ public:
             return DiskResult{DiskError::IoError};
         }
         _stats.writeBytes += wrote;
-        _cursorValid = true;
         _nextSequentialLba = lba + 1;
 
         return DiskResult{DiskError::None, static_cast<std::uint16_t>(secSize)};
     }
 
+    // Sectors (including the short boot sectors) are stored back to back, so
+    // a run of them is one contiguous span of the file in the packed layout.
+    DiskResult read_sectors(std::uint32_t lba, std::uint16_t count, std::uint8_t* dst, std::size_t dstBytes) override
+    {
+        if (!_file) return DiskResult{DiskError::NotMounted};
+        std::size_t total = 0;
+        DiskResult check = check_range(lba, count, dst, dstBytes, total);
+        if (!check.ok()) return check;
+
+        ++_stats.readOps;
+        if (!position(lba, _stats.sequentialReadHits)) return DiskResult{DiskError::IoError};
+        const std::size_t got = _file->read(dst, total);
+        if (got != total) {
+            _cursorValid = false;
+            return DiskResult{DiskError::IoError};
+        }
+        _stats.readBytes += got;
+        _nextSequentialLba = lba + count;
+        return DiskResult{DiskError::None, static_cast<std::uint16_t>(total)};
+    }
+
+    DiskResult write_sectors(std::uint32_t lba, std::uint16_t count, const std::uint8_t* src, std::size_t srcBytes) override
+    {
+        if (!_file) return DiskResult{DiskError::NotMounted};
+        if (_readOnly) return DiskResult{DiskError::ReadOnly};
+        std::size_t total = 0;
+        DiskResult check = check_range(lba, count, src, srcBytes, total);
+        if (!check.ok()) return check;
+
+        ++_stats.writeOps;
+        if (!position(lba, _stats.sequentialWriteHits)) return DiskResult{DiskError::IoError};
+        const std::size_t wrote = _file->write(src, total);
+        if (wrote != total) {
+            _cursorValid = false;
+            return DiskResult{DiskError::IoError};
+        }
+        _stats.writeBytes += wrote;
+        _nextSequentialLba = lba + count;
+        return DiskResult{DiskError::None, static_cast<std::uint16_t>(total)};
+    }
+
     DiskResult flush() override
     {
         if (!_file) return DiskResult{DiskError::NotMounted};
         return DiskResult{_file->flush() ? DiskError::None : DiskError::IoError};
     }
 
+    std::uint16_t sector_size(std::uint32_t lba) const noexcept override
+    {
+        return static_cast<std::uint16_t>(sector_size_for(_baseSectorSize, lba + 1));
+    }
+
     DiskImageStats image_stats() const noexcept override { return _stats; }
     void reset_image_stats() noexcept override { _stats = {}; }
 
 private:
+    DiskResult check_range(std::uint32_t lba, std::uint16_t count, const std::uint8_t* buf, std::size_t bufBytes,
+                           std::size_t& total) const
+    {
+        if (_geo.sectorCount == 0) return DiskResult{DiskError::BadImage};
+        if (count == 0 || !buf) return DiskResult{DiskError::InvalidRequest};
+        if (lba >= _geo.sectorCount || count > _geo.sectorCount - lba) return DiskResult{DiskError::OutOfRange};
+        total = static_cast<std::size_t>(sector_to_offset(_baseSectorSize, lba + count + 1) -
+                                         sector_to_offset(_baseSectorSize, lba + 1));
+        if (bufBytes < total || total > 0xFFFFu) return DiskResult{DiskError::InvalidRequest};
+        return DiskResult{DiskError::None};
+    }
+
+    // Seek to `lba` unless the file is already there. Callers invalidate
+    // the cursor again if the transfer that follows comes up short.
+    bool position(std::uint32_t lba, std::uint64_t& sequentialHits)
+    {
+        const bool sequential = _cursorValid && lba == _nextSequentialLba;
+        _cursorValid = false;
+        if (sequential) {
+            ++sequentialHits;
+        } else {
+            ++_stats.seekOps;
+            if (!_file->seek(sector_to_offset(_baseSectorSize, lba + 1))) return false;
+        }
+        _cursorValid = true;
+        return true;
+    }
+
     std::unique_ptr<fs::IFile> _file;
     DiskGeometry _geo{};
     bool _readOnly{true};
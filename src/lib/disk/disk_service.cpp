@@ -9,6 +9,9 @@ namespace fujinet::disk {
 static constexpr const char* TAG = "disk_svc";
 static constexpr const char* STATS_TAG = "diskstats";
 
+// Streamed per poll() while a slot prefetches, so other devices stay responsive.
+static constexpr std::size_t kPrefetchChunkBytes = 16 * 1024;
+
 static const char* disk_error_name(DiskError e) noexcept
 {
     switch (e) {
@@ -27,6 +30,7 @@ static const char* disk_error_name(DiskError e) noexcept
         case DiskError::OutOfRange: return "OutOfRange";
         case DiskError::IoError: return "IoError";
         case DiskError::InternalError: return "InternalError";
+        case DiskError::WouldBlock: return "WouldBlock";
     }
     return "Unknown";
 }
@@ -57,6 +61,102 @@ DiskError DiskService::set_error(std::size_t slotIndex, DiskError e)
     return e;
 }
 
+// The host's writes were acknowledged from the cache, so an image whose
+// write-back fails is kept mounted, dirty sectors and all: the error goes
+// back to the caller, and the host can flush or unmount again later.
+DiskResult DiskService::release_image(std::size_t slotIndex)
+{
+    auto* s = slot_ptr(slotIndex);
+    if (!s) return DiskResult{DiskError::InvalidSlot};
+
+    if (s->image) {
+        DiskResult r = s->cache.flush(*s->image);
+        if (!r.ok()) {
+            FN_LOGE(TAG, "Write-back on unmount failed: slot=%u err=%s dirty=%u; image kept mounted",
+                    static_cast<unsigned>(slotIndex),
+                    disk_error_name(r.error),
+                    static_cast<unsigned>(s->cache.dirty_count()));
+            return DiskResult{set_error(slotIndex, r.error)};
+        }
+        s->image->unmount();
+        s->image.reset();
+    }
+    s->prefetch = nullptr;
+    s->cache.clear();
+    return DiskResult{DiskError::None};
+}
+
+DiskResult DiskService::flush(std::size_t slotIndex)
+{
+    auto* s = slot_ptr(slotIndex);
+    if (!s) return DiskResult{DiskError::InvalidSlot};
+    if (!s->image) return DiskResult{DiskError::None};
+
+    DiskResult r = s->cache.flush(*s->image);
+    if (!r.ok()) {
+        FN_LOGE(TAG, "Write-back failed: slot=%u err=%s dirty=%u",
+                static_cast<unsigned>(slotIndex),
+                disk_error_name(r.error),
+                static_cast<unsigned>(s->cache.dirty_count()));
+        set_error(slotIndex, r.error);
+    }
+    return r;
+}
+
+void DiskService::poll()
+{
+    for (std::size_t i = 0; i < MAX_SLOTS; ++i) {
+        auto& s = _slots[i];
+        if (s.prefetch && !s.prefetch->complete()) {
+            if (!s.prefetch->pump(kPrefetchChunkBytes)) {
+                FN_LOGW(TAG, "Prefetch stopped: slot=%u landed=%llu/%llu; continuing on demand",
+                        static_cast<unsigned>(i),
+                        static_cast<unsigned long long>(s.prefetch->landed_bytes()),
+                        static_cast<unsigned long long>(s.prefetch->size()));
+            } else if (s.prefetch->complete()) {
+                FN_LOGI(TAG, "Prefetch complete: slot=%u bytes=%llu",
+                        static_cast<unsigned>(i),
+                        static_cast<unsigned long long>(s.prefetch->size()));
+            }
+        }
+
+        if (!s.image || s.cache.dirty_count() == 0) continue;
+
+        DiskResult r = s.cache.flush_if_idle(*s.image);
+        if (!r.ok()) {
+            FN_LOGE(TAG, "Idle write-back failed: slot=%u err=%s",
+                    static_cast<unsigned>(i), disk_error_name(r.error));
+            set_error(i, r.error);
+        }
+    }
+}
+
+bool DiskService::prefetch_pending() const
+{
+    for (const auto& s : _slots) {
+        if (s.prefetch && !s.prefetch->complete()) return true;
+    }
+    return false;
+}
+
+bool DiskService::next_write_back(std::chrono::milliseconds& in) const
+{
+    bool any = false;
+    for (const auto& s : _slots) {
+        SectorCache::Clock::duration d{};
+        if (!s.image || !s.cache.next_write_back(d)) continue;
+        const auto ms = std::chrono::ceil<std::chrono::milliseconds>(d);
+        if (!any || ms < in) in = ms;
+        any = true;
+    }
+    return any;
+}
+
+void DiskService::set_cache_config(const SectorCacheConfig& config)
+{
+    _cacheConfig = config;
+}
+
 DiskResult DiskService::mount(
     std::size_t slotIndex,
     const std::string& fsName,
@@ -67,20 +167,20 @@ DiskResult DiskService::mount(
     if (!s) return DiskResult{DiskError::InvalidSlot};
 
     FN_LOGI(TAG,
-            "Mount start: slot=%u fs='%s' path='%s' readonly_requested=%d type_override=%u sector_hint=%u",
+            "Mount start: slot=%u fs='%s' path='%s' readonly_requested=%d type_override=%u sector_hint=%u prefetch=%s",
             static_cast<unsigned>(slotIndex),
             fsName.c_str(),
             path.c_str(),
             opts.readOnlyRequested ? 1 : 0,
             static_cast<unsigned>(opts.typeOverride),
-            static_cast<unsigned>(opts.sectorSizeHint));
+            static_cast<unsigned>(opts.sectorSizeHint),
+            prefetch_mode_name(opts.prefetch));
 
     // Unmount any existing image first.
-    if (s->image) {
-        s->image->flush();
-        s->image->unmount();
-        s->image.reset();
+    if (DiskResult r = release_image(slotIndex); !r.ok()) {
+        return r;
     }
+    s->cache.set_config(_cacheConfig);
 
     s->inserted = false;
     s->readOnly = false;
@@ -103,35 +203,68 @@ DiskResult DiskService::mount(
         return DiskResult{set_error(slotIndex, DiskError::NoSuchFileSystem)};
     }
 
+    // A non-blocking filesystem (TNFS) may not have its answer yet: report
+    // WouldBlock so the host retries the same mount, which resumes it.
     if (!pfs->exists(path)) {
+        if (pfs->wouldBlock()) {
+            return DiskResult{set_error(slotIndex, DiskError::WouldBlock)};
+        }
         FN_LOGW(TAG, "Mount failed: path does not exist '%s'", path.c_str());
         return DiskResult{set_error(slotIndex, DiskError::FileNotFound)};
     }
 
     fs::FileInfo finfo{};
     if (!pfs->stat(path, finfo)) {
+        if (pfs->wouldBlock()) {
+            return DiskResult{set_error(slotIndex, DiskError::WouldBlock)};
+        }
         FN_LOGW(TAG, "Mount failed: stat failed for '%s'", path.c_str());
         return DiskResult{set_error(slotIndex, DiskError::OpenFailed)};
     }
 
+    PrefetchMode prefetch = opts.prefetch;
+    if (prefetch != PrefetchMode::Off &&
+        (finfo.sizeBytes == 0 || finfo.sizeBytes > _prefetchLimit)) {
+        FN_LOGI(TAG, "Prefetch skipped for '%s': size=%llu limit=%llu",
+                path.c_str(),
+                static_cast<unsigned long long>(finfo.sizeBytes),
+                static_cast<unsigned long long>(_prefetchLimit));
+        prefetch = PrefetchMode::Off;
+    }
+
     // Try open writeable if requested; if it fails, fall back to read-only.
+    // A snapshot never writes to the source, so read access is enough.
     bool readOnlyEffective = opts.readOnlyRequested;
     std::unique_ptr<fs::IFile> f;
-    if (opts.readOnlyRequested) {
+    if (opts.readOnlyRequested || prefetch == PrefetchMode::Snapshot) {
         f = pfs->open(path, "rb");
     } else {
         f = pfs->open(path, "r+b");
-        if (!f) {
+        if (!f && !pfs->wouldBlock()) {
             FN_LOGI(TAG, "Writable open failed for '%s'; retrying read-only", path.c_str());
             f = pfs->open(path, "rb");
             readOnlyEffective = true;
         }
     }
     if (!f) {
+        if (pfs->wouldBlock()) {
+            return DiskResult{set_error(slotIndex, DiskError::WouldBlock)};
+        }
         FN_LOGW(TAG, "Mount failed: file open failed for '%s'", path.c_str());
         return DiskResult{set_error(slotIndex, DiskError::OpenFailed)};
     }
 
+    PrefetchFile* prefetchFile = nullptr;
+    if (prefetch != PrefetchMode::Off) {
+        auto pf = std::make_unique<PrefetchFile>(std::move(f), finfo.sizeBytes, prefetch);
+        prefetchFile = pf.get();
+        f = std::move(pf);
+        FN_LOGI(TAG, "Prefetching '%s' (%llu bytes, mode=%s)",
+                path.c_str(),
+                static_cast<unsigned long long>(finfo.sizeBytes),
+                prefetch_mode_name(prefetch));
+    }
+
     MountOptions eff = opts;
     eff.readOnlyRequested = readOnlyEffective;
 
@@ -175,6 +308,7 @@ DiskResult DiskService::mount(
     s->type = img->type();
     s->geometry = img->geometry();
     s->image = std::move(img);
+    s->prefetch = prefetchFile;
 
     FN_LOGI(TAG,
             "Mount success: slot=%u type=%u readonly=%d sector_size=%u sector_count=%lu",
@@ -219,10 +353,8 @@ DiskResult DiskService::unmount(std::size_t slotIndex)
     auto* s = slot_ptr(slotIndex);
     if (!s) return DiskResult{DiskError::InvalidSlot};
 
-    if (s->image) {
-        s->image->flush();
-        s->image->unmount();
-        s->image.reset();
+    if (DiskResult r = release_image(slotIndex); !r.ok()) {
+        return r;
     }
 
     s->inserted = false;
@@ -247,7 +379,8 @@ static void log_slot_stats(std::size_t slotIndex, const DiskServiceSlotStats& st
     FN_LOGI(STATS_TAG,
             "slot=%u read_req=%llu read_sec=%llu read_bytes=%llu multi_read=%llu seq_read=%llu "
             "write_req=%llu write_sec=%llu write_bytes=%llu multi_write=%llu seq_write=%llu "
-            "fail=%llu img_read=%llu img_write=%llu img_seek=%llu img_seq_read=%llu img_seq_write=%llu",
+            "fail=%llu img_read=%llu img_write=%llu img_seek=%llu img_seq_read=%llu img_seq_write=%llu "
+            "cache_hit=%llu cache_miss=%llu cache_readahead=%llu cache_writeback=%llu cache_dirty=%u",
             static_cast<unsigned>(slotIndex + 1),
             static_cast<unsigned long long>(stats.readRequests),
             static_cast<unsigned long long>(stats.readSectors),
@@ -264,7 +397,12 @@ static void log_slot_stats(std::size_t slotIndex, const DiskServiceSlotStats& st
             static_cast<unsigned long long>(stats.image.writeOps),
             static_cast<unsigned long long>(stats.image.seekOps),
             static_cast<unsigned long long>(stats.image.sequentialReadHits),
-            static_cast<unsigned long long>(stats.image.sequentialWriteHits));
+            static_cast<unsigned long long>(stats.image.sequentialWriteHits),
+            static_cast<unsigned long long>(stats.cache.hits),
+            static_cast<unsigned long long>(stats.cache.misses),
+            static_cast<unsigned long long>(stats.cache.readAheadSectors),
+            static_cast<unsigned long long>(stats.cache.writeBackSectors),
+            static_cast<unsigned>(stats.cacheDirtySectors));
 }
 
 void DiskService::reset_stats(std::size_t slotIndex)
@@ -273,6 +411,7 @@ void DiskService::reset_stats(std::size_t slotIndex)
     if (!s) return;
     _stats[slotIndex] = {};
     if (s->image) s->image->reset_image_stats();
+    s->cache.reset_stats();
     s->statsReadCursorValid = false;
     s->statsWriteCursorValid = false;
     s->statsNextReadLba = 0;
@@ -290,6 +429,8 @@ DiskServiceSlotStats DiskService::stats(std::size_t slotIndex) const
     DiskServiceSlotStats out = _stats[slotIndex];
     if (const auto* s = slot_ptr(slotIndex); s && s->image) {
         out.image = s->image->image_stats();
+        out.cache = s->cache.stats();
+        out.cacheDirtySectors = s->cache.dirty_count();
     }
     return out;
 }
@@ -315,10 +456,11 @@ DiskResult DiskService::read_sector(std::size_t slotIndex, std::uint32_t lba, st
 
     ++stats.readRequests;
     ++stats.readSectors;
-    if (s->statsReadCursorValid && lba == s->statsNextReadLba)
+    const bool sequential = s->statsReadCursorValid && lba == s->statsNextReadLba;
+    if (sequential)
         ++stats.sequentialReadRequests;
 
-    DiskResult r = s->image->read_sector(lba, dst, dstBytes);
+    DiskResult r = s->cache.read(*s->image, lba, dst, dstBytes, sequential);
     if (r.ok()) {
         stats.readBytes += r.bytes;
         s->statsReadCursorValid = true;
@@ -356,7 +498,7 @@ DiskResult DiskService::write_sector(std::size_t slotIndex, std::uint32_t lba, c
     if (s->statsWriteCursorValid && lba == s->statsNextWriteLba)
         ++stats.sequentialWriteRequests;
 
-    DiskResult r = s->image->write_sector(lba, src, srcBytes);
+    DiskResult r = s->cache.write(*s->image, lba, src, srcBytes);
     if (r.ok()) {
         stats.writeBytes += r.bytes;
         s->dirty = true;
@@ -411,26 +553,25 @@ DiskResult DiskService::read_sectors(std::size_t slotIndex, std::uint32_t lba, s
     ++stats.readRequests;
     stats.readSectors += count;
     if (count > 1) ++stats.multiReadRequests;
-    if (s->statsReadCursorValid && lba == s->statsNextReadLba)
+    const bool sequential = s->statsReadCursorValid && lba == s->statsNextReadLba;
+    if (sequential)
         ++stats.sequentialReadRequests;
 
-    std::size_t bytes = 0;
-    for (std::uint16_t i = 0; i < count; ++i) {
-        DiskResult r = s->image->read_sector(lba + i, dst + bytes, sectorSize);
-        if (!r.ok()) {
-            ++stats.failedRequests;
-            s->statsReadCursorValid = false;
-            set_error(slotIndex, r.error);
-            log_slot_stats(slotIndex, this->stats(slotIndex));
-            return r;
-        }
-        bytes += r.bytes ? r.bytes : sectorSize;
+    // A multi-sector request is sequential within itself, so it also reads
+    // ahead. Uncached runs reach the image as single vectored reads.
+    DiskResult r = s->cache.read_sectors(*s->image, lba, count, dst, dstBytes, sequential || count > 1);
+    if (!r.ok()) {
+        ++stats.failedRequests;
+        s->statsReadCursorValid = false;
+        set_error(slotIndex, r.error);
+        log_slot_stats(slotIndex, this->stats(slotIndex));
+        return r;
     }
-    stats.readBytes += bytes;
+    stats.readBytes += r.bytes;
     s->statsReadCursorValid = true;
     s->statsNextReadLba = lba + count;
     log_slot_stats(slotIndex, this->stats(slotIndex));
-    return DiskResult{DiskError::None, static_cast<std::uint16_t>(bytes)};
+    return r;
 }
 
 DiskResult DiskService::write_sectors(std::size_t slotIndex, std::uint32_t lba, std::uint16_t count, const std::uint8_t* src, std::size_t srcBytes)
@@ -481,24 +622,20 @@ DiskResult DiskService::write_sectors(std::size_t slotIndex, std::uint32_t lba,
     if (s->statsWriteCursorValid && lba == s->statsNextWriteLba)
         ++stats.sequentialWriteRequests;
 
-    std::size_t bytes = 0;
-    for (std::uint16_t i = 0; i < count; ++i) {
-        DiskResult r = s->image->write_sector(lba + i, src + bytes, sectorSize);
-        if (!r.ok()) {
-            ++stats.failedRequests;
-            s->statsWriteCursorValid = false;
-            set_error(slotIndex, r.error);
-            log_slot_stats(slotIndex, this->stats(slotIndex));
-            return r;
-        }
-        bytes += r.bytes ? r.bytes : sectorSize;
+    DiskResult r = s->cache.write_sectors(*s->image, lba, count, src, srcBytes);
+    if (!r.ok()) {
+        ++stats.failedRequests;
+        s->statsWriteCursorValid = false;
+        set_error(slotIndex, r.error);
+        log_slot_stats(slotIndex, this->stats(slotIndex));
+        return r;
     }
-    stats.writeBytes += bytes;
+    stats.writeBytes += r.bytes;
     s->statsWriteCursorValid = true;
     s->statsNextWriteLba = lba + count;
     s->dirty = true;
     log_slot_stats(slotIndex, this->stats(slotIndex));
-    return DiskResult{DiskError::None, static_cast<std::uint16_t>(bytes)};
+    return r;
 }
 
 DiskResult DiskService::ensure_mounted(std::size_t slotIndex)
@@ -524,6 +661,7 @@ DiskResult DiskService::activate_pending_mount(std::size_t slotIndex)
     MountOptions opts{};
     opts.readOnlyRequested = (s->pendingMount->mode.find('w') == std::string::npos);
     opts.sectorSizeHint = s->pendingMount->sectorSizeHint;
+    opts.prefetch = s->pendingMount->prefetch;
 
     return mount(slotIndex, fs->name(), resolvedPath, opts);
 }
@@ -544,6 +682,11 @@ DiskSlotInfo DiskService::info(std::size_t slotIndex) const
     out.type = s->type;
     out.geometry = s->geometry;
     out.lastError = s->lastError;
+    if (s->prefetch) {
+        out.prefetch = s->prefetch->mode();
+        out.prefetchLandedBytes = s->prefetch->landed_bytes();
+        out.prefetchTotalBytes = s->prefetch->size();
+    }
     out.fsName = s->fsName;
     out.path = s->path;
     return out;
@@ -561,13 +704,14 @@ void DiskService::set_pending_mount(
     const std::string& uri,
     const std::string& mode,
     bool enabled,
-    std::uint16_t sectorSizeHint
+    std::uint16_t sectorSizeHint,
+    PrefetchMode prefetch
 )
 {
     auto* s = slot_ptr(slotIndex);
     if (!s) return;
     
-    s->pendingMount = PendingMountInfo{uri, mode, enabled, sectorSizeHint};
+    s->pendingMount = PendingMountInfo{uri, mode, enabled, sectorSizeHint, prefetch};
     
     // Also store fsName and path for display purposes (will be updated on actual mount)
     // Parse the URI to extract filesystem name
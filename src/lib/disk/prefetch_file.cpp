@@ -0,0 +1,185 @@
+#include "fujinet/disk/prefetch_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace fujinet::disk {
+
+PrefetchFile::PrefetchFile(std::unique_ptr<fs::IFile> source, std::uint64_t sizeBytes, PrefetchMode mode)
+    : _source(std::move(source))
+    , _mode(mode)
+    , _data(static_cast<std::size_t>(sizeBytes))
+    , _landed((static_cast<std::size_t>(sizeBytes) + kBlockSize - 1) / kBlockSize, false)
+{
+    _sourcePosValid = _source && _source->seek(0);
+}
+
+std::uint64_t PrefetchFile::landed_bytes() const noexcept
+{
+    if (_landedBlocks == _landed.size()) return _data.size();
+    std::uint64_t bytes = static_cast<std::uint64_t>(_landedBlocks) * kBlockSize;
+    // Only the last block can be short.
+    if (!_landed.empty() && _landed.back()) {
+        bytes -= kBlockSize - (_data.size() - (_landed.size() - 1) * kBlockSize);
+    }
+    return bytes;
+}
+
+std::size_t PrefetchFile::journaled_bytes() const noexcept
+{
+    std::size_t total = 0;
+    for (const auto& [start, end] : _journal) total += static_cast<std::size_t>(end - start);
+    return total;
+}
+
+bool PrefetchFile::fetch(std::size_t firstBlock, std::size_t endBlock)
+{
+    if (!_source) return false;
+
+    const std::uint64_t start = static_cast<std::uint64_t>(firstBlock) * kBlockSize;
+    const std::uint64_t end = std::min<std::uint64_t>(static_cast<std::uint64_t>(endBlock) * kBlockSize, _data.size());
+
+    if (!_sourcePosValid || _sourcePos != start) {
+        if (!_source->seek(start)) {
+            _sourcePosValid = false;
+            return false;
+        }
+    }
+
+    std::uint64_t off = start;
+    while (off < end) {
+        const std::size_t got = _source->read(_data.data() + off, static_cast<std::size_t>(end - off));
+        if (got == 0) {
+            _sourcePosValid = false;
+            return false;
+        }
+        off += got;
+    }
+    _sourcePos = end;
+    _sourcePosValid = true;
+
+    for (std::size_t b = firstBlock; b < endBlock; ++b) {
+        if (!_landed[b]) {
+            _landed[b] = true;
+            ++_landedBlocks;
+        }
+    }
+    return true;
+}
+
+bool PrefetchFile::ensure(std::uint64_t offset, std::size_t bytes)
+{
+    if (bytes == 0) return true;
+    const std::size_t first = static_cast<std::size_t>(offset / kBlockSize);
+    const std::size_t last = static_cast<std::size_t>((offset + bytes - 1) / kBlockSize);
+
+    // Fetch each run of missing blocks with one seek.
+    std::size_t b = first;
+    while (b <= last) {
+        if (_landed[b]) {
+            ++b;
+            continue;
+        }
+        std::size_t runEnd = b + 1;
+        while (runEnd <= last && !_landed[runEnd]) ++runEnd;
+        if (!fetch(b, runEnd)) return false;
+        b = runEnd;
+    }
+    return true;
+}
+
+bool PrefetchFile::pump(std::size_t maxBytes)
+{
+    if (complete()) return true;
+
+    std::size_t budget = std::max<std::size_t>(maxBytes / kBlockSize, 1);
+    while (budget > 0 && _nextBlock < _landed.size()) {
+        if (_landed[_nextBlock]) {
+            ++_nextBlock;
+            continue;
+        }
+        std::size_t runEnd = _nextBlock + 1;
+        while (runEnd < _landed.size() && !_landed[runEnd] && runEnd - _nextBlock < budget) ++runEnd;
+        if (!fetch(_nextBlock, runEnd)) {
+            _failed = true;
+            return false;
+        }
+        budget -= runEnd - _nextBlock;
+        _nextBlock = runEnd;
+    }
+    return true;
+}
+
+std::size_t PrefetchFile::read(void* dst, std::size_t maxBytes)
+{
+    if (!dst || _pos >= _data.size()) return 0;
+    const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(maxBytes, _data.size() - _pos));
+    if (!ensure(_pos, n)) return 0;
+    std::memcpy(dst, _data.data() + _pos, n);
+    _pos += n;
+    return n;
+}
+
+std::size_t PrefetchFile::write(const void* src, std::size_t bytes)
+{
+    if (!src || _pos > _data.size()) return 0;
+    // Disk images never grow through sector writes.
+    const std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(bytes, _data.size() - _pos));
+
+    // Partial blocks must land first or pump() would overwrite the write.
+    if (!ensure(_pos, n)) return 0;
+    std::memcpy(_data.data() + _pos, src, n);
+    if (_mode == PrefetchMode::Stream) {
+        journal(_pos, _pos + n);
+    }
+    _pos += n;
+    return n;
+}
+
+void PrefetchFile::journal(std::uint64_t offset, std::uint64_t end)
+{
+    if (offset >= end) return;
+
+    // Merge with any overlapping or touching ranges.
+    auto it = _journal.upper_bound(offset);
+    if (it != _journal.begin()) {
+        auto prev = std::prev(it);
+        if (prev->second >= offset) {
+            offset = prev->first;
+            end = std::max(end, prev->second);
+            it = _journal.erase(prev);
+        }
+    }
+    while (it != _journal.end() && it->first <= end) {
+        end = std::max(end, it->second);
+        it = _journal.erase(it);
+    }
+    _journal.emplace(offset, end);
+}
+
+bool PrefetchFile::seek(std::uint64_t offset)
+{
+    if (offset > _data.size()) return false;
+    _pos = offset;
+    return true;
+}
+
+bool PrefetchFile::flush()
+{
+    if (_mode != PrefetchMode::Stream || _journal.empty()) return true;
+    if (!_source) return false;
+
+    while (!_journal.empty()) {
+        auto it = _journal.begin();
+        const std::uint64_t start = it->first;
+        const std::size_t len = static_cast<std::size_t>(it->second - start);
+        _sourcePosValid = false;
+        if (!_source->seek(start)) return false;
+        if (_source->write(_data.data() + start, len) != len) return false;
+        _journal.erase(it);
+    }
+    return _source->flush();
+}
+
+} // namespace fujinet::disk
@@ -59,64 +59,60 @@ public:
     }
 
     DiskResult read_sector(std::uint32_t lba, std::uint8_t* dst, std::size_t dstBytes) override
+    {
+        if (_file) {
+            if (!dst) return DiskResult{DiskError::InvalidSlot};
+            if (dstBytes < _geo.sectorSize) return DiskResult{DiskError::InvalidSlot};
+        }
+        return read_sectors(lba, 1, dst, dstBytes);
+    }
+
+    DiskResult write_sector(std::uint32_t lba, const std::uint8_t* src, std::size_t srcBytes) override
+    {
+        if (_file && !_readOnly) {
+            if (!src) return DiskResult{DiskError::InvalidSlot};
+            if (srcBytes < _geo.sectorSize) return DiskResult{DiskError::InvalidSlot};
+        }
+        return write_sectors(lba, 1, src, srcBytes);
+    }
+
+    DiskResult read_sectors(std::uint32_t lba, std::uint16_t count, std::uint8_t* dst, std::size_t dstBytes) override
     {
         if (!_file) return DiskResult{DiskError::NotMounted};
-        if (!dst) return DiskResult{DiskError::InvalidSlot};
-        if (_geo.sectorSize == 0 || _geo.sectorCount == 0) return DiskResult{DiskError::BadImage};
-        if (lba >= _geo.sectorCount) return DiskResult{DiskError::OutOfRange};
-        if (dstBytes < _geo.sectorSize) return DiskResult{DiskError::InvalidSlot};
+        std::size_t total = 0;
+        DiskResult check = check_range(lba, count, dst, dstBytes, total);
+        if (!check.ok()) return check;
 
         ++_stats.readOps;
-        if (!_cursorValid || lba != _nextSequentialLba) {
-            const std::uint64_t off = static_cast<std::uint64_t>(lba) * _geo.sectorSize;
-            ++_stats.seekOps;
-            if (!_file->seek(off)) {
-                _cursorValid = false;
-                return DiskResult{DiskError::IoError};
-            }
-        } else {
-            ++_stats.sequentialReadHits;
-        }
-        const std::size_t got = _file->read(dst, _geo.sectorSize);
-        if (got != _geo.sectorSize) {
+        if (!position(lba, _stats.sequentialReadHits)) return DiskResult{DiskError::IoError};
+        const std::size_t got = _file->read(dst, total);
+        if (got != total) {
             _cursorValid = false;
             return DiskResult{DiskError::IoError};
         }
         _stats.readBytes += got;
-        _cursorValid = true;
-        _nextSequentialLba = lba + 1;
-        return DiskResult{DiskError::None, static_cast<std::uint16_t>(_geo.sectorSize)};
+        _nextSequentialLba = lba + count;
+        return DiskResult{DiskError::None, static_cast<std::uint16_t>(total)};
     }
 
-    DiskResult write_sector(std::uint32_t lba, const std::uint8_t* src, std::size_t srcBytes) override
+    DiskResult write_sectors(std::uint32_t lba, std::uint16_t count, const std::uint8_t* src, std::size_t srcBytes) override
     {
         if (!_file) return DiskResult{DiskError::NotMounted};
         if (_readOnly) return DiskResult{DiskError::ReadOnly};
-        if (!src) return DiskResult{DiskError::InvalidSlot};
-        if (_geo.sectorSize == 0 || _geo.sectorCount == 0) return DiskResult{DiskError::BadImage};
-        if (lba >= _geo.sectorCount) return DiskResult{DiskError::OutOfRange};
-        if (srcBytes < _geo.sectorSize) return DiskResult{DiskError::InvalidSlot};
+        std::size_t total = 0;
+        DiskResult check = check_range(lba, count, src, srcBytes, total);
+        if (!check.ok()) return check;
 
         ++_stats.writeOps;
-        if (!_cursorValid || lba != _nextSequentialLba) {
-            const std::uint64_t off = static_cast<std::uint64_t>(lba) * _geo.sectorSize;
-            ++_stats.seekOps;
-            if (!_file->seek(off)) {
-                _cursorValid = false;
-                return DiskResult{DiskError::IoError};
-            }
-        } else {
-            ++_stats.sequentialWriteHits;
-        }
-        const std::size_t wrote = _file->write(src, _geo.sectorSize);
-        if (wrote != _geo.sectorSize) {
+        if (!position(lba, _stats.sequentialWriteHits)) return DiskResult{DiskError::IoError};
+        const std::size_t wrote = _file->write(src, total);
+        if (wrote != total) {
             _cursorValid = false;
             return DiskResult{DiskError::IoError};
         }
         _stats.writeBytes += wrote;
-        _cursorValid = true;
-        _nextSequentialLba = lba + 1;
-        return DiskResult{DiskError::None, static_cast<std::uint16_t>(_geo.sectorSize)};
+        _nextSequentialLba = lba + count;
+        return DiskResult{DiskError::None, static_cast<std::uint16_t>(total)};
     }
 
     DiskResult flush() override
@@ -129,6 +125,33 @@ public:
     void reset_image_stats() noexcept override { _stats = {}; }
 
 private:
+    DiskResult check_range(std::uint32_t lba, std::uint16_t count, const std::uint8_t* buf, std::size_t bufBytes,
+                           std::size_t& total) const
+    {
+        if (_geo.sectorSize == 0 || _geo.sectorCount == 0) return DiskResult{DiskError::BadImage};
+        if (count == 0 || !buf) return DiskResult{DiskError::InvalidRequest};
+        if (lba >= _geo.sectorCount || count > _geo.sectorCount - lba) return DiskResult{DiskError::OutOfRange};
+        total = static_cast<std::size_t>(count) * _geo.sectorSize;
+        if (bufBytes < total || total > 0xFFFFu) return DiskResult{DiskError::InvalidRequest};
+        return DiskResult{DiskError::None};
+    }
+
+    // Seek to `lba` unless the file is already there. Callers invalidate
+    // the cursor again if the transfer that follows comes up short.
+    bool position(std::uint32_t lba, std::uint64_t& sequentialHits)
+    {
+        const bool sequential = _cursorValid && lba == _nextSequentialLba;
+        _cursorValid = false;
+        if (sequential) {
+            ++sequentialHits;
+        } else {
+            ++_stats.seekOps;
+            if (!_file->seek(static_cast<std::uint64_t>(lba) * _geo.sectorSize)) return false;
+        }
+        _cursorValid = true;
+        return true;
+    }
+
     std::unique_ptr<fs::IFile> _file;
     DiskGeometry _geo{};
     bool _readOnly{true};
@@ -0,0 +1,358 @@
+#include "fujinet/disk/sector_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace fujinet::disk {
+
+// Largest transfer a single image call can report in DiskResult::bytes.
+static constexpr std::size_t MAX_RUN_BYTES = 0xFFFF;
+
+void SectorCache::set_config(const SectorCacheConfig& config)
+{
+    _config = config;
+    if (_config.readAheadSectors == 0) {
+        _config.readAheadSectors = 1;
+    }
+}
+
+void SectorCache::clear()
+{
+    _entries.clear();
+    _index.clear();
+    _dirty = 0;
+    _retryDelay = Clock::duration::zero();
+}
+
+SectorCache::Entry* SectorCache::find(std::uint32_t lba)
+{
+    auto it = _index.find(lba);
+    if (it == _index.end()) {
+        return nullptr;
+    }
+    _entries.splice(_entries.begin(), _entries, it->second);
+    return &_entries.front();
+}
+
+DiskResult SectorCache::write_back(IDiskImage& image, Entry& e)
+{
+    DiskResult r = image.write_sector(e.lba, e.data.data(), e.bytes);
+    if (r.ok()) {
+        e.dirty = false;
+        --_dirty;
+        ++_stats.writeBackSectors;
+    }
+    return r;
+}
+
+DiskResult SectorCache::write_back_run(IDiskImage& image,
+                                       std::vector<Entry*>::const_iterator first,
+                                       std::vector<Entry*>::const_iterator last)
+{
+    if (last - first == 1) {
+        return write_back(image, **first);
+    }
+
+    _scratch.clear();
+    for (auto it = first; it != last; ++it) {
+        _scratch.insert(_scratch.end(), (*it)->data.begin(), (*it)->data.begin() + (*it)->bytes);
+    }
+    const auto count = static_cast<std::uint16_t>(last - first);
+    DiskResult r = image.write_sectors((*first)->lba, count, _scratch.data(), _scratch.size());
+    if (r.ok()) {
+        for (auto it = first; it != last; ++it) {
+            (*it)->dirty = false;
+        }
+        _dirty -= count;
+        _stats.writeBackSectors += count;
+    }
+    return r;
+}
+
+DiskResult SectorCache::insert(IDiskImage& image, Entry entry)
+{
+    while (!_entries.empty() && _entries.size() >= _config.capacitySectors) {
+        Entry& victim = _entries.back();
+        if (victim.dirty) {
+            DiskResult r = write_back(image, victim);
+            if (!r.ok()) {
+                return r;
+            }
+        }
+        _index.erase(victim.lba);
+        _entries.pop_back();
+        ++_stats.evictions;
+    }
+
+    if (entry.dirty) {
+        ++_dirty;
+    }
+    _entries.push_front(std::move(entry));
+    _index[_entries.front().lba] = _entries.begin();
+    return DiskResult{DiskError::None};
+}
+
+DiskResult SectorCache::read(IDiskImage& image, std::uint32_t lba, std::uint8_t* dst, std::size_t dstBytes, bool sequential)
+{
+    if (_config.capacitySectors == 0) {
+        return image.read_sector(lba, dst, dstBytes);
+    }
+
+    const std::size_t sectorSize = image.geometry().sectorSize;
+    if (!dst || dstBytes < sectorSize) {
+        return image.read_sector(lba, dst, dstBytes); // let the image reject it
+    }
+
+    if (Entry* e = find(lba)) {
+        ++_stats.hits;
+        std::memset(dst, 0, sectorSize);
+        std::memcpy(dst, e->data.data(), e->bytes);
+        return DiskResult{DiskError::None, e->bytes};
+    }
+    ++_stats.misses;
+
+    const std::uint32_t ahead = sequential ? read_ahead_after(image, lba + 1) : 0;
+    std::memset(dst, 0, sectorSize);
+    DiskResult r = fetch(image, lba, 1, ahead, dst);
+    if (r.ok() && ahead > 0) {
+        // Keep the requested sector most recent.
+        find(lba);
+    }
+    return r;
+}
+
+DiskResult SectorCache::read_sectors(IDiskImage& image, std::uint32_t lba, std::uint16_t count,
+                                     std::uint8_t* dst, std::size_t dstBytes, bool sequential)
+{
+    if (_config.capacitySectors == 0 || !dst || count == 0) {
+        return image.read_sectors(lba, count, dst, dstBytes); // uncached, or let the image reject it
+    }
+
+    const std::uint32_t sectorCount = image.geometry().sectorCount;
+    if (lba >= sectorCount || count > sectorCount - lba) return DiskResult{DiskError::OutOfRange};
+    std::size_t need = 0;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        need += image.sector_size(lba + i);
+    }
+    if (need > dstBytes || need > MAX_RUN_BYTES) return DiskResult{DiskError::InvalidRequest};
+
+    // Hits are copied out; each run of misses is one fetch, and the run that
+    // ends the request also pulls in the read-ahead.
+    std::size_t bytes = 0;
+    for (std::uint32_t i = 0; i < count;) {
+        if (Entry* e = find(lba + i)) {
+            ++_stats.hits;
+            std::memcpy(dst + bytes, e->data.data(), e->bytes);
+            bytes += e->bytes;
+            ++i;
+            continue;
+        }
+
+        std::uint32_t n = 1;
+        while (i + n < count && _index.count(lba + i + n) == 0) {
+            ++n;
+        }
+        _stats.misses += n;
+        const bool last = i + n == count;
+        const std::uint32_t ahead = (last && sequential) ? read_ahead_after(image, lba + count) : 0;
+        DiskResult r = fetch(image, lba + i, n, ahead, dst + bytes);
+        if (!r.ok()) {
+            return r;
+        }
+        bytes += r.bytes;
+        i += n;
+    }
+    return DiskResult{DiskError::None, static_cast<std::uint16_t>(bytes)};
+}
+
+std::uint32_t SectorCache::read_ahead_after(const IDiskImage& image, std::uint32_t lba) const
+{
+    if (_config.readAheadSectors <= 1) {
+        return 0;
+    }
+    const std::uint32_t sectorCount = image.geometry().sectorCount;
+    const std::uint32_t most = static_cast<std::uint32_t>(
+        std::min<std::size_t>(_config.readAheadSectors - 1U, _config.capacitySectors / 2));
+
+    std::uint32_t n = 0;
+    while (n < most && lba + n < sectorCount && _index.count(lba + n) == 0) {
+        ++n;
+    }
+    return n;
+}
+
+DiskResult SectorCache::fetch(IDiskImage& image, std::uint32_t lba, std::uint32_t count, std::uint32_t ahead,
+                              std::uint8_t* dst)
+{
+    std::uint32_t total = count + ahead;
+    std::size_t copied = 0;
+    for (std::uint32_t done = 0; done < total;) {
+        std::uint32_t n = 0;
+        std::size_t bytes = 0;
+        while (done + n < total) {
+            const std::size_t size = image.sector_size(lba + done + n);
+            if (bytes + size > MAX_RUN_BYTES) break;
+            bytes += size;
+            ++n;
+        }
+        if (n == 0) {
+            return DiskResult{DiskError::InvalidRequest};
+        }
+
+        _scratch.resize(bytes);
+        DiskResult r = image.read_sectors(lba + done, static_cast<std::uint16_t>(n), _scratch.data(), bytes);
+        if (!r.ok()) {
+            if (done >= count) {
+                break; // speculative
+            }
+            if (total > count) {
+                total = count; // retry without the read-ahead; the request reports its own error
+                continue;
+            }
+            return r;
+        }
+
+        std::size_t off = 0;
+        for (std::uint32_t k = 0; k < n; ++k) {
+            const std::uint32_t cur = lba + done + k;
+            const auto size = image.sector_size(cur);
+            const bool requested = done + k < count;
+            if (requested) {
+                std::memcpy(dst + copied, _scratch.data() + off, size);
+                copied += size;
+            }
+            DiskResult stored = insert(image, Entry{cur, size, false,
+                std::vector<std::uint8_t>(_scratch.data() + off, _scratch.data() + off + size)});
+            if (!stored.ok()) {
+                if (!requested) {
+                    return DiskResult{DiskError::None, static_cast<std::uint16_t>(copied)};
+                }
+                return stored;
+            }
+            if (!requested) {
+                ++_stats.readAheadSectors;
+            }
+            off += size;
+        }
+        done += n;
+    }
+    return DiskResult{DiskError::None, static_cast<std::uint16_t>(copied)};
+}
+
+DiskResult SectorCache::write(IDiskImage& image, std::uint32_t lba, const std::uint8_t* src, std::size_t srcBytes)
+{
+    if (_config.capacitySectors == 0) {
+        return image.write_sector(lba, src, srcBytes);
+    }
+
+    // Validate up front what the image would reject at write-back time.
+    if (image.read_only()) return DiskResult{DiskError::ReadOnly};
+    if (!src) return DiskResult{DiskError::InvalidRequest};
+    if (lba >= image.geometry().sectorCount) return DiskResult{DiskError::OutOfRange};
+    const std::uint16_t bytes = image.sector_size(lba);
+    if (bytes == 0 || srcBytes < bytes) return DiskResult{DiskError::InvalidRequest};
+
+    _lastWrite = Clock::now();
+
+    if (Entry* e = find(lba)) {
+        std::memcpy(e->data.data(), src, bytes);
+        e->bytes = bytes;
+        if (!e->dirty) {
+            e->dirty = true;
+            ++_dirty;
+        }
+        return DiskResult{DiskError::None, bytes};
+    }
+
+    DiskResult r = insert(image, Entry{lba, bytes, true, std::vector<std::uint8_t>(src, src + bytes)});
+    if (!r.ok()) {
+        return r;
+    }
+    return DiskResult{DiskError::None, bytes};
+}
+
+DiskResult SectorCache::write_sectors(IDiskImage& image, std::uint32_t lba, std::uint16_t count,
+                                      const std::uint8_t* src, std::size_t srcBytes)
+{
+    if (_config.capacitySectors == 0) {
+        return image.write_sectors(lba, count, src, srcBytes);
+    }
+    if (!src || count == 0) return DiskResult{DiskError::InvalidRequest};
+
+    std::size_t bytes = 0;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        DiskResult r = write(image, lba + i, src + bytes, srcBytes - bytes);
+        if (!r.ok()) {
+            return r;
+        }
+        bytes += r.bytes;
+    }
+    return DiskResult{DiskError::None, static_cast<std::uint16_t>(bytes)};
+}
+
+DiskResult SectorCache::flush(IDiskImage& image)
+{
+    if (_dirty > 0) {
+        // Ascending LBA, and each contiguous run in one image write.
+        std::vector<Entry*> dirty;
+        dirty.reserve(_dirty);
+        for (auto& e : _entries) {
+            if (e.dirty) {
+                dirty.push_back(&e);
+            }
+        }
+        std::sort(dirty.begin(), dirty.end(), [](const Entry* a, const Entry* b) { return a->lba < b->lba; });
+
+        for (auto first = dirty.cbegin(); first != dirty.cend();) {
+            auto last = first + 1;
+            std::size_t bytes = (*first)->bytes;
+            while (last != dirty.cend() && (*last)->lba == (*(last - 1))->lba + 1 &&
+                   bytes + (*last)->bytes <= MAX_RUN_BYTES) {
+                bytes += (*last)->bytes;
+                ++last;
+            }
+            DiskResult r = write_back_run(image, first, last);
+            if (!r.ok()) {
+                return r;
+            }
+            first = last;
+        }
+        ++_stats.flushes;
+    }
+    return image.flush();
+}
+
+DiskResult SectorCache::flush_if_idle(IDiskImage& image, Clock::time_point now)
+{
+    Clock::duration in{};
+    if (!next_write_back(in, now) || in > Clock::duration::zero()) {
+        return DiskResult{DiskError::None};
+    }
+    DiskResult r = flush(image);
+    if (r.ok()) {
+        _retryDelay = Clock::duration::zero();
+        return r;
+    }
+    if (_retryDelay == Clock::duration::zero()) {
+        _retryDelay = std::max<Clock::duration>(_config.writeBackDelay, MIN_WRITE_BACK_RETRY);
+    } else {
+        _retryDelay = std::min<Clock::duration>(_retryDelay * 2, MAX_WRITE_BACK_RETRY);
+    }
+    _retryAt = now + _retryDelay;
+    return r;
+}
+
+bool SectorCache::next_write_back(Clock::duration& in, Clock::time_point now) const
+{
+    if (_dirty == 0) {
+        return false;
+    }
+    auto due = _lastWrite + _config.writeBackDelay;
+    if (_retryDelay != Clock::duration::zero() && _retryAt > due) {
+        due = _retryAt;
+    }
+    in = (due > now) ? due - now : Clock::duration::zero();
+    return true;
+}
+
+} // namespace fujinet::disk
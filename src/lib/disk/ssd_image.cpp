@@ -62,45 +62,53 @@ public:
     }
 
     DiskResult read_sector(std::uint32_t lba, std::uint8_t* dst, std::size_t dstBytes) override
+    {
+        if (_file) {
+            if (!dst) return DiskResult{DiskError::InvalidSlot};
+            if (dstBytes < _geo.sectorSize) return DiskResult{DiskError::InvalidSlot};
+        }
+        return read_sectors(lba, 1, dst, dstBytes);
+    }
+
+    DiskResult write_sector(std::uint32_t lba, const std::uint8_t* src, std::size_t srcBytes) override
+    {
+        if (_file && !_readOnly) {
+            if (!src) return DiskResult{DiskError::InvalidSlot};
+            if (srcBytes < _geo.sectorSize) return DiskResult{DiskError::InvalidSlot};
+        }
+        return write_sectors(lba, 1, src, srcBytes);
+    }
+
+    DiskResult read_sectors(std::uint32_t lba, std::uint16_t count, std::uint8_t* dst, std::size_t dstBytes) override
     {
         if (!_file) return DiskResult{DiskError::NotMounted};
-        if (!dst) return DiskResult{DiskError::InvalidSlot};
-        if (_geo.sectorSize == 0 || _geo.sectorCount == 0) return DiskResult{DiskError::BadImage};
-        if (lba >= _geo.sectorCount) return DiskResult{DiskError::OutOfRange};
-        if (dstBytes < _geo.sectorSize) return DiskResult{DiskError::InvalidSlot};
+        std::size_t total = 0;
+        DiskResult check = check_range(lba, count, dst, dstBytes, total);
+        if (!check.ok()) return check;
 
+        // Sectors past the end of a truncated image read as zeros.
         const std::uint64_t off = static_cast<std::uint64_t>(lba) * _geo.sectorSize;
-        const std::uint64_t end = off + _geo.sectorSize;
-
-        if (off >= _fileSizeBytes) {
-            std::memset(dst, 0, _geo.sectorSize);
-            return DiskResult{DiskError::None, static_cast<std::uint16_t>(_geo.sectorSize)};
-        }
-        if (end <= _fileSizeBytes) {
+        const std::size_t inFile = off >= _fileSizeBytes
+            ? 0
+            : static_cast<std::size_t>(std::min<std::uint64_t>(total, _fileSizeBytes - off));
+        if (inFile > 0) {
             if (!_file->seek(off)) return DiskResult{DiskError::IoError};
-            const std::size_t got = _file->read(dst, _geo.sectorSize);
-            if (got != _geo.sectorSize) return DiskResult{DiskError::IoError};
-            return DiskResult{DiskError::None, static_cast<std::uint16_t>(_geo.sectorSize)};
+            if (_file->read(dst, inFile) != inFile) return DiskResult{DiskError::IoError};
         }
-        std::size_t inFile = static_cast<std::size_t>(_fileSizeBytes - off);
-        if (!_file->seek(off)) return DiskResult{DiskError::IoError};
-        const std::size_t got = _file->read(dst, inFile);
-        if (got != inFile) return DiskResult{DiskError::IoError};
-        std::memset(dst + inFile, 0, _geo.sectorSize - inFile);
-        return DiskResult{DiskError::None, static_cast<std::uint16_t>(_geo.sectorSize)};
+        std::memset(dst + inFile, 0, total - inFile);
+        return DiskResult{DiskError::None, static_cast<std::uint16_t>(total)};
     }
 
-    DiskResult write_sector(std::uint32_t lba, const std::uint8_t* src, std::size_t srcBytes) override
+    DiskResult write_sectors(std::uint32_t lba, std::uint16_t count, const std::uint8_t* src, std::size_t srcBytes) override
     {
         if (!_file) return DiskResult{DiskError::NotMounted};
         if (_readOnly) return DiskResult{DiskError::ReadOnly};
-        if (!src) return DiskResult{DiskError::InvalidSlot};
-        if (_geo.sectorSize == 0 || _geo.sectorCount == 0) return DiskResult{DiskError::BadImage};
-        if (lba >= _geo.sectorCount) return DiskResult{DiskError::OutOfRange};
-        if (srcBytes < _geo.sectorSize) return DiskResult{DiskError::InvalidSlot};
+        std::size_t total = 0;
+        DiskResult check = check_range(lba, count, src, srcBytes, total);
+        if (!check.ok()) return check;
 
         const std::uint64_t off = static_cast<std::uint64_t>(lba) * _geo.sectorSize;
-        const std::uint64_t end = off + _geo.sectorSize;
+        const std::uint64_t end = off + total;
 
         if (off > _fileSizeBytes) {
             static constexpr std::size_t ZERO_BUF = 256;
@@ -114,10 +122,10 @@ public:
             _fileSizeBytes = off;
         }
         if (!_file->seek(off)) return DiskResult{DiskError::IoError};
-        const std::size_t wrote = _file->write(src, _geo.sectorSize);
-        if (wrote != _geo.sectorSize) return DiskResult{DiskError::IoError};
+        const std::size_t wrote = _file->write(src, total);
+        if (wrote != total) return DiskResult{DiskError::IoError};
         if (end > _fileSizeBytes) _fileSizeBytes = end;
-        return DiskResult{DiskError::None, static_cast<std::uint16_t>(_geo.sectorSize)};
+        return DiskResult{DiskError::None, static_cast<std::uint16_t>(total)};
     }
 
     DiskResult flush() override
@@ -127,6 +135,17 @@ public:
     }
 
 private:
+    DiskResult check_range(std::uint32_t lba, std::uint16_t count, const std::uint8_t* buf, std::size_t bufBytes,
+                           std::size_t& total) const
+    {
+        if (_geo.sectorSize == 0 || _geo.sectorCount == 0) return DiskResult{DiskError::BadImage};
+        if (count == 0 || !buf) return DiskResult{DiskError::InvalidRequest};
+        if (lba >= _geo.sectorCount || count > _geo.sectorCount - lba) return DiskResult{DiskError::OutOfRange};
+        total = static_cast<std::size_t>(count) * _geo.sectorSize;
+        if (bufBytes < total || total > 0xFFFFu) return DiskResult{DiskError::InvalidRequest};
+        return DiskResult{DiskError::None};
+    }
+
     std::unique_ptr<fs::IFile> _file;
     DiskGeometry _geo{};
     bool _readOnly{true};
@@ -42,6 +42,7 @@ static const char* disk_error_name(DiskError e) noexcept
         case DiskError::OutOfRange: return "OutOfRange";
         case DiskError::IoError: return "IoError";
         case DiskError::InternalError: return "InternalError";
+        case DiskError::WouldBlock: return "WouldBlock";
     }
     return "Unknown";
 }
@@ -64,6 +65,7 @@ static StatusCode map_disk_error(DiskError e) noexcept
         case DiskError::OutOfRange:         return StatusCode::InvalidRequest;
         case DiskError::IoError:            return StatusCode::IOError;
         case DiskError::InternalError:      return StatusCode::InternalError;
+        case DiskError::WouldBlock:         return StatusCode::NotReady;
     }
     return StatusCode::InternalError;
 }
@@ -146,7 +148,7 @@ bool DiskDevice::save_runtime_mounts()
         return false;
     }
 
-    std::string data = "v1\n";
+    std::string data = "v2\n";
     std::size_t count = 0;
     for (std::size_t i = 0; i < _runtimeMounts.size(); ++i) {
         const auto& m = _runtimeMounts[i];
@@ -157,6 +159,8 @@ bool DiskDevice::save_runtime_mounts()
         data += '\t';
         data += (m->mode.empty() ? "rw" : m->mode);
         data += '\t';
+        data += disk::prefetch_mode_name(m->prefetch);
+        data += '\t';
         data += m->uri;
         data += '\n';
         ++count;
@@ -180,6 +184,7 @@ bool DiskDevice::load_runtime_mounts()
     _runtimeMounts.assign(disk::DiskService::MAX_SLOTS, std::nullopt);
     std::size_t lineStart = 0;
     bool sawVersion = false;
+    bool hasPrefetch = false; // v2 adds a prefetch field before the uri
     while (lineStart <= data.size()) {
         std::size_t lineEnd = data.find('\n', lineStart);
         if (lineEnd == std::string::npos) lineEnd = data.size();
@@ -188,23 +193,28 @@ bool DiskDevice::load_runtime_mounts()
 
         if (!line.empty()) {
             if (!sawVersion) {
-                sawVersion = (line == "v1");
+                sawVersion = (line == "v1" || line == "v2");
+                hasPrefetch = (line == "v2");
             } else {
                 const auto p1 = line.find('\t');
                 const auto p2 = p1 == std::string_view::npos ? p1 : line.find('\t', p1 + 1);
                 const auto p3 = p2 == std::string_view::npos ? p2 : line.find('\t', p2 + 1);
+                const auto p4 = (!hasPrefetch || p3 == std::string_view::npos) ? p3 : line.find('\t', p3 + 1);
                 std::size_t slot = 0;
                 std::uint16_t hint = 0;
+                disk::PrefetchMode prefetch = disk::PrefetchMode::Off;
                 if (p1 != std::string_view::npos &&
                     p2 != std::string_view::npos &&
-                    p3 != std::string_view::npos &&
+                    p4 != std::string_view::npos &&
                     parse_size(line.substr(0, p1), slot) &&
                     parse_u16(line.substr(p1 + 1, p2 - p1 - 1), hint) &&
+                    (!hasPrefetch || disk::parse_prefetch_mode(line.substr(p3 + 1, p4 - p3 - 1), prefetch)) &&
                     slot < _runtimeMounts.size()) {
                     RuntimeMountState state{};
                     state.sectorSizeHint = hint;
+                    state.prefetch = prefetch;
                     state.mode = std::string(line.substr(p2 + 1, p3 - p2 - 1));
-                    state.uri = std::string(line.substr(p3 + 1));
+                    state.uri = std::string(line.substr(p4 + 1));
                     if (!state.uri.empty()) _runtimeMounts[slot] = std::move(state);
                 }
             }
@@ -247,7 +257,7 @@ std::vector<std::size_t> DiskDevice::restore_runtime_mounts()
     for (std::size_t i = 0; i < _runtimeMounts.size(); ++i) {
         const auto& m = _runtimeMounts[i];
         if (!m || m->uri.empty()) continue;
-        _svc.set_pending_mount(i, m->uri, m->mode.empty() ? "rw" : m->mode, true, m->sectorSizeHint);
+        _svc.set_pending_mount(i, m->uri, m->mode.empty() ? "rw" : m->mode, true, m->sectorSizeHint, m->prefetch);
         restored.push_back(i);
     }
     if (!restored.empty()) {
@@ -256,6 +266,25 @@ std::vector<std::size_t> DiskDevice::restore_runtime_mounts()
     return restored;
 }
 
+void DiskDevice::poll()
+{
+    // Stream prefetching images; write back cached sectors once the host
+    // has stopped writing.
+    _svc.poll();
+}
+
+void DiskDevice::add_wait_sources(WaitSet& ws)
+{
+    if (_svc.prefetch_pending()) {
+        ws.wake_now();
+        return;
+    }
+    std::chrono::milliseconds in{};
+    if (_svc.next_write_back(in)) {
+        ws.limit_timeout(in);
+    }
+}
+
 IOResponse DiskDevice::handle(const IORequest& request)
 {
     const auto cmd = to_disk_command(request.command);
@@ -287,6 +316,11 @@ IOResponse DiskDevice::handle(const IORequest& request)
             opts.readOnlyRequested = (flags & 0x01) != 0;
             opts.typeOverride = static_cast<ImageType>(typeRaw);
             opts.sectorSizeHint = sectorHint;
+            if (flags & 0x04) {
+                opts.prefetch = disk::PrefetchMode::Snapshot;
+            } else if (flags & 0x02) {
+                opts.prefetch = disk::PrefetchMode::Stream;
+            }
 
             std::string uriStr(uri);
             HostState hostState(_storage);
@@ -328,6 +362,7 @@ IOResponse DiskDevice::handle(const IORequest& request)
                 uriStr,
                 info.readOnly ? "r" : "rw",
                 sectorHint,
+                opts.prefetch,
             });
 
             std::vector<std::uint8_t> out;
@@ -1,3 +1,4 @@
+#include "fujinet/build/profile.h"
 #include "fujinet/core/bootstrap.h"
 #include "fujinet/core/core.h"
 #include "fujinet/io/devices/disk_device.h"
@@ -5,6 +6,8 @@
 #include "fujinet/core/logging.h"
 #include "fujinet/platform/disk_registry.h"
 
+#include <algorithm>
+
 namespace fujinet::core {
 
 using fujinet::io::DeviceID;
@@ -13,11 +16,16 @@ using fujinet::io::protocol::WireDeviceId;
 using fujinet::io::protocol::to_device_id;
 
 static constexpr const char* TAG = "core";
+static constexpr std::size_t kMaxPrefetchBytes = 16 * 1024 * 1024;
 
 void register_disk_device(FujinetCore& core)
 {
     auto reg = fujinet::platform::make_default_disk_image_registry();
     auto dev = std::make_unique<DiskDevice>(core.storageManager(), std::move(reg));
+
+    // Whole-image prefetch buffers live in the large RAM pool (PSRAM on ESP32).
+    const auto pool = fujinet::build::current_build_profile().hw.memory.largeMemoryPoolBytes;
+    dev->disk_service().set_prefetch_limit(std::min<std::size_t>(pool / 4, kMaxPrefetchBytes));
     DeviceID id = to_device_id(WireDeviceId::DiskService); // 0xFC
 
     bool ok = core.deviceManager().registerDevice(id, std::move(dev));
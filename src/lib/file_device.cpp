@@ -23,6 +23,7 @@
 
 namespace fujinet::io {
 
+using fujinet::fs::FileHandleCache;
 using fujinet::fs::FileInfo;
 using fujinet::fs::IFile;
 using fujinet::fs::IFileSystem;
@@ -33,44 +34,6 @@ using fujinet::io::fileproto::Reader;
 // static constexpr const char* TAG = "io";
 
 static constexpr std::uint8_t FILEPROTO_VERSION = 1;
-static constexpr auto LIST_DIRECTORY_CACHE_TTL = std::chrono::seconds(120);
-
-struct ListDirectoryCache {
-    std::string uri;
-    std::vector<FileInfo> entries;
-    std::chrono::steady_clock::time_point expires_at{};
-    bool valid{false};
-};
-
-static ListDirectoryCache g_list_directory_cache{};
-
-static bool get_cached_directory_entries(const std::string& uri, std::vector<FileInfo>& out)
-{
-    if (!g_list_directory_cache.valid) {
-        return false;
-    }
-
-    if (g_list_directory_cache.uri != uri) {
-        return false;
-    }
-
-    if (std::chrono::steady_clock::now() > g_list_directory_cache.expires_at) {
-        g_list_directory_cache.valid = false;
-        return false;
-    }
-
-    out = g_list_directory_cache.entries;
-    g_list_directory_cache.expires_at = std::chrono::steady_clock::now() + LIST_DIRECTORY_CACHE_TTL;
-    return true;
-}
-
-static void store_cached_directory_entries(const std::string& uri, const std::vector<FileInfo>& entries)
-{
-    g_list_directory_cache.uri = uri;
-    g_list_directory_cache.entries = entries;
-    g_list_directory_cache.expires_at = std::chrono::steady_clock::now() + LIST_DIRECTORY_CACHE_TTL;
-    g_list_directory_cache.valid = true;
-}
 
 // Common request prefix:
 // u8 version
@@ -144,7 +107,70 @@ FileDevice::FileDevice(StorageManager& storage)
     : _storage(storage)
 {}
 
+void FileDevice::poll()
+{
+    // Close handles left open by transfers the host abandoned.
+    _storage.fileHandles().expire();
+
+    service_deferred();
+}
+
+bool FileDevice::take_completed(IOResponse& out)
+{
+    if (_completed.empty()) {
+        return false;
+    }
+    out = std::move(_completed.front());
+    _completed.pop_front();
+    return true;
+}
+
+void FileDevice::add_wait_sources(WaitSet& ws)
+{
+    if (!_completed.empty()) {
+        ws.wake_now();
+    }
+    if (!_deferred.empty()) {
+        ws.limit_timeout(DEFERRED_RETRY_INTERVAL);
+    }
+}
+
+void FileDevice::service_deferred()
+{
+    const auto now = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < _deferred.size();) {
+        DeferredRequest& d = _deferred[i];
+        IOResponse resp = handle_now(d.request);
+        if (resp.status == StatusCode::NotReady && now < d.deadline) {
+            ++i;
+            continue;
+        }
+        _completed.push_back(std::move(resp));
+        _deferred.erase(_deferred.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+}
+
 IOResponse FileDevice::handle(const IORequest& request)
+{
+    IOResponse resp = handle_now(request);
+    if (resp.status != StatusCode::NotReady || !request.deferrable) {
+        return resp;
+    }
+
+    // Only queries are safe to re-run from poll().
+    const auto cmd = protocol::to_file_command(request.command);
+    const bool query = cmd == protocol::FileCommand::Stat
+                    || cmd == protocol::FileCommand::ListDirectory
+                    || cmd == protocol::FileCommand::ReadFile;
+    if (!query || _deferred.size() >= MAX_DEFERRED) {
+        return resp;
+    }
+
+    _deferred.push_back(DeferredRequest{request, std::chrono::steady_clock::now() + _deferredTimeout});
+    return make_base_response(request, StatusCode::Pending);
+}
+
+IOResponse FileDevice::handle_now(const IORequest& request)
 {
     auto cmd = protocol::to_file_command(request.command);
 
@@ -174,6 +200,13 @@ IOResponse FileDevice::handle(const IORequest& request)
     }
 }
 
+// A failed filesystem call is NotReady when a non-blocking filesystem just
+// doesn't have the answer yet; the host (or service_deferred) repeats it.
+static StatusCode failure_status(const IFileSystem& fs)
+{
+    return fs.wouldBlock() ? StatusCode::NotReady : StatusCode::IOError;
+}
+
 static std::string normalize_dir_path(std::string p)
 {
     // Trim trailing slashes except root.
@@ -235,6 +268,10 @@ IOResponse FileDevice::handle_stat(const IORequest& request)
 
     FileInfo info{};
     const bool exists = fs->stat(resolvedPath, info);
+    if (!exists && fs->wouldBlock()) {
+        resp.status = StatusCode::NotReady;
+        return resp;
+    }
 
     std::uint8_t flags = 0;
     if (exists) {
@@ -269,12 +306,16 @@ IOResponse FileDevice::handle_stat(const IORequest& request)
 // --------------------
 // After uri + (startIndex, maxPayloadBytes), clients may send an optional u8 listFlags (if
 // payload has a byte left). listDirectory() on a filesystem has already collected the full
-// directory before this handler paginates, so sort-by-basename (flag) reorders a copy, not a
-// stream. maxPayloadBytes caps the variable entries blob; only whole entries are encoded.
+// directory before this handler paginates; the snapshot is cached in StorageManager::listings()
+// with a by-basename index for the sort flag. maxPayloadBytes caps the variable entries blob;
+// only whole entries are encoded.
 IOResponse FileDevice::handle_list_directory(const IORequest& request)
 {
     using fujinet::io::protocol::list_directory::kListFlagCompactOmitMetadata;
+    using fujinet::io::protocol::list_directory::kListFlagFilterDirectories;
     using fujinet::io::protocol::list_directory::kListFlagFormattedLines;
+    using fujinet::io::protocol::list_directory::kListFlagNameFilter;
+    using fujinet::io::protocol::list_directory::kListFlagNameSearch;
     using fujinet::io::protocol::list_directory::kListFlagSortByName;
     using fujinet::io::protocol::list_directory::kListResponseFlagFormatted;
 
@@ -305,6 +346,21 @@ IOResponse FileDevice::handle_list_directory(const IORequest& request)
     const bool formatted = (listFlags & kListFlagFormattedLines) != 0;
     const bool compact = (listFlags & kListFlagCompactOmitMetadata) != 0;
     const bool sortName = (listFlags & kListFlagSortByName) != 0;
+    const bool filterDirs = (listFlags & kListFlagFilterDirectories) != 0;
+
+    // Optional u8-length-prefixed filter strings, in flag order.
+    std::string_view pattern;
+    std::string_view search;
+    auto read_u8_string = [&](std::string_view& out) {
+        std::uint8_t n = 0;
+        return r.read_u8(n) && r.read_sv(out, n);
+    };
+    if (((listFlags & kListFlagNameFilter) != 0 && !read_u8_string(pattern)) ||
+        ((listFlags & kListFlagNameSearch) != 0 && !read_u8_string(search))) {
+        resp.status = StatusCode::InvalidRequest;
+        return resp;
+    }
+    const bool filtering = !pattern.empty() || !search.empty();
 
     if (formatted && compact) {
         resp.status = StatusCode::InvalidRequest;
@@ -324,13 +380,16 @@ IOResponse FileDevice::handle_list_directory(const IORequest& request)
         return resp;
     }
 
-    std::vector<FileInfo> entries;
-    if (!get_cached_directory_entries(canonical_uri, entries)) {
+    // Pages of one directory share a snapshot; sorted pages use its
+    // precomputed index instead of re-sorting per request.
+    auto listing = _storage.listings().find(*fs, resolvedPath);
+    if (!listing) {
+        std::vector<FileInfo> entries;
         if (!fs->listDirectory(resolvedPath, entries)) {
-            resp.status = StatusCode::IOError;
+            resp.status = failure_status(*fs);
             return resp;
         }
-        store_cached_directory_entries(canonical_uri, entries);
+        listing = _storage.listings().insert(*fs, resolvedPath, std::move(entries));
     }
 
     auto basename_sv = [](const std::string& s) -> std::string_view {
@@ -344,17 +403,21 @@ IOResponse FileDevice::handle_list_directory(const IORequest& request)
         return std::string_view{s}.substr(pos + 1);
     };
 
-    const std::vector<FileInfo>* source = &entries;
-    std::vector<FileInfo> sorted;
-    if (sortName) {
-        sorted = entries;
-        std::sort(
-            sorted.begin(), sorted.end(), [&](const FileInfo& a, const FileInfo& b) { return basename_sv(a.path) < basename_sv(b.path); });
-        source = &sorted;
-    }
+    const auto& all = listing->entries;
+    auto entry_at = [&](std::size_t i) -> const FileInfo& {
+        return sortName ? all[listing->byName[i]] : all[i];
+    };
+
+    const std::size_t total = all.size();
 
-    const std::size_t total = source->size();
-    const std::size_t start = (startIndex < total) ? startIndex : total;
+    // Filtering runs over the cached snapshot; startIndex counts matches, so
+    // the host only pages through (and receives) matching rows.
+    auto visible = [&](const FileInfo& e, std::string_view name) {
+        if (e.isDirectory && !filterDirs) {
+            return true;
+        }
+        return list_name_matches(pattern, name) && list_name_contains(name, search);
+    };
 
     // Response:
     // u8 version
@@ -380,47 +443,65 @@ IOResponse FileDevice::handle_list_directory(const IORequest& request)
     const std::size_t entriesStart = out.size();
     std::uint16_t returned = 0;
 
-    if (formatted) {
-        for (std::size_t i = start; i < total; ++i) {
-            const auto& e = (*source)[i];
-            const auto name = basename_sv(e.path);
+    // Encode one entry if it fits in maxPayloadBytes.
+    auto append_entry = [&](const FileInfo& e, std::string_view name) {
+        const std::size_t entriesUsed = out.size() - entriesStart;
+        if (formatted) {
             const std::string line = format_list_directory_line(e, name);
-            const std::size_t entriesUsed = out.size() - entriesStart;
             if (entriesUsed + line.size() > maxPayloadBytes) {
-                break;
+                return false;
             }
             out.append(line);
-            ++returned;
+            return true;
         }
-    } else {
-        for (std::size_t i = start; i < total; ++i) {
-            const auto& e = (*source)[i];
-            const auto name = basename_sv(e.path);
-
-            const std::uint8_t nameLen =
-                static_cast<std::uint8_t>(std::min<std::size_t>(name.size(), 220));
-            const std::size_t entryBytes =
-                2U + static_cast<std::size_t>(nameLen) + (compact ? 0U : 16U);
-            const std::size_t entriesUsed = out.size() - entriesStart;
-            if (entriesUsed + entryBytes > maxPayloadBytes) {
-                break;
-            }
 
-            std::uint8_t eflags = e.isDirectory ? 0x01 : 0x00;
-            fileproto::write_u8(out, eflags);
-            fileproto::write_u8(out, nameLen);
-            fileproto::write_bytes(out, name.data(), nameLen);
+        const std::uint8_t nameLen =
+            static_cast<std::uint8_t>(std::min<std::size_t>(name.size(), 220));
+        const std::size_t entryBytes =
+            2U + static_cast<std::size_t>(nameLen) + (compact ? 0U : 16U);
+        if (entriesUsed + entryBytes > maxPayloadBytes) {
+            return false;
+        }
 
-            if (!compact) {
-                fileproto::write_u64le(out, e.sizeBytes);
-                fileproto::write_u64le(out, to_unix_seconds(e.modifiedTime));
-            }
-            ++returned;
+        std::uint8_t eflags = e.isDirectory ? 0x01 : 0x00;
+        fileproto::write_u8(out, eflags);
+        fileproto::write_u8(out, nameLen);
+        fileproto::write_bytes(out, name.data(), nameLen);
+
+        if (!compact) {
+            fileproto::write_u64le(out, e.sizeBytes);
+            fileproto::write_u64le(out, to_unix_seconds(e.modifiedTime));
+        }
+        return true;
+    };
+
+    // Unfiltered listings index straight into the snapshot.
+    std::size_t skip = startIndex;
+    std::size_t i = 0;
+    if (!filtering) {
+        i = std::min<std::size_t>(startIndex, total);
+        skip = 0;
+    }
+
+    bool more = false;
+    for (; i < total; ++i) {
+        const auto& e = entry_at(i);
+        const auto name = basename_sv(e.path);
+        if (filtering && !visible(e, name)) {
+            continue;
         }
+        if (skip > 0) {
+            --skip;
+            continue;
+        }
+        if (!append_entry(e, name)) {
+            more = true;
+            break;
+        }
+        ++returned;
     }
 
     const std::size_t entriesLen = out.size() - entriesStart;
-    const bool more = (start + returned < total);
 
     std::uint8_t flags = 0;
     if (more) {
@@ -470,15 +551,22 @@ IOResponse FileDevice::handle_read_file(const IORequest& request)
         return resp;
     }
 
-    auto file = fs->open(resolvedPath, "rb");
+    // Chunked reads continue on the handle the previous chunk left at this
+    // offset, so a whole transfer costs one open.
+    FileHandleCache& handles = _storage.fileHandles();
+    IFile* file = handles.acquire(*fs, resolvedPath, FileHandleCache::Mode::Read, offset);
     if (!file) {
-        resp.status = StatusCode::IOError;
-        return resp;
-    }
+        auto opened = fs->open(resolvedPath, "rb");
+        if (!opened) {
+            resp.status = failure_status(*fs);
+            return resp;
+        }
 
-    if (!file->seek(static_cast<std::uint64_t>(offset))) {
-        resp.status = StatusCode::IOError;
-        return resp;
+        if (!opened->seek(static_cast<std::uint64_t>(offset))) {
+            resp.status = StatusCode::IOError;
+            return resp;
+        }
+        file = handles.insert(*fs, resolvedPath, FileHandleCache::Mode::Read, std::move(opened));
     }
 
     // Response:
@@ -488,8 +576,7 @@ IOResponse FileDevice::handle_read_file(const IORequest& request)
     // u32 offset (echo)
     // u16 dataLen
     // data...
-    std::string out;
-    out.reserve(1 + 1 + 2 + 4 + 2 + maxBytes);
+    fileproto::Writer out(resp.payload, 1 + 1 + 2 + 4 + 2 + maxBytes);
 
     fileproto::write_u8(out, FILEPROTO_VERSION);
     fileproto::write_u8(out, 0); // flags placeholder
@@ -499,16 +586,11 @@ IOResponse FileDevice::handle_read_file(const IORequest& request)
     const std::size_t dataLenPos = out.size();
     fileproto::write_u16le(out, 0); // placeholder
 
-    const std::size_t dataStart = out.size();
-    out.resize(dataStart + maxBytes);
-
-    const std::size_t n = file->read(out.data() + dataStart, maxBytes);
+    // The file is read straight into the response payload.
+    const std::size_t n = file->read(out.reserve_tail(maxBytes), maxBytes);
+    out.commit_tail(n);
 
-    out.resize(dataStart + n);
-
-    // Fill dataLen
-    out[dataLenPos + 0] = static_cast<char>(n & 0xFF);
-    out[dataLenPos + 1] = static_cast<char>((n >> 8) & 0xFF);
+    out.patch_u16le(dataLenPos, static_cast<std::uint16_t>(n));
 
     // Best-effort flags:
     // eof if we couldn't fill the request (n < maxBytes)
@@ -516,9 +598,13 @@ IOResponse FileDevice::handle_read_file(const IORequest& request)
     std::uint8_t flags = 0;
     if (n < maxBytes) flags |= 0x01;       // eof-ish
     if (n == maxBytes) flags |= 0x02;      // truncated-ish (more may exist)
-    out[1] = static_cast<char>(flags);
+    out.patch_u8(1, flags);
+
+    if (n < maxBytes) {
+        // Transfer finished (or failed); don't hold the handle until expiry.
+        handles.invalidate(*fs, resolvedPath, FileHandleCache::Mode::Read);
+    }
 
-    resp.payload.assign(out.begin(), out.end());
     return resp;
 }
 
@@ -555,27 +641,48 @@ IOResponse FileDevice::handle_write_file(const IORequest& request)
         return resp;
     }
 
-    // v1 open mode convention:
-    // offset==0 => create/truncate
-    // offset>0  => open existing read/write (best effort)
-    const char* mode = (offset == 0) ? "wb" : "r+b";
-    auto file = fs->open(resolvedPath, mode);
-    if (!file && offset > 0) {
-        // If file didn't exist, allow creation when offset>0 too.
-        file = fs->open(resolvedPath, "wb");
+    FileHandleCache& handles = _storage.fileHandles();
+
+    // Cached listings of the parent would show a stale size (or miss a new
+    // file). A cached reader of this file would now serve stale data, and a
+    // write at offset 0 starts a new transfer that must truncate.
+    _storage.listings().invalidate(*fs, resolvedPath);
+    handles.invalidate(*fs, resolvedPath, FileHandleCache::Mode::Read);
+    if (offset == 0) {
+        handles.invalidate(*fs, resolvedPath, FileHandleCache::Mode::Write);
     }
+
+    IFile* file = (offset > 0)
+        ? handles.acquire(*fs, resolvedPath, FileHandleCache::Mode::Write, offset)
+        : nullptr;
     if (!file) {
-        resp.status = StatusCode::IOError;
-        return resp;
-    }
+        // v1 open mode convention:
+        // offset==0 => create/truncate
+        // offset>0  => open existing read/write (best effort)
+        const char* mode = (offset == 0) ? "wb" : "r+b";
+        auto opened = fs->open(resolvedPath, mode);
+        if (!opened && offset > 0 && !fs->wouldBlock()) {
+            // If file didn't exist, allow creation when offset>0 too.
+            opened = fs->open(resolvedPath, "wb");
+        }
+        if (!opened) {
+            resp.status = failure_status(*fs);
+            return resp;
+        }
 
-    if (offset > 0 && !file->seek(static_cast<std::uint64_t>(offset))) {
-        resp.status = StatusCode::IOError;
-        return resp;
+        if (offset > 0 && !opened->seek(static_cast<std::uint64_t>(offset))) {
+            resp.status = StatusCode::IOError;
+            return resp;
+        }
+        file = handles.insert(*fs, resolvedPath, FileHandleCache::Mode::Write, std::move(opened));
     }
 
     const std::size_t written = file->write(dataPtr, dataLen);
-    (void)file->flush();
+    // Flush per chunk: the host may never send a "last chunk" marker.
+    const bool flushed = file->flush();
+    if (written != dataLen || !flushed) {
+        handles.invalidate(*fs, resolvedPath, FileHandleCache::Mode::Write);
+    }
 
     // Response:
     // u8 version
@@ -640,8 +747,11 @@ IOResponse FileDevice::handle_make_directory(const IORequest& request)
         }
     }
 
+    // Even a failed mkdir -p may have created some parents.
+    _storage.invalidatePath(*fs, resolvedPath);
+
     if (!ok) {
-        resp.status = StatusCode::IOError;
+        resp.status = failure_status(*fs);
         return resp;
     }
 
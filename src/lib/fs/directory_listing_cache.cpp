@@ -0,0 +1,123 @@
+#include "fujinet/fs/directory_listing_cache.h"
+
+#include <algorithm>
+#include <string_view>
+#include <utility>
+
+namespace fujinet::fs {
+
+namespace {
+
+std::string_view strip_trailing_slash(std::string_view p)
+{
+    while (p.size() > 1 && p.back() == '/') {
+        p.remove_suffix(1);
+    }
+    return p;
+}
+
+bool path_is_under(std::string_view path, std::string_view prefix)
+{
+    path = strip_trailing_slash(path);
+    prefix = strip_trailing_slash(prefix);
+    if (path == prefix || prefix.empty() || prefix == "/") {
+        return true;
+    }
+    return path.size() > prefix.size() && path.compare(0, prefix.size(), prefix) == 0 &&
+           path[prefix.size()] == '/';
+}
+
+std::string_view parent_of(std::string_view path)
+{
+    path = strip_trailing_slash(path);
+    const auto pos = path.find_last_of('/');
+    if (pos == std::string_view::npos) {
+        return {};
+    }
+    return pos == 0 ? path.substr(0, 1) : path.substr(0, pos);
+}
+
+std::string_view basename_of(const std::string& s)
+{
+    const auto pos = s.find_last_of('/');
+    if (pos == std::string::npos || pos + 1 >= s.size()) {
+        return std::string_view{s};
+    }
+    return std::string_view{s}.substr(pos + 1);
+}
+
+} // namespace
+
+std::shared_ptr<const DirectoryListing> DirectoryListingCache::find(
+    const IFileSystem& fs,
+    const std::string& path,
+    std::chrono::steady_clock::time_point now)
+{
+    for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+        if (it->fs != &fs || it->path != path) {
+            continue;
+        }
+        if (now > it->expiresAt) {
+            _entries.erase(it);
+            ++_stats.evictions;
+            break;
+        }
+        ++_stats.hits;
+        it->expiresAt = now + _config.ttl;
+        _entries.splice(_entries.begin(), _entries, it);
+        return _entries.front().listing;
+    }
+    ++_stats.misses;
+    return nullptr;
+}
+
+std::shared_ptr<const DirectoryListing> DirectoryListingCache::insert(
+    const IFileSystem& fs,
+    const std::string& path,
+    std::vector<FileInfo> entries,
+    std::chrono::steady_clock::time_point now)
+{
+    auto listing = std::make_shared<DirectoryListing>();
+    listing->entries = std::move(entries);
+
+    const auto& e = listing->entries;
+    listing->byName.resize(e.size());
+    for (std::uint32_t i = 0; i < listing->byName.size(); ++i) {
+        listing->byName[i] = i;
+    }
+    std::stable_sort(listing->byName.begin(), listing->byName.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return basename_of(e[a].path) < basename_of(e[b].path);
+    });
+
+    _entries.remove_if([&](const Entry& x) { return x.fs == &fs && x.path == path; });
+    while (!_entries.empty() && _entries.size() >= _config.maxEntries) {
+        _entries.pop_back();
+        ++_stats.evictions;
+    }
+
+    _entries.push_front(Entry{&fs, path, listing, now + _config.ttl});
+    return listing;
+}
+
+void DirectoryListingCache::invalidate(const IFileSystem& fs, const std::string& path)
+{
+    const std::string_view parent = parent_of(path);
+    _entries.remove_if([&](const Entry& e) {
+        if (e.fs != &fs) {
+            return false;
+        }
+        const bool hit = path_is_under(e.path, path) ||
+                         (!parent.empty() && strip_trailing_slash(e.path) == parent);
+        if (hit) {
+            ++_stats.invalidations;
+        }
+        return hit;
+    });
+}
+
+void DirectoryListingCache::invalidate(const IFileSystem& fs)
+{
+    _entries.remove_if([&](const Entry& e) { return e.fs == &fs; });
+}
+
+} // namespace fujinet::fs
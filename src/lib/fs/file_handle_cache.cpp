@@ -0,0 +1,102 @@
+#include "fujinet/fs/file_handle_cache.h"
+
+#include <utility>
+
+namespace fujinet::fs {
+
+namespace {
+
+bool path_is_under(const std::string& path, const std::string& prefix)
+{
+    if (path == prefix) {
+        return true;
+    }
+    if (prefix.empty() || prefix == "/") {
+        return true;
+    }
+    const std::size_t n = (prefix.back() == '/') ? prefix.size() - 1 : prefix.size();
+    return path.size() > n && path.compare(0, n, prefix, 0, n) == 0 && path[n] == '/';
+}
+
+} // namespace
+
+FileHandleCache::List::iterator FileHandleCache::find(const IFileSystem& fs, const std::string& path, Mode mode)
+{
+    for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+        if (it->fs == &fs && it->mode == mode && it->path == path) {
+            return it;
+        }
+    }
+    return _entries.end();
+}
+
+IFile* FileHandleCache::acquire(const IFileSystem& fs, const std::string& path, Mode mode, std::uint64_t offset)
+{
+    const auto now = std::chrono::steady_clock::now();
+    expire(now);
+
+    auto it = find(fs, path, mode);
+    if (it == _entries.end()) {
+        ++_stats.misses;
+        return nullptr;
+    }
+
+    if (it->file->tell() != offset && !it->file->seek(offset)) {
+        _entries.erase(it);
+        ++_stats.misses;
+        return nullptr;
+    }
+
+    ++_stats.hits;
+    it->lastUsed = now;
+    _entries.splice(_entries.begin(), _entries, it);
+    return _entries.front().file.get();
+}
+
+IFile* FileHandleCache::insert(const IFileSystem& fs, const std::string& path, Mode mode, std::unique_ptr<IFile> file)
+{
+    if (!file) {
+        return nullptr;
+    }
+
+    auto existing = find(fs, path, mode);
+    if (existing != _entries.end()) {
+        _entries.erase(existing);
+    }
+
+    while (!_entries.empty() && _entries.size() >= _config.maxEntries) {
+        _entries.pop_back();
+        ++_stats.evictions;
+    }
+
+    _entries.push_front(Entry{&fs, path, mode, std::move(file), std::chrono::steady_clock::now()});
+    return _entries.front().file.get();
+}
+
+void FileHandleCache::invalidate(const IFileSystem& fs, const std::string& path)
+{
+    _entries.remove_if([&](const Entry& e) { return e.fs == &fs && path_is_under(e.path, path); });
+}
+
+void FileHandleCache::invalidate(const IFileSystem& fs, const std::string& path, Mode mode)
+{
+    auto it = find(fs, path, mode);
+    if (it != _entries.end()) {
+        _entries.erase(it);
+    }
+}
+
+void FileHandleCache::invalidate(const IFileSystem& fs)
+{
+    _entries.remove_if([&](const Entry& e) { return e.fs == &fs; });
+}
+
+void FileHandleCache::expire(std::chrono::steady_clock::time_point now)
+{
+    while (!_entries.empty() && now - _entries.back().lastUsed > _config.idleTimeout) {
+        _entries.pop_back();
+        ++_stats.evictions;
+    }
+}
+
+} // namespace fujinet::fs
@@ -10,7 +10,10 @@
 #include <cstdint>
 #include <cstring>
 #include <limits>
+#include <list>
 #include <memory>
+#include <optional>
+#include <string>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -21,6 +24,11 @@ static constexpr const char* TAG = "http_fs";
 static constexpr auto kHttpWaitTimeout = std::chrono::seconds(15);
 static constexpr auto kHttpPollInterval = std::chrono::milliseconds(5);
 
+// HttpFile range cache: 8 x 4 KiB blocks, up to 4 blocks per request.
+static constexpr std::uint64_t kRangeBlockSize = 4096;
+static constexpr std::size_t kRangeCacheBlocks = 8;
+static constexpr std::uint64_t kRangeMaxSpanBlocks = 4;
+
 namespace {
 
 std::string to_lower_ascii(std::string_view value)
@@ -77,27 +85,267 @@ bool parse_http_uri(const std::string& path, ParsedHttpUri& out)
 
 struct HttpTransferResult {
     io::NetworkInfo info{};
-    std::vector<std::uint8_t> body;
+    std::uint64_t bodyBytes{0};
 };
 
+using HeaderList = std::vector<std::pair<std::string, std::string>>;
+
+std::unique_ptr<io::INetworkProtocol> start_request(const HttpProtocolFactory& factory,
+                                                    const ParsedHttpUri& uri,
+                                                    std::uint8_t method,
+                                                    HeaderList headers = {},
+                                                    std::vector<std::string> responseHeaders = {})
+{
+    auto protocol = factory(uri.schemeLower);
+    if (!protocol) {
+        FN_LOGE(TAG, "No HTTP protocol registered for scheme '%s'", uri.schemeLower.c_str());
+        return nullptr;
+    }
+
+    io::NetworkOpenRequest req{};
+    req.method = method;
+    req.url = uri.uri;
+    req.headers = std::move(headers);
+    req.responseHeaderNamesLower = std::move(responseHeaders);
+
+    if (protocol->open(req) != io::StatusCode::Ok) {
+        FN_LOGE(TAG, "HTTP open failed for '%s'", uri.uri.c_str());
+        return nullptr;
+    }
+    return protocol;
+}
+
+bool wait_for_info(io::INetworkProtocol& protocol, io::NetworkInfo& outInfo)
+{
+    const auto deadline = std::chrono::steady_clock::now() + kHttpWaitTimeout;
+    while (true) {
+        protocol.poll();
+
+        io::NetworkInfo info{};
+        const io::StatusCode status = protocol.info(info);
+        if (status == io::StatusCode::Ok) {
+            outInfo = std::move(info);
+            return true;
+        }
+        if (status != io::StatusCode::NotReady) {
+            return false;
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline) {
+            FN_LOGE(TAG, "Timed out waiting for HTTP metadata");
+            return false;
+        }
+
+        std::this_thread::sleep_for(kHttpPollInterval);
+    }
+}
+
+// Read up to `len` body bytes starting at `offset` (the protocol's next
+// sequential position). `dst` may be null to discard. Stops early at EOF.
+bool read_body_bytes(io::INetworkProtocol& protocol,
+                     std::uint32_t& offset,
+                     std::uint8_t* dst,
+                     std::size_t len,
+                     std::size_t& got,
+                     bool& eof)
+{
+    got = 0;
+    eof = false;
+
+    std::array<std::uint8_t, 1024> scratch{};
+    auto deadline = std::chrono::steady_clock::now() + kHttpWaitTimeout;
+
+    while (got < len) {
+        protocol.poll();
+
+        std::uint8_t* out = dst ? dst + got : scratch.data();
+        const std::size_t room = dst ? std::min<std::size_t>(len - got, 0xFFFFU)
+                                     : std::min(len - got, scratch.size());
+
+        std::uint16_t read = 0;
+        bool more_available = false;
+        const io::StatusCode status = protocol.read_body(offset, out, room, read, eof, more_available);
+        if (status == io::StatusCode::Ok) {
+            if (read > 0) {
+                if (offset > std::numeric_limits<std::uint32_t>::max() - read) {
+                    FN_LOGE(TAG, "HTTP body exceeds supported size");
+                    return false;
+                }
+                offset += read;
+                got += read;
+                deadline = std::chrono::steady_clock::now() + kHttpWaitTimeout;
+            }
+            if (eof) {
+                return true;
+            }
+            continue;
+        }
+
+        if (status != io::StatusCode::NotReady) {
+            return false;
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline) {
+            FN_LOGE(TAG, "Timed out reading HTTP body");
+            return false;
+        }
+
+        std::this_thread::sleep_for(kHttpPollInterval);
+    }
+    return true;
+}
+
+// Value of `nameLower` in a "Key: Value\r\n" block, without surrounding spaces.
+std::optional<std::string_view> find_header(std::string_view block, std::string_view nameLower)
+{
+    while (!block.empty()) {
+        const std::size_t eol = block.find('\n');
+        std::string_view line = block.substr(0, eol);
+        block = (eol == std::string_view::npos) ? std::string_view{} : block.substr(eol + 1);
+
+        const std::size_t colon = line.find(':');
+        if (colon == std::string_view::npos || to_lower_ascii(line.substr(0, colon)) != nameLower) {
+            continue;
+        }
+        std::string_view value = line.substr(colon + 1);
+        while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) value.remove_prefix(1);
+        while (!value.empty() && (value.back() == '\r' || value.back() == ' ' || value.back() == '\t')) value.remove_suffix(1);
+        return value;
+    }
+    return std::nullopt;
+}
+
+bool parse_u64(std::string_view s, std::uint64_t& out)
+{
+    if (s.empty()) {
+        return false;
+    }
+    out = 0;
+    for (char c : s) {
+        if (c < '0' || c > '9' || out > (std::numeric_limits<std::uint64_t>::max() - 9U) / 10U) {
+            return false;
+        }
+        out = out * 10U + static_cast<std::uint64_t>(c - '0');
+    }
+    return true;
+}
+
+// "bytes <first>-<last>/<total>"; an unknown total ("*") is rejected.
+bool parse_content_range(std::string_view value, std::uint64_t& first, std::uint64_t& total)
+{
+    constexpr std::string_view kUnit = "bytes ";
+    if (value.substr(0, kUnit.size()) != kUnit) {
+        return false;
+    }
+    value.remove_prefix(kUnit.size());
+
+    const std::size_t dash = value.find('-');
+    const std::size_t slash = value.find('/');
+    if (dash == std::string_view::npos || slash == std::string_view::npos || slash < dash) {
+        return false;
+    }
+    return parse_u64(value.substr(0, dash), first) && parse_u64(value.substr(slash + 1), total);
+}
+
+std::string range_header(std::uint64_t first, std::uint64_t last)
+{
+    return "bytes=" + std::to_string(first) + "-" + std::to_string(last);
+}
+
 } // namespace
 
+// Read-only view of an HTTP resource that downloads only what is read.
+//
+// open() sends one GET for the first block with a Range header. If the server
+// answers 206, the file works in range mode: reads are served from an LRU of
+// fixed-size blocks, and misses are fetched with further Range requests.
+// Sequential reads widen each request to several blocks. A 200 reply means
+// the server ignores ranges (no Accept-Ranges support). The file then
+// streams that response: forward seeks skip bytes, and backward seeks
+// restart the GET. Either way only a bounded amount of the body is in RAM.
 class HttpFile final : public IFile {
 public:
-    explicit HttpFile(std::vector<std::uint8_t> data)
-        : _data(std::move(data))
+    HttpFile(const HttpProtocolFactory& factory, ParsedHttpUri uri)
+        : _factory(factory)
+        , _uri(std::move(uri))
     {
     }
 
+    ~HttpFile() override { close_stream(); }
+
+    bool open()
+    {
+        auto protocol = start_request(_factory, _uri, kMethodGet,
+                                      {{"Range", range_header(0, kRangeBlockSize - 1)}},
+                                      {"content-range"});
+        if (!protocol) {
+            return false;
+        }
+
+        io::NetworkInfo info{};
+        if (!wait_for_info(*protocol, info) || !info.hasHttpStatus) {
+            protocol->close();
+            return false;
+        }
+
+        std::uint64_t first = 0;
+        std::uint64_t total = 0;
+        const auto contentRange = find_header(info.headersBlock, "content-range");
+
+        if (info.httpStatus == 206 && contentRange &&
+            parse_content_range(*contentRange, first, total) && first == 0) {
+            _ranged = true;
+            _size = total;
+            Block block{0, {}};
+            const bool ok = read_block_body(*protocol, std::min<std::uint64_t>(total, kRangeBlockSize), block.data);
+            protocol->close();
+            if (!ok) {
+                return false;
+            }
+            _blocks.push_front(std::move(block));
+            return true;
+        }
+
+        if (info.httpStatus == 416) {
+            // Range not satisfiable for byte 0: the resource is empty.
+            protocol->close();
+            _ranged = true;
+            _size = 0;
+            return true;
+        }
+
+        if (!is_success_http_status(info.httpStatus)) {
+            FN_LOGW(TAG, "HTTP request rejected: url='%s' status=%u",
+                    _uri.uri.c_str(), static_cast<unsigned>(info.httpStatus));
+            protocol->close();
+            return false;
+        }
+
+        FN_LOGI(TAG, "No byte ranges from '%s'; streaming", _uri.uri.c_str());
+        _ranged = false;
+        if (info.hasContentLength) {
+            _size = info.contentLength;
+        }
+        _stream = std::move(protocol);
+        _streamPos = 0;
+        return true;
+    }
+
     std::size_t read(void* dst, std::size_t maxBytes) override
     {
-        if (!dst || maxBytes == 0 || _position >= _data.size()) {
+        if (!dst || maxBytes == 0) {
             return 0;
         }
+        if (_size && _position >= *_size) {
+            return 0;
+        }
+        if (_size) {
+            maxBytes = static_cast<std::size_t>(std::min<std::uint64_t>(maxBytes, *_size - _position));
+        }
 
-        const std::size_t remaining = _data.size() - _position;
-        const std::size_t n = std::min(maxBytes, remaining);
-        std::memcpy(dst, _data.data() + _position, n);
+        const std::size_t n = _ranged
+            ? read_ranged(static_cast<std::uint8_t*>(dst), maxBytes)
+            : read_streamed(static_cast<std::uint8_t*>(dst), maxBytes);
         _position += n;
         return n;
     }
@@ -109,10 +357,10 @@ public:
 
     bool seek(std::uint64_t offset) override
     {
-        if (offset > _data.size()) {
+        if (_size && offset > *_size) {
             return false;
         }
-        _position = static_cast<std::size_t>(offset);
+        _position = offset;
         return true;
     }
 
@@ -127,8 +375,184 @@ public:
     }
 
 private:
-    std::vector<std::uint8_t> _data;
-    std::size_t _position{0};
+    static constexpr std::uint8_t kMethodGet = 1;
+
+    struct Block {
+        std::uint64_t index;
+        std::vector<std::uint8_t> data;
+    };
+
+    static bool read_block_body(io::INetworkProtocol& protocol, std::uint64_t len, std::vector<std::uint8_t>& out)
+    {
+        out.resize(static_cast<std::size_t>(len));
+        std::uint32_t offset = 0;
+        std::size_t got = 0;
+        bool eof = false;
+        if (!read_body_bytes(protocol, offset, out.data(), out.size(), got, eof)) {
+            return false;
+        }
+        out.resize(got);
+        return got == len;
+    }
+
+    const Block* find_block(std::uint64_t index)
+    {
+        for (auto it = _blocks.begin(); it != _blocks.end(); ++it) {
+            if (it->index == index) {
+                _blocks.splice(_blocks.begin(), _blocks, it);
+                return &_blocks.front();
+            }
+        }
+        return nullptr;
+    }
+
+    // Fetch blocks [first, first+count) with one Range request.
+    bool fetch_blocks(std::uint64_t first, std::uint64_t count)
+    {
+        const std::uint64_t size = *_size;
+        const std::uint64_t begin = first * kRangeBlockSize;
+        const std::uint64_t end = std::min(size, (first + count) * kRangeBlockSize);
+        if (begin >= end) {
+            return false;
+        }
+
+        auto protocol = start_request(_factory, _uri, kMethodGet,
+                                      {{"Range", range_header(begin, end - 1)}},
+                                      {"content-range"});
+        if (!protocol) {
+            return false;
+        }
+
+        io::NetworkInfo info{};
+        std::uint64_t rangeFirst = 0;
+        std::uint64_t total = 0;
+        if (!wait_for_info(*protocol, info) || info.httpStatus != 206) {
+            FN_LOGW(TAG, "Range request failed: url='%s' status=%u",
+                    _uri.uri.c_str(), static_cast<unsigned>(info.httpStatus));
+            protocol->close();
+            return false;
+        }
+        const auto contentRange = find_header(info.headersBlock, "content-range");
+        if (!contentRange || !parse_content_range(*contentRange, rangeFirst, total) || rangeFirst != begin) {
+            protocol->close();
+            return false;
+        }
+
+        std::uint32_t offset = 0;
+        bool ok = true;
+        for (std::uint64_t index = first; ok && index < first + count; ++index) {
+            const std::uint64_t blockBegin = index * kRangeBlockSize;
+            if (blockBegin >= end) {
+                break;
+            }
+            Block block{index, {}};
+            block.data.resize(static_cast<std::size_t>(std::min<std::uint64_t>(kRangeBlockSize, end - blockBegin)));
+            std::size_t got = 0;
+            bool eof = false;
+            ok = read_body_bytes(*protocol, offset, block.data.data(), block.data.size(), got, eof) &&
+                 got == block.data.size();
+            if (ok) {
+                if (_blocks.size() >= kRangeCacheBlocks) {
+                    _blocks.pop_back();
+                }
+                _blocks.push_front(std::move(block));
+            }
+        }
+        protocol->close();
+        return ok;
+    }
+
+    std::size_t read_ranged(std::uint8_t* dst, std::size_t maxBytes)
+    {
+        std::size_t copied = 0;
+        while (copied < maxBytes) {
+            const std::uint64_t pos = _position + copied;
+            const std::uint64_t index = pos / kRangeBlockSize;
+
+            const Block* block = find_block(index);
+            if (!block) {
+                // Widen the request while the caller keeps reading sequentially.
+                _sequential = (index == _lastFetched + 1) ? std::min(_sequential * 2, kRangeMaxSpanBlocks) : 1;
+                if (!fetch_blocks(index, _sequential)) {
+                    break;
+                }
+                _lastFetched = index + _sequential - 1;
+                block = find_block(index);
+                if (!block) {
+                    break;
+                }
+            }
+
+            const std::size_t inBlock = static_cast<std::size_t>(pos - index * kRangeBlockSize);
+            if (inBlock >= block->data.size()) {
+                break;
+            }
+            const std::size_t n = std::min(maxBytes - copied, block->data.size() - inBlock);
+            std::memcpy(dst + copied, block->data.data() + inBlock, n);
+            copied += n;
+        }
+        return copied;
+    }
+
+    std::size_t read_streamed(std::uint8_t* dst, std::size_t maxBytes)
+    {
+        if (_stream && _position < _streamPos) {
+            close_stream();
+        }
+        if (!_stream) {
+            _stream = start_request(_factory, _uri, kMethodGet);
+            _streamPos = 0;
+            io::NetworkInfo info{};
+            if (!_stream || !wait_for_info(*_stream, info) || !is_success_http_status(info.httpStatus)) {
+                close_stream();
+                return 0;
+            }
+        }
+
+        std::size_t got = 0;
+        bool eof = false;
+        if (_position > _streamPos) {
+            const std::uint64_t skip = _position - _streamPos;
+            if (skip > std::numeric_limits<std::uint32_t>::max() ||
+                !read_body_bytes(*_stream, _streamPos, nullptr, static_cast<std::size_t>(skip), got, eof) ||
+                _streamPos != _position) {
+                return 0;
+            }
+        }
+
+        if (!read_body_bytes(*_stream, _streamPos, dst, maxBytes, got, eof)) {
+            close_stream();
+            return 0;
+        }
+        if (eof && !_size) {
+            _size = _streamPos;
+        }
+        return got;
+    }
+
+    void close_stream()
+    {
+        if (_stream) {
+            _stream->close();
+            _stream.reset();
+        }
+        _streamPos = 0;
+    }
+
+    HttpProtocolFactory _factory;
+    ParsedHttpUri _uri;
+    std::optional<std::uint64_t> _size;
+    std::uint64_t _position{0};
+
+    // Range mode
+    bool _ranged{false};
+    std::list<Block> _blocks; // front = most recently used
+    std::uint64_t _lastFetched{0};
+    std::uint64_t _sequential{1};
+
+    // Streaming mode
+    std::unique_ptr<io::INetworkProtocol> _stream;
+    std::uint32_t _streamPos{0};
 };
 
 class HttpFileSystem final : public IFileSystem {
@@ -192,12 +616,17 @@ public:
             return nullptr;
         }
 
-        HttpTransferResult result{};
-        if (!perform_get(path, result)) {
+        ParsedHttpUri parsed{};
+        if (!parse_http_uri(path, parsed)) {
+            FN_LOGE(TAG, "Invalid HTTP URL: %s", path.c_str());
             return nullptr;
         }
 
-        return std::make_unique<HttpFile>(std::move(result.body));
+        auto file = std::make_unique<HttpFile>(_protocolFactory, std::move(parsed));
+        if (!file->open()) {
+            return nullptr;
+        }
+        return file;
     }
 
     bool stat(const std::string& path, FileInfo& outInfo) override
@@ -219,7 +648,7 @@ public:
         outInfo.isDirectory = false;
         outInfo.sizeBytes = result.info.hasContentLength
             ? result.info.contentLength
-            : static_cast<std::uint64_t>(result.body.size());
+            : result.bodyBytes;
         return true;
     }
 
@@ -256,26 +685,22 @@ private:
             return false;
         }
 
-        auto protocol = _protocolFactory(parsed.schemeLower);
+        auto protocol = start_request(_protocolFactory, parsed, method);
         if (!protocol) {
-            FN_LOGE(TAG, "No HTTP protocol registered for scheme '%s'", parsed.schemeLower.c_str());
             return false;
         }
 
-        io::NetworkOpenRequest req{};
-        req.method = method;
-        req.url = parsed.uri;
-
-        const io::StatusCode openStatus = protocol->open(req);
-        if (openStatus != io::StatusCode::Ok) {
-            FN_LOGE(TAG, "HTTP open failed for '%s'", parsed.uri.c_str());
-            return false;
+        // A body is only read to measure it (no Content-Length); it is
+        // discarded as it arrives.
+        bool ok = true;
+        if (readBody) {
+            std::uint32_t offset = 0;
+            std::size_t got = 0;
+            bool eof = false;
+            ok = read_body_bytes(*protocol, offset, nullptr, std::numeric_limits<std::uint32_t>::max(), got, eof);
+            out.bodyBytes = offset;
         }
 
-        bool ok = readBody
-            ? read_response_body(*protocol, out.body)
-            : wait_for_info(*protocol, out.info);
-
         if (!ok) {
             protocol->close();
             return false;
@@ -298,86 +723,12 @@ private:
 
         if (readBody && !out.info.hasContentLength) {
             out.info.hasContentLength = true;
-            out.info.contentLength = static_cast<std::uint64_t>(out.body.size());
+            out.info.contentLength = out.bodyBytes;
         }
 
         return true;
     }
 
-    static bool wait_for_info(io::INetworkProtocol& protocol, io::NetworkInfo& outInfo)
-    {
-        const auto deadline = std::chrono::steady_clock::now() + kHttpWaitTimeout;
-        while (true) {
-            protocol.poll();
-
-            io::NetworkInfo info{};
-            const io::StatusCode status = protocol.info(info);
-            if (status == io::StatusCode::Ok) {
-                outInfo = std::move(info);
-                return true;
-            }
-            if (status != io::StatusCode::NotReady) {
-                return false;
-            }
-
-            if (std::chrono::steady_clock::now() >= deadline) {
-                FN_LOGE(TAG, "Timed out waiting for HTTP metadata");
-                return false;
-            }
-
-            std::this_thread::sleep_for(kHttpPollInterval);
-        }
-    }
-
-    static bool read_response_body(io::INetworkProtocol& protocol, std::vector<std::uint8_t>& outBody)
-    {
-        outBody.clear();
-
-        std::array<std::uint8_t, 1024> buffer{};
-        std::uint32_t offset = 0;
-        const auto deadline = std::chrono::steady_clock::now() + kHttpWaitTimeout;
-
-        while (true) {
-            protocol.poll();
-
-            std::uint16_t read = 0;
-            bool eof = false;
-            bool more_available = false;
-            const io::StatusCode status = protocol.read_body(offset,
-                                                             buffer.data(),
-                                                             buffer.size(),
-                                                             read,
-                                                             eof,
-                                                             more_available);
-            if (status == io::StatusCode::Ok) {
-                if (read > 0) {
-                    outBody.insert(outBody.end(), buffer.begin(), buffer.begin() + read);
-                    if (offset > std::numeric_limits<std::uint32_t>::max() - read) {
-                        FN_LOGE(TAG, "HTTP body exceeds supported size");
-                        return false;
-                    }
-                    offset += read;
-                }
-
-                if (eof) {
-                    return true;
-                }
-                continue;
-            }
-
-            if (status != io::StatusCode::NotReady) {
-                return false;
-            }
-
-            if (std::chrono::steady_clock::now() >= deadline) {
-                FN_LOGE(TAG, "Timed out reading HTTP body");
-                return false;
-            }
-
-            std::this_thread::sleep_for(kHttpPollInterval);
-        }
-    }
-
     HttpProtocolFactory _protocolFactory;
 };
 
@@ -0,0 +1,857 @@
+#include "fujinet/fs/metadata_index.h"
+
+#include "fujinet/core/logging.h"
+
+#include <charconv>
+#include <list>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace fujinet::fs {
+
+static constexpr const char* TAG = "fs";
+
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+using WallClock = std::chrono::system_clock;
+
+constexpr std::string_view kStoreVersion = "fnidx1";
+
+std::string_view strip_trailing_slash(std::string_view p)
+{
+    while (p.size() > 1 && p.back() == '/') {
+        p.remove_suffix(1);
+    }
+    return p;
+}
+
+// Length of a "scheme://authority" prefix (TNFS/HTTP paths), 0 for plain paths.
+std::size_t root_len(std::string_view p)
+{
+    const auto sep = p.find("://");
+    if (sep == std::string_view::npos) {
+        return 0;
+    }
+    const auto slash = p.find('/', sep + 3);
+    return slash == std::string_view::npos ? p.size() : slash;
+}
+
+std::string key_of(const std::string& path)
+{
+    const auto p = strip_trailing_slash(path);
+    return p.empty() ? std::string("/") : std::string(p);
+}
+
+// Parent directory key of `key` and the basename within it. No parent for
+// roots, relative paths, or URLs with a query/fragment.
+std::optional<std::string> parent_key(std::string_view key, std::string_view& base)
+{
+    if (key == "/" || key.find_first_of("?#") != std::string_view::npos) {
+        return std::nullopt;
+    }
+    const auto root = root_len(key);
+    const auto pos = key.find_last_of('/');
+    if (pos == std::string_view::npos || pos < root || pos + 1 >= key.size()) {
+        return std::nullopt;
+    }
+    base = key.substr(pos + 1);
+    if (pos == root) {
+        return root == 0 ? std::string("/") : std::string(key.substr(0, root));
+    }
+    return std::string(key.substr(0, pos));
+}
+
+// Path to hand the inner filesystem for a directory key ("tnfs://h" -> "tnfs://h/").
+std::string dir_path(const std::string& key)
+{
+    const auto root = root_len(key);
+    return (root != 0 && root == key.size()) ? key + "/" : key;
+}
+
+std::string join(const std::string& key, std::string_view name)
+{
+    std::string out = dir_path(key);
+    if (out.empty() || out.back() != '/') {
+        out += '/';
+    }
+    out.append(name);
+    return out;
+}
+
+bool path_is_under(std::string_view path, std::string_view prefix)
+{
+    if (path == prefix || prefix == "/") {
+        return true;
+    }
+    return path.size() > prefix.size() && path.compare(0, prefix.size(), prefix) == 0 &&
+           path[prefix.size()] == '/';
+}
+
+std::string_view basename_of(std::string_view path)
+{
+    path = strip_trailing_slash(path);
+    const auto pos = path.find_last_of('/');
+    return pos == std::string_view::npos ? path : path.substr(pos + 1);
+}
+
+std::int64_t to_seconds(WallClock::time_point t)
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(t.time_since_epoch()).count();
+}
+
+bool writes(const char* mode)
+{
+    if (!mode) {
+        return false;
+    }
+    const std::string_view m(mode);
+    return m.find_first_of("wa+") != std::string_view::npos;
+}
+
+bool storable(std::string_view s)
+{
+    return s.find_first_of("\t\r\n") == std::string_view::npos;
+}
+
+template <typename T>
+bool parse_int(std::string_view s, T& out)
+{
+    auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), out);
+    return ec == std::errc{} && ptr == s.data() + s.size();
+}
+
+// Split a tab-separated line into exactly `n` fields (the last takes the rest).
+template <std::size_t N>
+bool split_fields(std::string_view line, std::string_view (&out)[N])
+{
+    for (std::size_t i = 0; i + 1 < N; ++i) {
+        const auto tab = line.find('\t');
+        if (tab == std::string_view::npos) {
+            return false;
+        }
+        out[i] = line.substr(0, tab);
+        line.remove_prefix(tab + 1);
+    }
+    out[N - 1] = line;
+    return true;
+}
+
+// A directory's entries in the order the filesystem listed them (new names
+// are appended), so a cached listing pages exactly like a fresh one.
+class DirEntries {
+public:
+    const FileInfo* find(std::string_view name) const
+    {
+        auto it = _index.find(std::string(name));
+        return it == _index.end() ? nullptr : &_items[it->second].second;
+    }
+
+    void set(std::string_view name, FileInfo info)
+    {
+        auto [it, inserted] = _index.emplace(std::string(name), _items.size());
+        if (inserted) {
+            _items.emplace_back(it->first, std::move(info));
+        } else {
+            _items[it->second].second = std::move(info);
+        }
+    }
+
+    void erase(std::string_view name)
+    {
+        auto it = _index.find(std::string(name));
+        if (it == _index.end()) {
+            return;
+        }
+        const std::size_t pos = it->second;
+        _index.erase(it);
+        _items.erase(_items.begin() + static_cast<std::ptrdiff_t>(pos));
+        for (auto& [key, i] : _index) {
+            if (i > pos) {
+                --i;
+            }
+        }
+    }
+
+    std::size_t size() const { return _items.size(); }
+    auto begin() const { return _items.begin(); }
+    auto end() const { return _items.end(); }
+
+private:
+    std::vector<std::pair<std::string, FileInfo>> _items;
+    std::unordered_map<std::string, std::size_t> _index; // name -> position in _items
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// State (shared with files opened for writing so they can report on close)
+// ---------------------------------------------------------------------------
+
+struct IndexedFileSystem::State {
+    struct Directory {
+        std::string key;
+        DirEntries entries;
+        bool complete{false};     // a full listing, not just remembered stat() results
+        bool racy{false};         // listed within mtimeGranularity of its mtime
+        std::int64_t dirMtime{0}; // seconds since epoch; 0 = unknown
+        std::optional<SteadyClock::time_point> builtAt;   // unset when loaded from the store
+        std::optional<SteadyClock::time_point> checkedAt;
+    };
+
+    using List = std::list<Directory>; // front = most recently used
+
+    std::unique_ptr<IFileSystem> inner;
+    MetadataIndexConfig config;
+    MetadataIndexStats stats;
+
+    List dirs;
+    std::unordered_map<std::string, List::iterator> byKey;
+    std::unordered_map<std::string, unsigned> openWriters; // parent key -> files open for writing
+    std::unordered_set<std::string> persistedKeys;         // directories in the store file
+
+    bool dirty{false};    // the store is behind memory
+    bool mustSave{false}; // ... and something in it is now wrong
+    SteadyClock::time_point dirtySince{};
+
+    State(std::unique_ptr<IFileSystem> fs, MetadataIndexConfig cfg)
+        : inner(std::move(fs)), config(std::move(cfg))
+    {
+        if (config.maxDirectories == 0) {
+            config.maxDirectories = 1;
+        }
+    }
+
+    Directory* find(const std::string& key)
+    {
+        auto it = byKey.find(key);
+        if (it == byKey.end()) {
+            return nullptr;
+        }
+        dirs.splice(dirs.begin(), dirs, it->second);
+        return &*it->second;
+    }
+
+    Directory& emplace(const std::string& key)
+    {
+        drop(key);
+        dirs.push_front(Directory{});
+        dirs.front().key = key;
+        byKey.emplace(key, dirs.begin());
+        while (dirs.size() > config.maxDirectories) {
+            byKey.erase(dirs.back().key);
+            dirs.pop_back();
+            ++stats.evictions;
+        }
+        return dirs.front();
+    }
+
+    void drop(const std::string& key)
+    {
+        auto it = byKey.find(key);
+        if (it == byKey.end()) {
+            return;
+        }
+        dirs.erase(it->second);
+        byKey.erase(it);
+        if (persistedKeys.count(key) != 0) {
+            mark_dirty(SteadyClock::now(), true);
+        }
+    }
+
+    void drop_subtree(const std::string& key)
+    {
+        for (auto it = dirs.begin(); it != dirs.end();) {
+            if (path_is_under(it->key, key)) {
+                if (persistedKeys.count(it->key) != 0) {
+                    mark_dirty(SteadyClock::now(), true);
+                }
+                byKey.erase(it->key);
+                it = dirs.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void mark_dirty(SteadyClock::time_point now, bool urgent)
+    {
+        if (!config.persist) {
+            return;
+        }
+        if (!dirty) {
+            dirty = true;
+            dirtySince = now;
+        }
+        mustSave = mustSave || urgent;
+    }
+
+    bool is_racy(std::int64_t dirMtime, WallClock::time_point listedAt) const
+    {
+        if (dirMtime == 0) {
+            return false;
+        }
+        return listedAt - WallClock::time_point{std::chrono::seconds(dirMtime)} < config.mtimeGranularity;
+    }
+
+    // Inside trustWindow/maxAge: usable without asking the filesystem.
+    bool trusted(const Directory& d, SteadyClock::time_point now) const
+    {
+        if (d.checkedAt && now - *d.checkedAt < config.trustWindow) {
+            return true;
+        }
+        return config.maxAge.count() > 0 && d.builtAt && now - *d.builtAt < config.maxAge;
+    }
+
+    // May `d` be used as-is? Stats the directory only when neither window applies.
+    bool usable(Directory& d, SteadyClock::time_point now)
+    {
+        if (trusted(d, now)) {
+            return true;
+        }
+        if (!d.complete || d.racy || d.dirMtime == 0) {
+            return false;
+        }
+        FileInfo info{};
+        if (!inner->stat(dir_path(d.key), info) || !info.isDirectory ||
+            to_seconds(info.modifiedTime) != d.dirMtime) {
+            return false;
+        }
+        d.checkedAt = now;
+        ++stats.revalidations;
+        return true;
+    }
+
+    // Index-only lookup; a miss says nothing about whether `path` exists.
+    //
+    // With `trustedOnly`, a record outside trustWindow/maxAge is a miss
+    // rather than revalidated: the directory mtime says nothing about a file
+    // rewritten in place, and a directory stat costs as much as statting
+    // the file itself.
+    bool lookup(const std::string& path, FileInfo& out, bool trustedOnly = false)
+    {
+        const std::string key = key_of(path);
+        std::string_view base;
+        const auto parent = parent_key(key, base);
+        if (!parent) {
+            return false;
+        }
+        Directory* d = find(*parent);
+        if (!d) {
+            return false;
+        }
+        const auto now = SteadyClock::now();
+        if (trustedOnly) {
+            if (!trusted(*d, now)) {
+                return false;
+            }
+        } else if (!usable(*d, now)) {
+            drop(*parent);
+            ++stats.staleDirectories;
+            return false;
+        }
+        const FileInfo* found = d->entries.find(base);
+        if (!found) {
+            return false;
+        }
+        out = *found;
+        out.path = path;
+        return true;
+    }
+
+    // A stat() that went to the filesystem. Patch the parent's record, which
+    // may hold an older size or mtime, and remember the result if records
+    // may be partial.
+    void remember(const std::string& path, const FileInfo& info)
+    {
+        const std::string key = key_of(path);
+        std::string_view base;
+        const auto parent = parent_key(key, base);
+        if (!parent) {
+            return;
+        }
+        Directory* d = find(*parent);
+        if (!d) {
+            if (config.maxAge.count() <= 0) {
+                return;
+            }
+            d = &emplace(*parent);
+            d->builtAt = SteadyClock::now();
+        }
+        if (!d->complete) {
+            d->entries.set(base, info);
+            return;
+        }
+
+        // A complete listing only has its own entries patched; adding one
+        // here could duplicate a name that differs only in case.
+        const FileInfo* old = d->entries.find(base);
+        if (!old || (old->isDirectory == info.isDirectory && old->sizeBytes == info.sizeBytes &&
+                     old->modifiedTime == info.modifiedTime)) {
+            return;
+        }
+        FileInfo patched = info;
+        patched.path = old->path;
+        d->entries.set(base, std::move(patched));
+        if (persistable(*d, store_dir())) {
+            mark_dirty(SteadyClock::now(), false);
+        }
+    }
+
+    // `path` was created, written, removed or renamed through this filesystem.
+    //
+    // The parent's record is patched and its mtime re-read, so our own
+    // change does not force a relist. (This would also absorb a concurrent
+    // change by someone else; network records are bounded by maxAge anyway.)
+    void note_changed(const std::string& path, bool removed)
+    {
+        const auto now = SteadyClock::now();
+        const std::string key = key_of(path);
+        std::string_view base;
+        const auto parent = parent_key(key, base);
+        if (!parent) {
+            return;
+        }
+        // Only a directory already in the store is now wrong on disk; anything
+        // else can wait for saveDelay like a fresh listing.
+        const bool persisted = persistedKeys.count(*parent) != 0;
+        if (persisted) {
+            mark_dirty(now, true);
+        }
+        Directory* d = find(*parent);
+        if (!d) {
+            return;
+        }
+
+        FileInfo info{};
+        if (!removed && inner->stat(path, info)) {
+            d->entries.set(base, std::move(info));
+        } else {
+            d->entries.erase(base);
+        }
+
+        if (d->complete) {
+            FileInfo dirInfo{};
+            const auto wallNow = WallClock::now();
+            if (!inner->stat(dir_path(*parent), dirInfo)) {
+                drop(*parent);
+                return;
+            }
+            d->dirMtime = to_seconds(dirInfo.modifiedTime);
+            d->racy = is_racy(d->dirMtime, wallNow);
+            d->checkedAt = now;
+        }
+        if (!persisted && persistable(*d, store_dir())) {
+            mark_dirty(now, false);
+        }
+    }
+
+    void writer_opened(const std::string& parent)
+    {
+        if (openWriters[parent]++ == 0 && persistedKeys.count(parent) != 0) {
+            mark_dirty(SteadyClock::now(), true); // take it out of the store while open
+        }
+    }
+
+    void writer_closed(const std::string& path, const std::string& parent)
+    {
+        auto it = openWriters.find(parent);
+        if (it != openWriters.end() && --it->second == 0) {
+            openWriters.erase(it);
+        }
+        note_changed(path, false);
+        maybe_save(SteadyClock::now());
+    }
+
+    void maybe_save(SteadyClock::time_point now)
+    {
+        if (dirty && (mustSave || now - dirtySince >= config.saveDelay)) {
+            save();
+        }
+    }
+
+    std::string store_dir() const
+    {
+        std::string_view base;
+        return parent_key(key_of(config.storePath), base).value_or(std::string());
+    }
+
+    bool persistable(const Directory& d, const std::string& storeDir) const
+    {
+        return d.complete && !d.racy && d.dirMtime != 0 && d.key != storeDir &&
+               openWriters.count(d.key) == 0 && storable(d.key);
+    }
+
+    bool save()
+    {
+        if (!config.persist) {
+            return true;
+        }
+        if (!dirty) {
+            return true;
+        }
+
+        const std::string storeDir = store_dir();
+        std::string data(kStoreVersion);
+        data += '\n';
+        std::unordered_set<std::string> saved;
+        for (const auto& d : dirs) {
+            if (!persistable(d, storeDir)) {
+                continue;
+            }
+            data += "D\t";
+            data += std::to_string(d.dirMtime);
+            data += '\t';
+            data += d.key;
+            data += '\n';
+            for (const auto& [name, info] : d.entries) {
+                if (!storable(name)) {
+                    continue;
+                }
+                data += "F\t";
+                data += info.isDirectory ? 'd' : 'f';
+                data += '\t';
+                data += std::to_string(info.sizeBytes);
+                data += '\t';
+                data += std::to_string(to_seconds(info.modifiedTime));
+                data += '\t';
+                data += name;
+                data += '\n';
+            }
+            saved.insert(d.key);
+        }
+
+        // Write aside and swap so a reset mid-save loses the index, never corrupts it.
+        if (!storeDir.empty() && storeDir != "/") {
+            inner->createDirectory(storeDir);
+        }
+        const std::string tmp = config.storePath + ".tmp";
+        bool ok = false;
+        if (auto f = inner->open(tmp, "wb")) {
+            ok = f->write(data.data(), data.size()) == data.size() && f->flush();
+        }
+        if (ok) {
+            inner->removeFile(config.storePath);
+            ok = inner->rename(tmp, config.storePath);
+        }
+
+        dirtySince = SteadyClock::now();
+        mustSave = false;
+        if (!ok) {
+            FN_LOGW(TAG, "metadata index: failed to write %s on '%s'",
+                    config.storePath.c_str(), inner->name().c_str());
+            return false;
+        }
+        dirty = false;
+        persistedKeys = std::move(saved);
+        ++stats.saves;
+        return true;
+    }
+
+    void load()
+    {
+        auto f = inner->open(config.storePath, "rb");
+        if (!f) {
+            return;
+        }
+        std::string data;
+        char buf[4096];
+        for (std::size_t n; (n = f->read(buf, sizeof(buf))) > 0;) {
+            data.append(buf, n);
+        }
+
+        std::string_view rest(data);
+        bool sawVersion = false;
+        Directory* cur = nullptr;
+        while (!rest.empty()) {
+            auto nl = rest.find('\n');
+            std::string_view line = rest.substr(0, nl);
+            rest.remove_prefix(nl == std::string_view::npos ? rest.size() : nl + 1);
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            if (line.empty()) {
+                continue;
+            }
+            if (!sawVersion) {
+                if (line != kStoreVersion) {
+                    FN_LOGW(TAG, "metadata index: ignoring %s (unknown format)", config.storePath.c_str());
+                    return;
+                }
+                sawVersion = true;
+                continue;
+            }
+
+            if (line.substr(0, 2) == "D\t") {
+                std::string_view fields[3];
+                std::int64_t mtime = 0;
+                cur = nullptr;
+                if (dirs.size() >= config.maxDirectories || !split_fields(line, fields) ||
+                    !parse_int(fields[1], mtime) || mtime == 0 || fields[2].empty()) {
+                    continue;
+                }
+                Directory& d = emplace(std::string(fields[2]));
+                d.complete = true;
+                d.dirMtime = mtime;
+                persistedKeys.insert(d.key);
+                cur = &d;
+            } else if (cur && line.substr(0, 2) == "F\t") {
+                std::string_view fields[5];
+                FileInfo info{};
+                std::int64_t mtime = 0;
+                if (!split_fields(line, fields) || fields[4].empty() ||
+                    !parse_int(fields[2], info.sizeBytes) || !parse_int(fields[3], mtime)) {
+                    continue;
+                }
+                info.isDirectory = fields[1] == "d";
+                info.modifiedTime = mtime != 0 ? WallClock::time_point{std::chrono::seconds(mtime)}
+                                               : WallClock::time_point{};
+                info.path = join(cur->key, fields[4]);
+                cur->entries.set(fields[4], std::move(info));
+            }
+        }
+        dirs.reverse(); // keep the store's most-recent-first order
+        ++stats.loads;
+        FN_LOGI(TAG, "metadata index: loaded %u directories for '%s'",
+                static_cast<unsigned>(dirs.size()), inner->name().c_str());
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Files opened for writing: refresh the entry when closed
+// ---------------------------------------------------------------------------
+
+class IndexedFileSystem::WriteTrackingFile final : public IFile {
+public:
+    WriteTrackingFile(std::shared_ptr<State> state,
+                      std::unique_ptr<IFile> file,
+                      std::string path,
+                      std::string parent)
+        : _state(std::move(state))
+        , _file(std::move(file))
+        , _path(std::move(path))
+        , _parent(std::move(parent))
+    {
+        _state->writer_opened(_parent);
+    }
+
+    ~WriteTrackingFile() override
+    {
+        _file.reset(); // close first so stat() sees the final size
+        _state->writer_closed(_path, _parent);
+    }
+
+    std::size_t read(void* dst, std::size_t maxBytes) override { return _file->read(dst, maxBytes); }
+    std::size_t write(const void* src, std::size_t bytes) override { return _file->write(src, bytes); }
+    bool seek(std::uint64_t offset) override { return _file->seek(offset); }
+    std::uint64_t tell() const override { return _file->tell(); }
+    bool flush() override { return _file->flush(); }
+
+private:
+    std::shared_ptr<State> _state;
+    std::unique_ptr<IFile> _file;
+    std::string _path;
+    std::string _parent;
+};
+
+// ---------------------------------------------------------------------------
+// IndexedFileSystem
+// ---------------------------------------------------------------------------
+
+IndexedFileSystem::IndexedFileSystem(std::unique_ptr<IFileSystem> inner, MetadataIndexConfig config)
+    : _state(std::make_shared<State>(std::move(inner), std::move(config)))
+{
+    if (_state->config.persist) {
+        _state->load();
+    }
+}
+
+IndexedFileSystem::~IndexedFileSystem()
+{
+    _state->save();
+}
+
+FileSystemKind IndexedFileSystem::kind() const { return _state->inner->kind(); }
+std::string IndexedFileSystem::name() const { return _state->inner->name(); }
+IFileSystem& IndexedFileSystem::inner() { return *_state->inner; }
+
+bool IndexedFileSystem::exists(const std::string& path)
+{
+    FileInfo info{};
+    return _state->lookup(path, info) || _state->inner->exists(path);
+}
+
+bool IndexedFileSystem::isDirectory(const std::string& path)
+{
+    FileInfo info{};
+    if (_state->lookup(path, info)) {
+        return info.isDirectory;
+    }
+    return _state->inner->isDirectory(path);
+}
+
+bool IndexedFileSystem::createDirectory(const std::string& path)
+{
+    if (!_state->inner->createDirectory(path)) {
+        return false;
+    }
+    _state->note_changed(path, false);
+    _state->maybe_save(std::chrono::steady_clock::now());
+    return true;
+}
+
+bool IndexedFileSystem::removeFile(const std::string& path)
+{
+    if (!_state->inner->removeFile(path)) {
+        return false;
+    }
+    _state->note_changed(path, true);
+    _state->maybe_save(std::chrono::steady_clock::now());
+    return true;
+}
+
+bool IndexedFileSystem::removeDirectory(const std::string& path)
+{
+    if (!_state->inner->removeDirectory(path)) {
+        return false;
+    }
+    _state->drop_subtree(key_of(path));
+    _state->note_changed(path, true);
+    _state->maybe_save(std::chrono::steady_clock::now());
+    return true;
+}
+
+bool IndexedFileSystem::rename(const std::string& from, const std::string& to)
+{
+    if (!_state->inner->rename(from, to)) {
+        return false;
+    }
+    _state->drop_subtree(key_of(from));
+    _state->drop_subtree(key_of(to));
+    _state->note_changed(from, true);
+    _state->note_changed(to, false);
+    _state->maybe_save(std::chrono::steady_clock::now());
+    return true;
+}
+
+std::unique_ptr<IFile> IndexedFileSystem::open(const std::string& path, const char* mode)
+{
+    auto file = _state->inner->open(path, mode);
+    if (!file || !writes(mode)) {
+        return file;
+    }
+    std::string_view base;
+    const std::string key = key_of(path);
+    auto parent = parent_key(key, base);
+    if (!parent) {
+        return file;
+    }
+    _state->note_changed(path, false); // a "wb" open may have just created it
+    auto tracked = std::make_unique<WriteTrackingFile>(_state, std::move(file), path, std::move(*parent));
+    _state->maybe_save(std::chrono::steady_clock::now());
+    return tracked;
+}
+
+bool IndexedFileSystem::stat(const std::string& path, FileInfo& outInfo)
+{
+    if (_state->lookup(path, outInfo, /*trustedOnly=*/true)) {
+        ++_state->stats.statHits;
+        return true;
+    }
+    ++_state->stats.statMisses;
+    if (!_state->inner->stat(path, outInfo)) {
+        return false;
+    }
+    _state->remember(path, outInfo);
+    return true;
+}
+
+bool IndexedFileSystem::listDirectory(const std::string& path, std::vector<FileInfo>& outEntries)
+{
+    auto& st = *_state;
+    const auto now = std::chrono::steady_clock::now();
+    const std::string key = key_of(path);
+
+    if (auto* d = st.find(key); d && d->complete) {
+        if (st.usable(*d, now)) {
+            ++st.stats.listHits;
+            outEntries.clear();
+            outEntries.reserve(d->entries.size());
+            for (const auto& [name, info] : d->entries) {
+                outEntries.push_back(info);
+            }
+            st.maybe_save(now);
+            return true;
+        }
+        st.drop(key);
+        ++st.stats.staleDirectories;
+    }
+    ++st.stats.listMisses;
+
+    // Stat before listing: a change made while listing then moves the mtime
+    // past what is recorded here.
+    FileInfo dirInfo{};
+    const bool haveMtime = st.inner->stat(path, dirInfo);
+    const auto wallNow = std::chrono::system_clock::now();
+    if (!st.inner->listDirectory(path, outEntries)) {
+        return false;
+    }
+
+    auto& d = st.emplace(key);
+    d.complete = true;
+    d.builtAt = now;
+    d.checkedAt = now;
+    d.dirMtime = haveMtime ? to_seconds(dirInfo.modifiedTime) : 0;
+    d.racy = st.is_racy(d.dirMtime, wallNow);
+    for (const auto& e : outEntries) {
+        const auto base = basename_of(e.path);
+        if (!base.empty()) {
+            d.entries.set(base, e);
+        }
+    }
+    if (st.persistable(d, st.store_dir())) {
+        st.mark_dirty(now, false);
+    }
+    st.maybe_save(now);
+    return true;
+}
+
+void IndexedFileSystem::invalidate(const std::string& path)
+{
+    const std::string key = key_of(path);
+    std::string_view base;
+    _state->drop_subtree(key);
+    if (auto parent = parent_key(key, base)) {
+        _state->drop(*parent);
+    }
+    _state->maybe_save(std::chrono::steady_clock::now());
+}
+
+void IndexedFileSystem::clear()
+{
+    _state->dirs.clear();
+    _state->byKey.clear();
+    if (!_state->persistedKeys.empty()) {
+        _state->mark_dirty(std::chrono::steady_clock::now(), true);
+    }
+}
+
+void IndexedFileSystem::poll()
+{
+    _state->inner->poll();
+    _state->maybe_save(std::chrono::steady_clock::now());
+}
+
+bool IndexedFileSystem::wouldBlock() const { return _state->inner->wouldBlock(); }
+
+bool IndexedFileSystem::save() { return _state->save(); }
+
+std::size_t IndexedFileSystem::directoryCount() const { return _state->dirs.size(); }
+const MetadataIndexStats& IndexedFileSystem::stats() const { return _state->stats; }
+const MetadataIndexConfig& IndexedFileSystem::config() const { return _state->config; }
+
+} // namespace fujinet::fs
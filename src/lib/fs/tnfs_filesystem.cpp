@@ -8,46 +8,72 @@
 #include <cstring>
 #include <cstdint>
 #include <cctype>
-#include <map>
 #include <memory>
-#include <tuple>
+#include <optional>
 #include <utility>
 
 namespace fujinet::fs {
 
 static constexpr const char* TAG = "tnfs_fs";
 
+// Open file on a pooled session. Remembers how it was opened so that,
+// if the session has to be remounted (server restart), it can reopen the
+// file and seek back to where it was.
 class TnfsFile final : public IFile {
 public:
-    TnfsFile(std::shared_ptr<tnfs::ITnfsClient> client, int fileHandle)
-        : _client(std::move(client))
+    TnfsFile(std::shared_ptr<TnfsSession> session,
+             std::string path,
+             std::uint16_t openMode,
+             int fileHandle)
+        : _session(std::move(session))
+        , _path(std::move(path))
+        , _openMode(openMode)
         , _fileHandle(fileHandle)
-        , _position(0)
+        , _generation(_session->generation())
     {
         FN_LOGD(TAG, "File handle %d created", fileHandle);
     }
 
     ~TnfsFile() override {
-        if (_fileHandle != -1) {
-            _client->close(_fileHandle);
+        if (_fileHandle != -1 && _generation == _session->generation()) {
+            _session->client().close(_fileHandle);
             FN_LOGD(TAG, "File handle %d closed", _fileHandle);
         }
     }
 
     std::size_t read(void* dst, std::size_t maxBytes) override {
-        std::size_t bytesRead = _client->read(_fileHandle, dst, maxBytes);
+        if (!ensure_open()) {
+            return 0;
+        }
+        std::size_t bytesRead = _session->client().read(_fileHandle, dst, maxBytes);
+        if (bytesRead == 0 && maxBytes > 0 && retry_after_recover()) {
+            bytesRead = _session->client().read(_fileHandle, dst, maxBytes);
+        }
         _position += bytesRead;
         return bytesRead;
     }
 
     std::size_t write(const void* src, std::size_t bytes) override {
-        std::size_t bytesWritten = _client->write(_fileHandle, src, bytes);
+        if (!ensure_open()) {
+            return 0;
+        }
+        std::size_t bytesWritten = _session->client().write(_fileHandle, src, bytes);
+        if (bytesWritten == 0 && bytes > 0 && retry_after_recover()) {
+            bytesWritten = _session->client().write(_fileHandle, src, bytes);
+        }
         _position += bytesWritten;
         return bytesWritten;
     }
 
     bool seek(std::uint64_t offset) override {
-        bool success = _client->seek(_fileHandle, static_cast<uint32_t>(offset));
+        if (!ensure_open()) {
+            return false;
+        }
+        const auto off32 = static_cast<uint32_t>(offset);
+        bool success = _session->client().seek(_fileHandle, off32);
+        if (!success && retry_after_recover()) {
+            success = _session->client().seek(_fileHandle, off32);
+        }
         if (success) {
             _position = offset;
         }
@@ -64,21 +90,65 @@ public:
     }
 
 private:
-    std::shared_ptr<tnfs::ITnfsClient> _client;
+    // Another user of the session may have remounted it since our last call.
+    bool ensure_open()
+    {
+        return _generation == _session->generation() || reopen();
+    }
+
+    bool retry_after_recover()
+    {
+        return _session->recover() && reopen();
+    }
+
+    bool reopen()
+    {
+        // Never truncate or create again: the file is already there.
+        const auto mode = static_cast<std::uint16_t>(
+            _openMode & ~(tnfs::OPENMODE_WRITE_CREATE | tnfs::OPENMODE_WRITE_TRUNCATE));
+        auto& client = _session->client();
+        _generation = _session->generation();
+        _fileHandle = client.open(_path, mode, 0);
+        if (_fileHandle == -1) {
+            FN_LOGE(TAG, "Failed to reopen %s after remount", _path.c_str());
+            return false;
+        }
+        if ((_openMode & tnfs::OPENMODE_WRITE_APPEND) == 0 &&
+            !client.seek(_fileHandle, static_cast<uint32_t>(_position))) {
+            return false;
+        }
+        FN_LOGI(TAG, "Reopened %s at %llu after remount",
+                _path.c_str(), static_cast<unsigned long long>(_position));
+        return true;
+    }
+
+    std::shared_ptr<TnfsSession> _session;
+    std::string _path;
+    std::uint16_t _openMode;
     int _fileHandle;
-    std::uint64_t _position;
+    std::uint32_t _generation;
+    std::uint64_t _position{0};
 };
 
 class TnfsFileSystem final : public IFileSystem {
 public:
-    explicit TnfsFileSystem(TnfsClientFactory clientFactory)
-        : _clientFactory(std::move(clientFactory))
+    TnfsFileSystem(TnfsClientFactory clientFactory, TnfsSessionPoolConfig poolConfig)
+        : _pool([factory = std::move(clientFactory)](const TnfsEndpoint& endpoint)
+                    -> std::shared_ptr<tnfs::ITnfsClient> {
+              return factory(endpoint);
+          },
+          poolConfig)
     {
         FN_LOGI(TAG, "TNFS filesystem created (dynamic endpoints)");
     }
 
     explicit TnfsFileSystem(std::shared_ptr<tnfs::ITnfsClient> fixedClient)
-        : _fixedClient(std::move(fixedClient))
+        : _fixed(true)
+        , _pool([fixedClient](const TnfsEndpoint& endpoint) -> std::shared_ptr<tnfs::ITnfsClient> {
+              // Bound to the first endpoint; remounts get the same client back.
+              static_cast<void>(endpoint);
+              return fixedClient;
+          })
     {
         FN_LOGI(TAG, "TNFS filesystem created (single client)");
     }
@@ -93,70 +163,47 @@ public:
         return "tnfs";
     }
 
+    void poll() override {
+        _pool.poll();
+    }
+
+    bool wouldBlock() const override {
+        return _wouldBlock;
+    }
+
     bool exists(const std::string& path) override {
-        ResolvedPath resolved{};
-        if (!resolve_path(path, resolved)) {
-            return false;
-        }
-        return resolved.client->exists(resolved.path);
+        return run(path, [](tnfs::ITnfsClient& c, const std::string& p) { return c.exists(p); });
     }
 
     bool isDirectory(const std::string& path) override {
-        ResolvedPath resolved{};
-        if (!resolve_path(path, resolved)) {
-            return false;
-        }
-        return resolved.client->isDirectory(resolved.path);
+        return run(path, [](tnfs::ITnfsClient& c, const std::string& p) { return c.isDirectory(p); });
     }
 
     bool createDirectory(const std::string& path) override {
-        ResolvedPath resolved{};
-        if (!resolve_path(path, resolved)) {
-            return false;
-        }
-        return resolved.client->createDirectory(resolved.path);
+        return run(path, [](tnfs::ITnfsClient& c, const std::string& p) { return c.createDirectory(p); });
     }
 
     bool removeFile(const std::string& path) override {
-        ResolvedPath resolved{};
-        if (!resolve_path(path, resolved)) {
-            return false;
-        }
-        return resolved.client->removeFile(resolved.path);
+        return run(path, [](tnfs::ITnfsClient& c, const std::string& p) { return c.removeFile(p); });
     }
 
     bool removeDirectory(const std::string& path) override {
-        ResolvedPath resolved{};
-        if (!resolve_path(path, resolved)) {
-            return false;
-        }
-        return resolved.client->removeDirectory(resolved.path);
+        return run(path, [](tnfs::ITnfsClient& c, const std::string& p) { return c.removeDirectory(p); });
     }
 
     bool rename(const std::string& from, const std::string& to) override {
-        ResolvedPath src{};
-        ResolvedPath dst{};
-        if (!resolve_path(from, src) || !resolve_path(to, dst)) {
-            return false;
-        }
-
-        if (src.endpoint.host != dst.endpoint.host ||
-            src.endpoint.port != dst.endpoint.port ||
-            src.endpoint.mountPath != dst.endpoint.mountPath ||
-            src.endpoint.user != dst.endpoint.user ||
-            src.endpoint.password != dst.endpoint.password) {
-            FN_LOGE(TAG, "Rename across TNFS endpoints is not supported");
+        TnfsEndpoint dstEndpoint{};
+        std::string dstPath;
+        if (!parse_endpoint_and_path(to, dstEndpoint, dstPath)) {
             return false;
         }
 
-        return src.client->rename(src.path, dst.path);
+        return run(from, [&](tnfs::ITnfsClient& c, const std::string& srcPath) {
+            return c.rename(srcPath, dstPath);
+        }, &dstEndpoint);
     }
 
     std::unique_ptr<IFile> open(const std::string& path, const char* mode) override {
-        ResolvedPath resolved{};
-        if (!resolve_path(path, resolved)) {
-            return nullptr;
-        }
         uint16_t openMode = 0;
         // Default perms for newly created files (rw-r--r--).
         uint16_t createPerms = 0644;
@@ -178,23 +225,23 @@ public:
             openMode = tnfs::OPENMODE_READ;
         }
 
-        int fileHandle = resolved.client->open(resolved.path, openMode, createPerms);
-        if (fileHandle == -1) {
+        int fileHandle = -1;
+        ResolvedPath resolved{};
+        const bool ok = run(path, [&](tnfs::ITnfsClient& c, const std::string& p) {
+            fileHandle = c.open(p, openMode, createPerms);
+            return fileHandle != -1;
+        }, nullptr, &resolved);
+        if (!ok) {
             FN_LOGE(TAG, "Failed to open file: %s", resolved.path.c_str());
             return nullptr;
         }
 
-        return std::make_unique<TnfsFile>(resolved.client, fileHandle);
+        return std::make_unique<TnfsFile>(resolved.session, resolved.path, openMode, fileHandle);
     }
 
     bool stat(const std::string& path, FileInfo& outInfo) override {
-        ResolvedPath resolved{};
-        if (!resolve_path(path, resolved)) {
-            return false;
-        }
-
         tnfs::TnfsStat st{};
-        if (!resolved.client->stat(resolved.path, st)) {
+        if (!run(path, [&](tnfs::ITnfsClient& c, const std::string& p) { return c.stat(p, st); })) {
             return false;
         }
 
@@ -207,29 +254,28 @@ public:
     }
 
     bool listDirectory(const std::string& path, std::vector<FileInfo>& outEntries) override {
-        ResolvedPath resolved{};
-        if (!resolve_path(path, resolved)) {
-            return false;
-        }
+        // One OPENDIRX listing carries each entry's size/mtime, so there is
+        // no separate isDirectory() or per-entry stat() round trip.
+        tnfs::TnfsDirOptions opts{};
+        opts.dirOptions = tnfs::DIROPT_NO_SKIPHIDDEN | tnfs::DIROPT_NO_SKIPSPECIAL;
 
-        if (!resolved.client->isDirectory(resolved.path)) {
+        std::vector<tnfs::TnfsDirEntry> entries;
+        ResolvedPath resolved{};
+        const bool ok = run(path, [&](tnfs::ITnfsClient& c, const std::string& p) {
+            return c.listDirectoryEntries(p, opts, entries);
+        }, nullptr, &resolved);
+        if (!ok) {
             return false;
         }
 
         outEntries.clear();
-        std::vector<std::string> entries = resolved.client->listDirectory(resolved.path);
-        for (const auto& entryName : entries) {
-            std::string entryPath = join_path(resolved.path, entryName);
-            tnfs::TnfsStat st{};
-            if (!resolved.client->stat(entryPath, st)) {
-                continue;
-            }
-
+        outEntries.reserve(entries.size());
+        for (const auto& entry : entries) {
             FileInfo info{};
-            info.path = entryPath;
-            info.isDirectory = st.isDir;
-            info.sizeBytes = st.filesize;
-            info.modifiedTime = std::chrono::system_clock::from_time_t(st.mTime);
+            info.path = join_path(resolved.path, entry.name);
+            info.isDirectory = entry.isDir;
+            info.sizeBytes = entry.filesize;
+            info.modifiedTime = std::chrono::system_clock::from_time_t(entry.mTime);
             outEntries.push_back(std::move(info));
         }
 
@@ -237,30 +283,10 @@ public:
     }
 
 private:
-    struct SessionKey {
-        std::string host;
-        std::uint16_t port{tnfs::DEFAULT_PORT};
-        std::string mountPath;
-        std::string user;
-        std::string password;
-        bool useTcp{false};
-
-        bool operator<(const SessionKey& other) const
-        {
-            return std::tie(host, port, mountPath, user, password, useTcp) <
-                   std::tie(other.host, other.port, other.mountPath, other.user, other.password, other.useTcp);
-        }
-    };
-
-    struct Session {
-        TnfsEndpoint endpoint;
-        std::shared_ptr<tnfs::ITnfsClient> client;
-    };
-
     struct ResolvedPath {
         TnfsEndpoint endpoint;
         std::string path;
-        std::shared_ptr<tnfs::ITnfsClient> client;
+        std::shared_ptr<TnfsSession> session;
     };
 
     static std::string ensure_abs_path(const std::string& path)
@@ -420,7 +446,7 @@ private:
         }
 
         // No endpoint info in path; use default route if configured.
-        if (_fixedClient) {
+        if (_fixed) {
             endpoint.host = "__fixed__";
             endpoint.port = tnfs::DEFAULT_PORT;
             endpoint.mountPath = "/";
@@ -438,74 +464,68 @@ private:
         return true;
     }
 
-    std::shared_ptr<tnfs::ITnfsClient> get_or_create_session(const TnfsEndpoint& endpoint)
+    static bool same_endpoint(const TnfsEndpoint& a, const TnfsEndpoint& b)
     {
-        SessionKey key{endpoint.host, endpoint.port, endpoint.mountPath, endpoint.user, endpoint.password, endpoint.useTcp};
-        auto existing = _sessions.find(key);
-        if (existing != _sessions.end()) {
-            return existing->second.client;
-        }
+        return a.host == b.host && a.port == b.port && a.mountPath == b.mountPath &&
+               a.user == b.user && a.password == b.password && a.useTcp == b.useTcp;
+    }
 
-        if (_fixedClient) {
-            if (_sessions.empty()) {
-                if (!_fixedClient->mount(endpoint.mountPath, endpoint.user, endpoint.password)) {
-                    FN_LOGE(TAG, "Failed to mount fixed TNFS client");
-                    return {};
-                }
-                Session session{};
-                session.endpoint = endpoint;
-                session.client = _fixedClient;
-                _sessions.emplace(std::move(key), std::move(session));
-                return _fixedClient;
-            }
-            FN_LOGE(TAG, "Fixed TNFS client cannot switch endpoints");
-            return {};
+    bool resolve_path(const std::string& rawPath, ResolvedPath& out)
+    {
+        if (!parse_endpoint_and_path(rawPath, out.endpoint, out.path)) {
+            return false;
         }
-
-        if (!_clientFactory) {
-            FN_LOGE(TAG, "No TNFS client factory configured");
-            return {};
+        if (_fixed && _fixedEndpoint && !same_endpoint(*_fixedEndpoint, out.endpoint)) {
+            FN_LOGE(TAG, "Fixed TNFS client cannot switch endpoints");
+            return false;
         }
-
-        std::unique_ptr<tnfs::ITnfsClient> created = _clientFactory(endpoint);
-        if (!created) {
-            FN_LOGE(TAG, "Failed to create TNFS client for %s:%u",
-                endpoint.host.c_str(),
-                static_cast<unsigned>(endpoint.port));
-            return {};
+        out.session = _pool.acquire(out.endpoint);
+        if (!out.session) {
+            return false;
         }
-
-        std::shared_ptr<tnfs::ITnfsClient> client(std::move(created));
-        if (!client->mount(endpoint.mountPath, endpoint.user, endpoint.password)) {
-            FN_LOGE(TAG, "Failed to mount TNFS session for %s:%u",
-                endpoint.host.c_str(),
-                static_cast<unsigned>(endpoint.port));
-            return {};
+        if (_fixed && !_fixedEndpoint) {
+            _fixedEndpoint = out.endpoint;
         }
-
-        Session session{};
-        session.endpoint = endpoint;
-        session.client = client;
-        _sessions.emplace(std::move(key), std::move(session));
-        FN_LOGI(TAG, "Mounted TNFS session %s:%u",
-            endpoint.host.c_str(),
-            static_cast<unsigned>(endpoint.port));
-        return client;
+        return true;
     }
 
-    bool resolve_path(const std::string& rawPath, ResolvedPath& out)
+    // Run `op(client, serverPath)` on the pooled session for `path`. If it
+    // fails because the session was lost (server restart), remount and run
+    // it once more, so callers never see a stale session.
+    //
+    // `mustMatch` rejects paths on another endpoint (rename); `resolvedOut`
+    // receives the session/path used.
+    template <typename Op>
+    bool run(const std::string& path,
+             Op&& op,
+             const TnfsEndpoint* mustMatch = nullptr,
+             ResolvedPath* resolvedOut = nullptr)
     {
-        if (!parse_endpoint_and_path(rawPath, out.endpoint, out.path)) {
+        _wouldBlock = false;
+        ResolvedPath local{};
+        ResolvedPath& resolved = resolvedOut ? *resolvedOut : local;
+        if (!resolve_path(path, resolved)) {
+            return false;
+        }
+        if (mustMatch && !same_endpoint(resolved.endpoint, *mustMatch)) {
+            FN_LOGE(TAG, "Rename across TNFS endpoints is not supported");
             return false;
         }
-        out.client = get_or_create_session(out.endpoint);
-        return static_cast<bool>(out.client);
+
+        TnfsSession& session = *resolved.session;
+        bool ok = session.ready() && op(session.client(), resolved.path);
+        if (!ok && session.recover()) {
+            ok = op(session.client(), resolved.path);
+        }
+        _wouldBlock = !ok && session.would_block();
+        return ok;
     }
 
-    TnfsClientFactory _clientFactory;
-    std::shared_ptr<tnfs::ITnfsClient> _fixedClient;
+    bool _fixed{false};
+    bool _wouldBlock{false};
+    std::optional<TnfsEndpoint> _fixedEndpoint;
     TnfsEndpoint _defaultEndpoint;
-    std::map<SessionKey, Session> _sessions;
+    TnfsSessionPool _pool;
 };
 
 std::unique_ptr<IFileSystem> make_tnfs_filesystem(std::shared_ptr<tnfs::ITnfsClient> client) {
@@ -520,11 +540,17 @@ std::unique_ptr<IFileSystem> make_tnfs_filesystem(std::unique_ptr<tnfs::ITnfsCli
 }
 
 std::unique_ptr<IFileSystem> make_tnfs_filesystem(TnfsClientFactory clientFactory)
+{
+    return make_tnfs_filesystem(std::move(clientFactory), TnfsSessionPoolConfig{});
+}
+
+std::unique_ptr<IFileSystem> make_tnfs_filesystem(TnfsClientFactory clientFactory,
+                                                  const TnfsSessionPoolConfig& poolConfig)
 {
     if (!clientFactory) {
         return nullptr;
     }
-    return std::make_unique<TnfsFileSystem>(std::move(clientFactory));
+    return std::make_unique<TnfsFileSystem>(std::move(clientFactory), poolConfig);
 }
 
 std::unique_ptr<IFileSystem> make_tnfs_filesystem() {
@@ -0,0 +1,205 @@
+#include "fujinet/fs/tnfs_session_pool.h"
+
+#include "fujinet/core/logging.h"
+
+#include <tuple>
+#include <utility>
+
+namespace fujinet::fs {
+
+static constexpr const char* TAG = "tnfs_fs";
+
+// ---------------------------------------------------------------------------
+// TnfsSession
+// ---------------------------------------------------------------------------
+
+TnfsSession::TnfsSession(TnfsEndpoint endpoint,
+                         TnfsSessionFactory factory,
+                         std::shared_ptr<TnfsSessionPoolStats> stats,
+                         bool nonBlocking)
+    : _endpoint(std::move(endpoint))
+    , _factory(std::move(factory))
+    , _stats(std::move(stats))
+    , _nonBlocking(nonBlocking)
+    , _lastUsed(std::chrono::steady_clock::now())
+{
+}
+
+tnfs::ITnfsClient& TnfsSession::client()
+{
+    _lastUsed = std::chrono::steady_clock::now();
+    return *_client;
+}
+
+bool TnfsSession::recover()
+{
+    if (!_client) {
+        return remount();
+    }
+    if (!_client->session_lost()) {
+        return false;
+    }
+    if (!_mounting) {
+        FN_LOGW(TAG, "TNFS session %s:%u lost; remounting",
+                _endpoint.host.c_str(), static_cast<unsigned>(_endpoint.port));
+    }
+    return remount();
+}
+
+bool TnfsSession::would_block() const
+{
+    return _mountBlocked || (_client && _client->would_block());
+}
+
+bool TnfsSession::remount()
+{
+    // A non-blocking mount that is still waiting keeps its client, so
+    // repeating mount() picks up the parked MOUNT instead of starting over.
+    if (!_mounting) {
+        _mounting = _factory(_endpoint);
+        if (!_mounting) {
+            FN_LOGE(TAG, "Failed to create TNFS client for %s:%u",
+                    _endpoint.host.c_str(), static_cast<unsigned>(_endpoint.port));
+            return false;
+        }
+        _mounting->set_nonblocking(_nonBlocking);
+    }
+
+    if (!_mounting->mount(_endpoint.mountPath, _endpoint.user, _endpoint.password)) {
+        _mountBlocked = _mounting->would_block();
+        if (!_mountBlocked) {
+            FN_LOGE(TAG, "TNFS mount of %s:%u failed",
+                    _endpoint.host.c_str(), static_cast<unsigned>(_endpoint.port));
+            _mounting.reset();
+        }
+        return false;
+    }
+
+    _mountBlocked = false;
+    const bool first = !_client;
+    _client = std::move(_mounting); // a lost client knows not to send UNMOUNT
+    if (first) {
+        ++_stats->mounts;
+        FN_LOGI(TAG, "Mounted TNFS session %s:%u",
+                _endpoint.host.c_str(), static_cast<unsigned>(_endpoint.port));
+    } else {
+        ++_generation;
+        ++_stats->remounts;
+    }
+    _lastUsed = std::chrono::steady_clock::now();
+    return true;
+}
+
+bool TnfsSession::ping()
+{
+    // TNFS has no NOP; a STAT of the mount root is the cheapest round trip.
+    ++_stats->pings;
+    _lastUsed = std::chrono::steady_clock::now();
+    return ping_step();
+}
+
+// Send the keep-alive STAT or, once a non-blocking client has parked it,
+// repeat it to collect the reply so it doesn't hold up other requests.
+bool TnfsSession::ping_step()
+{
+    if (!_client) {
+        _pingParked = false;
+        return recover();
+    }
+    if (_pingParked && _client->session_lost()) {
+        _pingParked = false;
+        return recover();
+    }
+    tnfs::TnfsStat st{};
+    const bool ok = _client->stat("/", st);
+    _pingParked = !ok && _client->would_block();
+    if (ok || _pingParked) {
+        return ok;
+    }
+    return recover();
+}
+
+void TnfsSession::poll_clients()
+{
+    if (_client) {
+        _client->poll();
+    }
+    if (_mounting && _mounting != _client) {
+        _mounting->poll();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// TnfsSessionPool
+// ---------------------------------------------------------------------------
+
+bool TnfsSessionPool::Key::operator<(const Key& other) const
+{
+    return std::tie(host, port, mountPath, user, password, useTcp) <
+           std::tie(other.host, other.port, other.mountPath, other.user, other.password, other.useTcp);
+}
+
+TnfsSessionPool::TnfsSessionPool(TnfsSessionFactory factory, TnfsSessionPoolConfig config)
+    : _factory(std::move(factory))
+    , _config(config)
+    , _stats(std::make_shared<TnfsSessionPoolStats>())
+{
+}
+
+std::shared_ptr<TnfsSession> TnfsSessionPool::acquire(const TnfsEndpoint& endpoint)
+{
+    Key key{endpoint.host, endpoint.port, endpoint.mountPath, endpoint.user, endpoint.password, endpoint.useTcp};
+    auto existing = _sessions.find(key);
+    if (existing != _sessions.end()) {
+        ++_stats->reuses;
+        existing->second->_lastUsed = std::chrono::steady_clock::now();
+        return existing->second;
+    }
+
+    if (!_factory) {
+        FN_LOGE(TAG, "No TNFS client factory configured");
+        return nullptr;
+    }
+
+    std::shared_ptr<TnfsSession> session(new TnfsSession(endpoint, _factory, _stats, _config.nonBlocking));
+    if (!session->remount() && !session->would_block()) {
+        return nullptr;
+    }
+    _sessions.emplace(std::move(key), session);
+    return session;
+}
+
+void TnfsSessionPool::poll(std::chrono::steady_clock::time_point now)
+{
+    std::size_t pings = 0;
+    for (auto it = _sessions.begin(); it != _sessions.end();) {
+        TnfsSession& s = *it->second;
+        s.poll_clients();
+        if (s._pingParked) {
+            (void)s.ping_step();
+        }
+        const auto quiet = now - s._lastUsed;
+        const bool held = it->second.use_count() > 1;
+
+        if (!held) {
+            if (quiet >= _config.idleTimeout) {
+                FN_LOGI(TAG, "Unmounting idle TNFS session %s:%u",
+                        s._endpoint.host.c_str(), static_cast<unsigned>(s._endpoint.port));
+                if (s._client) {
+                    s._client->umount();
+                }
+                ++_stats->unmounts;
+                it = _sessions.erase(it);
+                continue;
+            }
+        } else if (_config.keepAlive.count() > 0 && quiet >= _config.keepAlive &&
+                   pings < MAX_PINGS_PER_POLL && !s.would_block()) {
+            // Another due session gets its turn on a later poll().
+            ++pings;
+            (void)s.ping();
+        }
+        ++it;
+    }
+}
+
+} // namespace fujinet::fs
@@ -0,0 +1,295 @@
+#include "fujinet/io/protocol/fuji_bus_frame_decoder.h"
+#include "fujinet/io/protocol/slip_kernels.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace fujinet::io::protocol {
+
+namespace {
+
+constexpr std::size_t kChecksumOffset = offsetof(FujiBusHeader, checksum);
+
+// Number of param bytes described by one descriptor byte.
+inline std::size_t descriptor_param_bytes(std::uint8_t descr)
+{
+    const unsigned idx = descr & FUJI_DESCR_COUNT_MASK;
+    return static_cast<std::size_t>(NUM_FIELDS_TABLE[idx]) * FIELD_SIZE_TABLE[idx];
+}
+
+inline std::uint32_t read_le(const std::uint8_t* p, std::size_t size)
+{
+    std::uint32_t v = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        v |= static_cast<std::uint32_t>(p[i]) << (8U * i);
+    }
+    return v;
+}
+
+} // namespace
+
+const char* FujiBusFrameDecoder::to_string(Error e) noexcept
+{
+    switch (e) {
+        case Error::None:           return "none";
+        case Error::TooShort:       return "too short";
+        case Error::Truncated:      return "truncated descriptors/params";
+        case Error::LengthMismatch: return "length mismatch";
+        case Error::BadChecksum:    return "bad checksum";
+        case Error::Oversized:      return "oversized";
+    }
+    return "unknown";
+}
+
+void FujiBusFrameDecoder::begin_frame()
+{
+    _decoded    = 0;
+    _chk        = 0;
+    _moreDescr  = false;
+    _tagged     = false;
+    _paramBytes = 0;
+    _prefixLen  = 0;
+    _limit      = _maxFrameBytes;
+    _prefix.clear();
+    _payload.clear();
+}
+
+void FujiBusFrameDecoder::reset()
+{
+    begin_frame();
+    _state = State::Hunting;
+    _head = 0;
+    _tail = 0;
+}
+
+void FujiBusFrameDecoder::fail_frame(Error e)
+{
+    ++_dropped;
+    _lastError = e;
+    begin_frame();
+    _state = State::Discard;
+}
+
+// Size the payload buffer once from the header length rather than growing it.
+void FujiBusFrameDecoder::reserve_payload()
+{
+    if (_payload.empty() && _limit > _decoded) {
+        _payload.reserve(_limit - _decoded);
+    }
+}
+
+// Route one decoded byte into header, prefix (descriptors + params) or payload.
+void FujiBusFrameDecoder::accept(std::uint8_t b)
+{
+    if (_decoded >= _limit) {
+        fail_frame(Error::Oversized);
+        return;
+    }
+
+    const std::size_t idx = _decoded++;
+    _chk = checksum_step(_chk, idx == kChecksumOffset ? std::uint8_t{0} : b);
+
+    if (idx < sizeof(FujiBusHeader)) {
+        _hdr[idx] = b;
+        if (idx == offsetof(FujiBusHeader, length) + 1) {
+            const std::size_t len = read_le(&_hdr[offsetof(FujiBusHeader, length)], 2);
+            _limit = std::min(_maxFrameBytes, std::max(len, sizeof(FujiBusHeader)));
+        }
+        if (idx == offsetof(FujiBusHeader, descr)) {
+            // A request tag, if flagged, sits between descriptors and params;
+            // count it as one more prefix byte.
+            _tagged     = (b & FUJI_DESCR_TAGGED) != 0;
+            _paramBytes = descriptor_param_bytes(b) + (_tagged ? 1U : 0U);
+            _moreDescr  = (b & FUJI_DESCR_ADDTL_MASK) != 0;
+            if (!_moreDescr) {
+                _prefixLen = sizeof(FujiBusHeader) + _paramBytes;
+            }
+        }
+        return;
+    }
+
+    if (_moreDescr) {
+        _prefix.push_back(b);
+        _paramBytes += descriptor_param_bytes(b);
+        _moreDescr = (b & FUJI_DESCR_ADDTL_MASK) != 0;
+        if (!_moreDescr) {
+            _prefixLen = idx + 1 + _paramBytes;
+        }
+        return;
+    }
+
+    if (idx < _prefixLen) {
+        _prefix.push_back(b);
+        return;
+    }
+
+    reserve_payload();
+    _payload.push_back(b);
+}
+
+// Fast path for a run of literal (unescaped) bytes that all belong to the payload.
+void FujiBusFrameDecoder::accept_payload_run(const std::uint8_t* p, std::size_t n)
+{
+    if (_decoded + n > _limit) {
+        fail_frame(Error::Oversized);
+        return;
+    }
+
+    reserve_payload();
+
+    _chk = checksum_update(_chk, p, n);
+    _payload.insert(_payload.end(), p, p + n);
+    _decoded += n;
+}
+
+void FujiBusFrameDecoder::end_frame()
+{
+    if (_decoded == 0) {
+        // Leading END, idle fill, or back-to-back END END: nothing to do.
+        return;
+    }
+
+    if (_decoded < sizeof(FujiBusHeader)) {
+        fail_frame(Error::TooShort);
+        return;
+    }
+    if (_moreDescr || _decoded < _prefixLen) {
+        fail_frame(Error::Truncated);
+        return;
+    }
+
+    const std::size_t len = read_le(&_hdr[offsetof(FujiBusHeader, length)], 2);
+    if (len != _decoded) {
+        fail_frame(Error::LengthMismatch);
+        return;
+    }
+    if (static_cast<std::uint8_t>(_chk) != _hdr[kChecksumOffset]) {
+        fail_frame(Error::BadChecksum);
+        return;
+    }
+
+    if (_tail == _frames.size()) {
+        _frames.emplace_back();
+    }
+    FujiBusFrame& frame = _frames[_tail++];
+
+    frame.device  = static_cast<WireDeviceId>(_hdr[offsetof(FujiBusHeader, device)]);
+    frame.command = _hdr[offsetof(FujiBusHeader, command)];
+
+    // Walk the descriptor chain: the first lives in the header, any extra ones
+    // lead _prefix, then the optional tag, then the param fields.
+    const std::uint8_t firstDescr = _hdr[offsetof(FujiBusHeader, descr)];
+    std::size_t paramOff = 0;
+    std::uint8_t dsc = firstDescr;
+    while (dsc & FUJI_DESCR_ADDTL_MASK) {
+        dsc = _prefix[paramOff++];
+    }
+
+    frame.tagged = _tagged;
+    frame.tag    = _tagged ? _prefix[paramOff++] : std::uint8_t{0};
+
+    frame.params.clear();
+    std::size_t descrIdx = 0;
+    dsc = firstDescr;
+    for (;;) {
+        const unsigned fieldDesc  = dsc & FUJI_DESCR_COUNT_MASK;
+        const unsigned fieldCount = NUM_FIELDS_TABLE[fieldDesc];
+        const unsigned fieldSize  = FIELD_SIZE_TABLE[fieldDesc];
+        for (unsigned i = 0; i < fieldCount; ++i) {
+            frame.params.emplace_back(read_le(&_prefix[paramOff], fieldSize),
+                                      static_cast<std::uint8_t>(fieldSize));
+            paramOff += fieldSize;
+        }
+        if (!(dsc & FUJI_DESCR_ADDTL_MASK)) {
+            break;
+        }
+        dsc = _prefix[descrIdx++];
+    }
+
+    // Hand the payload over and keep the slot's old buffer for the next frame.
+    frame.payload.swap(_payload);
+    begin_frame();
+}
+
+void FujiBusFrameDecoder::feed(const std::uint8_t* data, std::size_t len)
+{
+    const std::uint8_t* p   = data;
+    const std::uint8_t* end = data + len;
+
+    while (p < end) {
+        switch (_state) {
+        case State::Hunting:
+        case State::Discard: {
+            p = std::find(p, end, to_byte(SlipByte::End));
+            if (p == end) {
+                return;
+            }
+            ++p;
+            begin_frame();
+            _state = State::Frame;
+            break;
+        }
+
+        case State::Escape: {
+            const std::uint8_t b = *p++;
+            _state = State::Frame;
+            if (b == to_byte(SlipByte::End)) {
+                end_frame();
+                _state = State::Frame;
+            } else if (b == to_byte(SlipByte::EscEnd)) {
+                accept(to_byte(SlipByte::End));
+            } else if (b == to_byte(SlipByte::EscEsc)) {
+                accept(to_byte(SlipByte::Escape));
+            }
+            // else: ignore malformed escape
+            break;
+        }
+
+        case State::Frame: {
+            if (in_payload()) {
+                const std::uint8_t* run = find_slip_special(p, end);
+                if (run != p) {
+                    accept_payload_run(p, static_cast<std::size_t>(run - p));
+                    p = run;
+                    break;
+                }
+            }
+
+            const std::uint8_t b = *p++;
+            if (b == to_byte(SlipByte::End)) {
+                // END closes this frame and also opens the next one.
+                end_frame();
+                _state = State::Frame;
+            } else if (b == to_byte(SlipByte::Escape)) {
+                _state = State::Escape;
+            } else {
+                accept(b);
+            }
+            break;
+        }
+        }
+    }
+}
+
+bool FujiBusFrameDecoder::next(FujiBusFrame& out)
+{
+    if (_head == _tail) {
+        return false;
+    }
+
+    FujiBusFrame& slot = _frames[_head++];
+    out.device  = slot.device;
+    out.command = slot.command;
+    out.tagged  = slot.tagged;
+    out.tag     = slot.tag;
+    out.params.swap(slot.params);
+    out.payload.swap(slot.payload);
+
+    if (_head == _tail) {
+        _head = 0;
+        _tail = 0;
+    }
+    return true;
+}
+
+} // namespace fujinet::io::protocol
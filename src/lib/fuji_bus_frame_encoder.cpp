@@ -0,0 +1,140 @@
+#include "fujinet/io/protocol/fuji_bus_frame_encoder.h"
+#include "fujinet/io/protocol/slip_kernels.h"
+
+#include <algorithm>
+#include <array>
+
+namespace fujinet::io::protocol {
+
+namespace {
+
+constexpr std::size_t kMaxPrefixBytes =
+    sizeof(FujiBusHeader) + 1U + kMaxEncodeParams * (1U + MAX_BYTES_PER_DESCR);
+
+// Append `n` bytes SLIP-escaped, copying escape-free runs in one go.
+void append_escaped(ByteBuffer& out, const std::uint8_t* p, std::size_t n)
+{
+    const std::uint8_t* end = p + n;
+    while (p < end) {
+        const std::uint8_t* run = find_slip_special(p, end);
+        out.insert(out.end(), p, run);
+        if (run == end) {
+            break;
+        }
+        out.push_back(to_byte(SlipByte::Escape));
+        out.push_back(*run == to_byte(SlipByte::End) ? to_byte(SlipByte::EscEnd)
+                                                     : to_byte(SlipByte::EscEsc));
+        p = run + 1;
+    }
+}
+
+} // namespace
+
+bool encode_frame(ByteBuffer& out,
+                  WireDeviceId device,
+                  std::uint8_t command,
+                  const PacketParam* params,
+                  std::size_t paramCount,
+                  const std::uint8_t* payload,
+                  std::size_t payloadLen,
+                  std::optional<std::uint8_t> tag)
+{
+    out.clear();
+
+    if (paramCount > kMaxEncodeParams) {
+        return false;
+    }
+
+    // ---- Header + descriptors + params, staged on the stack ----
+    //
+    // Layout: [header][extra descriptors][tag][param fields]. Descriptors are
+    // grouped exactly as FujiBusPacket always has: up to 4 bytes of params
+    // of one size per descriptor.
+    std::array<std::uint8_t, kMaxPrefixBytes> prefix{};
+    std::array<std::uint8_t, kMaxEncodeParams> descr{};
+    std::array<std::uint8_t, kMaxEncodeParams * MAX_BYTES_PER_DESCR> fields{};
+    std::size_t descrCount = 0;
+    std::size_t fieldBytes = 0;
+
+    std::size_t idx = 0;
+    while (idx < paramCount) {
+        unsigned fieldSize    = 0;
+        unsigned bytesWritten = 0;
+        unsigned count        = 0;
+
+        for (; (idx + count) < paramCount; ++count) {
+            const PacketParam& param = params[idx + count];
+
+            if ((fieldSize != 0 && fieldSize != param.size) ||
+                bytesWritten == MAX_BYTES_PER_DESCR) {
+                break;
+            }
+
+            fieldSize = param.size;
+            for (unsigned i = 0; i < param.size; ++i) {
+                fields[fieldBytes++] = static_cast<std::uint8_t>((param.value >> (8U * i)) & 0xFFU);
+            }
+            bytesWritten += param.size;
+        }
+
+        std::uint8_t fieldDescr = static_cast<std::uint8_t>(count);
+        if (fieldSize > 1) {
+            fieldDescr |= FUJI_DESCR_EXCEEDS_U8;
+            if (fieldSize > 2) {
+                fieldDescr |= FUJI_DESCR_EXCEEDS_U16;
+            }
+        }
+
+        descr[descrCount++] = static_cast<std::uint8_t>(fieldDescr | FUJI_DESCR_ADDTL_MASK);
+        idx += count;
+    }
+
+    // Clear the "additional descriptors" bit on the last descriptor.
+    if (descrCount > 0) {
+        descr[descrCount - 1] &= static_cast<std::uint8_t>(~FUJI_DESCR_ADDTL_MASK);
+    }
+
+    const std::size_t extraDescr = descrCount > 1 ? descrCount - 1 : 0;
+    const std::size_t tagBytes   = tag ? 1U : 0U;
+    const std::size_t prefixLen  = sizeof(FujiBusHeader) + extraDescr + tagBytes + fieldBytes;
+    const std::size_t totalLen   = prefixLen + payloadLen;
+    if (totalLen > 0xFFFFU) {
+        return false;
+    }
+
+    prefix[offsetof(FujiBusHeader, device)]     = static_cast<std::uint8_t>(device);
+    prefix[offsetof(FujiBusHeader, command)]    = command;
+    prefix[offsetof(FujiBusHeader, length)]     = static_cast<std::uint8_t>(totalLen & 0xFFU);
+    prefix[offsetof(FujiBusHeader, length) + 1] = static_cast<std::uint8_t>((totalLen >> 8) & 0xFFU);
+    prefix[offsetof(FujiBusHeader, checksum)]   = 0;
+    prefix[offsetof(FujiBusHeader, descr)]      = static_cast<std::uint8_t>(
+        (descrCount > 0 ? descr[0] : 0) | (tag ? FUJI_DESCR_TAGGED : 0));
+
+    std::size_t off = sizeof(FujiBusHeader);
+    std::copy_n(descr.begin() + 1, extraDescr, prefix.begin() + off);
+    off += extraDescr;
+    if (tag) {
+        prefix[off++] = *tag;
+    }
+    std::copy_n(fields.begin(), fieldBytes, prefix.begin() + off);
+
+    // ---- Checksum in wire order (checksum byte is still 0) ----
+    std::uint16_t chk = checksum_update(0, prefix.data(), prefixLen);
+    if (payloadLen > 0) {
+        chk = checksum_update(chk, payload, payloadLen);
+    }
+    prefix[offsetof(FujiBusHeader, checksum)] = static_cast<std::uint8_t>(chk);
+
+    // ---- SLIP encode straight into `out` ----
+    // Escapes are rare in practice; the vector grows geometrically if not.
+    out.reserve(totalLen + totalLen / 16U + 2U);
+    out.push_back(to_byte(SlipByte::End));
+    append_escaped(out, prefix.data(), prefixLen);
+    if (payloadLen > 0) {
+        append_escaped(out, payload, payloadLen);
+    }
+    out.push_back(to_byte(SlipByte::End));
+    return true;
+}
+
+} // namespace fujinet::io::protocol
@@ -67,6 +67,7 @@ static void from_yaml(const YAML::Node& node, MountConfig& out)
     out.mode           = get_or<std::string>(node, "mode", "r");
     out.enabled        = get_or<bool>(node, "enabled", true);
     out.sectorSizeHint = static_cast<std::uint16_t>(get_or<int>(node, "sector_size_hint", 0));
+    out.prefetch       = get_or<std::string>(node, "prefetch", "");
 }
 
 static void from_yaml(const YAML::Node& node, ModemConfig& out)
@@ -285,6 +286,9 @@ static void to_yaml(YAML::Emitter& out, const FujiConfig& cfg)
         if (m.sectorSizeHint != 0) {
             out << YAML::Key << "sector_size_hint" << YAML::Value << m.sectorSizeHint;
         }
+        if (!m.prefetch.empty() && m.prefetch != "off") {
+            out << YAML::Key << "prefetch" << YAML::Value << m.prefetch;
+        }
         out << YAML::EndMap;
     }
     out << YAML::EndSeq;
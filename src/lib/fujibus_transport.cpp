@@ -1,35 +1,49 @@
 #include "fujinet/io/transport/fujibus_transport.h"
+#include "fujinet/io/protocol/fuji_bus_frame_encoder.h"
 #include "fujinet/io/protocol/fuji_bus_packet.h"
 #include "fujinet/io/protocol/wire_device_ids.h"
 
 #include "fujinet/core/logging.h"
 #include "fujinet/core/utils.h"
 
-#include <algorithm>  // for std::find
+#include <optional>
 
 namespace fujinet::io {
 
 static constexpr const char* TAG = "fujibus";
 
 using fujinet::core::log_hexdump;
-using fujinet::io::protocol::FujiBusPacket;
-using fujinet::io::protocol::ByteBuffer;
-using fujinet::io::protocol::SlipByte;
+using fujinet::io::protocol::FujiBusFrameDecoder;
+using fujinet::io::protocol::PacketParam;
+using fujinet::io::protocol::encode_frame;
 using fujinet::io::protocol::WireDeviceId;
 
 void FujiBusTransport::poll()
 {
     std::uint8_t temp[256];
 
+    // Bytes are SLIP-decoded and checksummed as they arrive; complete frames
+    // queue up inside the decoder until receive() picks them up.
     while (_channel.available()) {
         std::size_t n = _channel.read(temp, sizeof(temp));
         if (n == 0) {
             break;
         }
-        _rxBuffer.insert(_rxBuffer.end(), temp, temp + n);
+        _decoder.feed(temp, n);
     }
 
-    // All framing is handled in receive() via SLIP + FujiBusPacket.
+    log_dropped_frames();
+}
+
+void FujiBusTransport::log_dropped_frames()
+{
+    const std::uint32_t dropped = _decoder.droppedFrames();
+    if (dropped != _droppedFrames) {
+        FN_LOGW(TAG, "invalid FujiBus frame (%s), dropped %u",
+                FujiBusFrameDecoder::to_string(_decoder.lastError()),
+                (unsigned)(dropped - _droppedFrames));
+        _droppedFrames = dropped;
+    }
 }
 
 bool FujiBusTransport::supports_work_wait() const
@@ -37,100 +51,63 @@ bool FujiBusTransport::supports_work_wait() const
     return _channel.supports_readable_wait();
 }
 
-bool FujiBusTransport::wait_for_work(std::chrono::milliseconds timeout)
+void FujiBusTransport::add_wait_sources(WaitSet& ws)
 {
-    if (!_rxBuffer.empty()) {
-        return true;
+    if (_decoder.hasFrame()) {
+        ws.wake_now();
+        return;
     }
-    return _channel.wait_for_readable(timeout);
+    _channel.add_wait_sources(ws);
 }
 
-// Helper: try to extract a single SLIP-framed message from _rxBuffer.
-// We look for: SlipByte::End ... SlipByte::End, and return that span (inclusive).
-static bool extractSlipFrame(std::vector<std::uint8_t>& buffer, ByteBuffer& outFrame)
+bool FujiBusTransport::wait_for_work(std::chrono::milliseconds timeout)
 {
-    // Find the first END marker.
-    auto startIt = std::find(
-        buffer.begin(),
-        buffer.end(),
-        to_byte(SlipByte::End)
-    );
-    if (startIt == buffer.end()) {
-        // No START/END marker yet.
-        return false;
-    }
-
-    // Find the next END marker after start.
-    auto endIt = std::find(
-        std::next(startIt),
-        buffer.end(),
-        to_byte(SlipByte::End)
-    );
-    if (endIt == buffer.end()) {
-        // We have a start but no complete frame yet.
-        // Optionally: discard noise before startIt.
-        if (startIt != buffer.begin()) {
-            buffer.erase(buffer.begin(), startIt);
-        }
-        return false;
+    if (_decoder.hasFrame()) {
+        return true;
     }
-
-    // We have a complete frame: [startIt, endIt].
-    outFrame.clear();
-    outFrame.insert(outFrame.end(), startIt, std::next(endIt));
-
-    // Erase everything up to and including endIt from the buffer.
-    buffer.erase(buffer.begin(), std::next(endIt));
-    return true;
+    return _channel.wait_for_readable(timeout);
 }
 
 // SLIP + FujiBus framing:
 //
-//  - poll() accumulates raw bytes from the Channel into _rxBuffer.
-//  - receive() looks for one full SLIP frame (END ... END).
-//  - FujiBusPacket::fromSerialized() parses that into a FujiBusPacket.
-//  - We then map FujiBusPacket → IORequest.
+//  - poll() streams raw bytes from the Channel through FujiBusFrameDecoder.
+//  - receive() pops one decoded, checksum-verified frame.
+//  - We then map the frame → IORequest. The payload vector is swapped, not
+//    copied, so the bytes devices see are the ones the decoder wrote.
 bool FujiBusTransport::receive(IORequest& outReq)
 {
-    ByteBuffer frame;
-    if (!extractSlipFrame(_rxBuffer, frame)) {
-        // No complete SLIP frame yet.
-        return false;
-    }
-
-    auto packetPtr = FujiBusPacket::fromSerialized(frame);
-    if (!packetPtr) {
-        FN_LOGW(TAG, "invalid FujiBus frame (response), dropped");
-        if (!frame.empty()) {
-            FN_LOGW(TAG, "  raw frame (%zu bytes):", frame.size());
-            log_hexdump(TAG, frame.data(), frame.size());
-        }
+    if (!_decoder.next(_frame)) {
+        // No complete frame yet.
         return false;
     }
 
-    const FujiBusPacket& packet = *packetPtr;
-
-    // Map FujiBusPacket → IORequest.
+    // Map FujiBusFrame → IORequest.
     outReq.id        = _nextRequestId++;
-    outReq.deviceId  = static_cast<DeviceID>(packet.device());
+    outReq.deviceId  = static_cast<DeviceID>(_frame.device);
     outReq.type      = RequestType::Command; // FujiBus operations are all "commands" at this level.
-    outReq.command   = static_cast<std::uint16_t>(packet.command());
+    outReq.command   = static_cast<std::uint16_t>(_frame.command);
 
     outReq.params.clear();
-    outReq.params.reserve(packet.paramCount());
-    for (unsigned int i = 0; i < packet.paramCount(); ++i) {
-        outReq.params.push_back(packet.param(i));
+    for (const auto& p : _frame.params) {
+        outReq.params.push_back(p.value);
     }
 
-    outReq.payload.clear();
-    if (const auto& dataOpt = packet.data()) {
-        outReq.payload.insert(outReq.payload.end(), dataOpt->begin(), dataOpt->end());
+    // Hand the decoded payload to the request; the request's previous buffer
+    // goes back to the decoder for reuse on the next frame.
+    outReq.payload.swap(_frame.payload);
+
+    // Pipelined host: remember the wire tag so send() can echo it. A host
+    // that correlates by tag can also wait for a deferred (late) answer.
+    outReq.deferrable = _frame.tagged;
+    if (_frame.tagged) {
+        _outstandingTags.push_back(OutstandingTag{outReq.id, _frame.tag});
     }
 
     // TODO: change to LOGD to reduce noise after initial debugging
     FN_LOGI(TAG,
-        "receive: id=%u dev=0x%02X cmd=0x%02X params=%u payload=%u",
+        "receive: id=%u tag=%d dev=0x%02X cmd=0x%02X params=%u payload=%u",
         (unsigned)outReq.id,
+        _frame.tagged ? (int)_frame.tag : -1,
         (unsigned)outReq.deviceId,
         (unsigned)(outReq.command & 0xFF),
         (unsigned)outReq.params.size(),
@@ -168,9 +145,6 @@ void FujiBusTransport::send(const IOResponse& resp)
     }
 #endif
 
-    // Payload is the device-specific protocol blob.
-    ByteBuffer data(resp.payload.begin(), resp.payload.end());
-
     // FujiBus uses an 8-bit command on-wire.
     const auto dev = static_cast<WireDeviceId>(resp.deviceId);
     const auto cmd = static_cast<std::uint8_t>(resp.command & 0xFF);
@@ -178,48 +152,51 @@ void FujiBusTransport::send(const IOResponse& resp)
     // Convention (transport-local):
     //  - param[0] = status (u8)
     //  - data     = device payload (opaque to transport)
-    FujiBusPacket packet(dev, cmd);
-    packet.addParamU8(static_cast<std::uint8_t>(resp.status))
-          .setData(std::move(data));
+    //
+    // The payload is checksummed and SLIP-escaped straight from resp into
+    // the reusable TX buffer; no intermediate packet is built.
+    std::optional<std::uint8_t> tag;
+    for (std::size_t i = 0; i < _outstandingTags.size(); ++i) {
+        if (_outstandingTags[i].id == resp.id) {
+            tag = _outstandingTags[i].tag;
+            _outstandingTags[i] = _outstandingTags.back();
+            _outstandingTags.pop_back();
+            break;
+        }
+    }
 
-    ByteBuffer serialized = packet.serialize();
-    if (!serialized.empty()) {
-        _channel.write(serialized.data(), serialized.size());
+    const PacketParam status{static_cast<std::uint8_t>(resp.status)};
+    if (!encode_frame(_txBuffer, dev, cmd, &status, 1,
+                      resp.payload.data(), resp.payload.size(), tag)) {
+        FN_LOGE(TAG, "send: response too large for FujiBus (%u bytes), dropped",
+                (unsigned)resp.payload.size());
+        return;
     }
+
+    _channel.write(_txBuffer.data(), _txBuffer.size());
 }
 
 bool FujiBusTransport::receiveResponse(IOResponse& outResp)
 {
-    ByteBuffer frame;
-    if (!extractSlipFrame(_rxBuffer, frame)) {
-        return false;
-    }
-
-    auto packetPtr = FujiBusPacket::fromSerialized(frame);
-    if (!packetPtr) {
-        FN_LOGW(TAG, "invalid FujiBus frame (response), dropped");
+    if (!_decoder.next(_frame)) {
         return false;
     }
 
-    const FujiBusPacket& packet = *packetPtr;
-
-    outResp.id       = _nextRequestId++; // still synthetic (no on-wire correlation yet)
-    outResp.deviceId = static_cast<DeviceID>(packet.device());
-    outResp.command  = static_cast<std::uint16_t>(packet.command());
+    // Tagged (pipelined) responses carry their correlation on the wire;
+    // untagged ones still get a synthetic id.
+    outResp.id       = _frame.tagged ? static_cast<RequestID>(_frame.tag) : _nextRequestId++;
+    outResp.deviceId = static_cast<DeviceID>(_frame.device);
+    outResp.command  = static_cast<std::uint16_t>(_frame.command);
 
     // Convention: param[0] is status (u8)
-    std::uint8_t st = static_cast<std::uint8_t>(StatusCode::InternalError);
-    if (!packet.tryParamU8(0, st)) {
+    if (_frame.params.empty() || _frame.params[0].size != 1) {
         FN_LOGW(TAG, "response missing status param[0] u8; defaulting InternalError");
         outResp.status = StatusCode::InternalError;
     } else {
-        outResp.status = static_cast<StatusCode>(st);
+        outResp.status = static_cast<StatusCode>(_frame.params[0].value & 0xFF);
     }
 
-    outResp.payload.clear();
-    if (const auto& dataOpt = packet.data()) {
-        outResp.payload.insert(outResp.payload.end(), dataOpt->begin(), dataOpt->end());
-    }
+    outResp.payload.swap(_frame.payload);
 
     FN_LOGI(TAG,
         "receiveResponse: id=%u dev=0x%02X cmd=0x%02X status=%u payload=%u",
@@ -15,10 +15,15 @@ void FujinetCore::tick()
     // 1. Let transports process I/O.
     _ioService.serviceOnce();
 
-    // 2. Let devices do background work.
+    // 2. Let devices do background work, then answer any deferred
+    //    requests that finished during it.
     _deviceManager.pollDevices();
+    _ioService.deliverCompletions();
 
-    // 3. Increment tick counter for diagnostics.
+    // 3. Filesystem housekeeping (TNFS keep-alives, index saves).
+    _storageManager.poll();
+
+    // 4. Increment tick counter for diagnostics.
     ++_tickCount;
 }
 
@@ -32,6 +37,12 @@ bool FujinetCore::waitForWork(std::chrono::milliseconds timeout)
     return _ioService.waitForWork(timeout);
 }
 
+void FujinetCore::addWaitSources(io::WaitSet& ws)
+{
+    _ioService.addWaitSources(ws);
+    _deviceManager.addWaitSources(ws);
+}
+
 void FujinetCore::addTransport(io::ITransport* transport)
 {
     _ioService.addTransport(transport);
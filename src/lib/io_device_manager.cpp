@@ -53,6 +53,27 @@ IOResponse IODeviceManager::handleRequest(const IORequest& request)
     return devResp;
 }
 
+bool IODeviceManager::takeCompletedResponse(IOResponse& out)
+{
+    for (auto& [id, dev] : _devices) {
+        if (dev && dev->take_completed(out)) {
+            out.deviceId = id;
+            return true;
+        }
+    }
+    return false;
+}
+
+void IODeviceManager::addWaitSources(WaitSet& ws)
+{
+    for (auto& [id, dev] : _devices) {
+        (void)id;
+        if (dev) {
+            dev->add_wait_sources(ws);
+        }
+    }
+}
+
 void IODeviceManager::pollDevices()
 {
     for (auto& [id, dev] : _devices) {
@@ -1,7 +1,11 @@
 #include "fujinet/io/transport/io_service.h"
 
+#include "fujinet/core/logging.h"
+
 namespace fujinet::io {
 
+static constexpr const char* TAG = "io";
+
 void IOService::serviceOnce()
 {
     // Let each transport do any internal background work.
@@ -11,6 +15,8 @@ void IOService::serviceOnce()
         }
     }
 
+    deliverCompletions();
+
     // Process all available requests on each transport.
     for (auto* t : _transports) {
         if (!t) {
@@ -20,11 +26,53 @@ void IOService::serviceOnce()
         IORequest req;
         while (t->receive(req)) {
             IOResponse resp = _handler.handleRequest(req);
+            if (resp.status == StatusCode::Pending) {
+                if (req.deferrable) {
+                    _pending.push_back(PendingRequest{t, req.id, req.deviceId});
+                    continue;
+                }
+                // Device broke the contract; don't leak Pending onto the wire.
+                resp.status = StatusCode::InternalError;
+            }
             t->send(resp);
         }
     }
 }
 
+void IOService::deliverCompletions()
+{
+    IOResponse resp;
+    while (_handler.takeCompletedResponse(resp)) {
+        auto it = _pending.begin();
+        for (; it != _pending.end(); ++it) {
+            if (it->id == resp.id && it->deviceId == resp.deviceId) {
+                break;
+            }
+        }
+        if (it == _pending.end()) {
+            FN_LOGW(TAG, "dropping completion for unknown request id=%u dev=0x%02X",
+                    (unsigned)resp.id, (unsigned)resp.deviceId);
+            continue;
+        }
+
+        ITransport* t = it->transport;
+        _pending.erase(it);
+        if (resp.status == StatusCode::Pending) {
+            resp.status = StatusCode::InternalError;
+        }
+        t->send(resp);
+    }
+}
+
+void IOService::addWaitSources(WaitSet& ws)
+{
+    for (auto* t : _transports) {
+        if (t) {
+            t->add_wait_sources(ws);
+        }
+    }
+}
+
 bool IOService::hasWaitableWorkSource() const
 {
     for (auto* t : _transports) {
@@ -1,14 +1,14 @@
 #include "fujinet/io/devices/json_content_translator.h"
 
-#include "cJSON.h"
-#include "cJSON_Utils.h"
-
 #include <algorithm>
+#include <cctype>
 #include <cmath>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <iomanip>
 #include <sstream>
+#include <string_view>
 
 namespace fujinet::io {
 
@@ -20,49 +20,50 @@ bool is_approx_integer(double v)
     return std::modf(v, &i) == 0.0 && v >= -9007199254740992.0 && v <= 9007199254740992.0;
 }
 
-std::string json_item_to_string(cJSON* item)
+std::string number_to_string(double num)
 {
-    if (!item) return {};
-
     std::ostringstream ss;
-
-    if (cJSON_IsString(item)) {
-        char* s = cJSON_GetStringValue(item);
-        if (s) ss << s;
-    } else if (cJSON_IsBool(item)) {
-        ss << (cJSON_IsTrue(item) ? "TRUE" : "FALSE");
-    } else if (cJSON_IsNull(item)) {
-        ss << "NULL";
-    } else if (cJSON_IsNumber(item)) {
-        double num = cJSON_GetNumberValue(item);
-        if (is_approx_integer(num)) {
-            ss << static_cast<std::int64_t>(num);
-        } else {
-            ss << std::setprecision(10) << num;
-        }
-    } else if (cJSON_IsObject(item)) {
-        cJSON* child = item->child;
-        if (child) {
-            do {
-                ss << child->string << "\n" << json_item_to_string(child);
-                if (child->next) ss << "\n";
-            } while ((child = child->next) != nullptr);
-        }
-    } else if (cJSON_IsArray(item)) {
-        cJSON* child = item->child;
-        bool first = true;
-        if (child) {
-            do {
-                if (!first) ss << "\n";
-                ss << json_item_to_string(child);
-                first = false;
-            } while ((child = child->next) != nullptr);
-        }
+    if (is_approx_integer(num)) {
+        ss << static_cast<std::int64_t>(num);
+    } else {
+        ss << std::setprecision(10) << num;
     }
-
     return ss.str();
 }
 
+bool is_whitespace(std::uint8_t c)
+{
+    return c <= 0x20;
+}
+
+bool is_number_char(std::uint8_t c)
+{
+    return (c >= '0' && c <= '9') || c == '+' || c == '-' || c == '.' || c == 'e' || c == 'E';
+}
+
+int hex_value(std::uint8_t c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool same_ascii_nocase(std::uint8_t a, std::uint8_t b)
+{
+    return std::tolower(a) == std::tolower(b);
+}
+
+bool equal_nocase(std::string_view a, std::string_view b)
+{
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return same_ascii_nocase(static_cast<std::uint8_t>(x), static_cast<std::uint8_t>(y));
+           });
+}
+
+constexpr std::uint8_t UTF8_BOM[3] = {0xEF, 0xBB, 0xBF};
+
 } // namespace
 
 StatusCode JsonContentTranslator::configure(const TranslationConfig& config)
@@ -72,14 +73,72 @@ StatusCode JsonContentTranslator::configure(const TranslationConfig& config)
     }
 
     _config = config;
-    _body.clear();
-    _translated.clear();
+    parse_pointer(_config.selector, _tokens);
+    reset();
     return StatusCode::Ok;
 }
 
+// "/a/b/0" -> {"a", "b", "0"}; parsing stops at the first token that isn't
+// introduced by '/', like cJSONUtils_GetPointer().
+void JsonContentTranslator::parse_pointer(const std::string& p, std::vector<Token>& tokens)
+{
+    tokens.clear();
+    std::size_t i = 0;
+    while (i < p.size() && p[i] == '/') {
+        ++i;
+        Token t;
+        bool digits = true;
+        std::size_t len = 0;
+        const std::size_t start = i;
+        while (i < p.size() && p[i] != '/') {
+            const char c = p[i];
+            digits = digits && c >= '0' && c <= '9';
+            if (c == '~') {
+                if (i + 1 < p.size() && (p[i + 1] == '0' || p[i + 1] == '1')) {
+                    t.key.push_back(p[i + 1] == '0' ? '~' : '/');
+                    ++i;
+                } else {
+                    t.keyValid = false;
+                }
+            } else {
+                t.key.push_back(c);
+            }
+            ++i;
+            ++len;
+        }
+
+        // An empty token indexes element 0, as in cJSON.
+        if (digits && len <= 9 && !(len > 1 && p[start] == '0')) {
+            t.hasIndex = true;
+            t.index = static_cast<std::uint32_t>(len == 0 ? 0 : std::strtoul(p.c_str() + start, nullptr, 10));
+        }
+        tokens.push_back(std::move(t));
+    }
+}
+
 void JsonContentTranslator::reset()
 {
-    _body.clear();
+    _state = State::Value;
+    _stack.clear();
+    _started = false;
+    _bomSeen = 0;
+    _inKey = false;
+    _keyMatches = false;
+    _keyPos = 0;
+    _unicode = 0;
+    _highSurrogate = 0;
+    _hexDigits = 0;
+    _numberLen = 0;
+    _literal = nullptr;
+    _literalPos = 0;
+    _emitDepth = -1;
+    _found = false;
+    _offset = 0;
+    _pos = 0;
+    _docBegin = 0;
+    _docEnd = 0;
+    _indexValid = _indexEnabled;
+    _containers.clear();
     _translated.clear();
 }
 
@@ -93,25 +152,555 @@ StatusCode JsonContentTranslator::append_body(const std::uint8_t* data, std::siz
         return StatusCode::InvalidRequest;
     }
 
-    _body.append(reinterpret_cast<const char*>(data), len);
+    for (std::size_t i = 0; i < len && _state != State::Done && _state != State::Error; ++i) {
+        _pos = _offset + static_cast<std::uint32_t>(i);
+        while (!step(data[i])) {
+        }
+    }
+    _offset += static_cast<std::uint32_t>(len);
     return StatusCode::Ok;
 }
 
 StatusCode JsonContentTranslator::finalize()
 {
+    if (_state == State::Number) {
+        _pos = _offset;
+        finish_number();
+    }
+
+    // A truncated document is as malformed as a broken one.
+    if (_state != State::Done) {
+        fail();
+    }
+
+    _stack.clear();
+    _stack.shrink_to_fit();
+    return StatusCode::Ok;
+}
+
+// Consumes `c`, or returns false if it ended a number and must be fed again.
+bool JsonContentTranslator::step(std::uint8_t c)
+{
+    switch (_state) {
+        case State::Value:
+            if (!_started && c == UTF8_BOM[_bomSeen]) {
+                _bomSeen = static_cast<std::uint8_t>(_bomSeen + 1);
+                _started = _bomSeen == sizeof(UTF8_BOM);
+                return true;
+            }
+            _started = true;
+            if (!is_whitespace(c)) {
+                begin_value(c);
+            }
+            return true;
+
+        case State::ArrayFirst:
+            if (is_whitespace(c)) {
+                return true;
+            }
+            if (c == ']') {
+                close_container();
+            } else {
+                begin_value(c);
+            }
+            return true;
+
+        case State::ObjectFirst:
+        case State::ObjectKey:
+            if (is_whitespace(c)) {
+                return true;
+            }
+            if (c == '"') {
+                begin_key();
+            } else if (c == '}' && _state == State::ObjectFirst) {
+                close_container();
+            } else {
+                fail();
+            }
+            return true;
+
+        case State::Colon:
+            if (is_whitespace(c)) {
+                return true;
+            }
+            if (c == ':') {
+                _state = State::Value;
+            } else {
+                fail();
+            }
+            return true;
+
+        case State::AfterValue: {
+            if (is_whitespace(c)) {
+                return true;
+            }
+            const bool array = _stack.back().array;
+            if (c == ',') {
+                _state = array ? State::Value : State::ObjectKey;
+            } else if ((c == ']' && array) || (c == '}' && !array)) {
+                close_container();
+            } else {
+                fail();
+            }
+            return true;
+        }
+
+        case State::String:
+            if (c == '"') {
+                if (_inKey) {
+                    end_key();
+                } else {
+                    end_value();
+                }
+            } else if (c == '\\') {
+                _state = State::Escape;
+            } else {
+                put(c);
+            }
+            return true;
+
+        case State::Escape:
+            _state = State::String;
+            switch (c) {
+                case '"':
+                case '\\':
+                case '/': put(c); break;
+                case 'b': put('\b'); break;
+                case 'f': put('\f'); break;
+                case 'n': put('\n'); break;
+                case 'r': put('\r'); break;
+                case 't': put('\t'); break;
+                case 'u':
+                    _unicode = 0;
+                    _hexDigits = 0;
+                    _state = State::Unicode;
+                    break;
+                default:
+                    fail();
+                    break;
+            }
+            return true;
+
+        case State::Unicode: {
+            const int v = hex_value(c);
+            if (v < 0) {
+                fail();
+                return true;
+            }
+            _unicode = (_unicode << 4) | static_cast<std::uint32_t>(v);
+            if (++_hexDigits < 4) {
+                return true;
+            }
+
+            const bool low = _unicode >= 0xDC00 && _unicode <= 0xDFFF;
+            if (_highSurrogate != 0) {
+                if (!low) {
+                    fail();
+                    return true;
+                }
+                put_codepoint(0x10000 + ((_highSurrogate - 0xD800) << 10) + (_unicode - 0xDC00));
+                _highSurrogate = 0;
+                _state = State::String;
+            } else if (low) {
+                fail();
+            } else if (_unicode >= 0xD800 && _unicode <= 0xDBFF) {
+                _highSurrogate = _unicode;
+                _hexDigits = 0;
+                _state = State::LowSurrogate;
+            } else {
+                put_codepoint(_unicode);
+                _state = State::String;
+            }
+            return true;
+        }
+
+        case State::LowSurrogate:
+            // _hexDigits counts the "\u" characters seen so far.
+            if (_hexDigits == 0 && c == '\\') {
+                _hexDigits = 1;
+            } else if (_hexDigits == 1 && c == 'u') {
+                _unicode = 0;
+                _hexDigits = 0;
+                _state = State::Unicode;
+            } else {
+                fail();
+            }
+            return true;
+
+        case State::Number:
+            if (is_number_char(c)) {
+                if (_numberLen >= MAX_NUMBER) {
+                    fail();
+                } else {
+                    _number[_numberLen++] = static_cast<char>(c);
+                }
+                return true;
+            }
+            finish_number();
+            return _state == State::Error;
+
+        case State::Literal:
+            if (c != static_cast<std::uint8_t>(_literal[_literalPos])) {
+                fail();
+                return true;
+            }
+            if (_literal[++_literalPos] == '\0') {
+                if (emitting()) {
+                    for (const char* l = _literal; *l; ++l) {
+                        _translated.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(*l))));
+                    }
+                }
+                end_value();
+            }
+            return true;
+
+        case State::Done:
+        case State::Error:
+            return true;
+    }
+
+    return true;
+}
+
+void JsonContentTranslator::begin_value(std::uint8_t c)
+{
+    // Decide whether this value lies on the selector path before opening it.
+    const std::size_t depth = _stack.size();
+    bool onPath = depth == 0;
+    if (depth > 0) {
+        Frame& parent = _stack.back();
+        if (parent.array) {
+            if (emitting() && parent.count > 0) {
+                _translated.push_back('\n');
+            }
+            onPath = parent.onPath && !parent.childTaken &&
+                     _tokens[depth - 1].hasIndex && _tokens[depth - 1].index == parent.count;
+            ++parent.count;
+        } else {
+            onPath = _keyMatches;
+        }
+        if (onPath) {
+            parent.childTaken = true;
+        }
+    }
+
+    if (depth == 0) {
+        _docBegin = _pos;
+    }
+
+    if (onPath && depth == _tokens.size() && !_found) {
+        _found = true;
+        _emitDepth = static_cast<long>(depth);
+    }
+
+    switch (c) {
+        case '{':
+        case '[':
+            if (_stack.size() >= MAX_DEPTH) {
+                fail();
+                return;
+            }
+            _stack.push_back(Frame{c == '[', onPath && depth < _tokens.size(), false, 0, NO_SLOT});
+            if (_indexValid) {
+                if (_containers.size() < MAX_INDEX_ENTRIES) {
+                    _stack.back().slot = static_cast<std::uint32_t>(_containers.size());
+                    _containers.push_back(Span{_pos, 0});
+                } else {
+                    _indexValid = false;
+                    std::vector<Span>().swap(_containers);
+                }
+            }
+            _state = c == '[' ? State::ArrayFirst : State::ObjectFirst;
+            return;
+        case '"':
+            _inKey = false;
+            _state = State::String;
+            return;
+        case 't':
+            _literal = "true";
+            break;
+        case 'f':
+            _literal = "false";
+            break;
+        case 'n':
+            _literal = "null";
+            break;
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                _number[0] = static_cast<char>(c);
+                _numberLen = 1;
+                _state = State::Number;
+            } else {
+                fail();
+            }
+            return;
+    }
+
+    _literalPos = 1;
+    _state = State::Literal;
+}
+
+void JsonContentTranslator::begin_key()
+{
+    Frame& f = _stack.back();
+    if (emitting() && f.count > 0) {
+        _translated.push_back('\n');
+    }
+    ++f.count;
+
+    const std::size_t depth = _stack.size();
+    _keyMatches = f.onPath && !f.childTaken && _tokens[depth - 1].keyValid;
+    _keyPos = 0;
+    _inKey = true;
+    _state = State::String;
+}
+
+void JsonContentTranslator::end_key()
+{
+    if (_keyMatches) {
+        _keyMatches = _keyPos == _tokens[_stack.size() - 1].key.size();
+    }
+    _inKey = false;
+    if (emitting()) {
+        _translated.push_back('\n');
+    }
+    _state = State::Colon;
+}
+
+void JsonContentTranslator::close_container()
+{
+    if (_indexValid && _stack.back().slot != NO_SLOT) {
+        _containers[_stack.back().slot].end = _pos + 1;
+    }
+    _stack.pop_back();
+    end_value();
+}
+
+void JsonContentTranslator::end_value()
+{
+    if (_stack.empty()) {
+        // A number ends at the byte after it; everything else on this one.
+        _docEnd = _state == State::Number ? _pos : _pos + 1;
+    }
+    if (emitting() && _stack.size() == static_cast<std::size_t>(_emitDepth)) {
+        _emitDepth = -1;
+    }
+    _state = _stack.empty() ? State::Done : State::AfterValue;
+}
+
+void JsonContentTranslator::put(std::uint8_t c)
+{
+    if (_inKey && _keyMatches) {
+        const std::string& key = _tokens[_stack.size() - 1].key;
+        if (_keyPos < key.size() && same_ascii_nocase(c, static_cast<std::uint8_t>(key[_keyPos]))) {
+            ++_keyPos;
+        } else {
+            _keyMatches = false;
+        }
+    }
+    if (emitting()) {
+        _translated.push_back(static_cast<char>(c));
+    }
+}
+
+void JsonContentTranslator::put_codepoint(std::uint32_t cp)
+{
+    if (cp < 0x80) {
+        put(static_cast<std::uint8_t>(cp));
+    } else if (cp < 0x800) {
+        put(static_cast<std::uint8_t>(0xC0 | (cp >> 6)));
+        put(static_cast<std::uint8_t>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        put(static_cast<std::uint8_t>(0xE0 | (cp >> 12)));
+        put(static_cast<std::uint8_t>(0x80 | ((cp >> 6) & 0x3F)));
+        put(static_cast<std::uint8_t>(0x80 | (cp & 0x3F)));
+    } else {
+        put(static_cast<std::uint8_t>(0xF0 | (cp >> 18)));
+        put(static_cast<std::uint8_t>(0x80 | ((cp >> 12) & 0x3F)));
+        put(static_cast<std::uint8_t>(0x80 | ((cp >> 6) & 0x3F)));
+        put(static_cast<std::uint8_t>(0x80 | (cp & 0x3F)));
+    }
+}
+
+void JsonContentTranslator::finish_number()
+{
+    _number[_numberLen] = '\0';
+    char* end = nullptr;
+    const double num = std::strtod(_number, &end);
+    if (end != _number + _numberLen) {
+        fail();
+        return;
+    }
+    if (emitting()) {
+        _translated += number_to_string(num);
+    }
+    end_value();
+}
+
+void JsonContentTranslator::fail()
+{
+    _state = State::Error;
+    _stack.clear();
+    _emitDepth = -1;
     _translated.clear();
+    _indexValid = false;
+    std::vector<Span>().swap(_containers);
+}
 
-    cJSON* json = cJSON_Parse(_body.c_str());
-    if (!json) {
+// Serializes a complete JSON value (or a quoted key) on its own.
+std::string JsonContentTranslator::translate_whole(std::string_view json, bool& valid)
+{
+    JsonContentTranslator t;
+    t._indexEnabled = false;
+    TranslationConfig cfg;
+    cfg.type = ContentTranslationType::Json;
+    (void)t.configure(cfg);
+    (void)t.append_body(reinterpret_cast<const std::uint8_t*>(json.data()), json.size());
+    (void)t.finalize();
+    valid = t._state == State::Done;
+    return std::move(t._translated);
+}
+
+// One past the end of the value starting at `pos`. The body has already
+// been validated, so this only has to find the boundary.
+std::size_t JsonContentTranslator::value_end(std::string_view body, std::size_t pos) const
+{
+    const char c = body[pos];
+    if (c == '{' || c == '[') {
+        const auto it = std::lower_bound(_containers.begin(), _containers.end(), pos,
+                                         [](const Span& span, std::size_t p) { return span.begin < p; });
+        return it != _containers.end() && it->begin == pos ? it->end : body.size();
+    }
+    if (c == '"') {
+        ++pos;
+        while (pos < body.size() && body[pos] != '"') {
+            pos += body[pos] == '\\' ? 2 : 1;
+        }
+        return std::min(pos + 1, body.size());
+    }
+    while (pos < body.size() && !is_whitespace(static_cast<std::uint8_t>(body[pos])) &&
+           body[pos] != ',' && body[pos] != ']' && body[pos] != '}') {
+        ++pos;
+    }
+    return pos;
+}
+
+// Narrows [begin, end) from a container to its member named by `token`.
+bool JsonContentTranslator::child(std::string_view body,
+                                  const Token& token,
+                                  std::size_t& begin,
+                                  std::size_t& end) const
+{
+    auto skip_ws = [&body](std::size_t p) {
+        while (p < body.size() && is_whitespace(static_cast<std::uint8_t>(body[p]))) {
+            ++p;
+        }
+        return p;
+    };
+
+    const char open = body[begin];
+    const char close = open == '[' ? ']' : '}';
+    if ((open != '[' && open != '{') || (open == '[' && !token.hasIndex)) {
+        return false;
+    }
+
+    std::size_t p = skip_ws(begin + 1);
+    for (std::uint32_t i = 0; p < end && body[p] != close; ++i) {
+        bool match = false;
+        if (open == '[') {
+            match = i == token.index;
+        } else {
+            const std::size_t keyEnd = value_end(body, p);
+            const std::string_view raw = body.substr(p + 1, keyEnd - p - 2);
+            if (token.keyValid) {
+                if (raw.find('\\') == std::string_view::npos) {
+                    match = equal_nocase(raw, token.key);
+                } else {
+                    bool valid = false;
+                    match = equal_nocase(translate_whole(body.substr(p, keyEnd - p), valid), token.key);
+                }
+            }
+            p = skip_ws(skip_ws(keyEnd) + 1); // past ':'
+        }
+
+        const std::size_t valueEnd = value_end(body, p);
+        if (match) {
+            begin = p;
+            end = valueEnd;
+            return true;
+        }
+        p = skip_ws(valueEnd);
+        if (p < end && body[p] == ',') {
+            p = skip_ws(p + 1);
+        }
+    }
+    return false;
+}
+
+StatusCode JsonContentTranslator::query(std::string_view body,
+                                        const std::string& selector,
+                                        std::string& out,
+                                        bool& found) const
+{
+    out.clear();
+    found = false;
+
+    // A malformed document has no values, as in translation.
+    if (_state != State::Done) {
+        return StatusCode::Ok;
+    }
+    if (body.size() < _docEnd) {
+        return StatusCode::InvalidRequest;
+    }
+
+    if (!_indexValid) {
+        // Too many containers to index: scan the body again.
+        JsonContentTranslator t;
+        t._indexEnabled = false;
+        TranslationConfig cfg = _config;
+        cfg.selector = selector;
+        (void)t.configure(cfg);
+        (void)t.append_body(reinterpret_cast<const std::uint8_t*>(body.data()), body.size());
+        (void)t.finalize();
+        found = t._found && t._state == State::Done;
+        out = std::move(t._translated);
         return StatusCode::Ok;
     }
 
-    cJSON* item = cJSONUtils_GetPointer(json, _config.selector.c_str());
-    if (item) {
-        _translated = json_item_to_string(item);
+    std::vector<Token> tokens;
+    parse_pointer(selector, tokens);
+
+    std::size_t begin = _docBegin;
+    std::size_t end = _docEnd;
+    for (const Token& token : tokens) {
+        if (!child(body, token, begin, end)) {
+            return StatusCode::Ok;
+        }
     }
 
-    cJSON_Delete(json);
+    bool valid = false;
+    out = translate_whole(body.substr(begin, end - begin), valid);
+    found = valid;
+    return StatusCode::Ok;
+}
+
+StatusCode JsonContentTranslator::reselect(std::string_view body, const TranslationConfig& config)
+{
+    if (config.type != ContentTranslationType::Json) {
+        return StatusCode::InvalidRequest;
+    }
+
+    std::string out;
+    bool found = false;
+    const StatusCode st = query(body, config.selector, out, found);
+    if (st != StatusCode::Ok) {
+        return st;
+    }
+
+    _config = config;
+    parse_pointer(_config.selector, _tokens);
+    _found = found;
+    _translated = std::move(out);
     return StatusCode::Ok;
 }
 
@@ -1,5 +1,6 @@
 #include "fujinet/io/list_directory_format.h"
 
+#include "fujinet/core/utils.h"
 #include "fujinet/platform/time.h"
 
 #include <algorithm>
@@ -63,8 +64,40 @@ std::string format_mtime_ls(std::chrono::system_clock::time_point tp)
     return std::string(buf);
 }
 
+char fold(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
 } // namespace
 
+bool list_name_matches(std::string_view pattern, std::string_view name)
+{
+    if (pattern.empty()) {
+        return true;
+    }
+    while (true) {
+        const auto bar = pattern.find('|');
+        if (core::glob_match(pattern.substr(0, bar), name)) {
+            return true;
+        }
+        if (bar == std::string_view::npos) {
+            return false;
+        }
+        pattern.remove_prefix(bar + 1);
+    }
+}
+
+bool list_name_contains(std::string_view name, std::string_view needle)
+{
+    if (needle.empty()) {
+        return true;
+    }
+    const auto it = std::search(name.begin(), name.end(), needle.begin(), needle.end(),
+                                [](char a, char b) { return fold(a) == fold(b); });
+    return it != name.end();
+}
+
 std::string format_list_directory_line(
     const fujinet::fs::FileInfo& entry,
     std::string_view basename)
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cstring>
 #include <string>
 #include <string_view>
@@ -58,7 +59,7 @@ void ModemDevice::reset_to_idle()
 
     _cmdMode = true;
     _plusCount = 0;
-    _plusTick = 0;
+    _plusAt = {};
 
     _hostWriteCursor = 0;
     _hostReadCursor = 0;
@@ -66,7 +67,7 @@ void ModemDevice::reset_to_idle()
     _netReadCursor = 0;
 
     _answered = false;
-    _answerAtTick = 0;
+    _answerAt = {};
 
     _cmdBuf.clear();
     _toHost.clear();
@@ -237,8 +238,8 @@ StatusCode ModemDevice::start_listen(std::uint16_t port)
 
     _listenFd = fd;
     _listenPort = port;
-    _lastRingTick = 0;
-    _pendingSinceTick = 0;
+    _lastRing = {};
+    _pendingSince = {};
     return StatusCode::Ok;
 }
 
@@ -253,8 +254,8 @@ void ModemDevice::stop_listen()
         _listenFd = -1;
     }
     _listenPort = 0;
-    _pendingSinceTick = 0;
-    _lastRingTick = 0;
+    _pendingSince = {};
+    _lastRing = {};
 }
 
 void ModemDevice::answer_pending()
@@ -281,7 +282,7 @@ void ModemDevice::answer_pending()
 
     _cmdMode = false;
     _answered = false;
-    _answerAtTick = _tickNow + ANSWER_DELAY_TICKS;
+    _answerAt = std::chrono::steady_clock::now() + ANSWER_DELAY;
 
     if (_useTelnet) {
         telnet_on_connect();
@@ -294,23 +295,23 @@ void ModemDevice::poll_listen()
 
     // If we already have a pending client, ring/time it out.
     if (_pendingFd >= 0) {
-        const std::uint64_t age = _tickNow - _pendingSinceTick;
         if (_autoAnswer) {
             answer_pending();
             return;
         }
 
-        if (age > RING_TIMEOUT_TICKS) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - _pendingSince > RING_TIMEOUT) {
             // Drop the pending caller.
             _sockOps.close(_pendingFd);
             _pendingFd = -1;
-            _pendingSinceTick = 0;
+            _pendingSince = {};
             return;
         }
 
-        if ((_tickNow - _lastRingTick) >= RING_INTERVAL_TICKS) {
+        if (now - _lastRing >= RING_INTERVAL) {
             emit_result_ring();
-            _lastRingTick = _tickNow;
+            _lastRing = now;
         }
 
         return;
@@ -331,8 +332,8 @@ void ModemDevice::poll_listen()
     _sockOps.apply_stream_socket_options(cfd, /*nodelay=*/true, /*keepalive=*/false);
 
     _pendingFd = cfd;
-    _pendingSinceTick = _tickNow;
-    _lastRingTick = _tickNow; // first ring emitted after interval
+    _pendingSince = std::chrono::steady_clock::now();
+    _lastRing = _pendingSince; // first ring emitted after interval
 
     if (_autoAnswer) {
         answer_pending();
@@ -675,7 +676,7 @@ void ModemDevice::process_at_command(std::string_view cmdUpper)
             // connect result is emitted after delay (matches old behavior)
             _cmdMode = false;
             _answered = false;
-            _answerAtTick = _tickNow + ANSWER_DELAY_TICKS;
+            _answerAt = std::chrono::steady_clock::now() + ANSWER_DELAY;
         } else {
             emit_result_no_carrier();
         }
@@ -799,7 +800,7 @@ void ModemDevice::process_host_byte(std::uint8_t b)
     if (b == '+') {
         _plusCount++;
         if (_plusCount >= 3) {
-            _plusTick = _tickNow;
+            _plusAt = std::chrono::steady_clock::now();
         }
     } else {
         _plusCount = 0;
@@ -815,10 +816,36 @@ void ModemDevice::process_host_byte(std::uint8_t b)
 // ----------------------------
 // Device poll + handle()
 // ----------------------------
-void ModemDevice::poll()
+void ModemDevice::add_wait_sources(WaitSet& ws)
 {
-    ++_tickNow;
+    // Incoming calls: only while nothing is waiting to be answered, otherwise
+    // the still-pending backlog entry would keep the listen fd readable.
+    if (_listenFd >= 0 && _pendingFd < 0) {
+        ws.add_readable(_listenFd);
+    }
 
+    // Wake for whichever timer poll() acts on next.
+    const auto now = std::chrono::steady_clock::now();
+    auto due_in = [&ws, now](std::chrono::steady_clock::time_point at) {
+        ws.limit_timeout(std::chrono::ceil<std::chrono::milliseconds>(at - now));
+    };
+    if (_pendingFd >= 0) {
+        due_in(_lastRing + RING_INTERVAL);
+        due_in(_pendingSince + RING_TIMEOUT);
+    }
+    if (!_cmdMode && !_answered && _answerAt > now) {
+        due_in(_answerAt); // once it has passed, CONNECT waits on the socket
+    }
+    if (_plusCount >= 3) {
+        due_in(_plusAt + ESCAPE_GUARD_TIME);
+    }
+
+    // Backpressured TX stays on the idle heartbeat.
+    _tcp.add_wait_sources(ws);
+}
+
+void ModemDevice::poll()
+{
     poll_listen();
 
     // Allow connect progress even before we consider ourselves "connected".
@@ -830,7 +857,7 @@ void ModemDevice::poll()
             close_network();
             _cmdMode = true;
             _answered = false;
-            _answerAtTick = 0;
+            _answerAt = {};
             emit_result_no_carrier();
         }
     }
@@ -838,17 +865,18 @@ void ModemDevice::poll()
     // Emit CONNECT only once, and only after:
     // - our answer delay elapsed, AND
     // - the TCP socket is actually connected (or peer closed after connect).
-    if (!_cmdMode && !_answered && _answerAtTick > 0 && _tickNow >= _answerAtTick) {
+    const auto now = std::chrono::steady_clock::now();
+    if (!_cmdMode && !_answered && _answerAt != std::chrono::steady_clock::time_point{} && now >= _answerAt) {
         if (is_connected()) {
             _answered = true;
-            _answerAtTick = 0;
+            _answerAt = {};
             emit_result_connect();
         }
     }
 
     // escape guard: if we saw "+++" and no other bytes for ~1s, return to command mode
     if (_plusCount >= 3) {
-        if ((_tickNow - _plusTick) > ANSWER_DELAY_TICKS) {
+        if (now - _plusAt > ESCAPE_GUARD_TIME) {
             _plusCount = 0;
             _cmdMode = true;
             emit_result_ok();
@@ -1035,7 +1063,7 @@ IOResponse ModemDevice::handle(const IORequest& request)
                     }
                     _cmdMode = false;
                     _answered = false;
-                    _answerAtTick = _tickNow + ANSWER_DELAY_TICKS;
+                    _answerAt = std::chrono::steady_clock::now() + ANSWER_DELAY;
                     break;
                 }
                 case 0x03: { // listen: u16 port
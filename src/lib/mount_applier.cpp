@@ -133,22 +133,30 @@ std::size_t apply_config_mounts_excluding(
             continue;
         }
 
+        disk::PrefetchMode prefetch = disk::PrefetchMode::Off;
+        if (!disk::parse_prefetch_mode(mount.prefetch, prefetch)) {
+            FN_LOGW(TAG, "Unknown prefetch mode '%s' at slot %d; mounting without prefetch",
+                    mount.prefetch.c_str(), mount.slot);
+        }
+
         // Store the mount config as pending - this is LAZY, not eager!
         // The actual mount will happen on first read/write access.
         // This allows TNFS servers to be unavailable at startup without blocking.
-        FN_LOGI(TAG, "Setting pending mount: slot %d, uri='%s', mode='%s', enabled=%d sector_size_hint=%u",
+        FN_LOGI(TAG, "Setting pending mount: slot %d, uri='%s', mode='%s', enabled=%d sector_size_hint=%u prefetch=%s",
                 slotIndex,
                 mount.uri.c_str(),
                 mount.mode.c_str(),
                 mount.enabled,
-                static_cast<unsigned>(mount.sectorSizeHint));
+                static_cast<unsigned>(mount.sectorSizeHint),
+                disk::prefetch_mode_name(prefetch));
 
         diskService.set_pending_mount(
             runtimeSlot, 
             mount.uri, 
             mount.mode, 
             mount.enabled,
-            mount.sectorSizeHint
+            mount.sectorSizeHint,
+            prefetch
         );
 
         applied++;
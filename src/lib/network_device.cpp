@@ -3,6 +3,7 @@
 #include "fujinet/core/logging.h"
 #include "fujinet/io/core/io_message.h"
 #include "fujinet/io/devices/json_content_translator.h"
+#include "fujinet/io/devices/xml_content_translator.h"
 #include "fujinet/io/devices/network_content_profile.h"
 
 #include "fujinet/io/devices/net_codec.h"
@@ -12,6 +13,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstddef>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -26,11 +28,10 @@ static constexpr std::uint8_t NET_OPEN_FLAG_STREAM_NO_PROBE = 0x10;
 static constexpr std::uint8_t NET_READ_FLAG_EOF = 0x01;
 static constexpr std::uint8_t NET_READ_FLAG_TRUNCATED = 0x02;
 static constexpr std::uint8_t NET_READ_FLAG_MORE_AVAILABLE = 0x04;
-
-static std::vector<std::uint8_t> to_vec(const std::string& s)
-{
-    return std::vector<std::uint8_t>(s.begin(), s.end());
-}
+// version, flags, reserved, handle, offset, dataLen
+static constexpr std::size_t READ_RESPONSE_HEADER = 1 + 1 + 2 + 2 + 4 + 2;
+static constexpr std::uint8_t QUERY_FLAG_FOUND = 0x01;
+static constexpr std::uint8_t QUERY_FLAG_TRUNCATED = 0x02;
 
 static std::string to_lower_ascii(std::string_view s)
 {
@@ -59,13 +60,7 @@ NetworkDevice::NetworkDevice(ProtocolRegistry registry)
 
 void NetworkDevice::poll()
 {
-    ++_tickNow;
-
-    // Shorter timeout for "body upload in progress" sessions so we don't
-    // wedge the session table if the host dies mid-upload.
-    // With a 50ms tick, 20 ticks = 1s.
-    static constexpr std::uint64_t BODY_UPLOAD_TIMEOUT_TICKS = 20ull * 10ull; // ~10s
-
+    const auto now = std::chrono::steady_clock::now();
     for (auto& s : _sessions) {
         if (!s.active || !s.proto) continue;
 
@@ -74,25 +69,64 @@ void NetworkDevice::poll()
 
         // If backend can signal progress/completion later, we can update s.completed
         // and/or touch(s) here when progress is made.
-        // const std::uint64_t age  = _tickNow - s.createdTick;
-        const std::uint64_t idle = _tickNow - s.lastActivityTick;
 
-        // If we're waiting for request body data and the client goes away,
-        // reap quickly to free the session slot.
-        if (s.awaitingBody && idle > BODY_UPLOAD_TIMEOUT_TICKS) {
+        // Reap dead/leaked handles, and sessions whose host went away
+        // mid-upload (shorter timeout), to free the slot.
+        if (now > expires_at(s)) {
             close_and_free(s);
-            continue;
         }
+    }
 
-        // Reap dead/leaked handles:
-        // - Enforce idle timeout
-        if (idle > IDLE_TIMEOUT_TICKS) {
-            close_and_free(s);
+    service_deferred();
+}
+
+void NetworkDevice::add_wait_sources(WaitSet& ws)
+{
+    const auto now = std::chrono::steady_clock::now();
+    for (auto& s : _sessions) {
+        if (s.active && s.proto) {
+            s.proto->add_wait_sources(ws);
+            ws.limit_timeout(std::chrono::ceil<std::chrono::milliseconds>(expires_at(s) - now));
+        }
+    }
+
+    if (!_completed.empty()) {
+        ws.wake_now();
+    }
+
+    // Parked requests are re-run whenever a backend fd wakes the loop; the
+    // deadline only matters for answering NotReady on time.
+    for (const auto& d : _deferred) {
+        ws.limit_timeout(std::chrono::duration_cast<std::chrono::milliseconds>(d.deadline - now));
+    }
+}
+
+void NetworkDevice::service_deferred()
+{
+    const auto now = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < _deferred.size();) {
+        DeferredRequest& d = _deferred[i];
+        IOResponse resp = handle_now(d.request);
+        if (resp.status == StatusCode::NotReady && now < d.deadline) {
+            ++i;
+            continue;
         }
+        _completed.push_back(std::move(resp));
+        _deferred.erase(_deferred.begin() + static_cast<std::ptrdiff_t>(i));
     }
 }
 
-static void write_common_prefix(std::string& out, std::uint8_t version, std::uint8_t flags)
+bool NetworkDevice::take_completed(IOResponse& out)
+{
+    if (_completed.empty()) {
+        return false;
+    }
+    out = std::move(_completed.front());
+    _completed.pop_front();
+    return true;
+}
+
+static void write_common_prefix(netproto::Writer& out, std::uint8_t version, std::uint8_t flags)
 {
     netproto::write_u8(out, version);
     netproto::write_u8(out, flags);
@@ -242,7 +276,7 @@ std::unique_ptr<IContentTranslator> NetworkDevice::make_translator(ContentTransl
             return std::make_unique<JsonContentTranslator>();
         case ContentTranslationType::Xml:
         case ContentTranslationType::Rss:
-            return nullptr;
+            return std::make_unique<XmlContentTranslator>();
     }
 
     return nullptr;
@@ -258,6 +292,10 @@ void NetworkDevice::reset_translation(Session& s) noexcept
     s.responseBodyCache.clear();
     s.responseBodyCached = false;
     s.responseBodyBuffering = false;
+    s.responseBodyRead = 0;
+    s.responseBodyComplete = false;
+    s.responseBodyDropped = false;
+    s.translatorPrimed = false;
     s.translationReady = false;
     s.translatedResultSize = 0;
 }
@@ -268,18 +306,37 @@ StatusCode NetworkDevice::configure_translation(Session& s, const TranslationCon
         return StatusCode::InvalidRequest;
     }
 
-    std::string cachedBody;
-    const bool hadCachedBody = s.responseBodyCached;
-    if (hadCachedBody) {
-        cachedBody = std::move(s.responseBodyCache);
+    // Another selector over a body the translator has already seen: let it
+    // answer from what it kept (e.g. the JSON container index) instead of
+    // another pass over the body.
+    if (config.enabled() && translation_enabled(s) && s.translation.type == config.type &&
+        s.translationReady && s.responseBodyCached) {
+        const StatusCode st = s.translator->reselect(s.responseBodyCache, config);
+        if (st == StatusCode::Ok) {
+            s.translation = config;
+            s.translatedResultSize = s.translator->translated_size();
+            return StatusCode::Ok;
+        }
+        if (st != StatusCode::Unsupported) {
+            return st;
+        }
     }
 
+    // Whatever has been read of the body stays with the session; the new
+    // translator starts over from the retained copy.
+    std::string cachedBody = std::move(s.responseBodyCache);
+    const bool cached = s.responseBodyCached;
+    const std::uint32_t bodyRead = s.responseBodyRead;
+    const bool complete = s.responseBodyComplete;
+    const bool dropped = s.responseBodyDropped;
+
     reset_translation(s);
 
-    if (hadCachedBody) {
-        s.responseBodyCache = std::move(cachedBody);
-        s.responseBodyCached = true;
-    }
+    s.responseBodyCache = std::move(cachedBody);
+    s.responseBodyCached = cached;
+    s.responseBodyRead = bodyRead;
+    s.responseBodyComplete = complete;
+    s.responseBodyDropped = dropped;
 
     if (!config.enabled()) {
         return StatusCode::Ok;
@@ -310,6 +367,10 @@ StatusCode NetworkDevice::buffer_translation_body(Session& s)
         return StatusCode::Ok;
     }
 
+    if (s.responseBodyDropped) {
+        return StatusCode::Unsupported;
+    }
+
     s.responseBodyBuffering = true;
     std::uint8_t tmp[4096];
 
@@ -318,7 +379,7 @@ StatusCode NetworkDevice::buffer_translation_body(Session& s)
         bool chunkEof = false;
         bool chunkMoreAvailable = false;
         const StatusCode st = s.proto->read_body(
-            static_cast<std::uint32_t>(s.responseBodyCache.size()),
+            s.responseBodyRead,
             tmp,
             sizeof(tmp),
             chunk,
@@ -331,9 +392,11 @@ StatusCode NetworkDevice::buffer_translation_body(Session& s)
 
         if (chunk > 0) {
             s.responseBodyCache.append(reinterpret_cast<const char*>(tmp), chunk);
+            s.responseBodyRead += chunk;
         }
 
         if (chunkEof) {
+            s.responseBodyComplete = true;
             s.responseBodyCached = true;
             s.responseBodyBuffering = false;
             return StatusCode::Ok;
@@ -346,19 +409,88 @@ StatusCode NetworkDevice::buffer_translation_body(Session& s)
     }
 }
 
+StatusCode NetworkDevice::stream_translation_body(Session& s)
+{
+    if (!translation_enabled(s)) {
+        return StatusCode::InvalidRequest;
+    }
+
+    if (!s.translatorPrimed) {
+        if (s.responseBodyDropped) {
+            // The start of the body is gone; only the first selector could see it.
+            return StatusCode::Unsupported;
+        }
+        s.translator->reset();
+        const StatusCode appendSt = s.translator->append_body(
+            reinterpret_cast<const std::uint8_t*>(s.responseBodyCache.data()),
+            s.responseBodyCache.size());
+        if (appendSt != StatusCode::Ok) {
+            return appendSt;
+        }
+        s.translatorPrimed = true;
+    }
+
+    std::uint8_t tmp[4096];
+
+    while (!s.responseBodyComplete) {
+        std::uint16_t chunk = 0;
+        bool chunkEof = false;
+        bool chunkMoreAvailable = false;
+        const StatusCode st = s.proto->read_body(
+            s.responseBodyRead,
+            tmp,
+            sizeof(tmp),
+            chunk,
+            chunkEof,
+            chunkMoreAvailable);
+        if (st != StatusCode::Ok) {
+            return st;
+        }
+
+        if (chunk > 0) {
+            const StatusCode appendSt = s.translator->append_body(tmp, chunk);
+            if (appendSt != StatusCode::Ok) {
+                return appendSt;
+            }
+            s.responseBodyRead += chunk;
+
+            if (!s.responseBodyDropped) {
+                if (s.responseBodyCache.size() + chunk <= MAX_RETAINED_TRANSLATION_BODY) {
+                    s.responseBodyCache.append(reinterpret_cast<const char*>(tmp), chunk);
+                } else {
+                    s.responseBodyDropped = true;
+                    std::string().swap(s.responseBodyCache);
+                }
+            }
+        }
+
+        if (chunkEof) {
+            s.responseBodyComplete = true;
+            s.responseBodyCached = !s.responseBodyDropped;
+        } else if (chunk == 0) {
+            return StatusCode::NotReady;
+        }
+    }
+
+    return finalize_translation(s);
+}
+
 StatusCode NetworkDevice::finalize_translation(Session& s)
 {
     if (!translation_enabled(s)) {
         return StatusCode::InvalidRequest;
     }
 
-    s.translator->reset();
-    const StatusCode appendSt = s.translator->append_body(
-        reinterpret_cast<const std::uint8_t*>(s.responseBodyCache.data()),
-        s.responseBodyCache.size());
-    if (appendSt != StatusCode::Ok) {
-        s.translationReady = false;
-        return appendSt;
+    // Streaming translators have already been fed by stream_translation_body().
+    if (s.translator->needs_full_body()) {
+        s.translator->reset();
+        const StatusCode appendSt = s.translator->append_body(
+            reinterpret_cast<const std::uint8_t*>(s.responseBodyCache.data()),
+            s.responseBodyCache.size());
+        if (appendSt != StatusCode::Ok) {
+            s.translationReady = false;
+            return appendSt;
+        }
     }
 
     const StatusCode finalizeSt = s.translator->finalize();
@@ -382,6 +514,10 @@ StatusCode NetworkDevice::ensure_translation_ready(Session& s)
         return StatusCode::Ok;
     }
 
+    if (!s.translator->needs_full_body()) {
+        return stream_translation_body(s);
+    }
+
     const StatusCode bufferSt = buffer_translation_body(s);
     if (bufferSt != StatusCode::Ok) {
         return bufferSt;
@@ -391,6 +527,27 @@ StatusCode NetworkDevice::ensure_translation_ready(Session& s)
 }
 
 IOResponse NetworkDevice::handle(const IORequest& request)
+{
+    IOResponse resp = handle_now(request);
+    if (resp.status != StatusCode::NotReady || !request.deferrable) {
+        return resp;
+    }
+
+    // Only pure queries are safe to re-run from poll().
+    const auto cmd = protocol::to_network_command(request.command);
+    const bool query = cmd == NetworkCommand::Info
+                    || cmd == NetworkCommand::InfoRead
+                    || cmd == NetworkCommand::Read
+                    || cmd == NetworkCommand::TranslateQuery;
+    if (!query || _deferred.size() >= MAX_DEFERRED) {
+        return resp;
+    }
+
+    _deferred.push_back(DeferredRequest{request, std::chrono::steady_clock::now() + _deferredTimeout});
+    return make_base_response(request, StatusCode::Pending);
+}
+
+IOResponse NetworkDevice::handle_now(const IORequest& request)
 {
     auto cmd = protocol::to_network_command(request.command);
 
@@ -542,8 +699,8 @@ IOResponse NetworkDevice::handle(const IORequest& request)
                     s.generation = static_cast<std::uint8_t>(s.generation + 1);
                     if (s.generation == 0) s.generation = 1;
         
-                    s.createdTick = _tickNow;
-                    s.lastActivityTick = _tickNow;
+                    s.createdAt = std::chrono::steady_clock::now();
+                    s.lastActivity = s.createdAt;
                     s.completed = false;
         
                     // Clear any stale fields just in case
@@ -643,8 +800,7 @@ IOResponse NetworkDevice::handle(const IORequest& request)
             }
         
             // Response: version, flags(bit0 accepted, bit1 needs_body_write), reserved, handle, proto_flags
-            std::string out;
-            out.reserve(1 + 1 + 2 + 2 + 1);
+            netproto::Writer out(resp.payload, 1 + 1 + 2 + 2 + 1);
         
             std::uint8_t oflags = 0x01; // accepted
             if (needsBodyWrite) oflags |= 0x02;
@@ -652,8 +808,6 @@ IOResponse NetworkDevice::handle(const IORequest& request)
             write_common_prefix(out, NETPROTO_VERSION, oflags);
             netproto::write_u16le(out, handle);
             netproto::write_u8(out, protoFlags);
-        
-            resp.payload = to_vec(out);
             return resp;
         }
 
@@ -681,10 +835,8 @@ IOResponse NetworkDevice::handle(const IORequest& request)
             close_and_free(*s);
 
             // Optional minimal response payload: version + reserved prefix
-            std::string out;
-            out.reserve(1 + 1 + 2);
+            netproto::Writer out(resp.payload, 1 + 1 + 2);
             write_common_prefix(out, NETPROTO_VERSION, 0);
-            resp.payload = to_vec(out);
             return resp;
         }
 
@@ -745,16 +897,13 @@ IOResponse NetworkDevice::handle(const IORequest& request)
                 flags |= 0x02;
             }
 
-            std::string out;
-            out.reserve(1 + 1 + 2 + 2 + 2 + 8 + 4);
+            netproto::Writer out(resp.payload, 1 + 1 + 2 + 2 + 2 + 8 + 4);
 
             write_common_prefix(out, NETPROTO_VERSION, flags);
             netproto::write_u16le(out, handle);
             netproto::write_u16le(out, info.hasHttpStatus ? info.httpStatus : 0);
             netproto::write_u64le(out, info.hasContentLength ? info.contentLength : 0);
             netproto::write_u32le(out, static_cast<std::uint32_t>(hdrLen));
-
-            resp.payload = to_vec(out);
             return resp;
         }
 
@@ -810,17 +959,14 @@ IOResponse NetworkDevice::handle(const IORequest& request)
                 flags |= 0x02;
             }
 
-            std::string out;
-            out.reserve(1 + 1 + 2 + 2 + 4 + 2 + n);
+            netproto::Writer out(resp.payload, 1 + 1 + 2 + 2 + 4 + 2 + n);
             write_common_prefix(out, NETPROTO_VERSION, flags);
             netproto::write_u16le(out, handle);
             netproto::write_u32le(out, offset);
             netproto::write_u16le(out, static_cast<std::uint16_t>(n));
             if (n > 0) {
-                out.append(info.headersBlock.data() + offset, n);
+                netproto::write_bytes(out, info.headersBlock.data() + offset, n);
             }
-
-            resp.payload = to_vec(out);
             return resp;
         }
 
@@ -856,7 +1002,6 @@ IOResponse NetworkDevice::handle(const IORequest& request)
             std::uint16_t n = 0;
             bool eof = false;
             bool moreAvailable = false;
-            std::string out;
             std::uint8_t flags = 0;
 
             if (translation_enabled(*s)) {
@@ -865,79 +1010,54 @@ IOResponse NetworkDevice::handle(const IORequest& request)
                     resp.status = translationSt;
                     return resp;
                 }
+            }
+
+            // Header first, then the data lands right behind it in the payload;
+            // flags and length are filled in once the read is done.
+            netproto::Writer out(resp.payload, READ_RESPONSE_HEADER + maxBytes);
+            write_common_prefix(out, NETPROTO_VERSION, 0);
+            netproto::write_u16le(out, handle);
+            netproto::write_u32le(out, offset);
+            netproto::write_u16le(out, 0);
+            std::uint8_t* data = out.reserve_tail(maxBytes);
 
-                std::vector<std::uint8_t> translatedBuf(maxBytes);
-                const StatusCode st = s->translator->read(offset,
-                                                          translatedBuf.data(),
-                                                          translatedBuf.size(),
-                                                          n,
-                                                          eof);
+            if (translation_enabled(*s)) {
+                const StatusCode st = s->translator->read(offset, data, maxBytes, n, eof);
                 if (st != StatusCode::Ok) {
+                    out.discard();
                     resp.status = st;
                     return resp;
                 }
-
-                out.reserve(1 + 1 + 2 + 2 + 4 + 2 + n);
-                if (eof) {
-                    flags |= NET_READ_FLAG_EOF;
-                    s->completed = true;
-                }
-                if (n == maxBytes && !eof) {
-                    flags |= NET_READ_FLAG_TRUNCATED;
-                }
                 if (!eof && (offset + n) < s->translatedResultSize) {
                     flags |= NET_READ_FLAG_MORE_AVAILABLE;
                 }
-                write_common_prefix(out, NETPROTO_VERSION, flags);
-                netproto::write_u16le(out, handle);
-                netproto::write_u32le(out, offset);
-                netproto::write_u16le(out, n);
-                if (n > 0) {
-                    netproto::write_bytes(out, translatedBuf.data(), n);
-                }
-                resp.payload = to_vec(out);
-                return resp;
-            }
-
-            // Normal (non-translated) read path
-            {
-                std::vector<std::uint8_t> buf;
-                buf.resize(maxBytes);
-
-                const StatusCode st = s->proto->read_body(offset, buf.data(), buf.size(), n, eof, moreAvailable);
+            } else {
+                const StatusCode st = s->proto->read_body(offset, data, maxBytes, n, eof, moreAvailable);
                 if (st != StatusCode::Ok) {
+                    out.discard();
                     resp.status = st;
                     return resp;
                 }
-
-                if (n > buf.size()) {
-                    n = static_cast<std::uint16_t>(buf.size());
-                }
-
-                out.reserve(1 + 1 + 2 + 2 + 4 + 2 + n);
-
-                if (eof) {
-                    flags |= NET_READ_FLAG_EOF;
-                    s->completed = true;
-                }
-                if (n == maxBytes && !eof) {
-                    flags |= NET_READ_FLAG_TRUNCATED;
+                if (n > maxBytes) {
+                    n = maxBytes;
                 }
                 if (moreAvailable) {
                     flags |= NET_READ_FLAG_MORE_AVAILABLE;
                 }
+            }
+            out.commit_tail(n);
 
-                write_common_prefix(out, NETPROTO_VERSION, flags);
-                netproto::write_u16le(out, handle);
-                netproto::write_u32le(out, offset);
-                netproto::write_u16le(out, n);
-                if (n > 0 && !buf.empty()) {
-                    netproto::write_bytes(out, buf.data(), n);
-                }
-
-                resp.payload = to_vec(out);
-                return resp;
+            if (eof) {
+                flags |= NET_READ_FLAG_EOF;
+                s->completed = true;
+            }
+            if (n == maxBytes && !eof) {
+                flags |= NET_READ_FLAG_TRUNCATED;
             }
+
+            out.patch_u8(1, flags);
+            out.patch_u16le(READ_RESPONSE_HEADER - 2, n);
+            return resp;
         }
 
         case NetworkCommand::Write: {
@@ -1027,13 +1147,11 @@ IOResponse NetworkDevice::handle(const IORequest& request)
                 }
             }
 
-            std::string out;
-            out.reserve(1 + 1 + 2 + 2 + 4 + 2);
+            netproto::Writer out(resp.payload, 1 + 1 + 2 + 2 + 4 + 2);
             write_common_prefix(out, NETPROTO_VERSION, 0);
             netproto::write_u16le(out, handle);
             netproto::write_u32le(out, offset);
             netproto::write_u16le(out, written);
-            resp.payload = to_vec(out);
             return resp;
         }
 
@@ -1090,12 +1208,96 @@ IOResponse NetworkDevice::handle(const IORequest& request)
                 }
             }
 
-            std::string out;
+            netproto::Writer out(resp.payload, 1 + 1 + 2 + 2 + 4);
             std::uint8_t jflags = s->translationReady ? 0x01 : 0x00;
             write_common_prefix(out, NETPROTO_VERSION, jflags);
             netproto::write_u16le(out, handle);
             netproto::write_u32le(out, static_cast<std::uint32_t>(s->translatedResultSize));
-            resp.payload = to_vec(out);
+            return resp;
+        }
+
+        case NetworkCommand::TranslateQuery: {
+            auto resp = make_success_response(request);
+            Reader r(request.payload.data(), request.payload.size());
+            if (!check_version(r, NETPROTO_VERSION)) {
+                resp.status = StatusCode::InvalidRequest;
+                return resp;
+            }
+
+            std::uint16_t handle = 0;
+            std::uint16_t maxBytes = 0;
+            std::uint8_t count = 0;
+            if (!r.read_u16le(handle) || !r.read_u16le(maxBytes) || !r.read_u8(count) ||
+                count == 0 || count > MAX_QUERY_SELECTORS) {
+                resp.status = StatusCode::InvalidRequest;
+                return resp;
+            }
+
+            std::vector<std::string> selectors;
+            selectors.reserve(count);
+            for (std::uint8_t i = 0; i < count; ++i) {
+                std::string_view selector;
+                if (!r.read_lp_u16_string(selector)) {
+                    resp.status = StatusCode::InvalidRequest;
+                    return resp;
+                }
+                selectors.emplace_back(selector);
+            }
+            if (r.remaining() != 0) {
+                resp.status = StatusCode::InvalidRequest;
+                return resp;
+            }
+
+            auto* s = session_for_handle(handle);
+            if (!s || !s->proto || !translation_enabled(*s)) {
+                resp.status = StatusCode::InvalidRequest;
+                return resp;
+            }
+            touch(*s);
+
+            if (s->awaitingBody) {
+                resp.status = StatusCode::NotReady;
+                return resp;
+            }
+
+            const StatusCode translationSt = ensure_translation_ready(*s);
+            if (translationSt != StatusCode::Ok) {
+                resp.status = translationSt;
+                return resp;
+            }
+            if (!s->responseBodyCached) {
+                resp.status = StatusCode::Unsupported;
+                return resp;
+            }
+
+            netproto::Writer out(resp.payload, 1 + 1 + 2 + 2 + 1 + count * (1 + 2) + maxBytes);
+            write_common_prefix(out, NETPROTO_VERSION, 0);
+            netproto::write_u16le(out, handle);
+            netproto::write_u8(out, count);
+
+            // Values share the host's budget in request order; whatever
+            // doesn't fit is cut short and flagged.
+            std::size_t budget = maxBytes;
+            std::string value;
+            for (std::uint8_t i = 0; i < count; ++i) {
+                bool found = false;
+                const StatusCode st = s->translator->query(s->responseBodyCache, selectors[i], value, found);
+                if (st != StatusCode::Ok) {
+                    out.discard();
+                    resp.status = st;
+                    return resp;
+                }
+
+                const std::size_t n = std::min(value.size(), budget);
+                std::uint8_t qflags = 0;
+                if (found) qflags |= QUERY_FLAG_FOUND;
+                if (n < value.size()) qflags |= QUERY_FLAG_TRUNCATED;
+                budget -= n;
+
+                netproto::write_u8(out, qflags);
+                netproto::write_u16le(out, static_cast<std::uint16_t>(n));
+                netproto::write_bytes(out, value.data(), n);
+            }
             return resp;
         }
 
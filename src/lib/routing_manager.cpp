@@ -15,4 +15,14 @@ IOResponse RoutingManager::handleRequest(const IORequest& request)
     return _deviceManager.handleRequest(request);
 }
 
+bool RoutingManager::takeCompletedResponse(IOResponse& out)
+{
+    // Deferred requests may have been forwarded to a device by an override,
+    // so drain both.
+    if (_overrideHandler && _overrideHandler->takeCompletedResponse(out)) {
+        return true;
+    }
+    return _deviceManager.takeCompletedResponse(out);
+}
+
 } // namespace fujinet::io
@@ -0,0 +1,299 @@
+#include "fujinet/io/protocol/slip_kernels.h"
+
+#include "fujinet/io/protocol/fuji_bus_packet.h"
+
+#include <initializer_list>
+
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#define FN_SLIP_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// AVX2 is compiled with a per-function target attribute and only used when
+// the CPU reports it at runtime, so the rest of the build stays baseline x86-64.
+#if defined(FN_SLIP_HAVE_SSE2) && defined(__x86_64__)
+#define FN_SLIP_HAVE_AVX2 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#define FN_SLIP_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace fujinet::io::protocol {
+
+namespace {
+
+constexpr std::uint8_t kEnd = to_byte(SlipByte::End);
+constexpr std::uint8_t kEsc = to_byte(SlipByte::Escape);
+
+// Fold a wide byte sum into a running checksum. See checksum_update().
+inline std::uint16_t fold_sum(std::uint16_t chk, std::uint64_t sum)
+{
+    const std::uint64_t total = chk + sum;
+    if (total == 0) {
+        return 0;
+    }
+    const auto r = static_cast<std::uint16_t>(total % 255U);
+    return r == 0 ? std::uint16_t{255} : r;
+}
+
+// ---- Scalar ----
+
+const std::uint8_t* find_scalar(const std::uint8_t* p, const std::uint8_t* end)
+{
+    for (; p < end; ++p) {
+        if (*p == kEnd || *p == kEsc) {
+            return p;
+        }
+    }
+    return end;
+}
+
+std::uint64_t sum_scalar(const std::uint8_t* p, std::size_t n)
+{
+    // Four independent accumulators keep the adds from serializing.
+    std::uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += p[i];
+        s1 += p[i + 1];
+        s2 += p[i + 2];
+        s3 += p[i + 3];
+    }
+    for (; i < n; ++i) {
+        s0 += p[i];
+    }
+    return s0 + s1 + s2 + s3;
+}
+
+std::uint16_t checksum_scalar(std::uint16_t chk, const std::uint8_t* p, std::size_t n)
+{
+    return fold_sum(chk, sum_scalar(p, n));
+}
+
+// ---- SSE2 ----
+
+#if defined(FN_SLIP_HAVE_SSE2)
+const std::uint8_t* find_sse2(const std::uint8_t* p, const std::uint8_t* end)
+{
+    const __m128i vEnd = _mm_set1_epi8(static_cast<char>(kEnd));
+    const __m128i vEsc = _mm_set1_epi8(static_cast<char>(kEsc));
+
+    while (end - p >= 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(v, vEnd), _mm_cmpeq_epi8(v, vEsc));
+        const int mask = _mm_movemask_epi8(hit);
+        if (mask != 0) {
+            return p + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+        p += 16;
+    }
+    return find_scalar(p, end);
+}
+
+std::uint16_t checksum_sse2(std::uint16_t chk, const std::uint8_t* p, std::size_t n)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = zero;
+
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(v, zero));
+    }
+
+    std::uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return fold_sum(chk, lanes[0] + lanes[1] + sum_scalar(p + i, n - i));
+}
+#endif
+
+// ---- AVX2 ----
+
+#if defined(FN_SLIP_HAVE_AVX2)
+__attribute__((target("avx2")))
+const std::uint8_t* find_avx2(const std::uint8_t* p, const std::uint8_t* end)
+{
+    const __m256i vEnd = _mm256_set1_epi8(static_cast<char>(kEnd));
+    const __m256i vEsc = _mm256_set1_epi8(static_cast<char>(kEsc));
+
+    while (end - p >= 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(v, vEnd), _mm256_cmpeq_epi8(v, vEsc));
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hit));
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+    return find_sse2(p, end);
+}
+
+__attribute__((target("avx2")))
+std::uint16_t checksum_avx2(std::uint16_t chk, const std::uint8_t* p, std::size_t n)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(v, zero));
+    }
+
+    std::uint64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return fold_sum(chk, lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_scalar(p + i, n - i));
+}
+#endif
+
+// ---- NEON (AArch64) ----
+
+#if defined(FN_SLIP_HAVE_NEON)
+const std::uint8_t* find_neon(const std::uint8_t* p, const std::uint8_t* end)
+{
+    const uint8x16_t vEnd = vdupq_n_u8(kEnd);
+    const uint8x16_t vEsc = vdupq_n_u8(kEsc);
+
+    while (end - p >= 16) {
+        const uint8x16_t v = vld1q_u8(p);
+        const uint8x16_t hit = vorrq_u8(vceqq_u8(v, vEnd), vceqq_u8(v, vEsc));
+        if (vmaxvq_u8(hit) != 0) {
+            return find_scalar(p, p + 16);
+        }
+        p += 16;
+    }
+    return find_scalar(p, end);
+}
+
+std::uint16_t checksum_neon(std::uint16_t chk, const std::uint8_t* p, std::size_t n)
+{
+    std::uint64_t sum = 0;
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        sum += vaddlvq_u8(vld1q_u8(p + i));
+    }
+    return fold_sum(chk, sum + sum_scalar(p + i, n - i));
+}
+#endif
+
+// ---- Dispatch ----
+
+using FindFn     = const std::uint8_t* (*)(const std::uint8_t*, const std::uint8_t*);
+using ChecksumFn = std::uint16_t (*)(std::uint16_t, const std::uint8_t*, std::size_t);
+
+struct KernelOps {
+    SlipKernel kind;
+    FindFn     find;
+    ChecksumFn checksum;
+};
+
+KernelOps ops_for(SlipKernel k)
+{
+    switch (k) {
+#if defined(FN_SLIP_HAVE_SSE2)
+        case SlipKernel::Sse2: return {k, find_sse2, checksum_sse2};
+#endif
+#if defined(FN_SLIP_HAVE_AVX2)
+        case SlipKernel::Avx2: return {k, find_avx2, checksum_avx2};
+#endif
+#if defined(FN_SLIP_HAVE_NEON)
+        case SlipKernel::Neon: return {k, find_neon, checksum_neon};
+#endif
+        default: return {SlipKernel::Scalar, find_scalar, checksum_scalar};
+    }
+}
+
+KernelOps best_ops()
+{
+    for (SlipKernel k : {SlipKernel::Avx2, SlipKernel::Neon, SlipKernel::Sse2}) {
+        if (slip_kernel_available(k)) {
+            return ops_for(k);
+        }
+    }
+    return ops_for(SlipKernel::Scalar);
+}
+
+KernelOps& active_ops()
+{
+    static KernelOps ops = best_ops();
+    return ops;
+}
+
+} // namespace
+
+const char* to_string(SlipKernel k) noexcept
+{
+    switch (k) {
+        case SlipKernel::Scalar: return "scalar";
+        case SlipKernel::Sse2:   return "sse2";
+        case SlipKernel::Avx2:   return "avx2";
+        case SlipKernel::Neon:   return "neon";
+    }
+    return "unknown";
+}
+
+bool slip_kernel_available(SlipKernel k) noexcept
+{
+    switch (k) {
+        case SlipKernel::Scalar:
+            return true;
+        case SlipKernel::Sse2:
+#if defined(FN_SLIP_HAVE_SSE2)
+            return true;
+#else
+            return false;
+#endif
+        case SlipKernel::Avx2:
+#if defined(FN_SLIP_HAVE_AVX2)
+            return __builtin_cpu_supports("avx2") != 0;
+#else
+            return false;
+#endif
+        case SlipKernel::Neon:
+#if defined(FN_SLIP_HAVE_NEON)
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+SlipKernel active_slip_kernel() noexcept
+{
+    return active_ops().kind;
+}
+
+bool set_slip_kernel(SlipKernel k) noexcept
+{
+    if (!slip_kernel_available(k)) {
+        return false;
+    }
+    active_ops() = ops_for(k);
+    return true;
+}
+
+const std::uint8_t* find_slip_special(const std::uint8_t* p, const std::uint8_t* end) noexcept
+{
+    return active_ops().find(p, end);
+}
+
+std::uint16_t checksum_update(std::uint16_t chk, const std::uint8_t* p, std::size_t n) noexcept
+{
+    return active_ops().checksum(chk, p, n);
+}
+
+const std::uint8_t* find_slip_special(SlipKernel k, const std::uint8_t* p, const std::uint8_t* end) noexcept
+{
+    return ops_for(k).find(p, end);
+}
+
+std::uint16_t checksum_update(SlipKernel k, std::uint16_t chk, const std::uint8_t* p, std::size_t n) noexcept
+{
+    return ops_for(k).checksum(chk, p, n);
+}
+
+} // namespace fujinet::io::protocol
@@ -39,16 +39,36 @@ bool StorageManager::registerFileSystem(std::unique_ptr<IFileSystem> fs)
     return inserted;
 }
 
+bool StorageManager::registerFileSystem(std::unique_ptr<IFileSystem> fs, const MetadataIndexConfig& index)
+{
+    if (!fs || get(fs->name())) {
+        return false;
+    }
+    auto indexed = std::make_unique<IndexedFileSystem>(std::move(fs), index);
+    IndexedFileSystem* raw = indexed.get();
+    if (!registerFileSystem(std::move(indexed))) {
+        return false;
+    }
+    _indexes.emplace(raw, raw);
+    return true;
+}
+
 
 bool StorageManager::unregisterFileSystem(const std::string& name)
 {
     auto it = _fileSystems.find(name);
     if (it != _fileSystems.end()) {
+        _fileHandles.invalidate(*it->second);
+        _listings.invalidate(*it->second);
+        _indexes.erase(it->second.get());
         _fileSystems.erase(it);
         return true;
     }
     for (it = _fileSystems.begin(); it != _fileSystems.end(); ++it) {
         if (iequals(it->first, name)) {
+            _fileHandles.invalidate(*it->second);
+            _listings.invalidate(*it->second);
+            _indexes.erase(it->second.get());
             _fileSystems.erase(it);
             return true;
         }
@@ -56,6 +76,25 @@ bool StorageManager::unregisterFileSystem(const std::string& name)
     return false;
 }
 
+void StorageManager::invalidatePath(const IFileSystem& fs, const std::string& path)
+{
+    _fileHandles.invalidate(fs, path);
+    _listings.invalidate(fs, path);
+}
+
+IndexedFileSystem* StorageManager::metadataIndex(const std::string& name)
+{
+    auto it = _indexes.find(get(name));
+    return it != _indexes.end() ? it->second : nullptr;
+}
+
+void StorageManager::poll()
+{
+    for (auto& [name, fs] : _fileSystems) {
+        fs->poll();
+    }
+}
+
 IFileSystem* StorageManager::get(const std::string& name)
 {
     auto it = _fileSystems.find(name);
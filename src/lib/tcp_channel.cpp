@@ -117,6 +117,22 @@ bool TcpChannel::available()
     return ret > 0;
 }
 
+bool TcpChannel::wait_for_readable(std::chrono::milliseconds timeout)
+{
+    if (!connected_ || socket_fd_ < 0) {
+        return false;
+    }
+
+    return socket_ops_.wait_readable(socket_fd_, timeout);
+}
+
+void TcpChannel::add_wait_sources(fujinet::io::WaitSet& ws)
+{
+    if (connected_) {
+        ws.add_readable(socket_fd_);
+    }
+}
+
 std::size_t TcpChannel::read(std::uint8_t* buffer, std::size_t max_len)
 {
     if (!connected_ || socket_fd_ < 0 || !buffer) {
@@ -623,6 +623,25 @@ void TcpNetworkProtocolCommon::poll()
     }
 }
 
+void TcpNetworkProtocolCommon::add_wait_sources(fujinet::io::WaitSet& ws)
+{
+    if (_fd < 0) return;
+
+    if (_state == State::Connecting) {
+        ws.add_writable(_fd);
+        if (_opt.connect_timeout_ms > 0 && _connect_start_ms > 0) {
+            const std::uint64_t elapsed = _socket_ops.now_ms() - _connect_start_ms;
+            const std::uint64_t limit = static_cast<std::uint64_t>(_opt.connect_timeout_ms);
+            ws.limit_timeout(std::chrono::milliseconds(elapsed >= limit ? 0 : limit - elapsed));
+        }
+        return;
+    }
+
+    if (_state == State::Connected && !_rx_full && rx_available() < _rx.size()) {
+        ws.add_readable(_fd);
+    }
+}
+
 void TcpNetworkProtocolCommon::close()
 {
     if (_fd >= 0) {
@@ -0,0 +1,106 @@
+#include "fujinet/tnfs/tnfs_protocol.h"
+
+#include "fujinet/core/utils.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace fujinet::tnfs {
+
+namespace {
+
+char lower(char c)
+{
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+int compare_names(const std::string& a, const std::string& b, bool caseSensitive)
+{
+    const std::size_t n = std::min(a.size(), b.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        const char ca = caseSensitive ? a[i] : lower(a[i]);
+        const char cb = caseSensitive ? b[i] : lower(b[i]);
+        if (ca != cb) {
+            return ca < cb ? -1 : 1;
+        }
+    }
+    if (a.size() == b.size()) return 0;
+    return a.size() < b.size() ? -1 : 1;
+}
+
+// Same ordering tnfsd applies for OPENDIRX, for servers that can't.
+void sort_entries(std::vector<TnfsDirEntry>& entries, const TnfsDirOptions& opts)
+{
+    if ((opts.sortOptions & SORTOPT_NONE) != 0) {
+        return;
+    }
+
+    const bool foldersFirst = (opts.dirOptions & DIROPT_NO_FOLDERSFIRST) == 0;
+    const bool caseSensitive = (opts.sortOptions & SORTOPT_CASE) != 0;
+    const bool descending = (opts.sortOptions & SORTOPT_DESCENDING) != 0;
+    const bool bySize = (opts.sortOptions & SORTOPT_SIZE) != 0;
+    const bool byModified = (opts.sortOptions & SORTOPT_MODIFIED) != 0;
+
+    std::stable_sort(entries.begin(), entries.end(), [&](const TnfsDirEntry& a, const TnfsDirEntry& b) {
+        if (foldersFirst && a.isDir != b.isDir) {
+            return a.isDir;
+        }
+        int c = 0;
+        if (bySize && a.filesize != b.filesize) {
+            c = a.filesize < b.filesize ? -1 : 1;
+        } else if (byModified && a.mTime != b.mTime) {
+            c = a.mTime < b.mTime ? -1 : 1;
+        } else {
+            c = compare_names(a.name, b.name, caseSensitive);
+        }
+        return descending ? c > 0 : c < 0;
+    });
+}
+
+} // namespace
+
+bool ITnfsClient::listDirectoryEntries(const std::string& path,
+                                       const TnfsDirOptions& opts,
+                                       std::vector<TnfsDirEntry>& out)
+{
+    out.clear();
+    if (!isDirectory(path)) {
+        return false;
+    }
+
+    const bool skipHidden = (opts.dirOptions & DIROPT_NO_SKIPHIDDEN) == 0;
+    const bool dirPattern = (opts.dirOptions & DIROPT_DIR_PATTERN) != 0;
+    const std::string base = (!path.empty() && path.back() == '/') ? path : path + "/";
+
+    for (auto& name : listDirectory(path)) {
+        const bool hidden = !name.empty() && name.front() == '.';
+        if (hidden && skipHidden) {
+            continue;
+        }
+
+        TnfsStat st{};
+        if (!stat(base + name, st)) {
+            continue;
+        }
+        if (!opts.pattern.empty() && (!st.isDir || dirPattern) && !core::glob_match(opts.pattern, name)) {
+            continue;
+        }
+
+        TnfsDirEntry e{};
+        e.name = std::move(name);
+        e.isDir = st.isDir;
+        e.hidden = hidden;
+        e.filesize = st.filesize;
+        e.mTime = st.mTime;
+        e.cTime = st.cTime;
+        out.push_back(std::move(e));
+    }
+
+    sort_entries(out, opts);
+    if (opts.maxResults != 0 && out.size() > opts.maxResults) {
+        out.resize(opts.maxResults);
+    }
+    return true;
+}
+
+} // namespace fujinet::tnfs
@@ -6,7 +6,8 @@ namespace fujinet::tnfs {
 
 std::unique_ptr<ITnfsClient> make_udp_tnfs_client(std::unique_ptr<fujinet::io::Channel> channel)
 {
-    return std::make_unique<CommonTnfsClient>(std::move(channel), "UDP");
+    // One datagram per reply, so sequential READs can be pipelined.
+    return std::make_unique<CommonTnfsClient>(std::move(channel), "UDP", CommonTnfsClient::kDefaultReadWindow);
 }
 
 } // namespace fujinet::tnfs
@@ -97,6 +97,13 @@ bool UdpChannel::wait_for_readable(std::chrono::milliseconds timeout)
     return socket_ops_.wait_readable(socket_fd_, timeout);
 }
 
+void UdpChannel::add_wait_sources(fujinet::io::WaitSet& ws)
+{
+    if (connected_) {
+        ws.add_readable(socket_fd_);
+    }
+}
+
 std::size_t UdpChannel::read(std::uint8_t* buffer, std::size_t max_len)
 {
     if (!connected_ || socket_fd_ < 0 || !buffer) {
@@ -0,0 +1,806 @@
+#include "fujinet/io/devices/xml_content_translator.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+namespace fujinet::io {
+
+namespace {
+
+bool is_whitespace(std::uint8_t c)
+{
+    return c <= 0x20;
+}
+
+bool equal_nocase(std::string_view a, std::string_view b)
+{
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+           });
+}
+
+std::string_view local_name(std::string_view name)
+{
+    const auto colon = name.rfind(':');
+    return colon == std::string_view::npos ? name : name.substr(colon + 1);
+}
+
+// Encodes `cp` as UTF-8 into `out`; returns the byte count.
+std::size_t encode_utf8(std::uint32_t cp, std::uint8_t (&out)[4])
+{
+    if (cp < 0x80) {
+        out[0] = static_cast<std::uint8_t>(cp);
+        return 1;
+    }
+    if (cp < 0x800) {
+        out[0] = static_cast<std::uint8_t>(0xC0 | (cp >> 6));
+        out[1] = static_cast<std::uint8_t>(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        out[0] = static_cast<std::uint8_t>(0xE0 | (cp >> 12));
+        out[1] = static_cast<std::uint8_t>(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = static_cast<std::uint8_t>(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<std::uint8_t>(0xF0 | (cp >> 18));
+    out[1] = static_cast<std::uint8_t>(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = static_cast<std::uint8_t>(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = static_cast<std::uint8_t>(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+// The five predefined entities and numeric character references.
+bool decode_entity(const std::string& e, std::uint32_t& cp)
+{
+    if (e == "amp") { cp = '&'; return true; }
+    if (e == "lt") { cp = '<'; return true; }
+    if (e == "gt") { cp = '>'; return true; }
+    if (e == "quot") { cp = '"'; return true; }
+    if (e == "apos") { cp = '\''; return true; }
+
+    if (e.size() < 2 || e[0] != '#') {
+        return false;
+    }
+    const bool hex = e[1] == 'x' || e[1] == 'X';
+    const std::size_t start = hex ? 2 : 1;
+    if (start >= e.size()) {
+        return false;
+    }
+    std::uint32_t v = 0;
+    for (std::size_t i = start; i < e.size(); ++i) {
+        const char c = e[i];
+        std::uint32_t d = 0;
+        if (c >= '0' && c <= '9') {
+            d = static_cast<std::uint32_t>(c - '0');
+        } else if (hex && c >= 'a' && c <= 'f') {
+            d = static_cast<std::uint32_t>(c - 'a' + 10);
+        } else if (hex && c >= 'A' && c <= 'F') {
+            d = static_cast<std::uint32_t>(c - 'A' + 10);
+        } else {
+            return false;
+        }
+        v = v * (hex ? 16 : 10) + d;
+        if (v > 0x10FFFF) {
+            return false;
+        }
+    }
+    if (v == 0) {
+        return false;
+    }
+    cp = v;
+    return true;
+}
+
+constexpr std::string_view COMMENT_OPEN = "--";
+constexpr std::string_view CDATA_OPEN = "[CDATA[";
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// TextSink
+// ---------------------------------------------------------------------------
+
+void XmlContentTranslator::TextSink::start(std::string* target, std::size_t limit)
+{
+    out = target;
+    cap = limit;
+    pendingSpace = false;
+    any = false;
+}
+
+void XmlContentTranslator::TextSink::add(std::uint8_t c)
+{
+    if (!out) {
+        return;
+    }
+    if (is_whitespace(c)) {
+        pendingSpace = any;
+        return;
+    }
+    if (out->size() + (pendingSpace ? 2 : 1) > cap) {
+        return;
+    }
+    if (pendingSpace) {
+        out->push_back(' ');
+        pendingSpace = false;
+    }
+    out->push_back(static_cast<char>(c));
+    any = true;
+}
+
+void XmlContentTranslator::TextSink::boundary()
+{
+    pendingSpace = any;
+}
+
+// ---------------------------------------------------------------------------
+// XmlContentTranslator
+// ---------------------------------------------------------------------------
+
+StatusCode XmlContentTranslator::configure(const TranslationConfig& config)
+{
+    if (config.type != ContentTranslationType::Xml && config.type != ContentTranslationType::Rss) {
+        return StatusCode::InvalidRequest;
+    }
+
+    _config = config;
+    _rss = config.type == ContentTranslationType::Rss;
+    _steps.clear();
+    _elementSteps = 0;
+    _maxItems = 0;
+
+    const std::string& sel = _config.selector;
+    if (_rss) {
+        if (!sel.empty()) {
+            if (sel.size() > 9 || !std::all_of(sel.begin(), sel.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+                return StatusCode::InvalidRequest;
+            }
+            _maxItems = static_cast<std::uint32_t>(std::strtoul(sel.c_str(), nullptr, 10));
+        }
+    } else {
+        std::size_t i = 0;
+        while (i < sel.size()) {
+            const std::size_t end = std::min(sel.find('/', i), sel.size());
+            std::string_view seg(sel.data() + i, end - i);
+            i = end + 1;
+            if (seg.empty()) {
+                continue;
+            }
+            if (!_steps.empty() && _steps.back().attribute) {
+                return StatusCode::InvalidRequest; // "@attr" must come last
+            }
+
+            Step s;
+            if (seg[0] == '@') {
+                s.attribute = true;
+                seg.remove_prefix(1);
+            } else if (seg.back() == ']') {
+                const auto open = seg.find('[');
+                const std::string_view digits = open == std::string_view::npos
+                    ? std::string_view{}
+                    : seg.substr(open + 1, seg.size() - open - 2);
+                if (digits.empty() || digits.size() > 9 ||
+                    !std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+                    return StatusCode::InvalidRequest;
+                }
+                s.index = static_cast<std::uint32_t>(std::strtoul(std::string(digits).c_str(), nullptr, 10));
+                seg = seg.substr(0, open);
+            }
+            if (seg.empty() || seg.find_first_of("[]@") != std::string_view::npos) {
+                return StatusCode::InvalidRequest;
+            }
+            s.name.assign(seg.data(), seg.size());
+            _steps.push_back(std::move(s));
+        }
+        _elementSteps = _steps.size() - ((!_steps.empty() && _steps.back().attribute) ? 1 : 0);
+    }
+
+    reset();
+    return StatusCode::Ok;
+}
+
+void XmlContentTranslator::reset()
+{
+    _state = State::Text;
+    _entityReturn = State::Text;
+    _stack.clear();
+    _name.clear();
+    _entity.clear();
+    _quote = 0;
+    _match = 0;
+    _bracketDepth = 0;
+
+    _emitDepth = -1;
+    _attrTarget = false;
+    _attrSelected = false;
+    _found = false;
+    _text = TextSink{};
+
+    _itemDepth = 0;
+    _fieldDepth = 0;
+    _field = Field::None;
+    _attrHref = false;
+    _attrRel = false;
+    _href.clear();
+    _rel.clear();
+    _title.clear();
+    _link.clear();
+    _date.clear();
+    _fieldSink = TextSink{};
+    _items = 0;
+
+    _translated.clear();
+}
+
+StatusCode XmlContentTranslator::append_body(const std::uint8_t* data, std::size_t len)
+{
+    if (len == 0) {
+        return StatusCode::Ok;
+    }
+
+    if (!data) {
+        return StatusCode::InvalidRequest;
+    }
+
+    for (std::size_t i = 0; i < len && _state != State::Done; ++i) {
+        while (!step(data[i])) {
+        }
+    }
+    return StatusCode::Ok;
+}
+
+StatusCode XmlContentTranslator::finalize()
+{
+    // A record cut off by the end of the body is dropped; selected text
+    // already collected stays.
+    _state = State::Done;
+    _stack.clear();
+    _stack.shrink_to_fit();
+    return StatusCode::Ok;
+}
+
+// Consumes `c`, or returns false if it must be fed again in the new state.
+bool XmlContentTranslator::step(std::uint8_t c)
+{
+    switch (_state) {
+        case State::Text:
+            if (c == '<') {
+                _state = State::TagOpen;
+            } else if (c == '&') {
+                _entity.clear();
+                _entityReturn = State::Text;
+                _state = State::Entity;
+            } else {
+                text_char(c);
+            }
+            return true;
+
+        case State::TagOpen:
+            _name.clear();
+            if (c == '/') {
+                _state = State::EndName;
+            } else if (c == '!') {
+                _state = State::Bang;
+            } else if (c == '?') {
+                _match = 0;
+                _state = State::Pi;
+            } else if (!is_whitespace(c) && c != '>' && c != '<') {
+                _name.push_back(static_cast<char>(c));
+                _state = State::StartName;
+            } else {
+                // A stray '<' is text.
+                text_char('<');
+                _state = State::Text;
+                return false;
+            }
+            return true;
+
+        case State::StartName:
+            if (is_whitespace(c) || c == '/' || c == '>') {
+                _state = State::InTag;
+                start_element();
+                return false;
+            }
+            if (_name.size() < MAX_NAME) {
+                _name.push_back(static_cast<char>(c));
+            }
+            return true;
+
+        case State::InTag:
+            if (is_whitespace(c)) {
+                return true;
+            }
+            if (c == '/') {
+                _state = State::EmptyClose;
+            } else if (c == '>') {
+                _state = State::Text;
+                start_tag_done(false);
+            } else {
+                _name.assign(1, static_cast<char>(c));
+                _state = State::AttrName;
+            }
+            return true;
+
+        case State::AttrName:
+            if (c == '=') {
+                begin_attribute();
+                _state = State::AttrQuote;
+                return true;
+            }
+            if (is_whitespace(c)) {
+                _state = State::AttrEq;
+                return true;
+            }
+            if (c == '>' || c == '/') {
+                // Attribute without a value (HTML style).
+                begin_attribute();
+                end_attribute();
+                _state = State::InTag;
+                return false;
+            }
+            if (_name.size() < MAX_NAME) {
+                _name.push_back(static_cast<char>(c));
+            }
+            return true;
+
+        case State::AttrEq:
+            if (is_whitespace(c)) {
+                return true;
+            }
+            begin_attribute();
+            if (c == '=') {
+                _state = State::AttrQuote;
+                return true;
+            }
+            end_attribute();
+            _state = State::InTag;
+            return false;
+
+        case State::AttrQuote:
+            if (is_whitespace(c)) {
+                return true;
+            }
+            _state = State::AttrValue;
+            if (c == '"' || c == '\'') {
+                _quote = c;
+                return true;
+            }
+            _quote = 0; // unquoted value
+            return false;
+
+        case State::AttrValue:
+            if (_quote != 0 ? c == _quote : (is_whitespace(c) || c == '>')) {
+                end_attribute();
+                _state = State::InTag;
+                return _quote != 0;
+            }
+            if (c == '&') {
+                _entity.clear();
+                _entityReturn = State::AttrValue;
+                _state = State::Entity;
+            } else {
+                attr_char(c);
+            }
+            return true;
+
+        case State::EmptyClose:
+            if (c == '>') {
+                _state = State::Text;
+                start_tag_done(true);
+                return true;
+            }
+            _state = State::InTag;
+            return is_whitespace(c);
+
+        case State::EndName:
+            if (c == '>') {
+                _state = State::Text;
+                end_element(_name);
+            } else if (!is_whitespace(c) && _name.size() < MAX_NAME) {
+                _name.push_back(static_cast<char>(c));
+            }
+            return true;
+
+        case State::Bang:
+            if (c == '>' && _name.empty()) {
+                _state = State::Text; // "<!>"
+                return true;
+            }
+            _name.push_back(static_cast<char>(c));
+            if (_name == COMMENT_OPEN) {
+                _match = 0;
+                _state = State::Comment;
+            } else if (_name == CDATA_OPEN) {
+                _match = 0;
+                _state = State::CData;
+            } else if (COMMENT_OPEN.substr(0, std::min(_name.size(), COMMENT_OPEN.size())) != _name &&
+                       CDATA_OPEN.substr(0, std::min(_name.size(), CDATA_OPEN.size())) != _name) {
+                _bracketDepth = 0;
+                _state = State::Declaration;
+                return c != '>';
+            }
+            return true;
+
+        case State::Comment:
+            if (c == '>' && _match >= 2) {
+                _state = State::Text;
+            } else {
+                _match = c == '-' ? static_cast<std::uint8_t>(std::min(_match + 1, 2)) : 0;
+            }
+            return true;
+
+        case State::CData:
+            if (c == ']') {
+                if (_match == 2) {
+                    text_char(']');
+                } else {
+                    ++_match;
+                }
+            } else if (c == '>' && _match == 2) {
+                _state = State::Text;
+            } else {
+                for (; _match > 0; --_match) {
+                    text_char(']');
+                }
+                text_char(c);
+            }
+            return true;
+
+        case State::Declaration:
+            if (c == '[') {
+                ++_bracketDepth;
+            } else if (c == ']' && _bracketDepth > 0) {
+                --_bracketDepth;
+            } else if (c == '>' && _bracketDepth == 0) {
+                _state = State::Text;
+            }
+            return true;
+
+        case State::Pi:
+            if (c == '>' && _match == 1) {
+                _state = State::Text;
+            } else {
+                _match = c == '?' ? 1 : 0;
+            }
+            return true;
+
+        case State::Entity:
+            if (c == ';') {
+                _state = _entityReturn;
+                flush_entity(true);
+                return true;
+            }
+            if ((std::isalnum(c) || c == '#') && _entity.size() < MAX_ENTITY) {
+                _entity.push_back(static_cast<char>(c));
+                return true;
+            }
+            _state = _entityReturn;
+            flush_entity(false);
+            return false;
+
+        case State::Done:
+            return true;
+    }
+
+    return true;
+}
+
+void XmlContentTranslator::text_char(std::uint8_t c)
+{
+    if (_emitDepth >= 0) {
+        _text.add(c);
+    }
+    if (_field != Field::None) {
+        _fieldSink.add(c);
+    }
+}
+
+void XmlContentTranslator::attr_char(std::uint8_t c)
+{
+    if (_attrSelected) {
+        _translated.push_back(static_cast<char>(c));
+    }
+    if (_attrHref && _href.size() < MAX_FIELD) {
+        _href.push_back(static_cast<char>(c));
+    }
+    if (_attrRel && _rel.size() < MAX_FIELD) {
+        _rel.push_back(static_cast<char>(c));
+    }
+}
+
+// `terminated`: the reference ended with ';'. Anything that isn't a known
+// entity is passed through as written.
+void XmlContentTranslator::flush_entity(bool terminated)
+{
+    auto put = [this](std::uint8_t c) {
+        if (_entityReturn == State::AttrValue) {
+            attr_char(c);
+        } else {
+            text_char(c);
+        }
+    };
+
+    std::uint32_t cp = 0;
+    if (terminated && decode_entity(_entity, cp)) {
+        std::uint8_t bytes[4];
+        const std::size_t n = encode_utf8(cp, bytes);
+        for (std::size_t i = 0; i < n; ++i) {
+            put(bytes[i]);
+        }
+        return;
+    }
+
+    put('&');
+    for (char c : _entity) {
+        put(static_cast<std::uint8_t>(c));
+    }
+    if (terminated) {
+        put(';');
+    }
+}
+
+bool XmlContentTranslator::name_matches(const std::string& name, const Step& step) const
+{
+    if (equal_nocase(name, step.name)) {
+        return true;
+    }
+    return step.name.find(':') == std::string::npos && equal_nocase(local_name(name), step.name);
+}
+
+void XmlContentTranslator::start_element()
+{
+    const std::size_t depth = _stack.size();
+    if (depth >= MAX_DEPTH) {
+        _state = State::Done;
+        return;
+    }
+
+    if (_emitDepth >= 0) {
+        _text.boundary();
+    }
+    if (_field != Field::None) {
+        _fieldSink.boundary();
+    }
+
+    Frame f;
+    f.name = _name;
+
+    if (!_rss) {
+        bool onPath = false;
+        if (depth == 0) {
+            onPath = _elementSteps == 0 || name_matches(_name, _steps[0]);
+        } else {
+            Frame& parent = _stack.back();
+            if (parent.onPath && !parent.childTaken && depth < _elementSteps && name_matches(_name, _steps[depth]) &&
+                parent.matches++ == _steps[depth].index) {
+                onPath = true;
+                parent.childTaken = true;
+            }
+        }
+        f.onPath = onPath;
+
+        const std::size_t target = _elementSteps == 0 ? 0 : _elementSteps - 1;
+        if (onPath && depth == target) {
+            // Only the first match counts, even if it lacks the attribute.
+            if (_elementSteps < _steps.size()) {
+                _attrTarget = true;
+            } else {
+                _found = true;
+                _emitDepth = static_cast<long>(depth + 1);
+                _text.start(&_translated, std::numeric_limits<std::size_t>::max());
+            }
+        }
+    } else {
+        const std::string_view local = local_name(_name);
+        if (_itemDepth == 0) {
+            if (equal_nocase(local, "item") || equal_nocase(local, "entry")) {
+                _itemDepth = depth + 1;
+                _title.clear();
+                _link.clear();
+                _date.clear();
+            }
+        } else if (depth == _itemDepth && _field == Field::None) {
+            std::string* target = nullptr;
+            if (equal_nocase(local, "title")) {
+                _field = Field::Title;
+                target = &_title;
+            } else if (equal_nocase(local, "link")) {
+                _field = Field::Link;
+                target = &_link;
+                _href.clear();
+                _rel.clear();
+            } else if (equal_nocase(local, "pubDate") || equal_nocase(local, "date") ||
+                       equal_nocase(local, "published") || equal_nocase(local, "updated")) {
+                _field = Field::Date;
+                target = &_date;
+            }
+            if (target && !target->empty()) {
+                _field = Field::None; // the first of each field wins
+            } else if (target) {
+                _fieldDepth = depth + 1;
+                _fieldSink.start(target, MAX_FIELD);
+            }
+        }
+    }
+
+    _stack.push_back(std::move(f));
+}
+
+void XmlContentTranslator::start_tag_done(bool empty)
+{
+    if (_attrTarget) {
+        // The selected element's attributes are all seen.
+        _attrTarget = false;
+        _state = State::Done;
+        return;
+    }
+
+    if (_field == Field::Link && _stack.size() == _fieldDepth && !_href.empty()) {
+        // Atom: <link rel="alternate" href="..."/>
+        if (_rel.empty() || equal_nocase(_rel, "alternate")) {
+            _link = _href;
+        }
+        _field = Field::None;
+        _fieldDepth = 0;
+    }
+
+    if (empty && !_stack.empty()) {
+        pop_frame();
+    }
+}
+
+void XmlContentTranslator::end_element(const std::string& name)
+{
+    // Close back to the matching start tag; an unmatched end tag is ignored.
+    for (std::size_t i = _stack.size(); i > 0; --i) {
+        if (_stack[i - 1].name == name) {
+            while (_stack.size() >= i && _state != State::Done) {
+                pop_frame();
+            }
+            return;
+        }
+    }
+}
+
+void XmlContentTranslator::pop_frame()
+{
+    _stack.pop_back();
+    const std::size_t depth = _stack.size();
+
+    if (_emitDepth >= 0) {
+        if (depth < static_cast<std::size_t>(_emitDepth)) {
+            // The selected element is complete; nothing else can match.
+            _emitDepth = -1;
+            _state = State::Done;
+            return;
+        }
+        _text.boundary();
+    }
+
+    if (_rss) {
+        if (_field != Field::None) {
+            if (depth < _fieldDepth) {
+                _field = Field::None;
+                _fieldDepth = 0;
+            } else {
+                _fieldSink.boundary();
+            }
+        }
+        if (_itemDepth != 0 && depth < _itemDepth) {
+            end_item();
+        }
+    }
+}
+
+void XmlContentTranslator::begin_attribute()
+{
+    _attrSelected = _attrTarget && name_matches(_name, _steps.back());
+    if (_attrSelected) {
+        _attrTarget = false; // first matching attribute only
+        _found = true;
+    }
+
+    const bool linkTag = _field == Field::Link && _stack.size() == _fieldDepth;
+    _attrHref = linkTag && equal_nocase(_name, "href");
+    _attrRel = linkTag && equal_nocase(_name, "rel");
+}
+
+void XmlContentTranslator::end_attribute()
+{
+    if (_attrSelected) {
+        _attrSelected = false;
+        _state = State::Done;
+    }
+    _attrHref = false;
+    _attrRel = false;
+}
+
+void XmlContentTranslator::end_item()
+{
+    _itemDepth = 0;
+    _field = Field::None;
+    _fieldDepth = 0;
+
+    _translated += _title;
+    _translated.push_back('\n');
+    _translated += _link;
+    _translated.push_back('\n');
+    _translated += _date;
+    _translated.push_back('\n');
+    _found = true;
+
+    if (_maxItems != 0 && ++_items >= _maxItems) {
+        _state = State::Done;
+    }
+}
+
+std::uint64_t XmlContentTranslator::translated_size() const
+{
+    return static_cast<std::uint64_t>(_translated.size());
+}
+
+StatusCode XmlContentTranslator::read(std::uint32_t offset,
+                                      std::uint8_t* out,
+                                      std::size_t maxBytes,
+                                      std::uint16_t& actual,
+                                      bool& eof) const
+{
+    actual = 0;
+    eof = false;
+
+    const auto total = static_cast<std::uint32_t>(_translated.size());
+    if (offset > total) {
+        return StatusCode::InvalidRequest;
+    }
+
+    const auto remaining = total - offset;
+    const auto n = std::min<std::size_t>(remaining, maxBytes);
+    if (n > 0 && out) {
+        std::memcpy(out, _translated.data() + offset, n);
+    }
+
+    actual = static_cast<std::uint16_t>(n);
+    eof = (offset + actual) >= total;
+    return StatusCode::Ok;
+}
+
+StatusCode XmlContentTranslator::query(std::string_view body,
+                                       const std::string& selector,
+                                       std::string& out,
+                                       bool& found) const
+{
+    out.clear();
+    found = false;
+
+    XmlContentTranslator t;
+    TranslationConfig cfg = _config;
+    cfg.selector = selector;
+    const StatusCode st = t.configure(cfg);
+    if (st != StatusCode::Ok) {
+        return st;
+    }
+    (void)t.append_body(reinterpret_cast<const std::uint8_t*>(body.data()), body.size());
+    (void)t.finalize();
+    found = t._found;
+    out = std::move(t._translated);
+    return StatusCode::Ok;
+}
+
+StatusCode XmlContentTranslator::reselect(std::string_view body, const TranslationConfig& config)
+{
+    const StatusCode st = configure(config);
+    if (st != StatusCode::Ok) {
+        return st;
+    }
+    (void)append_body(reinterpret_cast<const std::uint8_t*>(body.data()), body.size());
+    return finalize();
+}
+
+} // namespace fujinet::io
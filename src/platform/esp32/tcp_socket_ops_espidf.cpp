@@ -114,6 +114,19 @@ public:
         return sr > 0; // true if ready, false if still connecting
     }
 
+    bool wait_readable(int fd, std::chrono::milliseconds timeout) override
+    {
+        fd_set rfds;
+        FD_ZERO(&rfds);
+        FD_SET(fd, &rfds);
+
+        timeval tv {};
+        tv.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+        tv.tv_usec = static_cast<suseconds_t>((timeout.count() % 1000) * 1000);
+
+        return lwip_select(fd + 1, &rfds, nullptr, nullptr, &tv) > 0;
+    }
+
     SSize send(int fd, const void* buf, std::size_t len) override
     {
         // ESP-IDF lwIP: MSG_DONTWAIT for nonblocking
@@ -78,6 +78,17 @@ public:
         return _udp && _udp->wait_for_readable(timeout);
     }
 
+    void add_wait_sources(fujinet::io::WaitSet& ws) override
+    {
+        if (!_rx.empty()) {
+            ws.wake_now();
+            return;
+        }
+        if (_udp) {
+            _udp->add_wait_sources(ws);
+        }
+    }
+
 private:
     void write_netsio()
     {
@@ -67,6 +67,19 @@ public:
         return true;
     }
 
+    void add_wait_sources(fujinet::io::WaitSet& ws) override
+    {
+        if (_rx_off < _rx.size()) {
+            ws.wake_now();
+            return;
+        }
+        // A master with no slave attached reports HUP forever; don't let it
+        // wake the loop.
+        if (is_connected()) {
+            ws.add_readable(_masterFd);
+        }
+    }
+
     bool read_byte(std::uint8_t& out, int timeout_ms) override
     {
         if (_masterFd < 0) {
@@ -79,6 +79,9 @@ public:
 
         unsigned char ch = 0;
         const ssize_t n = ::read(STDIN_FILENO, &ch, 1);
+        if (n == 0) {
+            _eof = true; // e.g. stdin is /dev/null under a supervisor
+        }
         if (n != 1) {
             return false;
         }
@@ -87,6 +90,18 @@ public:
 #endif
     }
 
+    void add_wait_sources(fujinet::io::WaitSet& ws) override
+    {
+#if !defined(_WIN32)
+        // At EOF stdin stays readable forever; stop registering it.
+        if (!_eof) {
+            ws.add_readable(STDIN_FILENO);
+        }
+#else
+        (void)ws;
+#endif
+    }
+
     void write(std::string_view s) override
     {
         std::cout.write(s.data(), static_cast<std::streamsize>(s.size()));
@@ -103,6 +118,7 @@ public:
 private:
 #if !defined(_WIN32)
     bool _hasTermios{false};
+    bool _eof{false};
     termios _orig{};
 #endif
 };
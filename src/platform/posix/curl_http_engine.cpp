@@ -0,0 +1,197 @@
+#include "fujinet/platform/posix/curl_http_engine.h"
+
+#if FN_WITH_CURL == 1
+
+#include <chrono>
+
+#include <sys/select.h>
+
+#include "fujinet/core/logging.h"
+
+namespace fujinet::platform::posix {
+
+namespace {
+constexpr const char* TAG = "platform";
+
+// Bound per-host fan-out; extra sessions queue inside libcurl (or share one
+// HTTP/2 connection) instead of opening a socket each.
+constexpr long kMaxHostConnections = 4;
+constexpr long kMaxCachedConnections = 16;
+} // namespace
+
+CurlHttpEngine& CurlHttpEngine::instance()
+{
+    static CurlHttpEngine engine;
+    return engine;
+}
+
+CurlHttpEngine::CurlHttpEngine()
+{
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    _share = curl_share_init();
+    if (_share) {
+        curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        // Connection sharing needs libcurl >= 7.57; older builds still pool
+        // through the shared multi handle.
+        if (curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT) != CURLSHE_OK) {
+            FN_LOGD(TAG, "HTTP: libcurl cannot share connections; using multi pool only");
+        }
+    } else {
+        FN_LOGW(TAG, "HTTP: curl_share_init failed; DNS/TLS session caches are per-request");
+    }
+
+    _multi = curl_multi_init();
+    if (_multi) {
+        curl_multi_setopt(_multi, CURLMOPT_PIPELINING, static_cast<long>(CURLPIPE_MULTIPLEX));
+        curl_multi_setopt(_multi, CURLMOPT_MAX_HOST_CONNECTIONS, kMaxHostConnections);
+        curl_multi_setopt(_multi, CURLMOPT_MAXCONNECTS, kMaxCachedConnections);
+    } else {
+        FN_LOGE(TAG, "HTTP: curl_multi_init failed");
+    }
+}
+
+CurlHttpEngine::~CurlHttpEngine()
+{
+    if (_multi) {
+        curl_multi_cleanup(_multi);
+        _multi = nullptr;
+    }
+    if (_share) {
+        curl_share_cleanup(_share);
+        _share = nullptr;
+    }
+}
+
+void CurlHttpEngine::configure(CURL* easy)
+{
+    if (!easy) {
+        return;
+    }
+    if (_share) {
+        curl_easy_setopt(easy, CURLOPT_SHARE, _share);
+    }
+    // Prefer h2 over TLS, and wait for an existing connection that may be
+    // able to multiplex rather than racing a new one.
+    curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+    curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+    curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(easy, CURLOPT_DNS_CACHE_TIMEOUT, 300L);
+}
+
+bool CurlHttpEngine::add(CURL* easy)
+{
+    if (!_multi || !easy) {
+        return false;
+    }
+    _done.erase(easy);
+    _paused.erase(easy);
+    if (curl_multi_add_handle(_multi, easy) != CURLM_OK) {
+        return false;
+    }
+    ++_running; // until the next perform() recounts
+    return true;
+}
+
+void CurlHttpEngine::remove(CURL* easy)
+{
+    if (!_multi || !easy) {
+        return;
+    }
+    _done.erase(easy);
+    _paused.erase(easy);
+    (void)curl_multi_remove_handle(_multi, easy);
+}
+
+void CurlHttpEngine::perform()
+{
+    if (!_multi) {
+        return;
+    }
+
+    (void)curl_multi_perform(_multi, &_running);
+
+    int msgsLeft = 0;
+    while (CURLMsg* msg = curl_multi_info_read(_multi, &msgsLeft)) {
+        if (msg->msg != CURLMSG_DONE) continue;
+
+        CURL* easy = msg->easy_handle;
+        _done[easy] = msg->data.result;
+        _paused.erase(easy);
+
+        ++_stats.transfers;
+        long connects = 0;
+        if (curl_easy_getinfo(easy, CURLINFO_NUM_CONNECTS, &connects) == CURLE_OK && connects == 0) {
+            ++_stats.reusedConnections;
+        }
+
+        // Leave the multi now so a finished handle never holds a connection
+        // the next transfer could reuse.
+        curl_multi_remove_handle(_multi, easy);
+    }
+}
+
+void CurlHttpEngine::set_paused(CURL* easy, bool paused)
+{
+    if (!easy) {
+        return;
+    }
+    if (paused) {
+        _paused.insert(easy);
+    } else {
+        _paused.erase(easy);
+    }
+}
+
+bool CurlHttpEngine::take_done(CURL* easy, CURLcode& result)
+{
+    auto it = _done.find(easy);
+    if (it == _done.end()) {
+        return false;
+    }
+    result = it->second;
+    _done.erase(it);
+    return true;
+}
+
+void CurlHttpEngine::add_wait_sources(io::WaitSet& ws)
+{
+    if (!_multi || _running == 0) {
+        return;
+    }
+
+    fd_set readFds;
+    fd_set writeFds;
+    fd_set excFds;
+    FD_ZERO(&readFds);
+    FD_ZERO(&writeFds);
+    FD_ZERO(&excFds);
+    int maxFd = -1;
+    if (curl_multi_fdset(_multi, &readFds, &writeFds, &excFds, &maxFd) != CURLM_OK) {
+        ws.wake_now();
+        return;
+    }
+
+    for (int fd = 0; fd <= maxFd; ++fd) {
+        if (FD_ISSET(fd, &readFds)) ws.add_readable(fd);
+        if (FD_ISSET(fd, &writeFds)) ws.add_writable(fd);
+    }
+
+    // libcurl has no socket yet (resolver thread, retry backoff): fall back
+    // to its own timer so progress isn't left to the idle heartbeat. Paused
+    // transfers have no socket either, but nothing happens until a host read
+    // resumes them, so don't poll for those.
+    long timeoutMs = -1;
+    (void)curl_multi_timeout(_multi, &timeoutMs);
+    const bool allPaused = _paused.size() >= static_cast<std::size_t>(_running);
+    if (timeoutMs >= 0) {
+        ws.limit_timeout(std::chrono::milliseconds(timeoutMs));
+    } else if (maxFd < 0 && !allPaused) {
+        ws.limit_timeout(std::chrono::milliseconds(10));
+    }
+}
+
+} // namespace fujinet::platform::posix
+
+#endif // FN_WITH_CURL
@@ -65,7 +65,11 @@ std::unique_ptr<fujinet::fs::IFileSystem> create_tnfs_filesystem(bool useTcp) {
         return fujinet::tnfs::make_udp_tnfs_client(std::move(channel));
     };
 
-    return fujinet::fs::make_tnfs_filesystem(std::move(factory));
+    // A slow or unreachable server answers NotReady (or defers the request)
+    // instead of stalling the core loop for the whole retransmit budget.
+    fujinet::fs::TnfsSessionPoolConfig poolConfig;
+    poolConfig.nonBlocking = true;
+    return fujinet::fs::make_tnfs_filesystem(std::move(factory), poolConfig);
 }
 
 std::unique_ptr<fujinet::fs::IFileSystem> create_http_filesystem()
@@ -10,6 +10,7 @@
 #include <string>
 
 #include "fujinet/core/logging.h"
+#include "fujinet/platform/posix/curl_http_engine.h"
 #include "fujinet/net/https_trust_config.h"
 #include "fujinet/net/test_ca_cert.h"
 
@@ -119,15 +120,6 @@ CURLcode replace_with_test_ca_sslctx_cb(CURL* curl, void* sslctx, void* /*userda
 
 } // namespace
 
-static void ensure_curl_global_init()
-{
-    static const bool inited = []{
-        curl_global_init(CURL_GLOBAL_DEFAULT);
-        return true;
-    }();
-    (void)inited;
-}
-
 static bool method_supported(std::uint8_t method)
 {
     // v1: GET(1), POST(2), PUT(3), DELETE(4), HEAD(5)
@@ -143,6 +135,14 @@ static bool method_supported(std::uint8_t method)
     }
 }
 
+HttpNetworkProtocolCurl::HttpNetworkProtocolCurl(BufferLimits limits)
+    : _limits(limits)
+{
+    const std::size_t minHigh = _limits.lowWater + static_cast<std::size_t>(CURL_MAX_WRITE_SIZE);
+    _limits.highWater = std::max(_limits.highWater, minHigh);
+    _body.buf.assign(_limits.highWater, 0);
+}
+
 std::size_t HttpNetworkProtocolCurl::write_body_cb(
     char *ptr,
     std::size_t size,
@@ -169,9 +169,21 @@ std::size_t HttpNetworkProtocolCurl::write_body_cb(
     if (!ptr)
         return 0;
 
-    self->_body.insert(self->_body.end(),
-                       reinterpret_cast<const std::uint8_t *>(ptr),
-                       reinterpret_cast<const std::uint8_t *>(ptr) + n);
+    self->_bodyStarted = true;
+
+    // Ring full: have curl hold this chunk and stop reading the socket until
+    // read_body() drains below the low-water mark. curl redelivers the same
+    // chunk on resume.
+    if (n > self->_body.free_space()) {
+        if (n > self->_body.buf.size()) {
+            return 0; // can't ever fit; abort rather than stall forever
+        }
+        self->_paused = true;
+        CurlHttpEngine::instance().set_paused(self->_curl, true);
+        return CURL_WRITEFUNC_PAUSE;
+    }
+
+    self->_body.push(reinterpret_cast<const std::uint8_t *>(ptr), n);
     return n;
 }
 
@@ -235,51 +247,41 @@ io::StatusCode HttpNetworkProtocolCurl::start_async()
     _headersBlock.clear();
     _body.clear();
     _bodyBaseOffset = 0;
-    _bodyStartIndex = 0;
-
-    if (!_multi) {
-        _multi = curl_multi_init();
-        if (!_multi) {
-            return io::StatusCode::InternalError;
-        }
-    }
+    _paused = false;
+    _bodyStarted = false;
 
     if (_inProgress) {
         return io::StatusCode::InvalidRequest;
     }
 
+    if (!CurlHttpEngine::instance().add(_curl)) {
+        return io::StatusCode::InternalError;
+    }
+
     _performed = false;
     _inProgress = true;
     _finalStatus = io::StatusCode::Ok;
 
-    curl_multi_add_handle(_multi, _curl);
     tick_async(); // initial progress (may deliver first bytes immediately)
     return io::StatusCode::Ok;
 }
 
 void HttpNetworkProtocolCurl::tick_async()
 {
-    if (!_multi || !_curl || !_inProgress) {
+    if (!_curl || !_inProgress) {
         return;
     }
 
-    int running = 0;
-    int numfds = 0;
-    // Non-blocking poll to let libcurl process socket readiness.
-    // (The caller controls timing via NetworkDevice::poll/read_body calls.)
-    (void)curl_multi_poll(_multi, nullptr, 0, 0, &numfds);
-    (void)curl_multi_perform(_multi, &running);
-
-    int msgsLeft = 0;
-    while (CURLMsg* msg = curl_multi_info_read(_multi, &msgsLeft)) {
-        if (msg->msg != CURLMSG_DONE) continue;
-        if (msg->easy_handle != _curl) continue;
+    // Drives every session's transfer; completions for other handles stay
+    // queued in the engine until their owner asks.
+    auto& engine = CurlHttpEngine::instance();
+    engine.perform();
 
+    CURLcode result = CURLE_OK;
+    if (engine.take_done(_curl, result)) {
         _inProgress = false;
         _performed = true;
 
-        curl_multi_remove_handle(_multi, _curl);
-
         long httpCode = 0;
         curl_easy_getinfo(_curl, CURLINFO_RESPONSE_CODE, &httpCode);
         _httpStatus = static_cast<std::uint16_t>(httpCode < 0 ? 0 : httpCode);
@@ -294,7 +296,7 @@ void HttpNetworkProtocolCurl::tick_async()
             _contentLength = 0;
         }
 
-        _finalStatus = (msg->data.result == CURLE_OK) ? io::StatusCode::Ok : io::StatusCode::IOError;
+        _finalStatus = (result == CURLE_OK) ? io::StatusCode::Ok : io::StatusCode::IOError;
     }
 }
 
@@ -306,7 +308,7 @@ io::StatusCode HttpNetworkProtocolCurl::open(const io::NetworkOpenRequest& req)
         return io::StatusCode::Unsupported;
     }
 
-    ensure_curl_global_init();
+    auto& engine = CurlHttpEngine::instance();
     _req = req;
 
     const auto trust_policy = fujinet::net::https_trust_policy();
@@ -335,6 +337,7 @@ io::StatusCode HttpNetworkProtocolCurl::open(const io::NetworkOpenRequest& req)
     if (!_curl) {
         return io::StatusCode::InternalError;
     }
+    engine.configure(_curl);
 
     // Build request headers
     for (const auto& kv : _req.headers) {
@@ -405,7 +408,8 @@ io::StatusCode HttpNetworkProtocolCurl::open(const io::NetworkOpenRequest& req)
     _inProgress = false;
     _finalStatus = io::StatusCode::Ok;
     _bodyBaseOffset = 0;
-    _bodyStartIndex = 0;
+    _paused = false;
+    _bodyStarted = false;
 
     const bool hasBody = (_req.bodyLenHint > 0);
     const bool bodyUnknown = ((_req.flags & 0x04) != 0) && (_req.bodyLenHint == 0) && (isPost || isPut);
@@ -537,7 +541,7 @@ io::StatusCode HttpNetworkProtocolCurl::read_body(std::uint32_t offset,
     }
     const std::size_t rel = static_cast<std::size_t>(rel64);
 
-    const std::size_t avail = (_body.size() >= _bodyStartIndex) ? (_body.size() - _bodyStartIndex) : 0;
+    const std::size_t avail = _body.size();
     if (rel > avail) {
         if (_performed) {
             eof = true;
@@ -555,7 +559,7 @@ io::StatusCode HttpNetworkProtocolCurl::read_body(std::uint32_t offset,
     }
 
     if (n > 0 && out) {
-        std::memcpy(out, _body.data() + _bodyStartIndex + rel, n);
+        _body.peek(rel, out, n);
         read = static_cast<std::uint16_t>(n);
     }
 
@@ -565,13 +569,15 @@ io::StatusCode HttpNetworkProtocolCurl::read_body(std::uint32_t offset,
 
     // Retire bytes once host has consumed them (sequential offsets expected).
     if (n > 0 && rel == 0) {
-        _bodyStartIndex += n;
+        _body.drop(n);
         _bodyBaseOffset += static_cast<std::uint32_t>(n);
 
-        // Compact occasionally.
-        if (_bodyStartIndex > 4096 && _bodyStartIndex * 2 > _body.size()) {
-            _body.erase(_body.begin(), _body.begin() + static_cast<std::ptrdiff_t>(_bodyStartIndex));
-            _bodyStartIndex = 0;
+        if (_paused && _body.size() <= _limits.lowWater && _curl) {
+            _paused = false;
+            CurlHttpEngine::instance().set_paused(_curl, false);
+            // May call write_body_cb right away with the held chunk; there is
+            // at least CURL_MAX_WRITE_SIZE of room now.
+            curl_easy_pause(_curl, CURLPAUSE_CONT);
         }
     }
 
@@ -584,19 +590,36 @@ io::StatusCode HttpNetworkProtocolCurl::read_body(std::uint32_t offset,
 io::StatusCode HttpNetworkProtocolCurl::info(io::NetworkInfo& out)
 {
     tick_async();
-    if (!_performed) return io::StatusCode::NotReady;
-    if (_finalStatus != io::StatusCode::Ok) return _finalStatus;
+
+    // Metadata is available as soon as the final response's body starts.
+    // Waiting for completion would deadlock once the body outgrows the ring
+    // and the transfer pauses for the host to read.
+    if (!_performed && !(_inProgress && _bodyStarted)) return io::StatusCode::NotReady;
+    if (_performed && _finalStatus != io::StatusCode::Ok) return _finalStatus;
 
     out = io::NetworkInfo{};
     out.hasHttpStatus = true;
-    out.httpStatus = _httpStatus;
 
-    out.hasContentLength = _hasContentLength;
-    if (_hasContentLength) {
-        out.contentLength = _contentLength;
+    if (_performed) {
+        out.httpStatus = _httpStatus;
+        out.hasContentLength = _hasContentLength;
+        if (_hasContentLength) {
+            out.contentLength = _contentLength;
+        } else {
+            // Transfer complete: total bytes received = already retired + currently buffered
+            out.contentLength = static_cast<std::uint64_t>(_bodyBaseOffset) + _body.size();
+        }
     } else {
-        // Transfer complete: total bytes received = already retired + currently buffered
-        out.contentLength = static_cast<std::uint64_t>(_bodyBaseOffset + (_body.size() - _bodyStartIndex));
+        long httpCode = 0;
+        curl_easy_getinfo(_curl, CURLINFO_RESPONSE_CODE, &httpCode);
+        out.httpStatus = static_cast<std::uint16_t>(httpCode < 0 ? 0 : httpCode);
+
+        curl_off_t contentLength = -1;
+        if (curl_easy_getinfo(_curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &contentLength) == CURLE_OK &&
+            contentLength >= 0) {
+            out.hasContentLength = true;
+            out.contentLength = static_cast<std::uint64_t>(contentLength);
+        }
     }
 
     // headers already filtered.
@@ -610,6 +633,13 @@ void HttpNetworkProtocolCurl::poll()
     tick_async();
 }
 
+void HttpNetworkProtocolCurl::add_wait_sources(io::WaitSet& ws)
+{
+    if (_inProgress) {
+        CurlHttpEngine::instance().add_wait_sources(ws);
+    }
+}
+
 
 void HttpNetworkProtocolCurl::close()
 {
@@ -620,7 +650,8 @@ void HttpNetworkProtocolCurl::close()
     _headersBlock.clear();
     _body.clear();
     _bodyBaseOffset = 0;
-    _bodyStartIndex = 0;
+    _paused = false;
+    _bodyStarted = false;
 
     _requestBody.clear();
     _expectedRequestBodyLen = 0;
@@ -629,16 +660,11 @@ void HttpNetworkProtocolCurl::close()
     _finalStatus = io::StatusCode::Ok;
 
     if (_curl) {
-        if (_multi) {
-            curl_multi_remove_handle(_multi, _curl);
-        }
+        // Any connection this handle used returns to the shared pool.
+        CurlHttpEngine::instance().remove(_curl);
         curl_easy_cleanup(_curl);
         _curl = nullptr;
     }
-    if (_multi) {
-        curl_multi_cleanup(_multi);
-        _multi = nullptr;
-    }
     if (_slist) {
         curl_slist_free_all(_slist);
         _slist = nullptr;
@@ -0,0 +1,51 @@
+#include "fujinet/platform/posix/poll_reactor.h"
+
+#include <cerrno>
+#include <thread>
+
+namespace fujinet::platform::posix {
+
+bool PollReactor::wait(const io::WaitSet& ws, std::chrono::milliseconds idle)
+{
+    const auto timeout = ws.timeout(idle);
+    const auto start = std::chrono::steady_clock::now();
+
+    _fds.clear();
+    for (const auto& e : ws.entries()) {
+        pollfd p{};
+        p.fd = e.fd;
+        p.events = static_cast<short>((e.readable ? POLLIN : 0) | (e.writable ? POLLOUT : 0));
+        _fds.push_back(p);
+    }
+
+    int ret = 0;
+    for (;;) {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+        const auto remaining = timeout > elapsed ? timeout - elapsed : std::chrono::milliseconds(0);
+
+        ret = ::poll(_fds.data(), static_cast<nfds_t>(_fds.size()), static_cast<int>(remaining.count()));
+        if (ret >= 0 || errno != EINTR) {
+            break;
+        }
+    }
+
+    if (ret <= 0) {
+        return false;
+    }
+
+    for (const auto& p : _fds) {
+        if ((p.revents & (POLLIN | POLLOUT)) != 0) {
+            return true;
+        }
+    }
+
+    // Only hangups/errors: sleep out what's left of the timeout.
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    if (elapsed < timeout) {
+        std::this_thread::sleep_for(timeout - elapsed);
+    }
+    return false;
+}
+
+} // namespace fujinet::platform::posix
@@ -63,6 +63,11 @@ public:
         return static_cast<std::size_t>(n);
     }
 
+    void add_wait_sources(fujinet::io::WaitSet& ws) override
+    {
+        ws.add_readable(_masterFd);
+    }
+
     void write(const std::uint8_t* buffer, std::size_t len) override
     {
         if (_masterFd < 0) {
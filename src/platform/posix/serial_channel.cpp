@@ -40,6 +40,11 @@ public:
         return (n > 0) ? static_cast<std::size_t>(n) : 0;
     }
 
+    void add_wait_sources(fujinet::io::WaitSet& ws) override
+    {
+        ws.add_readable(_fd);
+    }
+
     void write(const std::uint8_t* buffer, std::size_t len) override
     {
         if (_fd < 0) {
@@ -66,6 +66,13 @@ public:
         return 0;
     }
 
+    void add_wait_sources(fujinet::io::WaitSet& ws) override
+    {
+        // No client yet: a readable listen socket means one is waiting to be
+        // accepted on the next available()/read().
+        ws.add_readable(_clientFd >= 0 ? _clientFd : _listenFd);
+    }
+
     void write(const std::uint8_t* buffer, std::size_t len) override
     {
         ensure_client();
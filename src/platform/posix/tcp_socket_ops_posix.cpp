@@ -110,6 +110,16 @@ public:
         return pr > 0; // true if ready, false if still connecting
     }
 
+    bool wait_readable(int fd, std::chrono::milliseconds timeout) override
+    {
+        struct pollfd pfd {};
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+
+        const int pr = ::poll(&pfd, 1, static_cast<int>(timeout.count()));
+        return pr > 0;
+    }
+
     SSize send(int fd, const void* buf, std::size_t len) override
     {
         // Apply platform-specific flags for nonblocking behavior
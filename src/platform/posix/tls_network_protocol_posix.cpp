@@ -1,8 +1,10 @@
 #include "fujinet/platform/posix/tls_network_protocol_posix.h"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 #include <cerrno>
+#include <map>
 
 #include "fujinet/core/logging.h"
 #include "fujinet/net/https_trust_config.h"
@@ -23,7 +25,185 @@ namespace fujinet::platform::posix {
 
 static constexpr const char* TAG = "platform";
 static constexpr std::size_t RX_BUFFER_SIZE = 8192;
-static constexpr int CONNECT_TIMEOUT_SEC = 10;
+static constexpr int CONNECT_TIMEOUT_SEC = 10; // TCP connect plus handshake
+static constexpr std::size_t MAX_CACHED_SESSIONS = 16;
+
+namespace {
+
+using NewSessionCallback = int (*)(SSL*, SSL_SESSION*);
+
+// Adds the embedded FujiNet test CA to `store`. A duplicate is fine.
+bool add_test_ca(X509_STORE* store)
+{
+    BIO* bio = BIO_new_mem_buf(fujinet::net::test_ca_cert_pem, -1);
+    if (!bio) {
+        FN_LOGE(TAG, "TLS: Failed to create BIO for test CA");
+        return false;
+    }
+    X509* cert = PEM_read_bio_X509(bio, nullptr, nullptr, nullptr);
+    BIO_free(bio);
+    if (!cert) {
+        FN_LOGE(TAG, "TLS: Failed to parse test CA certificate");
+        return false;
+    }
+
+    const int addOk = X509_STORE_add_cert(store, cert);
+    const unsigned long err = ERR_peek_last_error();
+    X509_free(cert);
+    if (addOk != 1 && !(ERR_GET_LIB(err) == ERR_LIB_X509 && ERR_GET_REASON(err) == X509_R_CERT_ALREADY_IN_HASH_TABLE)) {
+        FN_LOGE(TAG, "TLS: Failed to add test CA certificate");
+        return false;
+    }
+    ERR_clear_error();
+    return true;
+}
+
+SSL_CTX* build_context(fujinet::net::HttpsTrustPolicy policy, NewSessionCallback onNewSession)
+{
+    SSL_CTX* ctx = SSL_CTX_new(TLS_client_method());
+    if (!ctx) {
+        FN_LOGE(TAG, "TLS: Failed to create SSL context");
+        return nullptr;
+    }
+
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, nullptr);
+
+    bool ok = true;
+    switch (policy) {
+    case fujinet::net::HttpsTrustPolicy::PlatformDefault:
+        SSL_CTX_set_default_verify_paths(ctx);
+        break;
+
+    case fujinet::net::HttpsTrustPolicy::TestCaOnly: {
+        FN_LOGD(TAG, "TLS: Using FujiNet Test CA only");
+        X509_STORE* store = X509_STORE_new();
+        if (!store) {
+            FN_LOGE(TAG, "TLS: Failed to create X509 store");
+            ok = false;
+            break;
+        }
+        SSL_CTX_set_cert_store(ctx, store); // ctx owns it from here
+        ok = add_test_ca(store);
+        break;
+    }
+
+    case fujinet::net::HttpsTrustPolicy::PlatformPlusTestCa: {
+        FN_LOGD(TAG, "TLS: Adding FujiNet Test CA to certificate verification store");
+        SSL_CTX_set_default_verify_paths(ctx);
+        X509_STORE* store = SSL_CTX_get_cert_store(ctx);
+        if (!store) {
+            FN_LOGE(TAG, "TLS: SSL_CTX has no cert store");
+            ok = false;
+            break;
+        }
+        ok = add_test_ca(store);
+        break;
+    }
+    }
+
+    if (!ok) {
+        SSL_CTX_free(ctx);
+        return nullptr;
+    }
+
+    // Client-side caching only through the new-session callback: OpenSSL's
+    // internal store is keyed by session ID, which a client can't look up.
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ctx, onNewSession);
+    return ctx;
+}
+
+// One SSL_CTX per trust policy for the life of the process, so the CA
+// store is loaded (and the test CA parsed) once, not per connection.
+class ContextCache {
+public:
+    ~ContextCache()
+    {
+        for (SSL_CTX* ctx : _contexts) {
+            if (ctx) SSL_CTX_free(ctx);
+        }
+    }
+
+    SSL_CTX* get(fujinet::net::HttpsTrustPolicy policy, NewSessionCallback onNewSession)
+    {
+        SSL_CTX*& ctx = _contexts[static_cast<std::size_t>(policy)];
+        if (!ctx) {
+            ctx = build_context(policy, onNewSession);
+        }
+        return ctx;
+    }
+
+private:
+    std::array<SSL_CTX*, 3> _contexts{};
+};
+
+// Resumable client sessions by "host:port", oldest evicted first.
+class SessionCache {
+public:
+    ~SessionCache()
+    {
+        for (auto& kv : _sessions) {
+            SSL_SESSION_free(kv.second.session);
+        }
+    }
+
+    // Borrowed; SSL_set_session() takes its own reference.
+    SSL_SESSION* find(const std::string& key) const
+    {
+        auto it = _sessions.find(key);
+        return it == _sessions.end() ? nullptr : it->second.session;
+    }
+
+    // Takes ownership of `session`.
+    void put(const std::string& key, SSL_SESSION* session)
+    {
+        auto it = _sessions.find(key);
+        if (it != _sessions.end()) {
+            SSL_SESSION_free(it->second.session);
+            it->second = Entry{session, ++_clock};
+            return;
+        }
+        if (_sessions.size() >= MAX_CACHED_SESSIONS) {
+            auto oldest = std::min_element(_sessions.begin(), _sessions.end(),
+                [](const auto& a, const auto& b) { return a.second.stamp < b.second.stamp; });
+            SSL_SESSION_free(oldest->second.session);
+            _sessions.erase(oldest);
+        }
+        _sessions.emplace(key, Entry{session, ++_clock});
+    }
+
+    void drop(const std::string& key)
+    {
+        auto it = _sessions.find(key);
+        if (it != _sessions.end()) {
+            SSL_SESSION_free(it->second.session);
+            _sessions.erase(it);
+        }
+    }
+
+private:
+    struct Entry {
+        SSL_SESSION* session;
+        std::uint64_t stamp;
+    };
+
+    std::map<std::string, Entry> _sessions;
+    std::uint64_t _clock{0};
+};
+
+ContextCache& contexts()
+{
+    static ContextCache cache;
+    return cache;
+}
+
+SessionCache& sessions()
+{
+    static SessionCache cache;
+    return cache;
+}
+
+} // namespace
 
 TlsNetworkProtocolPosix::TlsNetworkProtocolPosix()
     : _rxBuffer(RX_BUFFER_SIZE)
@@ -114,25 +294,34 @@ bool TlsNetworkProtocolPosix::parse_tls_url(const std::string& url,
     return !outHost.empty();
 }
 
+int TlsNetworkProtocolPosix::on_new_session(SSL* ssl, SSL_SESSION* session)
+{
+    // TLS 1.3 tickets arrive after the handshake, from inside SSL_read().
+    auto* self = static_cast<TlsNetworkProtocolPosix*>(SSL_get_app_data(ssl));
+    if (!self || self->_sessionKey.empty() || !SSL_SESSION_is_resumable(session)) {
+        return 0;
+    }
+    sessions().put(self->_sessionKey, session);
+    return 1; // we keep the reference
+}
+
 fujinet::io::StatusCode TlsNetworkProtocolPosix::open(const fujinet::io::NetworkOpenRequest& req)
 {
     close();
 
-    const auto trust_policy = fujinet::net::https_trust_policy();
-    if (trust_policy == fujinet::net::HttpsTrustPolicy::PlatformPlusTestCa) {
-        FN_LOGD(TAG, "TLS: Adding FujiNet Test CA to certificate verification store");
-    } else if (trust_policy == fujinet::net::HttpsTrustPolicy::TestCaOnly) {
-        FN_LOGD(TAG, "TLS: Using FujiNet Test CA only");
-    }
-
     if (!parse_tls_url(req.url, _host, _port)) {
         FN_LOGE(TAG, "TLS: Invalid URL format: %s", req.url.c_str());
         return fujinet::io::StatusCode::InvalidRequest;
     }
 
+    SSL_CTX* ctx = contexts().get(fujinet::net::https_trust_policy(), &TlsNetworkProtocolPosix::on_new_session);
+    if (!ctx) {
+        return fujinet::io::StatusCode::InternalError;
+    }
+
     FN_LOGI(TAG, "TLS: Connecting to %s:%u", _host.c_str(), _port);
 
-    // Resolve host
+    // Resolve host (still synchronous, as for tcp://)
     struct addrinfo hints{};
     hints.ai_family = AF_UNSPEC;     // IPv4 or IPv6
     hints.ai_socktype = SOCK_STREAM;
@@ -153,143 +342,27 @@ fujinet::io::StatusCode TlsNetworkProtocolPosix::open(const fujinet::io::Network
         return fujinet::io::StatusCode::InternalError;
     }
 
-    // Connect
+    // Non-blocking from the start: SSL_connect/SSL_read report WANT_READ or
+    // WANT_WRITE instead of blocking.
+    int flags = fcntl(_socket, F_GETFL, 0);
+    if (flags >= 0) {
+        fcntl(_socket, F_SETFL, flags | O_NONBLOCK);
+    }
+
     int connRet = connect(_socket, result->ai_addr, result->ai_addrlen);
+    const int connErr = errno;
     freeaddrinfo(result);
 
-    if (connRet < 0) {
-        FN_LOGE(TAG, "TLS: Connection failed to %s:%u: %s", _host.c_str(), _port, strerror(errno));
-        ::close(_socket);
-        _socket = -1;
+    if (connRet < 0 && connErr != EINPROGRESS) {
+        FN_LOGE(TAG, "TLS: Connection failed to %s:%u: %s", _host.c_str(), _port, strerror(connErr));
+        close();
         return fujinet::io::StatusCode::IOError;
     }
 
-    // Create SSL context
-    const SSL_METHOD* method = TLS_client_method();
-    _ctx = SSL_CTX_new(method);
-    if (!_ctx) {
-        FN_LOGE(TAG, "TLS: Failed to create SSL context");
-        ::close(_socket);
-        _socket = -1;
-        return fujinet::io::StatusCode::InternalError;
-    }
-
-    // Configure certificate verification
-    SSL_CTX_set_verify(_ctx, SSL_VERIFY_PEER, nullptr);
-
-    switch (trust_policy) {
-    case fujinet::net::HttpsTrustPolicy::PlatformDefault:
-        SSL_CTX_set_default_verify_paths(_ctx);
-        break;
-
-    case fujinet::net::HttpsTrustPolicy::TestCaOnly: {
-        X509_STORE* store = X509_STORE_new();
-        if (!store) {
-            FN_LOGE(TAG, "TLS: Failed to create X509 store");
-            SSL_CTX_free(_ctx);
-            _ctx = nullptr;
-            ::close(_socket);
-            _socket = -1;
-            return fujinet::io::StatusCode::InternalError;
-        }
-
-        BIO* bio = BIO_new_mem_buf(fujinet::net::test_ca_cert_pem, -1);
-        if (!bio) {
-            X509_STORE_free(store);
-            FN_LOGE(TAG, "TLS: Failed to create BIO for test CA");
-            SSL_CTX_free(_ctx);
-            _ctx = nullptr;
-            ::close(_socket);
-            _socket = -1;
-            return fujinet::io::StatusCode::InternalError;
-        }
-
-        X509* cert = PEM_read_bio_X509(bio, nullptr, nullptr, nullptr);
-        BIO_free(bio);
-        if (!cert) {
-            X509_STORE_free(store);
-            FN_LOGE(TAG, "TLS: Failed to parse test CA certificate");
-            SSL_CTX_free(_ctx);
-            _ctx = nullptr;
-            ::close(_socket);
-            _socket = -1;
-            return fujinet::io::StatusCode::InternalError;
-        }
-
-        if (X509_STORE_add_cert(store, cert) != 1) {
-            X509_free(cert);
-            X509_STORE_free(store);
-            FN_LOGE(TAG, "TLS: Failed to add test CA to store");
-            SSL_CTX_free(_ctx);
-            _ctx = nullptr;
-            ::close(_socket);
-            _socket = -1;
-            return fujinet::io::StatusCode::InternalError;
-        }
-        X509_free(cert);
-        SSL_CTX_set_cert_store(_ctx, store);
-        break;
-    }
-
-    case fujinet::net::HttpsTrustPolicy::PlatformPlusTestCa:
-        SSL_CTX_set_default_verify_paths(_ctx);
-        {
-        BIO* bio = BIO_new_mem_buf(fujinet::net::test_ca_cert_pem, -1);
-        if (!bio) {
-            FN_LOGE(TAG, "TLS: Failed to create BIO for test CA");
-            SSL_CTX_free(_ctx);
-            _ctx = nullptr;
-            ::close(_socket);
-            _socket = -1;
-            return fujinet::io::StatusCode::InternalError;
-        }
-
-        X509* cert = PEM_read_bio_X509(bio, nullptr, nullptr, nullptr);
-        BIO_free(bio);
-        if (!cert) {
-            FN_LOGE(TAG, "TLS: Failed to parse test CA certificate");
-            SSL_CTX_free(_ctx);
-            _ctx = nullptr;
-            ::close(_socket);
-            _socket = -1;
-            return fujinet::io::StatusCode::InternalError;
-        }
-
-        X509_STORE* store = SSL_CTX_get_cert_store(_ctx);
-        if (!store) {
-            X509_free(cert);
-            FN_LOGE(TAG, "TLS: SSL_CTX has no cert store");
-            SSL_CTX_free(_ctx);
-            _ctx = nullptr;
-            ::close(_socket);
-            _socket = -1;
-            return fujinet::io::StatusCode::InternalError;
-        }
-
-        const int addOk = X509_STORE_add_cert(store, cert);
-        const unsigned long err = ERR_peek_last_error();
-        X509_free(cert);
-        if (addOk != 1 && !(ERR_GET_LIB(err) == ERR_LIB_X509 && ERR_GET_REASON(err) == X509_R_CERT_ALREADY_IN_HASH_TABLE)) {
-            FN_LOGE(TAG, "TLS: Failed to add test CA certificate");
-            SSL_CTX_free(_ctx);
-            _ctx = nullptr;
-            ::close(_socket);
-            _socket = -1;
-            return fujinet::io::StatusCode::InternalError;
-        }
-        ERR_clear_error();
-        }
-        break;
-    }
-
-    // Create SSL connection
-    _ssl = SSL_new(_ctx);
+    _ssl = SSL_new(ctx);
     if (!_ssl) {
         FN_LOGE(TAG, "TLS: Failed to create SSL structure");
-        SSL_CTX_free(_ctx);
-        _ctx = nullptr;
-        ::close(_socket);
-        _socket = -1;
+        close();
         return fujinet::io::StatusCode::InternalError;
     }
 
@@ -299,34 +372,83 @@ fujinet::io::StatusCode TlsNetworkProtocolPosix::open(const fujinet::io::Network
     // Attach socket to SSL
     SSL_set_fd(_ssl, _socket);
 
-    // Perform TLS handshake
-    int sslRet = SSL_connect(_ssl);
-    if (sslRet != 1) {
-        int sslError = SSL_get_error(_ssl, sslRet);
-        handle_error("connect", sslError);
-        SSL_free(_ssl);
-        _ssl = nullptr;
-        SSL_CTX_free(_ctx);
-        _ctx = nullptr;
-        ::close(_socket);
-        _socket = -1;
+    _sessionKey = _host + ":" + std::to_string(_port);
+    SSL_set_app_data(_ssl, this);
+    if (SSL_SESSION* cached = sessions().find(_sessionKey)) {
+        SSL_set_session(_ssl, cached);
+    }
+
+    _state = connRet == 0 ? State::Handshaking : State::Connecting;
+    _handshakeWantsWrite = false;
+    _deadline = std::chrono::steady_clock::now() + std::chrono::seconds(CONNECT_TIMEOUT_SEC);
+
+    // Loopback and LAN peers often get through a step right away.
+    poll();
+    if (_state == State::Error) {
+        close();
         return fujinet::io::StatusCode::IOError;
     }
+    return fujinet::io::StatusCode::Ok;
+}
 
-    FN_LOGI(TAG, "TLS: Connected to %s:%u (cipher: %s)", 
-            _host.c_str(), _port, SSL_get_cipher_name(_ssl));
+bool TlsNetworkProtocolPosix::handshake_timed_out()
+{
+    if (std::chrono::steady_clock::now() < _deadline) {
+        return false;
+    }
+    FN_LOGE(TAG, "TLS: Timed out connecting to %s:%u", _host.c_str(), _port);
+    _lastError = ETIMEDOUT;
+    _state = State::Error;
+    return true;
+}
 
-    // Set socket to non-blocking mode AFTER TLS handshake completes
-    // This allows SSL_read to return SSL_ERROR_WANT_READ instead of blocking
-    int flags = fcntl(_socket, F_GETFL, 0);
-    if (flags >= 0) {
-        fcntl(_socket, F_SETFL, flags | O_NONBLOCK);
+void TlsNetworkProtocolPosix::step_connect()
+{
+    struct pollfd pfd{};
+    pfd.fd = _socket;
+    pfd.events = POLLOUT;
+    const int ready = ::poll(&pfd, 1, 0);
+    if (ready == 0) {
+        (void)handshake_timed_out();
+        return;
     }
 
-    reset_state();
-    _state = State::Connected;
+    int err = 0;
+    socklen_t len = sizeof(err);
+    if (ready < 0 || getsockopt(_socket, SOL_SOCKET, SO_ERROR, &err, &len) != 0) {
+        err = errno;
+    }
+    if (err != 0) {
+        FN_LOGE(TAG, "TLS: Connection failed to %s:%u: %s", _host.c_str(), _port, strerror(err));
+        _lastError = err;
+        _state = State::Error;
+        return;
+    }
+    _state = State::Handshaking;
+}
 
-    return fujinet::io::StatusCode::Ok;
+void TlsNetworkProtocolPosix::step_handshake()
+{
+    ERR_clear_error();
+    const int ret = SSL_connect(_ssl);
+    if (ret == 1) {
+        _state = State::Connected;
+        FN_LOGI(TAG, "TLS: Connected to %s:%u (cipher: %s%s)",
+                _host.c_str(), _port, SSL_get_cipher_name(_ssl),
+                SSL_session_reused(_ssl) ? ", resumed" : "");
+        return;
+    }
+
+    const int sslError = SSL_get_error(_ssl, ret);
+    if (sslError == SSL_ERROR_WANT_READ || sslError == SSL_ERROR_WANT_WRITE) {
+        _handshakeWantsWrite = sslError == SSL_ERROR_WANT_WRITE;
+        (void)handshake_timed_out();
+        return;
+    }
+
+    // Don't offer a session the server just failed with again.
+    sessions().drop(_sessionKey);
+    handle_error("connect", sslError);
 }
 
 fujinet::io::StatusCode TlsNetworkProtocolPosix::write_body(std::uint32_t offset,
@@ -336,6 +458,9 @@ fujinet::io::StatusCode TlsNetworkProtocolPosix::write_body(std::uint32_t offset
 {
     written = 0;
 
+    if (_state == State::Connecting || _state == State::Handshaking) {
+        return fujinet::io::StatusCode::NotReady;
+    }
     if (_state != State::Connected) {
         return fujinet::io::StatusCode::InvalidRequest;
     }
@@ -391,6 +516,10 @@ fujinet::io::StatusCode TlsNetworkProtocolPosix::read_body(std::uint32_t offset,
         return fujinet::io::StatusCode::IOError;
     }
 
+    if (_state == State::Connecting || _state == State::Handshaking) {
+        return fujinet::io::StatusCode::NotReady;
+    }
+
     if (!out || outLen == 0) {
         return fujinet::io::StatusCode::Ok;
     }
@@ -496,23 +625,68 @@ fujinet::io::StatusCode TlsNetworkProtocolPosix::info(fujinet::io::NetworkInfo&
 
 void TlsNetworkProtocolPosix::poll()
 {
-    // Nothing to poll for now - reads are handled synchronously
-    // Future: could implement async connection establishment here
+    if (_state == State::Connecting) {
+        step_connect();
+    }
+    if (_state == State::Handshaking) {
+        step_handshake();
+    }
+
+    // Pull decrypted bytes off the socket while the buffer is empty, so a
+    // readable socket is drained here (and stops waking the loop) rather
+    // than only when the host next calls Read.
+    if (_state != State::Connected || _rxAvailable > 0 || !_ssl) {
+        return;
+    }
+
+    const int ret = SSL_read(_ssl, _rxBuffer.data(), static_cast<int>(_rxBuffer.size()));
+    if (ret > 0) {
+        _rxAvailable = static_cast<std::size_t>(ret);
+        return;
+    }
+
+    const int sslError = SSL_get_error(_ssl, ret);
+    if (sslError == SSL_ERROR_WANT_READ || sslError == SSL_ERROR_WANT_WRITE) {
+        return;
+    }
+    if (sslError == SSL_ERROR_ZERO_RETURN) {
+        _peerClosed = true;
+        _state = State::PeerClosed;
+        return;
+    }
+    handle_error("poll", sslError);
+}
+
+void TlsNetworkProtocolPosix::add_wait_sources(fujinet::io::WaitSet& ws)
+{
+    if (_state == State::Connecting || _state == State::Handshaking) {
+        if (_state == State::Connecting || _handshakeWantsWrite) {
+            ws.add_writable(_socket);
+        } else {
+            ws.add_readable(_socket);
+        }
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            _deadline - std::chrono::steady_clock::now());
+        ws.limit_timeout(left);
+        return;
+    }
+
+    if (_state == State::Connected && _rxAvailable == 0) {
+        ws.add_readable(_socket);
+    }
 }
 
 void TlsNetworkProtocolPosix::close()
 {
     if (_ssl) {
-        SSL_shutdown(_ssl);
+        // No close_notify mid-handshake; the SSL_CTX is shared and stays.
+        if (_state == State::Connected || _state == State::PeerClosed) {
+            SSL_shutdown(_ssl);
+        }
         SSL_free(_ssl);
         _ssl = nullptr;
     }
     
-    if (_ctx) {
-        SSL_CTX_free(_ctx);
-        _ctx = nullptr;
-    }
-    
     if (_socket >= 0) {
         ::close(_socket);
         _socket = -1;
@@ -521,6 +695,7 @@ void TlsNetworkProtocolPosix::close()
     reset_state();
     _host.clear();
     _port = 0;
+    _sessionKey.clear();
 }
 
 } // namespace fujinet::platform::posix
@@ -0,0 +1,142 @@
+// FujiBus SLIP/checksum throughput benchmark.
+//
+// Not part of ctest; run by hand to compare kernels on a given host:
+//   ./fujibus_bench [iterations-scale]
+//
+// Reports MB/s per kernel for the raw scan and checksum loops and for full
+// frame encode/decode, across payload sizes and SLIP escape densities.
+
+#include "fujinet/io/protocol/fuji_bus_frame_decoder.h"
+#include "fujinet/io/protocol/fuji_bus_frame_encoder.h"
+#include "fujinet/io/protocol/fuji_bus_packet.h"
+#include "fujinet/io/protocol/slip_kernels.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace fujinet::io::protocol;
+
+namespace {
+
+constexpr SlipKernel kAllKernels[] = {
+    SlipKernel::Scalar, SlipKernel::Sse2, SlipKernel::Avx2, SlipKernel::Neon,
+};
+
+constexpr std::size_t kSizes[] = {128, 1024, 8192, 65000};
+
+// Escape density expressed as "one special byte per N" (0 = none).
+constexpr unsigned kDensities[] = {0, 1000, 100, 10};
+
+volatile std::uint64_t g_sink = 0;
+
+ByteBuffer make_payload(std::size_t n, unsigned specialEvery)
+{
+    std::mt19937 rng(42);
+    ByteBuffer out(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        std::uint8_t b = static_cast<std::uint8_t>(rng());
+        if (b == 0xC0 || b == 0xDB) {
+            b = 0x20;
+        }
+        if (specialEvery != 0 && rng() % specialEvery == 0) {
+            b = (rng() & 1) ? 0xC0 : 0xDB;
+        }
+        out[i] = b;
+    }
+    return out;
+}
+
+template <typename Fn>
+double mb_per_sec(std::size_t bytesPerIter, std::size_t iters, Fn&& fn)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iters; ++i) {
+        fn();
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const double secs = std::chrono::duration<double>(t1 - t0).count();
+    if (secs <= 0.0) {
+        return 0.0;
+    }
+    return (static_cast<double>(bytesPerIter) * static_cast<double>(iters)) / (secs * 1e6);
+}
+
+void scan_all(const ByteBuffer& buf)
+{
+    const std::uint8_t* p = buf.data();
+    const std::uint8_t* end = p + buf.size();
+    std::uint64_t hits = 0;
+    while (p < end) {
+        p = find_slip_special(p, end);
+        if (p < end) {
+            ++hits;
+            ++p;
+        }
+    }
+    g_sink = g_sink + hits;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const double scale = (argc > 1) ? std::atof(argv[1]) : 1.0;
+    const std::size_t budgetBytes = static_cast<std::size_t>(64.0 * 1024 * 1024 * (scale > 0 ? scale : 1.0));
+
+    std::printf("fujibus_bench: startup kernel = %s\n\n", to_string(active_slip_kernel()));
+    std::printf("%-7s %7s %7s %10s %10s %10s %10s %10s\n",
+                "kernel", "size", "1/esc", "scan", "checksum", "bytewise", "encode", "decode");
+
+    const SlipKernel startup = active_slip_kernel();
+    const PacketParam status{std::uint8_t{0}};
+
+    for (SlipKernel k : kAllKernels) {
+        if (!set_slip_kernel(k)) {
+            continue;
+        }
+
+        for (std::size_t size : kSizes) {
+            for (unsigned density : kDensities) {
+                const ByteBuffer payload = make_payload(size, density);
+                const std::size_t iters = budgetBytes / size + 1;
+
+                const double scan = mb_per_sec(size, iters, [&] { scan_all(payload); });
+
+                const double chk = mb_per_sec(size, iters, [&] {
+                    g_sink = g_sink + checksum_update(0, payload.data(), payload.size());
+                });
+
+                const double bytewise = mb_per_sec(size, iters, [&] {
+                    std::uint16_t c = 0;
+                    for (std::uint8_t b : payload) {
+                        c = checksum_step(c, b);
+                    }
+                    g_sink = g_sink + c;
+                });
+
+                ByteBuffer wire;
+                const double enc = mb_per_sec(size, iters, [&] {
+                    encode_frame(wire, static_cast<WireDeviceId>(0x70), 1, &status, 1,
+                                 payload.data(), payload.size());
+                });
+
+                FujiBusFrameDecoder dec;
+                FujiBusFrame frame;
+                const double decode = mb_per_sec(size, iters, [&] {
+                    dec.feed(wire.data(), wire.size());
+                    dec.next(frame);
+                });
+
+                std::printf("%-7s %7zu %7u %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                            to_string(k), size, density, scan, chk, bytewise, enc, decode);
+            }
+        }
+    }
+
+    set_slip_kernel(startup);
+    return 0;
+}
@@ -4,6 +4,7 @@
 
 #include <array>
 #include <cstdint>
+#include <vector>
 
 TEST_CASE("byte codec reads little-endian integers from byte pointers")
 {
@@ -27,3 +28,25 @@ TEST_CASE("byte codec Reader uses shared little-endian readers")
     CHECK(u32 == 0x12345678);
     CHECK(reader.remaining() == 0);
 }
+
+TEST_CASE("byte codec Writer builds in place and patches placeholders")
+{
+    std::vector<std::uint8_t> payload{0xff, 0xff};
+    fujinet::io::bytecodec::Writer writer(payload, 16);
+
+    fujinet::io::bytecodec::write_u8(writer, 0x01);
+    fujinet::io::bytecodec::write_u16le(writer, 0); // length placeholder
+    const std::uint8_t* before = payload.data();
+
+    std::uint8_t* tail = writer.reserve_tail(8);
+    tail[0] = 'h';
+    tail[1] = 'i';
+    writer.commit_tail(2);
+    writer.patch_u16le(1, 2);
+
+    CHECK(payload == std::vector<std::uint8_t>{0x01, 0x02, 0x00, 'h', 'i'});
+    CHECK(payload.data() == before); // capacity reserved up front
+
+    writer.discard();
+    CHECK(payload.empty());
+}
@@ -0,0 +1,97 @@
+#include "doctest.h"
+
+#include "fujinet/fs/directory_listing_cache.h"
+#include "fujinet/fs/storage_manager.h"
+#include "fake_fs.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+using fujinet::fs::DirectoryListingCache;
+using fujinet::fs::FileInfo;
+using fujinet::tests::MemoryFileSystem;
+
+namespace {
+
+std::vector<FileInfo> entries(const std::string& dir, std::initializer_list<const char*> names)
+{
+    std::vector<FileInfo> out;
+    for (const char* n : names) {
+        out.push_back(FileInfo{dir + "/" + n, false, 0, {}});
+    }
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("DirectoryListingCache: keeps several directories with a by-name index")
+{
+    MemoryFileSystem fs("host");
+    DirectoryListingCache cache(DirectoryListingCache::Config{2, std::chrono::milliseconds(1000)});
+
+    CHECK(cache.find(fs, "/a") == nullptr);
+    auto a = cache.insert(fs, "/a", entries("/a", {"zeta", "Alpha", "beta"}));
+    REQUIRE(a);
+    REQUIRE(a->byName.size() == 3);
+    CHECK(a->entries[a->byName[0]].path == "/a/Alpha");
+    CHECK(a->entries[a->byName[1]].path == "/a/beta");
+    CHECK(a->entries[a->byName[2]].path == "/a/zeta");
+
+    cache.insert(fs, "/b", entries("/b", {"x"}));
+    CHECK(cache.find(fs, "/a") == a); // /a now most recent
+    cache.insert(fs, "/c", entries("/c", {"y"}));
+
+    CHECK(cache.find(fs, "/a") == a);
+    CHECK(cache.find(fs, "/b") == nullptr);
+    CHECK(cache.stats().evictions == 1);
+
+    // Snapshots expire after the TTL.
+    const auto later = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    CHECK(cache.find(fs, "/c", later) == nullptr);
+}
+
+TEST_CASE("DirectoryListingCache: invalidating a path drops its parent and subtree only")
+{
+    MemoryFileSystem fs("host");
+    MemoryFileSystem other("sd");
+    DirectoryListingCache cache(DirectoryListingCache::Config{8, std::chrono::milliseconds(60000)});
+
+    cache.insert(fs, "/", entries("", {"games"}));
+    cache.insert(fs, "/games", entries("/games", {"a.atr"}));
+    cache.insert(fs, "/games/old", entries("/games/old", {"b.atr"}));
+    cache.insert(fs, "/docs", entries("/docs", {"readme"}));
+    cache.insert(other, "/games", entries("/games", {"c.atr"}));
+
+    // A file written in /games changes that listing only.
+    cache.invalidate(fs, "/games/new.atr");
+    CHECK(cache.find(fs, "/games") == nullptr);
+    CHECK(cache.find(fs, "/games/old") != nullptr);
+    CHECK(cache.find(fs, "/") != nullptr);
+
+    // Renaming /games away changes / and everything under /games.
+    cache.insert(fs, "/games", entries("/games", {"a.atr"}));
+    cache.invalidate(fs, "/games");
+    CHECK(cache.find(fs, "/") == nullptr);
+    CHECK(cache.find(fs, "/games") == nullptr);
+    CHECK(cache.find(fs, "/games/old") == nullptr);
+    CHECK(cache.find(fs, "/docs") != nullptr);
+    CHECK(cache.find(other, "/games") != nullptr);
+}
+
+TEST_CASE("StorageManager: invalidatePath drops listings and file handles")
+{
+    fujinet::fs::StorageManager sm;
+    auto owned = std::make_unique<MemoryFileSystem>("host");
+    MemoryFileSystem* fs = owned.get();
+    REQUIRE(fs->createDirectory("/dir"));
+    { auto f = fs->open("/dir/a", "wb"); REQUIRE(f); }
+    REQUIRE(sm.registerFileSystem(std::move(owned)));
+
+    sm.listings().insert(*fs, "/dir", entries("/dir", {"a"}));
+    sm.fileHandles().insert(*fs, "/dir/a", fujinet::fs::FileHandleCache::Mode::Read, fs->open("/dir/a", "rb"));
+
+    sm.invalidatePath(*fs, "/dir/a");
+    CHECK(sm.listings().size() == 0);
+    CHECK(sm.fileHandles().size() == 0);
+}
@@ -3,6 +3,7 @@
 #include "fake_fs.h"
 
 #include "fujinet/disk/disk_service.h"
+#include "fujinet/disk/sector_cache.h"
 #include "fujinet/fs/mount_applier.h"
 #include "fujinet/fs/storage_manager.h"
 #include "fujinet/io/core/io_message.h"
@@ -11,6 +12,7 @@
 #include "fujinet/io/protocol/wire_device_ids.h"
 
 #include <cstring>
+#include <memory>
 #include <vector>
 
 namespace diskproto = fujinet::io::diskproto;
@@ -120,14 +122,347 @@ TEST_CASE("DiskService: mount raw + read/write sector")
     CHECK(stats.writeRequests == 1);
     CHECK(stats.writeSectors == 1);
     CHECK(stats.failedRequests == 1);
-    CHECK(stats.image.readOps == 2);
+    // Second read is a cache hit; the write waits for write-back.
+    CHECK(stats.image.readOps == 1);
+    CHECK(stats.image.writeOps == 0);
+    CHECK(stats.cache.hits == 1);
+    CHECK(stats.cache.misses == 1);
+    CHECK(stats.cacheDirtySectors == 1);
+    CHECK(bytes[0] == 0x00);
+
+    REQUIRE(svc.flush(0).ok());
+    stats = svc.stats(0);
     CHECK(stats.image.writeOps == 1);
+    CHECK(stats.cache.writeBackSectors == 1);
+    CHECK(stats.cacheDirtySectors == 0);
+    CHECK(bytes[0] == 0xAA);
+    CHECK(bytes[1] == 0x55);
 
     CHECK(svc.info(0).dirty);
     REQUIRE(svc.unmount(0).ok());
     CHECK(!svc.info(0).inserted);
 }
 
+TEST_CASE("DiskService: sequential reads prefetch and writes coalesce until unmount")
+{
+    fujinet::fs::StorageManager sm;
+    auto memfs = std::make_unique<fujinet::tests::MemoryFileSystem>("mem");
+
+    const std::string path = "/disks/seq.img";
+    auto& bytes = memfs->file_bytes(path);
+    bytes.resize(32 * 256);
+    for (std::size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<std::uint8_t>(i / 256);
+
+    REQUIRE(sm.registerFileSystem(std::move(memfs)));
+
+    fujinet::disk::DiskService svc(sm, fujinet::disk::make_default_image_registry());
+
+    fujinet::disk::SectorCacheConfig cfg{};
+    cfg.capacitySectors = 16;
+    cfg.readAheadSectors = 4;
+    svc.set_cache_config(cfg);
+
+    fujinet::disk::MountOptions opts{};
+    opts.typeOverride = fujinet::disk::ImageType::Raw;
+    opts.sectorSizeHint = 256;
+    REQUIRE(svc.mount(0, "mem", path, opts).ok());
+
+    // lba 0 is a plain miss; lba 1 is sequential and pulls in 1..4 with a
+    // single image read.
+    std::vector<std::uint8_t> sec(256);
+    for (std::uint32_t lba = 0; lba < 5; ++lba) {
+        REQUIRE(svc.read_sector(0, lba, sec.data(), sec.size()).ok());
+        CHECK(sec[0] == lba);
+    }
+
+    auto stats = svc.stats(0);
+    CHECK(stats.image.readOps == 2);
+    CHECK(stats.cache.misses == 2);
+    CHECK(stats.cache.hits == 3);
+    CHECK(stats.cache.readAheadSectors == 3);
+
+    // Rewriting the same sectors only reaches the image once each.
+    std::vector<std::uint8_t> out(256);
+    for (int pass = 0; pass < 3; ++pass) {
+        for (std::uint32_t lba : {9u, 7u, 8u}) {
+            std::fill(out.begin(), out.end(), static_cast<std::uint8_t>(0xE0 + pass));
+            REQUIRE(svc.write_sector(0, lba, out.data(), out.size()).bytes == 256);
+        }
+    }
+    CHECK(svc.stats(0).image.writeOps == 0);
+    CHECK(svc.stats(0).cacheDirtySectors == 3);
+
+    // Written data is visible to reads before write-back.
+    REQUIRE(svc.read_sector(0, 8, sec.data(), sec.size()).ok());
+    CHECK(sec[0] == 0xE2);
+
+    // Unmount writes them back, as one contiguous run.
+    REQUIRE(svc.flush(0).ok());
+    CHECK(svc.stats(0).image.writeOps == 1);
+    CHECK(svc.stats(0).cache.writeBackSectors == 3);
+    REQUIRE(svc.unmount(0).ok());
+    for (std::size_t lba : {7u, 8u, 9u}) {
+        CHECK(bytes[lba * 256] == 0xE2);
+        CHECK(bytes[lba * 256 + 255] == 0xE2);
+    }
+    CHECK(bytes[6 * 256] == 6);
+    CHECK(bytes[10 * 256] == 10);
+
+    // Read-only slots still reject writes up front.
+    opts.readOnlyRequested = true;
+    REQUIRE(svc.mount(0, "mem", path, opts).ok());
+    CHECK(svc.write_sector(0, 1, out.data(), out.size()).error == fujinet::disk::DiskError::ReadOnly);
+    CHECK(svc.stats(0).cacheDirtySectors == 0);
+}
+
+namespace {
+
+// An image whose backend went away: every write and flush fails.
+class UnreachableImage final : public fujinet::disk::IDiskImage {
+public:
+    fujinet::disk::ImageType type() const noexcept override { return fujinet::disk::ImageType::Raw; }
+    fujinet::disk::DiskGeometry geometry() const noexcept override { return {256, 16, false}; }
+    bool read_only() const noexcept override { return false; }
+    fujinet::disk::DiskResult mount(std::unique_ptr<fujinet::fs::IFile>, std::uint64_t,
+                                    const fujinet::disk::MountOptions&) override
+    {
+        return {};
+    }
+    fujinet::disk::DiskResult unmount() override { return {}; }
+    fujinet::disk::DiskResult read_sector(std::uint32_t, std::uint8_t*, std::size_t) override
+    {
+        return {fujinet::disk::DiskError::IoError};
+    }
+    fujinet::disk::DiskResult write_sector(std::uint32_t, const std::uint8_t*, std::size_t) override
+    {
+        ++*writes;
+        return {reachable ? fujinet::disk::DiskError::None : fujinet::disk::DiskError::IoError};
+    }
+    fujinet::disk::DiskResult flush() override
+    {
+        return {reachable ? fujinet::disk::DiskError::None : fujinet::disk::DiskError::IoError};
+    }
+
+    bool reachable{false};
+    std::shared_ptr<int> writes = std::make_shared<int>(0);
+};
+
+} // namespace
+
+TEST_CASE("SectorCache: failed idle write-back backs off")
+{
+    using Clock = fujinet::disk::SectorCache::Clock;
+    using std::chrono::milliseconds;
+
+    UnreachableImage image;
+    fujinet::disk::SectorCache cache;
+    fujinet::disk::SectorCacheConfig cfg{};
+    cfg.writeBackDelay = milliseconds(100);
+    cache.set_config(cfg);
+
+    std::vector<std::uint8_t> sec(256, 0x5A);
+    REQUIRE(cache.write(image, 3, sec.data(), sec.size()).ok());
+
+    auto now = Clock::now() + milliseconds(200);
+    CHECK(cache.flush_if_idle(image, now).error == fujinet::disk::DiskError::IoError);
+    CHECK(*image.writes == 1);
+
+    // The retry is in the future, not overdue, and the delay doubles.
+    Clock::duration in{};
+    REQUIRE(cache.next_write_back(in, now));
+    CHECK(in == fujinet::disk::SectorCache::MIN_WRITE_BACK_RETRY);
+    CHECK(cache.flush_if_idle(image, now).ok());
+    CHECK(*image.writes == 1);
+
+    now += in;
+    CHECK_FALSE(cache.flush_if_idle(image, now).ok());
+    CHECK(*image.writes == 2);
+    REQUIRE(cache.next_write_back(in, now));
+    CHECK(in == 2 * fujinet::disk::SectorCache::MIN_WRITE_BACK_RETRY);
+
+    for (int i = 0; i < 10; ++i) {
+        now += in;
+        (void)cache.flush_if_idle(image, now);
+        REQUIRE(cache.next_write_back(in, now));
+    }
+    CHECK(in == fujinet::disk::SectorCache::MAX_WRITE_BACK_RETRY);
+    CHECK(cache.dirty_count() == 1);
+}
+
+TEST_CASE("DiskService: unmount reports a failed write-back and keeps the image")
+{
+    fujinet::fs::StorageManager sm;
+    auto memfs = std::make_unique<fujinet::tests::MemoryFileSystem>("mem");
+    const std::string path = "/disks/remote.img";
+    memfs->file_bytes(path).resize(16 * 256);
+    REQUIRE(sm.registerFileSystem(std::move(memfs)));
+
+    UnreachableImage* image = nullptr;
+    fujinet::disk::ImageRegistry registry;
+    registry.register_type(fujinet::disk::ImageType::Raw, [&image] {
+        auto img = std::make_unique<UnreachableImage>();
+        image = img.get();
+        return img;
+    });
+    fujinet::disk::DiskService svc(sm, std::move(registry));
+    fujinet::disk::SectorCacheConfig cfg{};
+    cfg.capacitySectors = 8;
+    svc.set_cache_config(cfg);
+
+    fujinet::disk::MountOptions opts{};
+    opts.typeOverride = fujinet::disk::ImageType::Raw;
+    REQUIRE(svc.mount(0, "mem", path, opts).ok());
+    REQUIRE(image);
+    const auto writes = image->writes;
+
+    // Acknowledged to the host, but only in the cache.
+    std::vector<std::uint8_t> sec(256, 0x5A);
+    REQUIRE(svc.write_sector(0, 3, sec.data(), sec.size()).ok());
+
+    CHECK(svc.unmount(0).error == fujinet::disk::DiskError::IoError);
+    CHECK(svc.info(0).inserted);
+    CHECK(svc.mount(0, "mem", path, opts).error == fujinet::disk::DiskError::IoError);
+    CHECK(svc.info(0).inserted);
+
+    // Once the image is back, the same sector is written and unmount succeeds.
+    image->reachable = true;
+    CHECK(svc.unmount(0).ok());
+    CHECK_FALSE(svc.info(0).inserted);
+    CHECK(*writes == 3);
+}
+
+TEST_CASE("DiskService: multi-sector requests reach the image as single transfers")
+{
+    fujinet::fs::StorageManager sm;
+    auto memfs = std::make_unique<fujinet::tests::MemoryFileSystem>("mem");
+
+    const std::string path = "/disks/multi.img";
+    auto& bytes = memfs->file_bytes(path);
+    bytes.resize(64 * 256);
+    for (std::size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<std::uint8_t>(i / 256);
+
+    REQUIRE(sm.registerFileSystem(std::move(memfs)));
+
+    fujinet::disk::DiskService svc(sm, fujinet::disk::make_default_image_registry());
+
+    fujinet::disk::SectorCacheConfig cfg{};
+    cfg.capacitySectors = 32;
+    cfg.readAheadSectors = 4;
+    svc.set_cache_config(cfg);
+
+    fujinet::disk::MountOptions opts{};
+    opts.typeOverride = fujinet::disk::ImageType::Raw;
+    opts.sectorSizeHint = 256;
+    REQUIRE(svc.mount(0, "mem", path, opts).ok());
+
+    // Ten sectors plus three of read-ahead in one image read.
+    std::vector<std::uint8_t> buf(10 * 256);
+    auto r = svc.read_sectors(0, 2, 10, buf.data(), buf.size());
+    REQUIRE(r.ok());
+    CHECK(r.bytes == buf.size());
+    for (std::uint32_t i = 0; i < 10; ++i) CHECK(buf[i * 256] == 2 + i);
+    auto stats = svc.stats(0);
+    CHECK(stats.image.readOps == 1);
+    CHECK(stats.image.seekOps == 1);
+    CHECK(stats.cache.misses == 10);
+    CHECK(stats.cache.readAheadSectors == 3);
+
+    // A request straddling cached sectors only fetches the gaps, one run each.
+    std::vector<std::uint8_t> one(256);
+    REQUIRE(svc.read_sector(0, 20, one.data(), one.size()).ok());
+    CHECK(svc.read_sectors(0, 10, 12, buf.data(), buf.size()).error == fujinet::disk::DiskError::InvalidRequest);
+    buf.resize(12 * 256);
+    REQUIRE(svc.read_sectors(0, 10, 12, buf.data(), buf.size()).ok());
+    for (std::uint32_t i = 0; i < 12; ++i) CHECK(buf[i * 256] == 10 + i);
+    stats = svc.stats(0);
+    // 10..14 and 20 were cached: 15..19 is one read, 21 plus read-ahead another.
+    CHECK(stats.image.readOps == 4);
+
+    // Writes are cached, then written back as one run.
+    std::fill(buf.begin(), buf.end(), 0x77);
+    REQUIRE(svc.write_sectors(0, 40, 8, buf.data(), 8 * 256).ok());
+    CHECK(svc.stats(0).image.writeOps == 0);
+    REQUIRE(svc.flush(0).ok());
+    CHECK(svc.stats(0).image.writeOps == 1);
+    CHECK(bytes[40 * 256] == 0x77);
+    CHECK(bytes[48 * 256 - 1] == 0x77);
+    CHECK(bytes[48 * 256] == 48);
+    REQUIRE(svc.unmount(0).ok());
+}
+
+TEST_CASE("DiskService: prefetch streams the image and journals writes")
+{
+    fujinet::fs::StorageManager sm;
+    auto memfs = std::make_unique<fujinet::tests::MemoryFileSystem>("mem");
+
+    // 40 KiB: ten prefetch blocks, three poll() chunks.
+    const std::string path = "/disks/boot.img";
+    auto& bytes = memfs->file_bytes(path);
+    bytes.resize(160 * 256);
+    for (std::size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<std::uint8_t>(i / 256);
+
+    REQUIRE(sm.registerFileSystem(std::move(memfs)));
+
+    fujinet::disk::DiskService svc(sm, fujinet::disk::make_default_image_registry());
+    svc.set_prefetch_limit(1024 * 1024);
+
+    fujinet::disk::MountOptions opts{};
+    opts.typeOverride = fujinet::disk::ImageType::Raw;
+    opts.sectorSizeHint = 256;
+    opts.prefetch = fujinet::disk::PrefetchMode::Stream;
+    REQUIRE(svc.mount(0, "mem", path, opts).ok());
+
+    auto info = svc.info(0);
+    CHECK(info.prefetch == fujinet::disk::PrefetchMode::Stream);
+    CHECK(info.prefetchTotalBytes == bytes.size());
+    CHECK(svc.prefetch_pending());
+
+    // A sector far ahead of the stream is fetched on demand.
+    std::vector<std::uint8_t> sec(256);
+    REQUIRE(svc.read_sector(0, 150, sec.data(), sec.size()).ok());
+    CHECK(sec[0] == 150);
+    CHECK(svc.info(0).prefetchLandedBytes == 4096);
+
+    int polls = 0;
+    while (svc.prefetch_pending() && polls < 10) {
+        svc.poll();
+        ++polls;
+    }
+    CHECK(polls == 3);
+    CHECK(svc.info(0).prefetchLandedBytes == bytes.size());
+
+    // Writes stay in RAM until flush, then only the written range is synced.
+    std::vector<std::uint8_t> out(256, 0xC3);
+    REQUIRE(svc.write_sector(0, 20, out.data(), out.size()).ok());
+    REQUIRE(svc.read_sector(0, 20, sec.data(), sec.size()).ok());
+    CHECK(sec[0] == 0xC3);
+    CHECK(bytes[20 * 256] == 20);
+
+    REQUIRE(svc.flush(0).ok());
+    CHECK(bytes[20 * 256] == 0xC3);
+    CHECK(bytes[20 * 256 + 255] == 0xC3);
+    CHECK(bytes[21 * 256] == 21);
+    REQUIRE(svc.unmount(0).ok());
+
+    // Snapshot: writable even though nothing reaches the source.
+    opts.prefetch = fujinet::disk::PrefetchMode::Snapshot;
+    REQUIRE(svc.mount(0, "mem", path, opts).ok());
+    CHECK(!svc.info(0).readOnly);
+    out.assign(256, 0x5A);
+    REQUIRE(svc.write_sector(0, 30, out.data(), out.size()).ok());
+    REQUIRE(svc.flush(0).ok());
+    REQUIRE(svc.read_sector(0, 30, sec.data(), sec.size()).ok());
+    CHECK(sec[0] == 0x5A);
+    REQUIRE(svc.unmount(0).ok());
+    CHECK(bytes[30 * 256] == 30);
+
+    // Images over the limit mount without prefetch.
+    svc.set_prefetch_limit(16 * 1024);
+    REQUIRE(svc.mount(0, "mem", path, opts).ok());
+    CHECK(svc.info(0).prefetch == fujinet::disk::PrefetchMode::Off);
+    CHECK(!svc.prefetch_pending());
+}
+
 TEST_CASE("DiskService: central probes detect FAT raw geometry without sector hint")
 {
     fujinet::fs::StorageManager sm;
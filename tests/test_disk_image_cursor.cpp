@@ -122,6 +122,26 @@ std::vector<std::uint8_t> make_atr_128_bytes(std::uint32_t sectors)
     return bytes;
 }
 
+std::vector<std::uint8_t> make_atr_256_bytes(std::uint32_t sectors)
+{
+    // Double density: sectors 1..3 are stored as 128 bytes.
+    constexpr std::size_t headerBytes = 16;
+    const std::uint32_t dataBytes = 3 * 128 + (sectors - 3) * 256;
+    const std::uint32_t paragraphs = dataBytes / 16;
+
+    std::vector<std::uint8_t> bytes(headerBytes + dataBytes);
+    bytes[0] = 0x96;
+    bytes[1] = 0x02;
+    bytes[2] = static_cast<std::uint8_t>(paragraphs & 0xff);
+    bytes[3] = static_cast<std::uint8_t>((paragraphs >> 8) & 0xff);
+    bytes[4] = 0x00;
+    bytes[5] = 0x01;
+    for (std::size_t i = headerBytes; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<std::uint8_t>(i & 0xff);
+    }
+    return bytes;
+}
+
 } // namespace
 
 TEST_CASE("Raw image skips seeks for sequential sector reads")
@@ -237,3 +257,60 @@ TEST_CASE("ATR image skips seeks for sequential sector reads")
     CHECK(stats.seeks == mountSeeks + 2);
     CHECK(image->image_stats().seekOps == 2);
 }
+
+TEST_CASE("Raw image reads and writes a sector run with one seek")
+{
+    FileStats stats;
+    auto file = std::make_unique<TrackingFile>(make_raw_bytes(256, 8), stats, false);
+    auto image = fujinet::disk::make_raw_disk_image();
+
+    fujinet::disk::MountOptions opts{};
+    opts.sectorSizeHint = 256;
+    REQUIRE(image->mount(std::move(file), 8 * 256, opts).ok());
+
+    std::vector<std::uint8_t> buf(4 * 256);
+    auto r = image->read_sectors(2, 4, buf.data(), buf.size());
+    REQUIRE(r.ok());
+    CHECK(r.bytes == 4 * 256);
+    CHECK(buf[0] == 0x00);   // offset 512
+    CHECK(buf[255] == 0xff);
+    CHECK(stats.seeks == 1);
+    CHECK(image->image_stats().readOps == 1);
+
+    // Continues where the run ended without another seek.
+    std::fill(buf.begin(), buf.end(), 0xAB);
+    REQUIRE(image->write_sectors(6, 2, buf.data(), 2 * 256).ok());
+    CHECK(stats.seeks == 1);
+    CHECK(image->image_stats().sequentialWriteHits == 1);
+
+    REQUIRE(image->read_sectors(7, 1, buf.data(), 256).ok());
+    CHECK(buf[0] == 0xAB);
+
+    CHECK(image->read_sectors(6, 3, buf.data(), buf.size()).error == fujinet::disk::DiskError::OutOfRange);
+    CHECK(image->read_sectors(0, 4, buf.data(), 3 * 256).error == fujinet::disk::DiskError::InvalidRequest);
+}
+
+TEST_CASE("ATR image packs short boot sectors in a sector run")
+{
+    FileStats stats;
+    const auto bytes = make_atr_256_bytes(6);
+    auto file = std::make_unique<TrackingFile>(bytes, stats, true);
+    auto image = fujinet::disk::make_atr_disk_image();
+
+    REQUIRE(image->mount(std::move(file), bytes.size(), fujinet::disk::MountOptions{}).ok());
+    REQUIRE(image->geometry().sectorCount == 6);
+    const int mountSeeks = stats.seeks;
+
+    // Sectors 2..5: two 128-byte boot sectors, then two full ones.
+    std::vector<std::uint8_t> buf(4 * 256);
+    auto r = image->read_sectors(1, 4, buf.data(), buf.size());
+    REQUIRE(r.ok());
+    CHECK(r.bytes == 2 * 128 + 2 * 256);
+    CHECK(stats.seeks == mountSeeks + 1);
+    CHECK(std::equal(buf.begin(), buf.begin() + r.bytes, bytes.begin() + 16 + 128));
+
+    // Same bytes as reading the sectors one by one.
+    std::vector<std::uint8_t> sector(256);
+    REQUIRE(image->read_sector(3, sector.data(), sector.size()).ok());
+    CHECK(std::equal(sector.begin(), sector.end(), buf.begin() + 2 * 128));
+}
@@ -28,11 +28,15 @@ using fujinet::io::AppStore;
 using fujinet::io::FileDevice;
 using fujinet::io::HostService;
 using fujinet::io::IORequest;
+using fujinet::io::IOResponse;
 using fujinet::io::StatusCode;
 using fujinet::io::protocol::FileCommand;
 using fujinet::io::protocol::HostCommand;
 using fujinet::io::protocol::list_directory::kListFlagCompactOmitMetadata;
 using fujinet::io::protocol::list_directory::kListFlagFormattedLines;
+using fujinet::io::protocol::list_directory::kListFlagFilterDirectories;
+using fujinet::io::protocol::list_directory::kListFlagNameFilter;
+using fujinet::io::protocol::list_directory::kListFlagNameSearch;
 using fujinet::io::protocol::list_directory::kListFlagSortByName;
 
 constexpr std::uint8_t kVersion = 1;
@@ -154,6 +158,23 @@ std::string_view first_list_entry_name(const std::vector<std::uint8_t>& payload)
         name_len};
 }
 
+// Basenames of a compact ListDirectory response.
+std::vector<std::string> compact_list_names(const std::vector<std::uint8_t>& payload)
+{
+    std::vector<std::string> names;
+    REQUIRE(payload.size() >= kListDirHeaderBytes);
+    std::size_t off = kListDirHeaderBytes;
+    const std::uint16_t count = static_cast<std::uint16_t>(payload[6] | (payload[7] << 8));
+    for (std::uint16_t i = 0; i < count; ++i) {
+        REQUIRE(payload.size() >= off + 2);
+        const std::uint8_t len = payload[off + 1];
+        REQUIRE(payload.size() >= off + 2 + len);
+        names.emplace_back(reinterpret_cast<const char*>(payload.data() + off + 2), len);
+        off += 2U + len;
+    }
+    return names;
+}
+
 std::vector<std::uint8_t> make_app_store_prefix(std::string_view ns, std::string_view key)
 {
     std::vector<std::uint8_t> payload;
@@ -481,6 +502,73 @@ TEST_CASE("FileDevice ListDirectory sort-by-name request reorders by basename")
     CHECK(first_list_entry_name(r1.payload) == "alpha.txt");
 }
 
+TEST_CASE("FileDevice ListDirectory filters by glob and search before paging")
+{
+    constexpr const char* kDir = "tnfs://server/ld-filter";
+    StorageManager storage;
+    auto fs = std::make_unique<MemoryFs>("tnfs");
+    fs->set_directory(kDir, {
+        FileInfo{std::string(kDir) + "/Games", true, 0, {}},
+        FileInfo{std::string(kDir) + "/zork.ATR", false, 1, {}},
+        FileInfo{std::string(kDir) + "/readme.txt", false, 1, {}},
+        FileInfo{std::string(kDir) + "/basic.xex", false, 1, {}},
+        FileInfo{std::string(kDir) + "/Ms Pacman.atr", false, 1, {}},
+        FileInfo{std::string(kDir) + "/pac.cas", false, 1, {}},
+    });
+    CHECK(storage.registerFileSystem(std::move(fs)));
+
+    FileDevice device(storage);
+    IORequest request{};
+    request.command = static_cast<std::uint16_t>(FileCommand::ListDirectory);
+
+    auto list = [&](std::uint16_t start, std::uint16_t maxBytes, std::uint8_t flags,
+                    std::string_view pattern, std::string_view search) {
+        request.payload = make_list_request_with_flags(
+            kDir, start, maxBytes,
+            static_cast<std::uint8_t>(flags | kListFlagCompactOmitMetadata | kListFlagSortByName));
+        if (flags & kListFlagNameFilter) {
+            request.payload.push_back(static_cast<std::uint8_t>(pattern.size()));
+            request.payload.insert(request.payload.end(), pattern.begin(), pattern.end());
+        }
+        if (flags & kListFlagNameSearch) {
+            request.payload.push_back(static_cast<std::uint8_t>(search.size()));
+            request.payload.insert(request.payload.end(), search.begin(), search.end());
+        }
+        auto resp = device.handle(request);
+        REQUIRE(resp.status == StatusCode::Ok);
+        return resp;
+    };
+
+    // Case-insensitive glob alternatives; directories stay listed.
+    auto r = list(0, kListMaxPayloadBytes, kListFlagNameFilter, "*.atr|*.XEX", "");
+    CHECK(compact_list_names(r.payload) ==
+          std::vector<std::string>{"Games", "Ms Pacman.atr", "basic.xex", "zork.ATR"});
+    CHECK((r.payload[1] & 0x01U) == 0);
+
+    // Paging counts matches only.
+    r = list(1, 16, kListFlagNameFilter, "*.atr|*.XEX", "");
+    CHECK(compact_list_names(r.payload) == std::vector<std::string>{"Ms Pacman.atr"});
+    CHECK((r.payload[1] & 0x01U) == 0x01U);
+    r = list(3, 16, kListFlagNameFilter, "*.atr|*.XEX", "");
+    CHECK(compact_list_names(r.payload) == std::vector<std::string>{"zork.ATR"});
+    CHECK((r.payload[1] & 0x01U) == 0);
+
+    // Substring search, applied to directories too when asked.
+    r = list(0, kListMaxPayloadBytes, kListFlagNameSearch | kListFlagFilterDirectories, "", "PAC");
+    CHECK(compact_list_names(r.payload) == std::vector<std::string>{"Ms Pacman.atr", "pac.cas"});
+
+    // Filter and search combine.
+    r = list(0, kListMaxPayloadBytes,
+             kListFlagNameFilter | kListFlagNameSearch | kListFlagFilterDirectories, "*.atr", "pac");
+    CHECK(compact_list_names(r.payload) == std::vector<std::string>{"Ms Pacman.atr"});
+
+    // A truncated filter field is rejected.
+    request.payload = make_list_request_with_flags(kDir, 0, kListMaxPayloadBytes, kListFlagNameFilter);
+    request.payload.push_back(5);
+    request.payload.push_back('*');
+    CHECK(device.handle(request).status == StatusCode::InvalidRequest);
+}
+
 TEST_CASE("FileDevice ListDirectory formatted request returns ls-style text lines")
 {
     constexpr const char* kDir = "tnfs://server/ld-formatted";
@@ -630,9 +718,61 @@ TEST_CASE("FileDevice ListDirectory caches listing and skips repeated filesystem
     CHECK(device.handle(req).status == StatusCode::Ok);
     CHECK(spy->list_directory_calls() == 2);
 
+    // Both directories stay cached; flipping back does not relist.
     req.payload = make_list_request(kDirA, 0, kListMaxPayloadBytes);
     CHECK(device.handle(req).status == StatusCode::Ok);
-    CHECK(spy->list_directory_calls() == 3);
+    CHECK(spy->list_directory_calls() == 2);
+
+    // Sorted pages come from the same snapshot.
+    req.payload = make_list_request_with_flags(kDirA, 0, kListMaxPayloadBytes, kListFlagSortByName);
+    CHECK(device.handle(req).status == StatusCode::Ok);
+    CHECK(spy->list_directory_calls() == 2);
+}
+
+TEST_CASE("FileDevice ListDirectory relists after MakeDirectory or WriteFile in that directory")
+{
+    constexpr const char* kDirA = "tnfs://server/ld-inv-a";
+    constexpr const char* kDirB = "tnfs://server/ld-inv-b";
+
+    StorageManager storage;
+    auto fs = std::make_unique<CountingMemoryFs>("tnfs");
+    CountingMemoryFs* const spy = fs.get();
+    spy->set_directory(kDirA, {
+        FileInfo{std::string(kDirA) + "/one.txt", false, 1, {}},
+    });
+    spy->set_directory(kDirB, {
+        FileInfo{std::string(kDirB) + "/two.txt", false, 1, {}},
+    });
+    CHECK(storage.registerFileSystem(std::move(fs)));
+
+    FileDevice device(storage);
+    IORequest list{};
+    list.command = static_cast<std::uint16_t>(FileCommand::ListDirectory);
+    auto list_calls_after = [&](const char* dir) {
+        list.payload = make_list_request(dir, 0, kListMaxPayloadBytes);
+        CHECK(device.handle(list).status == StatusCode::Ok);
+        return spy->list_directory_calls();
+    };
+
+    CHECK(list_calls_after(kDirA) == 1);
+    CHECK(list_calls_after(kDirB) == 2);
+
+    IORequest mkdir{};
+    mkdir.command = static_cast<std::uint16_t>(FileCommand::MakeDirectory);
+    mkdir.payload = make_mkdir_request(std::string(kDirA) + "/sub", false, true);
+    CHECK(device.handle(mkdir).status == StatusCode::Ok);
+
+    // Only the touched directory is relisted.
+    CHECK(list_calls_after(kDirA) == 3);
+    CHECK(list_calls_after(kDirB) == 3);
+
+    IORequest write{};
+    write.command = static_cast<std::uint16_t>(FileCommand::WriteFile);
+    write.payload = make_write_request(std::string(kDirB) + "/new.txt", 0, "x");
+    CHECK(device.handle(write).status == StatusCode::Ok);
+
+    CHECK(list_calls_after(kDirA) == 3);
+    CHECK(list_calls_after(kDirB) == 4);
 }
 
 TEST_CASE("HostService manipulates current host and LRU history")
@@ -742,6 +882,165 @@ TEST_CASE("FileDevice ListDirectory rejects relative specs without current host"
     CHECK(response.status == StatusCode::DeviceNotFound);
 }
 
+/** Wraps a filesystem and counts IFileSystem::open invocations. */
+class OpenCountingFs final : public IFileSystem {
+public:
+    explicit OpenCountingFs(std::string name) : _inner(std::move(name)) {}
+
+    unsigned open_calls() const { return _open_calls; }
+    fujinet::tests::MemoryFileSystem& inner() { return _inner; }
+
+    FileSystemKind kind() const override { return _inner.kind(); }
+    std::string name() const override { return _inner.name(); }
+    bool exists(const std::string& path) override { return _inner.exists(path); }
+    bool isDirectory(const std::string& path) override { return _inner.isDirectory(path); }
+    bool createDirectory(const std::string& path) override { return _inner.createDirectory(path); }
+    bool removeFile(const std::string& path) override { return _inner.removeFile(path); }
+    bool removeDirectory(const std::string& path) override { return _inner.removeDirectory(path); }
+    bool rename(const std::string& from, const std::string& to) override { return _inner.rename(from, to); }
+    std::unique_ptr<IFile> open(const std::string& path, const char* mode) override
+    {
+        ++_open_calls;
+        return _inner.open(path, mode);
+    }
+    bool stat(const std::string& path, FileInfo& outInfo) override { return _inner.stat(path, outInfo); }
+    bool listDirectory(const std::string& path, std::vector<FileInfo>& outEntries) override
+    {
+        return _inner.listDirectory(path, outEntries);
+    }
+
+private:
+    fujinet::tests::MemoryFileSystem _inner;
+    unsigned _open_calls{0};
+};
+
+TEST_CASE("FileDevice chunked ReadFile and WriteFile open the file once per transfer")
+{
+    StorageManager storage;
+    auto owned = std::make_unique<OpenCountingFs>("host");
+    auto* fs = owned.get();
+    REQUIRE(storage.registerFileSystem(std::move(owned)));
+
+    std::string content;
+    for (int i = 0; i < 1000; ++i) content.push_back(static_cast<char>('a' + (i % 26)));
+
+    FileDevice device(storage);
+
+    IORequest write{};
+    write.command = static_cast<std::uint16_t>(FileCommand::WriteFile);
+    for (std::size_t off = 0; off < content.size(); off += 128) {
+        const std::string_view chunk = std::string_view(content).substr(off, 128);
+        write.payload = make_write_request("host:/big.bin", static_cast<std::uint32_t>(off), chunk);
+        const auto r = device.handle(write);
+        REQUIRE(r.status == StatusCode::Ok);
+        CHECK(read_u16le(r.payload, 8) == chunk.size());
+    }
+    CHECK(fs->open_calls() == 1);
+
+    IORequest read{};
+    read.command = static_cast<std::uint16_t>(FileCommand::ReadFile);
+    std::string got;
+    for (std::uint32_t off = 0;;) {
+        read.payload = make_read_request("host:/big.bin", off, 100);
+        const auto r = device.handle(read);
+        REQUIRE(r.status == StatusCode::Ok);
+        const auto n = read_u16le(r.payload, 8);
+        got.append(r.payload.begin() + 10, r.payload.end());
+        off += n;
+        if (n < 100) break;
+    }
+    CHECK(got == content);
+    CHECK(fs->open_calls() == 2);
+
+    // Rewriting the file invalidates the cached reader.
+    read.payload = make_read_request("host:/big.bin", 0, 4);
+    REQUIRE(device.handle(read).status == StatusCode::Ok);
+    write.payload = make_write_request("host:/big.bin", 0, "ZZZZ");
+    REQUIRE(device.handle(write).status == StatusCode::Ok);
+    read.payload = make_read_request("host:/big.bin", 0, 4);
+    const auto reread = device.handle(read);
+    REQUIRE(reread.status == StatusCode::Ok);
+    CHECK(std::string(reread.payload.begin() + 10, reread.payload.end()) == "ZZZZ");
+}
+
+/** A non-blocking filesystem whose stat() needs `pending` more calls to finish. */
+class SlowStatFs final : public IFileSystem {
+public:
+    explicit SlowStatFs(std::string name) : _inner(std::move(name)) {}
+
+    int pending{0};
+    fujinet::tests::MemoryFileSystem& inner() { return _inner; }
+
+    FileSystemKind kind() const override { return _inner.kind(); }
+    std::string name() const override { return _inner.name(); }
+    bool exists(const std::string& path) override { return _inner.exists(path); }
+    bool isDirectory(const std::string& path) override { return _inner.isDirectory(path); }
+    bool createDirectory(const std::string& path) override { return _inner.createDirectory(path); }
+    bool removeFile(const std::string& path) override { return _inner.removeFile(path); }
+    bool removeDirectory(const std::string& path) override { return _inner.removeDirectory(path); }
+    bool rename(const std::string& from, const std::string& to) override { return _inner.rename(from, to); }
+    std::unique_ptr<IFile> open(const std::string& path, const char* mode) override
+    {
+        return _inner.open(path, mode);
+    }
+    bool stat(const std::string& path, FileInfo& outInfo) override
+    {
+        _blocked = pending > 0;
+        if (_blocked) {
+            --pending;
+            return false;
+        }
+        return _inner.stat(path, outInfo);
+    }
+    bool listDirectory(const std::string& path, std::vector<FileInfo>& outEntries) override
+    {
+        return _inner.listDirectory(path, outEntries);
+    }
+    bool wouldBlock() const override { return _blocked; }
+
+private:
+    fujinet::tests::MemoryFileSystem _inner;
+    bool _blocked{false};
+};
+
+TEST_CASE("FileDevice parks deferrable requests a non-blocking filesystem can't answer yet")
+{
+    StorageManager storage;
+    auto owned = std::make_unique<SlowStatFs>("host");
+    auto* fs = owned.get();
+    REQUIRE(storage.registerFileSystem(std::move(owned)));
+    {
+        auto f = fs->inner().open("/a.txt", "wb");
+        REQUIRE(f);
+        REQUIRE(f->write("abc", 3) == 3);
+    }
+
+    FileDevice device(storage);
+    IORequest stat{};
+    stat.id = 7;
+    stat.command = static_cast<std::uint16_t>(FileCommand::Stat);
+    stat.payload = make_uri_request("host:/a.txt");
+
+    // Not deferrable: the host is told to retry.
+    fs->pending = 1;
+    CHECK(device.handle(stat).status == StatusCode::NotReady);
+
+    fs->pending = 2;
+    stat.deferrable = true;
+    CHECK(device.handle(stat).status == StatusCode::Pending);
+
+    IOResponse done{};
+    device.poll();
+    CHECK_FALSE(device.take_completed(done));
+    device.poll();
+    REQUIRE(device.take_completed(done));
+    CHECK(done.id == 7);
+    CHECK(done.status == StatusCode::Ok);
+    REQUIRE(done.payload.size() >= 12);
+    CHECK(done.payload[1] == 0x02); // exists
+    CHECK(read_u64le(done.payload, 4) == 3);
+}
+
 TEST_CASE("FileDevice resolves persist URI through default persistent filesystem")
 {
     StorageManager storage;
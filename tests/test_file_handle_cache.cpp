@@ -0,0 +1,113 @@
+#include "doctest.h"
+
+#include "fujinet/fs/file_handle_cache.h"
+#include "fujinet/fs/storage_manager.h"
+#include "fake_fs.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+using fujinet::fs::FileHandleCache;
+using fujinet::fs::IFile;
+using fujinet::tests::MemoryFileSystem;
+
+namespace {
+
+void put_file(MemoryFileSystem& fs, const std::string& path, const std::string& data)
+{
+    auto f = fs.open(path, "wb");
+    REQUIRE(f);
+    f->write(data.data(), data.size());
+}
+
+} // namespace
+
+TEST_CASE("FileHandleCache: reuses a handle at its current offset")
+{
+    MemoryFileSystem fs("host");
+    put_file(fs, "/a.bin", "0123456789");
+
+    FileHandleCache cache;
+    CHECK(cache.acquire(fs, "/a.bin", FileHandleCache::Mode::Read, 0) == nullptr);
+
+    IFile* h = cache.insert(fs, "/a.bin", FileHandleCache::Mode::Read, fs.open("/a.bin", "rb"));
+    REQUIRE(h != nullptr);
+    char buf[4]{};
+    CHECK(h->read(buf, 4) == 4);
+
+    CHECK(cache.acquire(fs, "/a.bin", FileHandleCache::Mode::Read, 4) == h);
+    CHECK(cache.acquire(fs, "/a.bin", FileHandleCache::Mode::Write, 4) == nullptr);
+
+    // A different offset is served by seeking the same handle.
+    CHECK(cache.acquire(fs, "/a.bin", FileHandleCache::Mode::Read, 8) == h);
+    CHECK(h->tell() == 8);
+
+    CHECK(cache.stats().hits == 2);
+    CHECK(cache.stats().misses == 2);
+}
+
+TEST_CASE("FileHandleCache: evicts least recently used and expires idle handles")
+{
+    MemoryFileSystem fs("host");
+    put_file(fs, "/1", "x");
+    put_file(fs, "/2", "x");
+    put_file(fs, "/3", "x");
+
+    FileHandleCache cache(FileHandleCache::Config{2, std::chrono::milliseconds(1000)});
+    cache.insert(fs, "/1", FileHandleCache::Mode::Read, fs.open("/1", "rb"));
+    cache.insert(fs, "/2", FileHandleCache::Mode::Read, fs.open("/2", "rb"));
+    REQUIRE(cache.acquire(fs, "/1", FileHandleCache::Mode::Read, 0) != nullptr); // /1 now most recent
+    cache.insert(fs, "/3", FileHandleCache::Mode::Read, fs.open("/3", "rb"));
+
+    CHECK(cache.size() == 2);
+    CHECK(cache.acquire(fs, "/2", FileHandleCache::Mode::Read, 0) == nullptr);
+    CHECK(cache.acquire(fs, "/1", FileHandleCache::Mode::Read, 0) != nullptr);
+
+    cache.expire(std::chrono::steady_clock::now() + std::chrono::seconds(2));
+    CHECK(cache.size() == 0);
+}
+
+TEST_CASE("FileHandleCache: invalidation by path, subtree and filesystem")
+{
+    MemoryFileSystem fs("host");
+    MemoryFileSystem other("sd0");
+    REQUIRE(fs.createDirectory("/dir"));
+    put_file(fs, "/dir/a", "a");
+    put_file(fs, "/dir/b", "b");
+    put_file(fs, "/dirx", "c");
+    REQUIRE(other.createDirectory("/dir"));
+    put_file(other, "/dir/a", "a");
+
+    FileHandleCache cache(FileHandleCache::Config{8, std::chrono::milliseconds(1000)});
+    cache.insert(fs, "/dir/a", FileHandleCache::Mode::Read, fs.open("/dir/a", "rb"));
+    cache.insert(fs, "/dir/a", FileHandleCache::Mode::Write, fs.open("/dir/a", "r+b"));
+    cache.insert(fs, "/dir/b", FileHandleCache::Mode::Read, fs.open("/dir/b", "rb"));
+    cache.insert(fs, "/dirx", FileHandleCache::Mode::Read, fs.open("/dirx", "rb"));
+    cache.insert(other, "/dir/a", FileHandleCache::Mode::Read, other.open("/dir/a", "rb"));
+
+    cache.invalidate(fs, "/dir/a", FileHandleCache::Mode::Read);
+    CHECK(cache.size() == 4);
+
+    cache.invalidate(fs, "/dir/");
+    CHECK(cache.size() == 2); // "/dirx" and the other filesystem survive
+    CHECK(cache.acquire(fs, "/dirx", FileHandleCache::Mode::Read, 0) != nullptr);
+
+    cache.invalidate(other);
+    CHECK(cache.size() == 1);
+}
+
+TEST_CASE("StorageManager: unregistering a filesystem closes its cached handles")
+{
+    fujinet::fs::StorageManager storage;
+    auto owned = std::make_unique<MemoryFileSystem>("host");
+    auto* fs = owned.get();
+    put_file(*fs, "/f", "data");
+    REQUIRE(storage.registerFileSystem(std::move(owned)));
+
+    storage.fileHandles().insert(*fs, "/f", FileHandleCache::Mode::Read, fs->open("/f", "rb"));
+    CHECK(storage.fileHandles().size() == 1);
+
+    CHECK(storage.unregisterFileSystem("host"));
+    CHECK(storage.fileHandles().size() == 0);
+}
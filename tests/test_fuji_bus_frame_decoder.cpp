@@ -0,0 +1,155 @@
+#include "doctest.h"
+
+#include "fujinet/io/protocol/fuji_bus_frame_decoder.h"
+#include "fujinet/io/protocol/fuji_bus_packet.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace fujinet::io::protocol;
+
+namespace {
+
+ByteBuffer make_payload(std::size_t n)
+{
+    ByteBuffer out(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        // Sprinkle SLIP specials through the payload so escapes get exercised.
+        out[i] = static_cast<std::uint8_t>((i % 7 == 0) ? 0xC0 : (i % 11 == 0) ? 0xDB : i);
+    }
+    return out;
+}
+
+FujiBusPacket make_packet(std::uint8_t cmd, ByteBuffer payload)
+{
+    return FujiBusPacket(static_cast<WireDeviceId>(0x70), cmd,
+                         std::uint8_t{1}, std::uint8_t{2}, std::uint8_t{3},
+                         std::uint8_t{4}, std::uint8_t{5},
+                         std::uint16_t{0xBEEF},
+                         std::move(payload));
+}
+
+} // namespace
+
+TEST_CASE("FujiBusFrameDecoder: byte-at-a-time feed decodes params and payload")
+{
+    const ByteBuffer payload = make_payload(300);
+    const ByteBuffer wire = make_packet(0x21, payload).serialize();
+
+    FujiBusFrameDecoder dec;
+    for (std::uint8_t b : wire) {
+        CHECK_FALSE(dec.hasFrame());
+        dec.feed(&b, 1);
+    }
+
+    FujiBusFrame frame;
+    REQUIRE(dec.next(frame));
+    CHECK(frame.device == static_cast<WireDeviceId>(0x70));
+    CHECK(frame.command == 0x21);
+    REQUIRE(frame.params.size() == 6);
+    CHECK(frame.params[0].value == 1);
+    CHECK(frame.params[4].value == 5);
+    CHECK(frame.params[5].value == 0xBEEF);
+    CHECK(frame.params[5].size == 2);
+    CHECK(frame.payload == payload);
+    CHECK_FALSE(dec.next(frame));
+    CHECK(dec.droppedFrames() == 0);
+}
+
+TEST_CASE("FujiBusFrameDecoder: back-to-back frames in one feed, bad one dropped")
+{
+    const ByteBuffer a = make_packet(1, make_payload(10)).serialize();
+    ByteBuffer bad = make_packet(2, make_payload(20)).serialize();
+    bad[bad.size() - 2] ^= 0x01; // corrupt last payload byte -> checksum mismatch
+    const ByteBuffer c = make_packet(3, {}).serialize();
+
+    ByteBuffer wire{0x00, 0x55}; // line noise before the first END
+    wire.insert(wire.end(), a.begin(), a.end());
+    wire.insert(wire.end(), bad.begin(), bad.end());
+    wire.insert(wire.end(), c.begin(), c.end());
+
+    FujiBusFrameDecoder dec;
+    dec.feed(wire.data(), wire.size());
+
+    FujiBusFrame frame;
+    REQUIRE(dec.next(frame));
+    CHECK(frame.command == 1);
+    CHECK(frame.payload == make_payload(10));
+
+    REQUIRE(dec.next(frame));
+    CHECK(frame.command == 3);
+    CHECK(frame.payload.empty());
+
+    CHECK_FALSE(dec.next(frame));
+    CHECK(dec.droppedFrames() == 1);
+    CHECK(dec.lastError() == FujiBusFrameDecoder::Error::BadChecksum);
+}
+
+TEST_CASE("FujiBusFrameDecoder: oversized frame is discarded up to the next END")
+{
+    FujiBusFrameDecoder dec(64);
+
+    const ByteBuffer big = make_packet(1, make_payload(200)).serialize();
+    const ByteBuffer ok = make_packet(2, make_payload(8)).serialize();
+
+    dec.feed(big.data(), big.size());
+    dec.feed(ok.data(), ok.size());
+
+    FujiBusFrame frame;
+    REQUIRE(dec.next(frame));
+    CHECK(frame.command == 2);
+    CHECK(dec.droppedFrames() == 1);
+    CHECK(dec.lastError() == FujiBusFrameDecoder::Error::Oversized);
+}
+
+TEST_CASE("FujiBusFrameDecoder: payload buffers are recycled across frames")
+{
+    const ByteBuffer wire = make_packet(9, make_payload(1024)).serialize();
+
+    FujiBusFrameDecoder dec;
+    FujiBusFrame frame;
+    std::vector<const std::uint8_t*> seen;
+
+    for (int i = 0; i < 12; ++i) {
+        dec.feed(wire.data(), wire.size());
+        REQUIRE(dec.next(frame));
+        REQUIRE(frame.payload.size() == 1024);
+        seen.push_back(frame.payload.data());
+    }
+
+    // Once warmed up, the same few buffers rotate through; nothing new is allocated.
+    for (std::size_t i = 6; i < seen.size(); ++i) {
+        CHECK(seen[i] == seen[i - 3]);
+    }
+}
+
+TEST_CASE("FujiBusFrameDecoder: tagged frame carries its tag ahead of the params")
+{
+    FujiBusPacket pkt = make_packet(0x42, make_payload(40));
+    pkt.setTag(0xC0); // SLIP END as the tag: must be escaped on the wire
+
+    const ByteBuffer wire = pkt.serialize();
+
+    FujiBusFrameDecoder dec;
+    dec.feed(wire.data(), wire.size());
+
+    FujiBusFrame frame;
+    REQUIRE(dec.next(frame));
+    CHECK(frame.tagged);
+    CHECK(frame.tag == 0xC0);
+    REQUIRE(frame.params.size() == 6);
+    CHECK(frame.params[0].value == 1);
+    CHECK(frame.params[5].value == 0xBEEF);
+    CHECK(frame.payload == make_payload(40));
+
+    const auto parsed = FujiBusPacket::fromSerialized(wire);
+    REQUIRE(parsed);
+    REQUIRE(parsed->tag());
+    CHECK(*parsed->tag() == 0xC0);
+
+    // Untagged frames report no tag.
+    const ByteBuffer plain = make_packet(0x42, {}).serialize();
+    dec.feed(plain.data(), plain.size());
+    REQUIRE(dec.next(frame));
+    CHECK_FALSE(frame.tagged);
+}
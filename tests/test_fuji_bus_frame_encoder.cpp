@@ -0,0 +1,92 @@
+#include "doctest.h"
+
+#include "fujinet/io/protocol/fuji_bus_frame_decoder.h"
+#include "fujinet/io/protocol/fuji_bus_frame_encoder.h"
+#include "fujinet/io/protocol/fuji_bus_packet.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace fujinet::io::protocol;
+
+TEST_CASE("encode_frame: params + payload with SLIP specials round-trip")
+{
+    const std::vector<PacketParam> params{
+        PacketParam{std::uint8_t{0x01}},
+        PacketParam{std::uint16_t{0xC0DB}},
+        PacketParam{std::uint32_t{0xDBC0C0DB}},
+    };
+    ByteBuffer payload(700);
+    for (std::size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = static_cast<std::uint8_t>(i * 37);
+    }
+
+    ByteBuffer wire;
+    REQUIRE(encode_frame(wire, static_cast<WireDeviceId>(0x45), 0x12,
+                         params.data(), params.size(), payload.data(), payload.size()));
+    CHECK(wire.front() == to_byte(SlipByte::End));
+    CHECK(wire.back() == to_byte(SlipByte::End));
+
+    FujiBusFrameDecoder dec;
+    dec.feed(wire.data(), wire.size());
+    FujiBusFrame frame;
+    REQUIRE(dec.next(frame));
+    CHECK(frame.device == static_cast<WireDeviceId>(0x45));
+    CHECK(frame.command == 0x12);
+    REQUIRE(frame.params.size() == 3);
+    CHECK(frame.params[1].value == 0xC0DB);
+    CHECK(frame.params[2].value == 0xDBC0C0DBu);
+    CHECK(frame.payload == payload);
+}
+
+TEST_CASE("encode_frame: produces the documented wire format")
+{
+    const std::vector<PacketParam> params{
+        PacketParam{std::uint8_t{1}}, PacketParam{std::uint8_t{2}}, PacketParam{std::uint8_t{3}},
+        PacketParam{std::uint8_t{4}}, PacketParam{std::uint8_t{5}}, PacketParam{std::uint16_t{0xABCD}},
+    };
+    const ByteBuffer payload{0x00, 0xC0, 0xDB, 0xFF};
+
+    // Built by hand, not by either encoder:
+    //   header: device, command, length (u16le = 19), checksum, descr[0]
+    //   descr: 4 x u8 (+more), 1 x u8 (+more), 1 x u16
+    //   params, then payload; C0/DB in the payload are SLIP-escaped.
+    const ByteBuffer expected{
+        0xC0,
+        0x09, 0x0A, 0x13, 0x00, 0x56, 0x84,
+        0x81, 0x05,
+        0x01, 0x02, 0x03, 0x04, 0x05, 0xCD, 0xAB,
+        0x00, 0xDB, 0xDC, 0xDB, 0xDD, 0xFF,
+        0xC0,
+    };
+
+    ByteBuffer wire;
+    REQUIRE(encode_frame(wire, static_cast<WireDeviceId>(9), 10,
+                         params.data(), params.size(), payload.data(), payload.size()));
+    CHECK(wire == expected);
+
+    FujiBusPacket pkt(static_cast<WireDeviceId>(9), 10,
+                      std::uint8_t{1}, std::uint8_t{2}, std::uint8_t{3},
+                      std::uint8_t{4}, std::uint8_t{5}, std::uint16_t{0xABCD},
+                      payload);
+    CHECK(pkt.serialize() == expected);
+}
+
+TEST_CASE("encode_frame: reuses the output buffer and rejects oversized packets")
+{
+    const PacketParam status{std::uint8_t{0}};
+    ByteBuffer payload(1024, 0x5A);
+
+    ByteBuffer wire;
+    REQUIRE(encode_frame(wire, static_cast<WireDeviceId>(1), 2, &status, 1,
+                         payload.data(), payload.size()));
+    const auto* first = wire.data();
+    REQUIRE(encode_frame(wire, static_cast<WireDeviceId>(1), 2, &status, 1,
+                         payload.data(), payload.size() / 2));
+    CHECK(wire.data() == first);
+
+    ByteBuffer huge(0x10000, 0x00);
+    CHECK_FALSE(encode_frame(wire, static_cast<WireDeviceId>(1), 2, &status, 1,
+                             huge.data(), huge.size()));
+    CHECK(wire.empty());
+}
@@ -130,9 +130,9 @@ TEST_CASE("FujiDevice persists mount updates using 0-based slot indices")
 TEST_CASE("FujiDevice returns sorted persisted mount table with 0-based indices")
 {
     FujiConfig initial;
-    initial.mounts.push_back(MountConfig{3, "host:/images/data.atr", "rw", true});
-    initial.mounts.push_back(MountConfig{1, "sd:/disks/boot.atr", "r", true});
-    initial.mounts.push_back(MountConfig{0, "ignored:/invalid", "r", true});
+    initial.mounts.push_back(MountConfig{3, "host:/images/data.atr", "rw", true, 0, ""});
+    initial.mounts.push_back(MountConfig{1, "sd:/disks/boot.atr", "r", true, 0, ""});
+    initial.mounts.push_back(MountConfig{0, "ignored:/invalid", "r", true, 0, ""});
 
     auto store = std::make_unique<MemoryFujiConfigStore>(initial);
     fujinet::fs::StorageManager storage;
@@ -162,9 +162,9 @@ TEST_CASE("FujiDevice returns sorted persisted mount table with 0-based indices"
 TEST_CASE("FujiDevice returns extended binary mount table with slot range filtering")
 {
     FujiConfig initial;
-    initial.mounts.push_back(MountConfig{2, "tnfs://server/game1.atr", "r", true});
-    initial.mounts.push_back(MountConfig{11, "host:/images/game2.atr", "rw", false});
-    initial.mounts.push_back(MountConfig{300, "sd:/archive/game3.atr", "r", true});
+    initial.mounts.push_back(MountConfig{2, "tnfs://server/game1.atr", "r", true, 0, ""});
+    initial.mounts.push_back(MountConfig{11, "host:/images/game2.atr", "rw", false, 0, ""});
+    initial.mounts.push_back(MountConfig{300, "sd:/archive/game3.atr", "r", true, 0, ""});
 
     auto store = std::make_unique<MemoryFujiConfigStore>(initial);
     fujinet::fs::StorageManager storage;
@@ -207,8 +207,8 @@ TEST_CASE("FujiDevice returns extended binary mount table with slot range filter
 TEST_CASE("FujiDevice returns formatted mount lines for extended requests")
 {
     FujiConfig initial;
-    initial.mounts.push_back(MountConfig{2, "tnfs://server/game1.atr", "r", true});
-    initial.mounts.push_back(MountConfig{11, "host:/images/game2.atr", "rw", false});
+    initial.mounts.push_back(MountConfig{2, "tnfs://server/game1.atr", "r", true, 0, ""});
+    initial.mounts.push_back(MountConfig{11, "host:/images/game2.atr", "rw", false, 0, ""});
 
     auto store = std::make_unique<MemoryFujiConfigStore>(initial);
     fujinet::fs::StorageManager storage;
@@ -239,8 +239,8 @@ TEST_CASE("FujiDevice returns formatted mount lines for extended requests")
 TEST_CASE("FujiDevice paginates formatted mount lines when max payload is small")
 {
     FujiConfig initial;
-    initial.mounts.push_back(MountConfig{2, "tnfs://server/game1.atr", "r", true});
-    initial.mounts.push_back(MountConfig{11, "host:/images/game2.atr", "rw", false});
+    initial.mounts.push_back(MountConfig{2, "tnfs://server/game1.atr", "r", true, 0, ""});
+    initial.mounts.push_back(MountConfig{11, "host:/images/game2.atr", "rw", false, 0, ""});
 
     auto store = std::make_unique<MemoryFujiConfigStore>(initial);
     fujinet::fs::StorageManager storage;
@@ -274,8 +274,8 @@ TEST_CASE("FujiDevice paginates formatted mount lines when max payload is small"
 TEST_CASE("FujiDevice defaults extended mount range to configured bounds")
 {
     FujiConfig initial;
-    initial.mounts.push_back(MountConfig{25, "tnfs://server/game1.atr", "r", true});
-    initial.mounts.push_back(MountConfig{1200, "host:/images/game2.atr", "rw", true});
+    initial.mounts.push_back(MountConfig{25, "tnfs://server/game1.atr", "r", true, 0, ""});
+    initial.mounts.push_back(MountConfig{1200, "host:/images/game2.atr", "rw", true, 0, ""});
 
     auto store = std::make_unique<MemoryFujiConfigStore>(initial);
     fujinet::fs::StorageManager storage;
@@ -332,7 +332,7 @@ TEST_CASE("FujiDevice rejects extended get mounts requests with zero max payload
 TEST_CASE("FujiDevice clears a persisted mount when URI is empty")
 {
     FujiConfig initial;
-    initial.mounts.push_back(MountConfig{2, "tnfs://server/game.atr", "r", true});
+    initial.mounts.push_back(MountConfig{2, "tnfs://server/game.atr", "r", true, 0, ""});
 
     auto store = std::make_unique<MemoryFujiConfigStore>(initial);
     auto* storePtr = store.get();
@@ -354,7 +354,7 @@ TEST_CASE("FujiDevice clears a persisted mount when URI is empty")
 TEST_CASE("FujiDevice accepts a 4-byte clear mount request with empty URI and mode")
 {
     FujiConfig initial;
-    initial.mounts.push_back(MountConfig{2, "tnfs://server/game.atr", "rw", true});
+    initial.mounts.push_back(MountConfig{2, "tnfs://server/game.atr", "rw", true, 0, ""});
 
     auto store = std::make_unique<MemoryFujiConfigStore>(initial);
     auto* storePtr = store.get();
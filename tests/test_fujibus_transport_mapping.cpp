@@ -120,3 +120,87 @@ TEST_CASE("FujiBusTransport: responses use param[0] as status (receiveResponse m
     CHECK(resp.payload[1] == 0x20);
     CHECK(resp.payload[2] == 0x30);
 }
+
+TEST_CASE("FujiBusTransport: send() encodes status + payload that receiveResponse() decodes")
+{
+    FakeChannel devSide;
+    FujiBusTransport tx(devSide);
+
+    IOResponse out{};
+    out.deviceId = 0x70;
+    out.command  = 0x05;
+    out.status   = StatusCode::NotReady;
+    out.payload  = {0xC0, 0x01, 0xDB, 0x02};
+
+    tx.send(out);
+    tx.send(out); // second send reuses the transport's TX buffer
+
+    FakeChannel hostSide;
+    FujiBusTransport rx(hostSide);
+    hostSide.pushRx(devSide.tx());
+    rx.poll();
+
+    for (int i = 0; i < 2; ++i) {
+        IOResponse in{};
+        REQUIRE(rx.receiveResponse(in) == true);
+        CHECK(in.deviceId == 0x70);
+        CHECK((in.command & 0xFF) == 0x05);
+        CHECK(in.status == StatusCode::NotReady);
+        CHECK(in.payload == out.payload);
+    }
+}
+
+TEST_CASE("FujiBusTransport: pipelined tagged requests get their tag echoed, in any order")
+{
+    FakeChannel devSide;
+    FujiBusTransport dev(devSide);
+
+    // Host queues three tagged requests back-to-back without waiting.
+    for (std::uint8_t tag : {std::uint8_t{7}, std::uint8_t{8}, std::uint8_t{9}}) {
+        FujiBusPacket pkt(static_cast<WireDeviceId>(0x70), 0x05,
+                          static_cast<std::uint8_t>(tag * 2),
+                          ByteBuffer{tag});
+        pkt.setTag(tag);
+        devSide.pushRx(pkt.serialize());
+    }
+    // And one plain request, which must stay untagged.
+    devSide.pushRx(FujiBusPacket(static_cast<WireDeviceId>(0x70), 0x06, ByteBuffer{}).serialize());
+    dev.poll();
+
+    std::vector<IORequest> reqs;
+    for (;;) {
+        IORequest r{};
+        if (!dev.receive(r)) break;
+        reqs.push_back(std::move(r));
+    }
+    REQUIRE(reqs.size() == 4);
+    CHECK(dev.outstanding_tagged() == 3);
+
+    // Answer out of order: last request first.
+    for (auto it = reqs.rbegin(); it != reqs.rend(); ++it) {
+        IOResponse resp{};
+        resp.id       = it->id;
+        resp.deviceId = it->deviceId;
+        resp.command  = it->command;
+        resp.status   = StatusCode::Ok;
+        resp.payload  = it->payload;
+        dev.send(resp);
+    }
+    CHECK(dev.outstanding_tagged() == 0);
+
+    FakeChannel hostSide;
+    FujiBusTransport host(hostSide);
+    hostSide.pushRx(devSide.tx());
+    host.poll();
+
+    IOResponse in{};
+    REQUIRE(host.receiveResponse(in));
+    CHECK((in.command & 0xFF) == 0x06); // untagged one, answered first
+
+    for (std::uint8_t expect : {std::uint8_t{9}, std::uint8_t{8}, std::uint8_t{7}}) {
+        REQUIRE(host.receiveResponse(in));
+        CHECK(in.id == expect);
+        REQUIRE(in.payload.size() == 1);
+        CHECK(in.payload[0] == expect);
+    }
+}
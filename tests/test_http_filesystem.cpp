@@ -4,6 +4,8 @@
 #include "fujinet/io/devices/network_protocol.h"
 #include "fujinet/io/core/io_message.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
 #include <memory>
 #include <string>
@@ -118,6 +120,89 @@ HttpProtocolFactory make_mock_http_factory()
     };
 }
 
+// Serves one large resource and honours "Range: bytes=a-b" with 206 replies.
+struct RangeServer {
+    std::vector<std::uint8_t> body;
+    int requests{0};
+    std::size_t bytesServed{0};
+};
+
+class RangeHttpProtocol final : public fujinet::io::INetworkProtocol {
+public:
+    explicit RangeHttpProtocol(RangeServer& server) : _server(server) {}
+
+    fujinet::io::StatusCode open(const fujinet::io::NetworkOpenRequest& req) override
+    {
+        ++_server.requests;
+        _first = 0;
+        _last = _server.body.size() - 1;
+        _status = 200;
+        for (const auto& [name, value] : req.headers) {
+            if (name != "Range") continue;
+            unsigned long long a = 0;
+            unsigned long long b = 0;
+            REQUIRE(std::sscanf(value.c_str(), "bytes=%llu-%llu", &a, &b) == 2);
+            _first = static_cast<std::size_t>(a);
+            _last = std::min<std::size_t>(static_cast<std::size_t>(b), _server.body.size() - 1);
+            _status = 206;
+        }
+        if (_status == 206) {
+            for (const auto& want : req.responseHeaderNamesLower) {
+                if (want == "content-range") {
+                    _headers = "Content-Range: bytes " + std::to_string(_first) + "-" + std::to_string(_last) + "/" +
+                               std::to_string(_server.body.size()) + "\r\n";
+                }
+            }
+        }
+        return fujinet::io::StatusCode::Ok;
+    }
+
+    fujinet::io::StatusCode write_body(std::uint32_t, const std::uint8_t*, std::size_t, std::uint16_t& written) override
+    {
+        written = 0;
+        return fujinet::io::StatusCode::Unsupported;
+    }
+
+    fujinet::io::StatusCode read_body(std::uint32_t offset,
+                                      std::uint8_t* out,
+                                      std::size_t outLen,
+                                      std::uint16_t& read,
+                                      bool& eof,
+                                      bool& more_available) override
+    {
+        const std::size_t len = _last - _first + 1;
+        REQUIRE(offset <= len);
+        const std::size_t n = std::min(outLen, len - offset);
+        std::memcpy(out, _server.body.data() + _first + offset, n);
+        _server.bytesServed += n;
+        read = static_cast<std::uint16_t>(n);
+        eof = offset + n >= len;
+        more_available = !eof;
+        return fujinet::io::StatusCode::Ok;
+    }
+
+    fujinet::io::StatusCode info(fujinet::io::NetworkInfo& out) override
+    {
+        out = fujinet::io::NetworkInfo{};
+        out.hasHttpStatus = true;
+        out.httpStatus = _status;
+        out.hasContentLength = true;
+        out.contentLength = _last - _first + 1;
+        out.headersBlock = _headers;
+        return fujinet::io::StatusCode::Ok;
+    }
+
+    void poll() override {}
+    void close() override {}
+
+private:
+    RangeServer& _server;
+    std::size_t _first{0};
+    std::size_t _last{0};
+    std::uint16_t _status{0};
+    std::string _headers;
+};
+
 } // namespace
 
 TEST_CASE("HttpFileSystem: create and basic properties")
@@ -180,3 +265,65 @@ TEST_CASE("HttpFileSystem: directory and mutation operations are unsupported")
     CHECK_FALSE(fs->rename("http://example.com/a", "http://example.com/b"));
     CHECK_FALSE(fs->isDirectory("http://example.com/"));
 }
+
+TEST_CASE("HttpFileSystem: streaming fallback re-fetches on backward seek")
+{
+    auto fs = make_http_filesystem(make_mock_http_factory());
+    auto file = fs->open("https://secure.example.com/demo.xex", "rb");
+    REQUIRE(file != nullptr);
+
+    char buffer[8]{};
+    CHECK(file->seek(3));
+    CHECK(file->read(buffer, 2) == 2);
+    CHECK(std::string(buffer, 2) == "UR");
+    CHECK(file->seek(1));
+    CHECK(file->read(buffer, sizeof(buffer)) == 5);
+    CHECK(std::string(buffer, 5) == "ECURE");
+    CHECK(file->read(buffer, sizeof(buffer)) == 0);
+}
+
+TEST_CASE("HttpFileSystem: open fetches only the blocks that are read via Range requests")
+{
+    RangeServer server;
+    server.body.resize(1024 * 1024);
+    for (std::size_t i = 0; i < server.body.size(); ++i) {
+        server.body[i] = static_cast<std::uint8_t>((i * 7U) ^ (i >> 9));
+    }
+    auto fs = make_http_filesystem([&](std::string_view) { return std::make_unique<RangeHttpProtocol>(server); });
+
+    auto file = fs->open("http://example.com/big.atr", "rb");
+    REQUIRE(file != nullptr);
+    CHECK(server.requests == 1);
+    CHECK(server.bytesServed <= 4096);
+
+    // Random access deep into the image costs one small request.
+    std::vector<std::uint8_t> buf(300);
+    REQUIRE(file->seek(700000));
+    REQUIRE(file->read(buf.data(), buf.size()) == buf.size());
+    CHECK(std::equal(buf.begin(), buf.end(), server.body.begin() + 700000));
+    CHECK(server.requests == 2);
+    CHECK(server.bytesServed <= 3 * 4096);
+
+    // Re-reading a cached block is free.
+    REQUIRE(file->seek(700100));
+    REQUIRE(file->read(buf.data(), 100) == 100);
+    CHECK(server.requests == 2);
+
+    // Sequential reads widen requests; past the end returns 0.
+    const int before = server.requests;
+    REQUIRE(file->seek(0));
+    std::vector<std::uint8_t> chunk(512);
+    std::size_t total = 0;
+    bool same = true;
+    for (int i = 0; i < 128; ++i) {
+        const std::size_t n = file->read(chunk.data(), chunk.size());
+        REQUIRE(n == chunk.size());
+        same = same && std::equal(chunk.begin(), chunk.end(), server.body.begin() + static_cast<std::ptrdiff_t>(total));
+        total += n;
+    }
+    CHECK(same);
+    CHECK(server.requests - before < 16); // 64 KiB = 16 blocks
+    REQUIRE(file->seek(server.body.size()));
+    CHECK(file->read(chunk.data(), chunk.size()) == 0);
+    CHECK_FALSE(file->seek(server.body.size() + 1));
+}
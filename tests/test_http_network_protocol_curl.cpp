@@ -0,0 +1,295 @@
+#include "doctest.h"
+
+#if FN_WITH_CURL == 1 && !defined(_WIN32)
+
+#include "fujinet/platform/posix/curl_http_engine.h"
+#include "fujinet/platform/posix/http_network_protocol_curl.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using fujinet::io::NetworkInfo;
+using fujinet::io::NetworkOpenRequest;
+using fujinet::io::StatusCode;
+using fujinet::platform::posix::CurlHttpEngine;
+using fujinet::platform::posix::HttpNetworkProtocolCurl;
+
+namespace {
+
+// Keep-alive HTTP/1.1 server on 127.0.0.1 that answers every request with
+// `body` (default "ok") and counts accepted TCP connections.
+struct KeepAliveHttpServer {
+    std::string body{"ok"};
+    int listenFd{-1};
+    std::uint16_t port{0};
+    std::atomic<int> accepted{0};
+    std::atomic<int> requests{0};
+    std::atomic<bool> stop{false};
+    std::thread th;
+
+    bool start()
+    {
+        listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (listenFd < 0) return false;
+        int opt = 1;
+        (void)::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(0);
+        if (::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) return false;
+        socklen_t len = sizeof(addr);
+        if (::getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) return false;
+        port = ntohs(addr.sin_port);
+        if (::listen(listenFd, 4) != 0) return false;
+
+        th = std::thread([this] { run(); });
+        return true;
+    }
+
+    void run()
+    {
+        std::vector<pollfd> fds;
+        fds.push_back(pollfd{listenFd, POLLIN, 0});
+        std::vector<std::string> bufs(1);
+
+        while (!stop.load()) {
+            if (::poll(fds.data(), static_cast<nfds_t>(fds.size()), 20) <= 0) continue;
+
+            for (std::size_t i = 0; i < fds.size(); ++i) {
+                if ((fds[i].revents & (POLLIN | POLLHUP)) == 0) continue;
+
+                if (i == 0) {
+                    const int c = ::accept(listenFd, nullptr, nullptr);
+                    if (c >= 0) {
+                        ++accepted;
+                        fds.push_back(pollfd{c, POLLIN, 0});
+                        bufs.emplace_back();
+                    }
+                    continue;
+                }
+
+                char tmp[1024];
+                const ssize_t n = ::recv(fds[i].fd, tmp, sizeof(tmp), 0);
+                if (n <= 0) {
+                    ::close(fds[i].fd);
+                    fds[i].fd = -1;
+                    continue;
+                }
+                bufs[i].append(tmp, static_cast<std::size_t>(n));
+                std::size_t end;
+                while ((end = bufs[i].find("\r\n\r\n")) != std::string::npos) {
+                    bufs[i].erase(0, end + 4);
+                    ++requests;
+                    const std::string resp = "HTTP/1.1 200 OK\r\nContent-Length: " +
+                                             std::to_string(body.size()) +
+                                             "\r\nConnection: keep-alive\r\n\r\n" + body;
+                    std::size_t sent = 0;
+                    while (sent < resp.size()) {
+                        const ssize_t w = ::send(fds[i].fd, resp.data() + sent, resp.size() - sent, MSG_NOSIGNAL);
+                        if (w <= 0) break;
+                        sent += static_cast<std::size_t>(w);
+                    }
+                }
+            }
+        }
+
+        for (std::size_t i = 1; i < fds.size(); ++i) {
+            if (fds[i].fd >= 0) ::close(fds[i].fd);
+        }
+    }
+
+    ~KeepAliveHttpServer()
+    {
+        stop.store(true);
+        if (th.joinable()) th.join();
+        if (listenFd >= 0) ::close(listenFd);
+    }
+};
+
+// Make sure a developer's proxy settings don't route loopback requests.
+struct NoProxyEnv {
+    NoProxyEnv() { ::setenv("no_proxy", "127.0.0.1", 1); ::setenv("NO_PROXY", "127.0.0.1", 1); }
+};
+
+StatusCode fetch(HttpNetworkProtocolCurl& proto, const std::string& url, std::string& body)
+{
+    NetworkOpenRequest req{};
+    req.method = 1;
+    req.url = url;
+    const StatusCode st = proto.open(req);
+    if (st != StatusCode::Ok) return st;
+
+    NetworkInfo info{};
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    StatusCode ist = StatusCode::NotReady;
+    while ((ist = proto.info(info)) == StatusCode::NotReady &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (ist != StatusCode::Ok) return ist;
+
+    std::uint8_t buf[64];
+    std::uint16_t n = 0;
+    bool eof = false;
+    bool more = false;
+    const StatusCode rst = proto.read_body(0, buf, sizeof(buf), n, eof, more);
+    body.assign(reinterpret_cast<const char*>(buf), n);
+    return rst;
+}
+
+} // namespace
+
+TEST_CASE("CurlHttpEngine: sequential sessions to one host reuse the connection")
+{
+    NoProxyEnv env;
+    KeepAliveHttpServer server;
+    REQUIRE(server.start());
+    const std::string url = "http://127.0.0.1:" + std::to_string(server.port) + "/index.json";
+
+    const auto before = CurlHttpEngine::instance().stats();
+
+    for (int i = 0; i < 3; ++i) {
+        HttpNetworkProtocolCurl proto;
+        std::string body;
+        REQUIRE(fetch(proto, url, body) == StatusCode::Ok);
+        CHECK(body == "ok");
+        proto.close();
+    }
+
+    const auto after = CurlHttpEngine::instance().stats();
+    CHECK(server.requests.load() == 3);
+    CHECK(server.accepted.load() == 1);
+    CHECK(after.transfers - before.transfers == 3);
+    CHECK(after.reusedConnections - before.reusedConnections == 2);
+}
+
+TEST_CASE("CurlHttpEngine: concurrent sessions each get their own completion")
+{
+    NoProxyEnv env;
+    KeepAliveHttpServer server;
+    REQUIRE(server.start());
+    const std::string url = "http://127.0.0.1:" + std::to_string(server.port) + "/a";
+
+    HttpNetworkProtocolCurl a;
+    HttpNetworkProtocolCurl b;
+    NetworkOpenRequest req{};
+    req.method = 1;
+    req.url = url;
+    REQUIRE(a.open(req) == StatusCode::Ok);
+    REQUIRE(b.open(req) == StatusCode::Ok);
+
+    // Only `a` is polled; `b`'s completion must wait for it in the engine.
+    NetworkInfo info{};
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (server.requests.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+        a.poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    while (a.info(info) == StatusCode::NotReady && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(info.httpStatus == 200);
+
+    NetworkInfo infoB{};
+    while (b.info(infoB) == StatusCode::NotReady && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(infoB.httpStatus == 200);
+}
+
+TEST_CASE("HttpNetworkProtocolCurl: large body is buffered in a bounded ring with pause/resume")
+{
+    NoProxyEnv env;
+    KeepAliveHttpServer server;
+    server.body.resize(1024 * 1024);
+    for (std::size_t i = 0; i < server.body.size(); ++i) {
+        server.body[i] = static_cast<char>((i * 7u) & 0xFFu);
+    }
+    REQUIRE(server.start());
+
+    HttpNetworkProtocolCurl::BufferLimits limits;
+    limits.highWater = 32 * 1024;
+    limits.lowWater = 8 * 1024;
+    HttpNetworkProtocolCurl proto(limits);
+    const std::size_t cap = proto.buffer_capacity();
+    CHECK(cap >= limits.lowWater + CURL_MAX_WRITE_SIZE);
+
+    NetworkOpenRequest req{};
+    req.method = 1;
+    req.url = "http://127.0.0.1:" + std::to_string(server.port) + "/big.bin";
+    REQUIRE(proto.open(req) == StatusCode::Ok);
+
+    // Don't read: the backend must fill its ring and pause, not keep buffering.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!proto.paused() && std::chrono::steady_clock::now() < deadline) {
+        proto.poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(proto.paused());
+    for (int i = 0; i < 50; ++i) {
+        proto.poll();
+    }
+    CHECK(proto.buffered_bytes() <= cap);
+
+    // Only transfer is paused: once curl's own one-shot timers from the
+    // connect have run out, there is no socket to watch and nothing to poll.
+    CHECK(CurlHttpEngine::instance().paused_count() == 1);
+    const auto idle = std::chrono::milliseconds(1000);
+    const auto timerDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    fujinet::io::WaitSet ws;
+    for (;;) {
+        ws.clear();
+        proto.add_wait_sources(ws);
+        if (ws.timeout(idle) == idle || std::chrono::steady_clock::now() >= timerDeadline) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        proto.poll();
+    }
+    REQUIRE(proto.paused());
+    CHECK(ws.entries().empty());
+    CHECK(ws.timeout(idle) == idle);
+
+    // Headers are available while the body is still streaming.
+    NetworkInfo info{};
+    REQUIRE(proto.info(info) == StatusCode::Ok);
+    CHECK(info.httpStatus == 200);
+    CHECK(info.hasContentLength);
+    CHECK(info.contentLength == server.body.size());
+
+    std::string got;
+    got.reserve(server.body.size());
+    std::uint8_t buf[512];
+    bool eof = false;
+    std::size_t peak = 0;
+    while (!eof && std::chrono::steady_clock::now() < deadline) {
+        std::uint16_t n = 0;
+        bool more = false;
+        const StatusCode st = proto.read_body(static_cast<std::uint32_t>(got.size()), buf, sizeof(buf), n, eof, more);
+        if (st == StatusCode::NotReady) {
+            proto.poll();
+            continue;
+        }
+        REQUIRE(st == StatusCode::Ok);
+        got.append(reinterpret_cast<const char*>(buf), n);
+        peak = std::max(peak, proto.buffered_bytes());
+    }
+
+    CHECK(eof);
+    CHECK(peak <= cap);
+    CHECK(got.size() == server.body.size());
+    CHECK(got == server.body);
+    CHECK(CurlHttpEngine::instance().paused_count() == 0);
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include "fujinet/io/transport/transport.h"
 
 #include <chrono>
+#include <deque>
 #include <utility>
 #include <vector>
 
@@ -69,8 +70,109 @@ private:
     std::vector<std::chrono::milliseconds> _waitCalls;
 };
 
+// Defers every deferrable request; completes them when told to.
+class DeferringHandler final : public fujinet::io::IRequestHandler {
+public:
+    fujinet::io::IOResponse handleRequest(const fujinet::io::IORequest& request) override
+    {
+        fujinet::io::IOResponse response{};
+        response.id = request.id;
+        response.deviceId = request.deviceId;
+        response.status = fujinet::io::StatusCode::Pending;
+        if (request.deferrable) {
+            parked.push_back(response);
+        }
+        return response;
+    }
+
+    bool takeCompletedResponse(fujinet::io::IOResponse& out) override
+    {
+        if (done.empty()) {
+            return false;
+        }
+        out = done.front();
+        done.pop_front();
+        return true;
+    }
+
+    void completeAll()
+    {
+        for (auto& r : parked) {
+            r.status = fujinet::io::StatusCode::Ok;
+            done.push_back(r);
+        }
+        parked.clear();
+    }
+
+    std::vector<fujinet::io::IOResponse> parked;
+    std::deque<fujinet::io::IOResponse> done;
+};
+
+class QueueTransport final : public fujinet::io::ITransport {
+public:
+    bool receive(fujinet::io::IORequest& out) override
+    {
+        if (inbox.empty()) {
+            return false;
+        }
+        out = inbox.front();
+        inbox.pop_front();
+        return true;
+    }
+
+    void send(const fujinet::io::IOResponse& resp) override
+    {
+        sent.push_back(resp);
+    }
+
+    std::deque<fujinet::io::IORequest> inbox;
+    std::vector<fujinet::io::IOResponse> sent;
+};
+
 } // namespace
 
+TEST_CASE("IOService holds Pending responses and sends them on completion")
+{
+    DeferringHandler handler;
+    fujinet::io::IOService service(handler);
+    QueueTransport transport;
+    service.addTransport(&transport);
+
+    fujinet::io::IORequest req{};
+    req.id = 7;
+    req.deviceId = 0x70;
+    req.deferrable = true;
+    transport.inbox.push_back(req);
+
+    service.serviceOnce();
+    CHECK(transport.sent.empty());
+    CHECK(service.pendingCount() == 1);
+
+    handler.completeAll();
+    service.deliverCompletions();
+    REQUIRE(transport.sent.size() == 1);
+    CHECK(transport.sent[0].id == 7);
+    CHECK(transport.sent[0].status == fujinet::io::StatusCode::Ok);
+    CHECK(service.pendingCount() == 0);
+}
+
+TEST_CASE("IOService never puts Pending on the wire for non-deferrable requests")
+{
+    DeferringHandler handler;
+    fujinet::io::IOService service(handler);
+    QueueTransport transport;
+    service.addTransport(&transport);
+
+    fujinet::io::IORequest req{};
+    req.id = 8;
+    transport.inbox.push_back(req);
+
+    service.serviceOnce();
+    REQUIRE(transport.sent.size() == 1);
+    CHECK(transport.sent[0].status == fujinet::io::StatusCode::InternalError);
+    CHECK(service.pendingCount() == 0);
+}
+
 TEST_CASE("IOService reports whether any transport supports waiting")
 {
     FakeRequestHandler handler;
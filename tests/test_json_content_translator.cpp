@@ -0,0 +1,185 @@
+#include "doctest.h"
+
+#include "fujinet/io/devices/json_content_translator.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+using fujinet::io::ContentTranslationType;
+using fujinet::io::JsonContentTranslator;
+using fujinet::io::StatusCode;
+using fujinet::io::TranslationConfig;
+
+namespace {
+
+// Feeds `body` in `chunk`-byte pieces and returns the translated view.
+std::string translate(std::string_view body, std::string_view selector, std::size_t chunk = 4096)
+{
+    JsonContentTranslator t;
+    TranslationConfig cfg;
+    cfg.type = ContentTranslationType::Json;
+    cfg.selector = std::string(selector);
+    REQUIRE(t.configure(cfg) == StatusCode::Ok);
+    CHECK_FALSE(t.needs_full_body());
+
+    for (std::size_t off = 0; off < body.size(); off += chunk) {
+        const std::size_t n = std::min(chunk, body.size() - off);
+        REQUIRE(t.append_body(reinterpret_cast<const std::uint8_t*>(body.data() + off), n) == StatusCode::Ok);
+    }
+    REQUIRE(t.finalize() == StatusCode::Ok);
+
+    std::string out(static_cast<std::size_t>(t.translated_size()), '\0');
+    std::uint16_t actual = 0;
+    bool eof = false;
+    REQUIRE(t.read(0, reinterpret_cast<std::uint8_t*>(out.data()), out.size(), actual, eof) == StatusCode::Ok);
+    CHECK(eof);
+    out.resize(actual);
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("JsonContentTranslator: values are serialized for 8-bit hosts")
+{
+    const std::string doc =
+        "\xEF\xBB\xBF { \"name\": \"Caf\\u00e9 \\\"A\\\"\", \"n\": 42, \"pi\": 3.14159,"
+        " \"big\": 1e3, \"ok\": true, \"no\": false, \"nil\": null,"
+        " \"obj\": {\"a\": 1, \"b\": [\"x\", {\"c\": \"d\"}], \"e\": {}},"
+        " \"emoji\": \"\\ud83d\\ude00\", \"a/b\": \"slash\", \"m~n\": \"tilde\" } trailing";
+
+    // Byte-at-a-time feeding must not change anything.
+    for (std::size_t chunk : {std::size_t{1}, std::size_t{7}, std::size_t{4096}}) {
+        CAPTURE(chunk);
+        CHECK(translate(doc, "/name", chunk) == "Caf\xC3\xA9 \"A\"");
+        CHECK(translate(doc, "/n", chunk) == "42");
+        CHECK(translate(doc, "/pi", chunk) == "3.14159");
+        CHECK(translate(doc, "/big", chunk) == "1000");
+        CHECK(translate(doc, "/ok", chunk) == "TRUE");
+        CHECK(translate(doc, "/no", chunk) == "FALSE");
+        CHECK(translate(doc, "/nil", chunk) == "NULL");
+        CHECK(translate(doc, "/obj", chunk) == "a\n1\nb\nx\nc\nd\ne\n");
+        CHECK(translate(doc, "/obj/b", chunk) == "x\nc\nd");
+        CHECK(translate(doc, "/obj/b/1/c", chunk) == "d");
+        CHECK(translate(doc, "/emoji", chunk) == "\xF0\x9F\x98\x80");
+    }
+
+    CHECK(translate(doc, "/a~1b") == "slash");
+    CHECK(translate(doc, "/m~0n") == "tilde");
+    CHECK(translate(doc, "/NAME") == "Caf\xC3\xA9 \"A\"");
+    CHECK(translate("[1,[2,3]]", "") == "1\n2\n3");
+}
+
+TEST_CASE("JsonContentTranslator: misses and malformed documents translate to nothing")
+{
+    const std::string doc = "{\"items\":[\"alpha\",\"beta\"],\"dup\":{\"x\":1},\"dup\":{\"y\":2}}";
+
+    CHECK(translate(doc, "/items/1") == "beta");
+    CHECK(translate(doc, "/items/2").empty());
+    CHECK(translate(doc, "/items/01").empty());
+    CHECK(translate(doc, "/items/x").empty());
+    CHECK(translate(doc, "/missing").empty());
+    CHECK(translate(doc, "/items/0/deeper").empty());
+
+    // The first of duplicate keys wins, like cJSON.
+    CHECK(translate(doc, "/dup/x") == "1");
+    CHECK(translate(doc, "/dup/y").empty());
+
+    // Selected value already seen, but the document is broken or cut short.
+    CHECK(translate("{\"a\":\"b\",}", "/a").empty());
+    CHECK(translate("{\"a\":\"b\"", "/a").empty());
+    CHECK(translate("{\"a\":tru}", "/a").empty());
+    CHECK(translate("{\"a\":\"\\q\"}", "/a").empty());
+    CHECK(translate("", "/a").empty());
+}
+
+TEST_CASE("JsonContentTranslator: memory doesn't grow with the document")
+{
+    // 1 MB of array elements before the selected value; only the value is kept.
+    std::string doc = "{\"filler\":[";
+    for (int i = 0; i < 100000; ++i) {
+        doc += i ? ",\"012345678\"" : "\"012345678\"";
+    }
+    doc += "],\"wanted\":{\"deep\":[0,1,{\"v\":-2.5}]}}";
+
+    CHECK(translate(doc, "/wanted/deep/2/v", 512) == "-2.5");
+    CHECK(translate(doc, "/filler/99999", 512) == "012345678");
+}
+
+TEST_CASE("JsonContentTranslator: query() and reselect() answer from the container index")
+{
+    const std::string doc =
+        "{\"a\": {\"list\": [10, {\"x\": \"y\"}, [true, null]], \"s\\u0074r\": \"esc\"},"
+        " \"b\": [[], {}], \"c\": -1.5e2, \"A\": \"second\"}";
+
+    JsonContentTranslator t;
+    TranslationConfig cfg;
+    cfg.type = ContentTranslationType::Json;
+    cfg.selector = "/c";
+    REQUIRE(t.configure(cfg) == StatusCode::Ok);
+    REQUIRE(t.append_body(reinterpret_cast<const std::uint8_t*>(doc.data()), doc.size()) == StatusCode::Ok);
+    REQUIRE(t.finalize() == StatusCode::Ok);
+    CHECK(t.translated_size() == 4); // "-150"
+
+    // Every answer matches a fresh translation of the whole body.
+    for (const char* selector : {"", "/a", "/a/list", "/a/list/0", "/a/list/1/x", "/a/list/2",
+                                 "/a/list/2/1", "/a/str", "/A/STR", "/b", "/b/0", "/b/1", "/c",
+                                 "/a/list/3", "/a/list/1/z", "/c/0", "/zz", "/b/00"}) {
+        CAPTURE(selector);
+        std::string out;
+        bool found = false;
+        REQUIRE(t.query(doc, selector, out, found) == StatusCode::Ok);
+        CHECK(out == translate(doc, selector));
+        const std::string_view sv(selector);
+        const bool missing = sv == "/a/list/3" || sv == "/a/list/1/z" || sv == "/c/0" || sv == "/zz" || sv == "/b/00";
+        CHECK(found == !missing);
+    }
+
+    // The active view is unchanged until reselect().
+    CHECK(t.translated_size() == 4);
+    cfg.selector = "/a/list/1/x";
+    REQUIRE(t.reselect(doc, cfg) == StatusCode::Ok);
+    std::uint8_t buf[8]{};
+    std::uint16_t actual = 0;
+    bool eof = false;
+    REQUIRE(t.read(0, buf, sizeof(buf), actual, eof) == StatusCode::Ok);
+    CHECK(std::string(reinterpret_cast<const char*>(buf), actual) == "y");
+
+    // A malformed body has nothing to query.
+    const std::string broken = "{\"a\":1";
+    cfg.selector = "/a";
+    REQUIRE(t.configure(cfg) == StatusCode::Ok);
+    REQUIRE(t.append_body(reinterpret_cast<const std::uint8_t*>(broken.data()), broken.size()) == StatusCode::Ok);
+    REQUIRE(t.finalize() == StatusCode::Ok);
+    std::string out;
+    bool found = true;
+    CHECK(t.query(broken, "/a", out, found) == StatusCode::Ok);
+    CHECK_FALSE(found);
+    CHECK(out.empty());
+}
+
+TEST_CASE("JsonContentTranslator: query() falls back to a rescan past the index limit")
+{
+    std::string doc = "[";
+    for (int i = 0; i < 1500; ++i) {
+        doc += i ? ",{\"i\":" : "{\"i\":";
+        doc += std::to_string(i) + "}";
+    }
+    doc += "]";
+
+    JsonContentTranslator t;
+    TranslationConfig cfg;
+    cfg.type = ContentTranslationType::Json;
+    cfg.selector = "/0/i";
+    REQUIRE(t.configure(cfg) == StatusCode::Ok);
+    REQUIRE(t.append_body(reinterpret_cast<const std::uint8_t*>(doc.data()), doc.size()) == StatusCode::Ok);
+    REQUIRE(t.finalize() == StatusCode::Ok);
+
+    std::string out;
+    bool found = false;
+    REQUIRE(t.query(doc, "/1499/i", out, found) == StatusCode::Ok);
+    CHECK(found);
+    CHECK(out == "1499");
+    REQUIRE(t.query(doc, "/1500/i", out, found) == StatusCode::Ok);
+    CHECK_FALSE(found);
+}
@@ -0,0 +1,336 @@
+#include "doctest.h"
+
+#include "fujinet/fs/metadata_index.h"
+#include "fujinet/fs/storage_manager.h"
+#include "fake_fs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using fujinet::fs::FileInfo;
+using fujinet::fs::IFile;
+using fujinet::fs::IFileSystem;
+using fujinet::fs::IndexedFileSystem;
+using fujinet::fs::MetadataIndexConfig;
+using fujinet::tests::MemoryFileSystem;
+
+namespace {
+
+// MemoryFileSystem with directory mtimes and call counters, so tests can
+// see which requests reach the "card".
+class CountingFs final : public IFileSystem {
+public:
+    explicit CountingFs(MemoryFileSystem& mem) : _mem(mem) {}
+
+    fujinet::fs::FileSystemKind kind() const override { return _mem.kind(); }
+    std::string name() const override { return _mem.name(); }
+    bool exists(const std::string& p) override { return _mem.exists(p); }
+    bool isDirectory(const std::string& p) override { return _mem.isDirectory(p); }
+    bool createDirectory(const std::string& p) override { return _mem.createDirectory(p); }
+    bool removeFile(const std::string& p) override { return _mem.removeFile(p); }
+    bool removeDirectory(const std::string& p) override { return _mem.removeDirectory(p); }
+    bool rename(const std::string& a, const std::string& b) override { return _mem.rename(a, b); }
+    std::unique_ptr<IFile> open(const std::string& p, const char* m) override { return _mem.open(p, m); }
+
+    bool stat(const std::string& p, FileInfo& out) override
+    {
+        ++stats;
+        if (!_mem.stat(p, out)) return false;
+        auto it = dirMtimes.find(out.path);
+        if (out.isDirectory && it != dirMtimes.end()) {
+            out.modifiedTime = std::chrono::system_clock::time_point{std::chrono::seconds(it->second)};
+        }
+        return true;
+    }
+
+    bool listDirectory(const std::string& p, std::vector<FileInfo>& out) override
+    {
+        ++lists;
+        if (!_mem.listDirectory(p, out)) return false;
+        if (foldersFirst) {
+            // Like tnfsd: directories ahead of files, not sorted by name.
+            std::stable_partition(out.begin(), out.end(), [](const FileInfo& e) { return e.isDirectory; });
+        }
+        return true;
+    }
+
+    std::unordered_map<std::string, std::int64_t> dirMtimes;
+    bool foldersFirst{false};
+    int stats{0};
+    int lists{0};
+
+private:
+    MemoryFileSystem& _mem;
+};
+
+void put_file(MemoryFileSystem& fs, const std::string& path, std::size_t size)
+{
+    REQUIRE(fs.create_file(path, std::vector<std::uint8_t>(size, 0xAA)));
+}
+
+MetadataIndexConfig untrusting()
+{
+    MetadataIndexConfig cfg;
+    cfg.trustWindow = std::chrono::milliseconds(0);
+    return cfg;
+}
+
+} // namespace
+
+TEST_CASE("IndexedFileSystem: repeat listings and stats are served from the index")
+{
+    MemoryFileSystem mem("sd0");
+    REQUIRE(mem.createDirectory("/games"));
+    put_file(mem, "/games/a.atr", 100);
+    put_file(mem, "/games/b.atr", 200);
+
+    auto counting = std::make_unique<CountingFs>(mem);
+    CountingFs& card = *counting;
+    card.dirMtimes["/games"] = 1000000;
+    IndexedFileSystem fs(std::move(counting), untrusting());
+
+    std::vector<FileInfo> entries;
+    REQUIRE(fs.listDirectory("/games", entries));
+    CHECK(entries.size() == 2);
+    CHECK(card.lists == 1);
+
+    // Revalidated with one directory stat, no readdir.
+    const int statsBefore = card.stats;
+    REQUIRE(fs.listDirectory("/games/", entries));
+    CHECK(entries.size() == 2);
+    CHECK(card.lists == 1);
+    CHECK(card.stats == statsBefore + 1);
+
+    // Outside trustWindow a single stat goes to the file, not the record.
+    FileInfo info{};
+    REQUIRE(fs.stat("/games/b.atr", info));
+    CHECK(info.sizeBytes == 200);
+    CHECK(info.path == "/games/b.atr");
+    CHECK(fs.stats().statHits == 0);
+    CHECK(fs.stats().statMisses == 1);
+
+    // Misses always fall through (FAT names are case-insensitive).
+    CHECK_FALSE(fs.stat("/games/missing.atr", info));
+    CHECK(fs.stats().statMisses == 2);
+
+    // Someone changed the directory behind our back: mtime moves, relist.
+    put_file(mem, "/games/c.atr", 300);
+    card.dirMtimes["/games"] = 1000010;
+    REQUIRE(fs.listDirectory("/games", entries));
+    CHECK(entries.size() == 3);
+    CHECK(card.lists == 2);
+    CHECK(fs.stats().staleDirectories == 1);
+}
+
+TEST_CASE("IndexedFileSystem: stat() sees a file rewritten in place")
+{
+    MemoryFileSystem mem("sd0");
+    REQUIRE(mem.createDirectory("/games"));
+    put_file(mem, "/games/a.atr", 100);
+
+    auto counting = std::make_unique<CountingFs>(mem);
+    CountingFs& card = *counting;
+    card.dirMtimes["/games"] = 1000000;
+    IndexedFileSystem fs(std::move(counting), untrusting());
+
+    std::vector<FileInfo> entries;
+    REQUIRE(fs.listDirectory("/games", entries));
+
+    // Overwritten behind our back (cp over it, a PC editing the card): the
+    // directory mtime does not move.
+    put_file(mem, "/games/a.atr", 500);
+    FileInfo info{};
+    REQUIRE(fs.stat("/games/a.atr", info));
+    CHECK(info.sizeBytes == 500);
+    CHECK(info.path == "/games/a.atr");
+
+    // The record was patched, so the revalidated listing agrees.
+    REQUIRE(fs.listDirectory("/games", entries));
+    CHECK(card.lists == 1);
+    REQUIRE(entries.size() == 1);
+    CHECK(entries[0].sizeBytes == 500);
+}
+
+TEST_CASE("IndexedFileSystem: cached listings keep the filesystem's order")
+{
+    MemoryFileSystem mem("tnfs");
+    REQUIRE(mem.createDirectory("/mix"));
+    put_file(mem, "/mix/a.atr", 1);
+    put_file(mem, "/mix/c.atr", 2);
+    REQUIRE(mem.createDirectory("/mix/zz"));
+
+    auto counting = std::make_unique<CountingFs>(mem);
+    CountingFs& server = *counting;
+    server.foldersFirst = true;
+    server.dirMtimes["/mix"] = 1000000;
+    IndexedFileSystem fs(std::move(counting), untrusting());
+
+    std::vector<FileInfo> first;
+    REQUIRE(fs.listDirectory("/mix", first));
+    REQUIRE(first.size() == 3);
+    CHECK(first[0].path == "/mix/zz");
+
+    std::vector<FileInfo> second;
+    REQUIRE(fs.listDirectory("/mix", second));
+    CHECK(server.lists == 1);
+    REQUIRE(second.size() == first.size());
+    for (std::size_t i = 0; i < first.size(); ++i) {
+        CAPTURE(i);
+        CHECK(second[i].path == first[i].path);
+    }
+}
+
+TEST_CASE("IndexedFileSystem: writes through the filesystem update records in place")
+{
+    MemoryFileSystem mem("sd0");
+    REQUIRE(mem.createDirectory("/games"));
+    put_file(mem, "/games/a.atr", 100);
+
+    auto counting = std::make_unique<CountingFs>(mem);
+    CountingFs& card = *counting;
+    card.dirMtimes["/games"] = 1000000;
+    IndexedFileSystem fs(std::move(counting), untrusting());
+
+    std::vector<FileInfo> entries;
+    REQUIRE(fs.listDirectory("/games", entries));
+    REQUIRE(card.lists == 1);
+
+    {
+        auto f = fs.open("/games/new.atr", "wb");
+        REQUIRE(f);
+        card.dirMtimes["/games"] = 1000005; // creating the file touched the directory
+        const std::vector<std::uint8_t> data(512, 0x11);
+        CHECK(f->write(data.data(), data.size()) == data.size());
+    }
+    REQUIRE(fs.rename("/games/a.atr", "/games/renamed.atr"));
+    REQUIRE(fs.createDirectory("/games/sub"));
+
+    REQUIRE(fs.listDirectory("/games", entries));
+    CHECK(card.lists == 1);
+    REQUIRE(entries.size() == 3);
+    CHECK(entries[0].path == "/games/new.atr");
+    CHECK(entries[0].sizeBytes == 512);
+    CHECK(entries[1].path == "/games/renamed.atr");
+    CHECK(entries[2].path == "/games/sub");
+    CHECK(entries[2].isDirectory);
+
+    REQUIRE(fs.removeFile("/games/new.atr"));
+    FileInfo info{};
+    CHECK_FALSE(fs.stat("/games/new.atr", info));
+    REQUIRE(fs.listDirectory("/games", entries));
+    CHECK(entries.size() == 2);
+    CHECK(card.lists == 1);
+}
+
+TEST_CASE("IndexedFileSystem: the index persists across instances and skips open writers")
+{
+    MemoryFileSystem mem("sd0");
+    REQUIRE(mem.createDirectory("/games"));
+    REQUIRE(mem.createDirectory("/demos"));
+    put_file(mem, "/games/a.atr", 100);
+    put_file(mem, "/demos/d.xex", 50);
+
+    MetadataIndexConfig cfg = untrusting();
+    cfg.persist = true;
+
+    {
+        auto counting = std::make_unique<CountingFs>(mem);
+        counting->dirMtimes["/games"] = 1000000;
+        counting->dirMtimes["/demos"] = 1000000;
+        IndexedFileSystem fs(std::move(counting), cfg);
+        std::vector<FileInfo> entries;
+        REQUIRE(fs.listDirectory("/games", entries));
+        REQUIRE(fs.listDirectory("/demos", entries));
+    } // saved on destruction
+    CHECK(mem.exists(cfg.storePath));
+
+    std::unique_ptr<IFile> writer;
+    {
+        auto counting = std::make_unique<CountingFs>(mem);
+        CountingFs& card = *counting;
+        card.dirMtimes["/games"] = 1000000;
+        card.dirMtimes["/demos"] = 1000000;
+        IndexedFileSystem fs(std::move(counting), cfg);
+        CHECK(fs.stats().loads == 1);
+        CHECK(fs.directoryCount() == 2);
+
+        std::vector<FileInfo> entries;
+        REQUIRE(fs.listDirectory("/games", entries));
+        REQUIRE(entries.size() == 1);
+        CHECK(entries[0].path == "/games/a.atr");
+        CHECK(entries[0].sizeBytes == 100);
+        CHECK(card.lists == 0);
+
+        // A disk image open for writing keeps its directory out of the store.
+        writer = fs.open("/demos/d.xex", "r+b");
+        REQUIRE(writer);
+        CHECK(fs.stats().saves == 1);
+    }
+
+    {
+        auto counting = std::make_unique<CountingFs>(mem);
+        counting->dirMtimes["/games"] = 1000000;
+        counting->dirMtimes["/demos"] = 1000000;
+        IndexedFileSystem fs(std::move(counting), cfg);
+        CHECK(fs.directoryCount() == 1);
+    }
+    writer.reset();
+}
+
+TEST_CASE("IndexedFileSystem: changes outside the store wait for saveDelay")
+{
+    MemoryFileSystem mem("sd0");
+    REQUIRE(mem.createDirectory("/games"));
+    put_file(mem, "/games/a.atr", 100);
+
+    MetadataIndexConfig cfg = untrusting();
+    cfg.persist = true;
+    cfg.saveDelay = std::chrono::hours(1);
+
+    auto counting = std::make_unique<CountingFs>(mem);
+    CountingFs& card = *counting;
+    card.dirMtimes["/games"] = 1000000;
+    IndexedFileSystem fs(std::move(counting), cfg);
+
+    std::vector<FileInfo> entries;
+    REQUIRE(fs.listDirectory("/games", entries));
+    {
+        auto f = fs.open("/games/new.atr", "wb");
+        REQUIRE(f);
+    }
+    REQUIRE(fs.rename("/games/new.atr", "/games/other.atr"));
+    REQUIRE(fs.removeFile("/games/other.atr"));
+    REQUIRE(fs.createDirectory("/scratch"));
+    CHECK(fs.stats().saves == 0);
+
+    REQUIRE(fs.save());
+    CHECK(fs.stats().saves == 1);
+}
+
+TEST_CASE("StorageManager: registers a filesystem behind a metadata index")
+{
+    auto mem = std::make_unique<MemoryFileSystem>("sd0");
+    REQUIRE(mem->createDirectory("/games"));
+
+    fujinet::fs::StorageManager sm;
+    REQUIRE(sm.registerFileSystem(std::move(mem), MetadataIndexConfig{}));
+    CHECK_FALSE(sm.registerFileSystem(std::make_unique<MemoryFileSystem>("sd0"), MetadataIndexConfig{}));
+
+    IndexedFileSystem* index = sm.metadataIndex("sd0");
+    REQUIRE(index != nullptr);
+    CHECK(sm.get("sd0") == index);
+    CHECK(index->name() == "sd0");
+
+    std::vector<FileInfo> entries;
+    REQUIRE(sm.get("sd0")->listDirectory("/", entries));
+    CHECK(index->directoryCount() == 1);
+    index->invalidate("/games");
+    CHECK(index->directoryCount() == 0);
+
+    CHECK(sm.unregisterFileSystem("sd0"));
+    CHECK(sm.metadataIndex("sd0") == nullptr);
+}
@@ -3,6 +3,10 @@
 #include "doctest.h"
 #include "net_device_test_helpers.h"
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
 using namespace fujinet::tests::netdev;
 
 TEST_CASE("NetworkDevice v1: Open -> Info -> Read -> Close (stub backend)")
@@ -609,6 +613,118 @@ TEST_CASE("HTTP body lifecycle: Info/Read are NotReady until POST body fully wri
     CHECK(close_req(dev, deviceId, h).status == StatusCode::Ok);
 }
 
+TEST_CASE("Deferred completion: deferrable Read parks until the POST body is written")
+{
+    auto reg = make_stub_registry_http_only();
+    NetworkDevice dev(std::move(reg));
+    const auto deviceId = to_device_id(WireDeviceId::NetworkService);
+
+    const std::uint16_t h = open_handle_stub(dev, deviceId, "http://example.com/post", /*method=*/2, /*flags=*/0, /*bodyLenHint=*/2);
+
+    std::string rp;
+    netproto::write_u8(rp, V);
+    netproto::write_u16le(rp, h);
+    netproto::write_u32le(rp, 0);
+    netproto::write_u16le(rp, 128);
+
+    IORequest rreq{};
+    rreq.id = 301;
+    rreq.deviceId = deviceId;
+    rreq.command = 0x02; // Read
+    rreq.payload = to_vec(rp);
+
+    // Host that cannot wait still sees NotReady.
+    CHECK(dev.handle(rreq).status == StatusCode::NotReady);
+
+    rreq.deferrable = true;
+    CHECK(dev.handle(rreq).status == StatusCode::Pending);
+
+    IOResponse done{};
+    dev.poll();
+    CHECK_FALSE(dev.take_completed(done));
+
+    CHECK(write_req(dev, deviceId, h, 0, "AB").status == StatusCode::Ok);
+    dev.poll();
+
+    REQUIRE(dev.take_completed(done));
+    CHECK(done.id == 301);
+    CHECK(done.status == StatusCode::Ok);
+    CHECK_FALSE(done.payload.empty());
+    CHECK_FALSE(dev.take_completed(done));
+
+    CHECK(close_req(dev, deviceId, h).status == StatusCode::Ok);
+}
+
+TEST_CASE("Deferred completion: parked request times out with NotReady")
+{
+    auto reg = make_stub_registry_http_only();
+    NetworkDevice dev(std::move(reg));
+    dev.set_deferred_timeout(std::chrono::milliseconds(20));
+    const auto deviceId = to_device_id(WireDeviceId::NetworkService);
+
+    const std::uint16_t h = open_handle_stub(dev, deviceId, "http://example.com/post", /*method=*/2, /*flags=*/0, /*bodyLenHint=*/2);
+
+    std::string ip;
+    netproto::write_u8(ip, V);
+    netproto::write_u16le(ip, h);
+
+    IORequest ireq{};
+    ireq.id = 201;
+    ireq.deviceId = deviceId;
+    ireq.command = 0x05; // Info
+    ireq.payload = to_vec(ip);
+    ireq.deferrable = true;
+    REQUIRE(dev.handle(ireq).status == StatusCode::Pending);
+
+    // The parked request asks the loop to wake by its deadline.
+    fujinet::io::WaitSet ws;
+    dev.add_wait_sources(ws);
+    CHECK(ws.timeout(std::chrono::milliseconds(1000)) <= std::chrono::milliseconds(20));
+
+    dev.poll();
+    IOResponse done{};
+    CHECK_FALSE(dev.take_completed(done));
+
+    int ticks = 0;
+    while (!dev.take_completed(done) && ticks < 200) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        dev.poll();
+        ++ticks;
+    }
+    CHECK(ticks < 200);
+    CHECK(done.id == 201);
+    CHECK(done.status == StatusCode::NotReady);
+}
+
+TEST_CASE("Session reaping: idle and stalled-upload sessions expire on wall-clock time")
+{
+    auto reg = make_stub_registry_http_only();
+    NetworkDevice dev(std::move(reg));
+    dev.set_session_timeouts(std::chrono::milliseconds(300), std::chrono::milliseconds(20));
+    const auto deviceId = to_device_id(WireDeviceId::NetworkService);
+
+    const std::uint16_t get = open_handle_stub(dev, deviceId, "http://example.com/get", 1, 0, 0);
+    const std::uint16_t post = open_handle_stub(dev, deviceId, "http://example.com/post", /*method=*/2, /*flags=*/0, /*bodyLenHint=*/2);
+    REQUIRE(get != 0);
+    REQUIRE(post != 0);
+
+    // The loop is asked to wake when the stalled upload is due, however
+    // rarely poll() would otherwise run.
+    fujinet::io::WaitSet ws;
+    dev.add_wait_sources(ws);
+    CHECK(ws.timeout(std::chrono::milliseconds(1000)) <= std::chrono::milliseconds(20));
+
+    // One poll() after the deadline is enough.
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    dev.poll();
+    CHECK(info_req(dev, deviceId, post).status == StatusCode::InvalidRequest);
+    CHECK(info_req(dev, deviceId, get).status == StatusCode::Ok);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(320));
+    dev.poll();
+    CHECK(info_req(dev, deviceId, get).status == StatusCode::InvalidRequest);
+}
+
 TEST_CASE("HTTP body lifecycle: non-sequential Write offset => InvalidRequest")
 {
     auto reg = make_stub_registry_http_only();
@@ -865,6 +981,277 @@ TEST_CASE("NetworkDevice v1: JSON array elements can be fetched by indexed path"
     CHECK(close_req(dev, deviceId, handle).status == StatusCode::Ok);
 }
 
+TEST_CASE("NetworkDevice v1: TranslateQuery returns several JSON values in one response")
+{
+    auto reg = make_stub_registry_http_only();
+    NetworkDevice dev(std::move(reg));
+    const auto deviceId = to_device_id(WireDeviceId::NetworkService);
+
+    const std::uint16_t handle = open_handle_stub(
+        dev, deviceId, "http://example.com/json", 1, 0, 0, {},
+        fujinet::io::ContentTranslationType::Json, "/url");
+
+    auto query = [&](std::uint16_t maxBytes, std::initializer_list<std::string_view> selectors) {
+        std::string qp;
+        netproto::write_u8(qp, V);
+        netproto::write_u16le(qp, handle);
+        netproto::write_u16le(qp, maxBytes);
+        netproto::write_u8(qp, static_cast<std::uint8_t>(selectors.size()));
+        for (auto sel : selectors) {
+            netproto::write_lp_u16_string(qp, sel);
+        }
+
+        IORequest qreq{};
+        qreq.id = 970;
+        qreq.deviceId = deviceId;
+        qreq.command = 0x08; // TranslateQuery
+        qreq.payload = to_vec(qp);
+        return dev.handle(qreq);
+    };
+
+    IOResponse resp = query(256, {"/headers/Host", "/missing", "/url"});
+    REQUIRE(resp.status == StatusCode::Ok);
+
+    netproto::Reader r(resp.payload.data(), resp.payload.size());
+    std::uint8_t ver = 0, flags = 0, count = 0;
+    std::uint16_t reserved = 0, h = 0;
+    REQUIRE(r.read_u8(ver));
+    REQUIRE(r.read_u8(flags));
+    REQUIRE(r.read_u16le(reserved));
+    REQUIRE(r.read_u16le(h));
+    REQUIRE(r.read_u8(count));
+    CHECK(h == handle);
+    REQUIRE(count == 3);
+
+    auto entry = [&r](std::uint8_t& eflags) {
+        std::uint16_t len = 0;
+        const std::uint8_t* ptr = nullptr;
+        REQUIRE(r.read_u8(eflags));
+        REQUIRE(r.read_u16le(len));
+        REQUIRE(r.read_bytes(ptr, len));
+        return std::string(reinterpret_cast<const char*>(ptr), len);
+    };
+
+    std::uint8_t eflags = 0;
+    CHECK(entry(eflags) == "example.com");
+    CHECK(eflags == 0x01);
+    CHECK(entry(eflags).empty());
+    CHECK(eflags == 0x00);
+    CHECK(entry(eflags) == "http://example.com/json");
+    CHECK(eflags == 0x01);
+    CHECK(r.remaining() == 0);
+
+    // The open-time view is untouched.
+    IOResponse rresp = read_req(dev, deviceId, handle, 0, 128);
+    REQUIRE(rresp.status == StatusCode::Ok);
+    CHECK(rresp.payload.size() == 12 + std::string("http://example.com/json").size());
+
+    // Values share the byte budget in order; the rest is cut short.
+    resp = query(5, {"/headers/Host", "/url"});
+    REQUIRE(resp.status == StatusCode::Ok);
+    r = netproto::Reader(resp.payload.data(), resp.payload.size());
+    REQUIRE(r.read_u8(ver));
+    REQUIRE(r.read_u8(flags));
+    REQUIRE(r.read_u16le(reserved));
+    REQUIRE(r.read_u16le(h));
+    REQUIRE(r.read_u8(count));
+    CHECK(entry(eflags) == "examp");
+    CHECK(eflags == 0x03);
+    CHECK(entry(eflags).empty());
+    CHECK(eflags == 0x03);
+
+    CHECK(query(16, {}).status == StatusCode::InvalidRequest);
+    CHECK(close_req(dev, deviceId, handle).status == StatusCode::Ok);
+
+    // Only handles with a translated view can be queried.
+    const std::uint16_t raw = open_handle_stub(dev, deviceId, "http://example.com/json");
+    std::string qp;
+    netproto::write_u8(qp, V);
+    netproto::write_u16le(qp, raw);
+    netproto::write_u16le(qp, 64);
+    netproto::write_u8(qp, 1);
+    netproto::write_lp_u16_string(qp, "/url");
+    IORequest qreq{};
+    qreq.deviceId = deviceId;
+    qreq.command = 0x08;
+    qreq.payload = to_vec(qp);
+    CHECK(dev.handle(qreq).status == StatusCode::InvalidRequest);
+}
+
+namespace {
+
+// A large JSON response that arrives a little at a time: every other
+// read_body() call finds nothing new, like a slow server.
+std::string large_json_body()
+{
+    std::string body = "{\"filler\":[";
+    for (int i = 0; i < 4000; ++i) {
+        body += i ? ",\"0123456789\"" : "\"0123456789\"";
+    }
+    body += "],\"wanted\":\"found it\"}";
+    return body;
+}
+
+// Serves `body` in pieces of at most 1000 bytes, with an empty read between.
+class TrickleProtocol final : public fujinet::io::INetworkProtocol {
+public:
+    TrickleProtocol(std::size_t& maxRead, std::string body) : _body(std::move(body)), _maxRead(maxRead) {}
+
+    StatusCode open(const fujinet::io::NetworkOpenRequest&) override { return StatusCode::Ok; }
+
+    StatusCode write_body(std::uint32_t, const std::uint8_t*, std::size_t, std::uint16_t& written) override
+    {
+        written = 0;
+        return StatusCode::Unsupported;
+    }
+
+    StatusCode read_body(std::uint32_t offset,
+                         std::uint8_t* out,
+                         std::size_t outLen,
+                         std::uint16_t& read,
+                         bool& eof,
+                         bool& more_available) override
+    {
+        read = 0;
+        more_available = false;
+        eof = offset >= _body.size();
+        if ((_calls++ % 2) == 0 || eof) {
+            return StatusCode::Ok;
+        }
+        const std::size_t n = std::min<std::size_t>({outLen, 1000, _body.size() - offset});
+        std::copy_n(_body.data() + offset, n, out);
+        read = static_cast<std::uint16_t>(n);
+        _maxRead = std::max(_maxRead, n);
+        eof = offset + n >= _body.size();
+        return StatusCode::Ok;
+    }
+
+    StatusCode info(fujinet::io::NetworkInfo& out) override
+    {
+        out = fujinet::io::NetworkInfo{};
+        out.hasHttpStatus = true;
+        out.httpStatus = 200;
+        return StatusCode::Ok;
+    }
+
+    void poll() override {}
+    void close() override {}
+
+private:
+    std::string _body;
+    std::size_t _calls{0};
+    std::size_t& _maxRead;
+};
+
+} // namespace
+
+TEST_CASE("NetworkDevice v1: JSON translation streams a large body")
+{
+    std::size_t maxRead = 0;
+    fujinet::io::ProtocolRegistry reg;
+    reg.register_scheme("http", [&maxRead] { return std::make_unique<TrickleProtocol>(maxRead, large_json_body()); });
+    NetworkDevice dev(std::move(reg));
+    const auto deviceId = to_device_id(WireDeviceId::NetworkService);
+
+    const std::uint16_t handle = open_handle_stub(
+        dev, deviceId, "http://example.com/feed", 1, 0, 0, {},
+        fujinet::io::ContentTranslationType::Json, "/wanted");
+
+    // Each attempt translates what has arrived so far and then reports NotReady.
+    int attempts = 0;
+    IOResponse iresp = info_req(dev, deviceId, handle);
+    while (iresp.status == StatusCode::NotReady && attempts < 1000) {
+        iresp = info_req(dev, deviceId, handle);
+        ++attempts;
+    }
+    REQUIRE(iresp.status == StatusCode::Ok);
+    CHECK(attempts > 40);
+    CHECK(maxRead == 1000);
+
+    IOResponse rresp = read_req(dev, deviceId, handle, 0, 128);
+    REQUIRE(rresp.status == StatusCode::Ok);
+    netproto::Reader rr(rresp.payload.data(), rresp.payload.size());
+    std::uint8_t rver = 0, rflags = 0;
+    std::uint16_t rres = 0, rhandle = 0, dataLen = 0;
+    std::uint32_t offEcho = 0;
+    REQUIRE(rr.read_u8(rver));
+    REQUIRE(rr.read_u8(rflags));
+    REQUIRE(rr.read_u16le(rres));
+    REQUIRE(rr.read_u16le(rhandle));
+    REQUIRE(rr.read_u32le(offEcho));
+    REQUIRE(rr.read_u16le(dataLen));
+    const std::uint8_t* dataPtr = nullptr;
+    REQUIRE(rr.read_bytes(dataPtr, dataLen));
+    CHECK(std::string(reinterpret_cast<const char*>(dataPtr), dataLen) == "found it");
+
+    // Too large to retain, so a second selector has nothing to run over.
+    std::string qp;
+    netproto::write_u8(qp, V);
+    netproto::write_u16le(qp, handle);
+    netproto::write_u8(qp, 1); // translationType=Json
+    netproto::write_u8(qp, 0); // translationFlags
+    netproto::write_lp_u16_string(qp, "/filler/0");
+
+    IORequest qreq{};
+    qreq.id = 960;
+    qreq.deviceId = deviceId;
+    qreq.command = 0x07;
+    qreq.payload = to_vec(qp);
+    CHECK(dev.handle(qreq).status == StatusCode::Unsupported);
+
+    CHECK(close_req(dev, deviceId, handle).status == StatusCode::Ok);
+}
+
+TEST_CASE("NetworkDevice v1: RSS translation flattens feed items")
+{
+    std::string feed = "<?xml version=\"1.0\"?><rss version=\"2.0\"><channel><title>News</title>";
+    for (int i = 0; i < 200; ++i) {
+        const std::string n = std::to_string(i);
+        feed += "<item><title>Story " + n + "</title><link>http://n/" + n + "</link>"
+                "<description>" + std::string(100, 'x') + "</description>"
+                "<pubDate>Day " + n + "</pubDate></item>";
+    }
+    feed += "</channel></rss>";
+
+    std::size_t maxRead = 0;
+    fujinet::io::ProtocolRegistry reg;
+    reg.register_scheme("http", [&maxRead, feed] { return std::make_unique<TrickleProtocol>(maxRead, feed); });
+    NetworkDevice dev(std::move(reg));
+    const auto deviceId = to_device_id(WireDeviceId::NetworkService);
+
+    const std::uint16_t handle = open_handle_stub(
+        dev, deviceId, "http://example.com/rss", 1, 0, 0, {},
+        fujinet::io::ContentTranslationType::Rss, "2");
+
+    int attempts = 0;
+    IOResponse iresp = info_req(dev, deviceId, handle);
+    while (iresp.status == StatusCode::NotReady && attempts < 1000) {
+        iresp = info_req(dev, deviceId, handle);
+        ++attempts;
+    }
+    REQUIRE(iresp.status == StatusCode::Ok);
+
+    IOResponse rresp = read_req(dev, deviceId, handle, 0, 128);
+    REQUIRE(rresp.status == StatusCode::Ok);
+    netproto::Reader rr(rresp.payload.data(), rresp.payload.size());
+    std::uint8_t rver = 0, rflags = 0;
+    std::uint16_t rres = 0, rhandle = 0, dataLen = 0;
+    std::uint32_t offEcho = 0;
+    REQUIRE(rr.read_u8(rver));
+    REQUIRE(rr.read_u8(rflags));
+    REQUIRE(rr.read_u16le(rres));
+    REQUIRE(rr.read_u16le(rhandle));
+    REQUIRE(rr.read_u32le(offEcho));
+    REQUIRE(rr.read_u16le(dataLen));
+    const std::uint8_t* dataPtr = nullptr;
+    REQUIRE(rr.read_bytes(dataPtr, dataLen));
+    CHECK(std::string(reinterpret_cast<const char*>(dataPtr), dataLen) ==
+          "Story 0\nhttp://n/0\nDay 0\nStory 1\nhttp://n/1\nDay 1\n");
+    CHECK((rflags & 0x01) != 0);
+
+    CHECK(close_req(dev, deviceId, handle).status == StatusCode::Ok);
+}
+
 TEST_CASE("NetworkDevice v1: Open content profile injects request Content-Type")
 {
     fujinet::io::StubNetworkProtocol* lastStub = nullptr;
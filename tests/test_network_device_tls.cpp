@@ -6,9 +6,15 @@
 #include "fujinet/platform/posix/tls_network_protocol_posix.h"
 #include "fujinet/io/devices/network_protocol.h"
 
+#include <chrono>
 #include <cstring>
 #include <string>
 
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
 namespace fujinet::tests {
 
 // ------------------------
@@ -125,6 +131,56 @@ TEST_CASE("TLS: close is safe to call multiple times")
     proto.close();  // Second close should also be safe
 }
 
+TEST_CASE("TLS: open returns before the handshake and poll() carries it on")
+{
+    // A loopback listener that accepts but never speaks TLS.
+    const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE(listener >= 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    REQUIRE(::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    REQUIRE(::listen(listener, 1) == 0);
+    socklen_t len = sizeof(addr);
+    REQUIRE(::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &len) == 0);
+
+    platform::posix::TlsNetworkProtocolPosix proto;
+    io::NetworkOpenRequest req;
+    req.url = "tls://127.0.0.1:" + std::to_string(ntohs(addr.sin_port));
+
+    const auto start = std::chrono::steady_clock::now();
+    REQUIRE(proto.open(req) == io::StatusCode::Ok);
+    proto.poll();
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+
+    std::uint8_t buf[16];
+    std::uint16_t read = 0;
+    bool eof = false;
+    bool more = false;
+    CHECK(proto.read_body(0, buf, sizeof(buf), read, eof, more) == io::StatusCode::NotReady);
+    std::uint16_t written = 0;
+    CHECK(proto.write_body(0, buf, 4, written) == io::StatusCode::NotReady);
+
+    // The handshake waits for the server's reply; the loop may sleep on it.
+    io::WaitSet ws;
+    proto.add_wait_sources(ws);
+    CHECK(ws.entries().size() == 1);
+    CHECK(ws.timeout(std::chrono::milliseconds(60000)) <= std::chrono::seconds(10));
+
+    // The server hangs up: the handshake fails without blocking.
+    const int peer = ::accept(listener, nullptr, nullptr);
+    REQUIRE(peer >= 0);
+    ::close(peer);
+    for (int i = 0; i < 100 && proto.read_body(0, buf, sizeof(buf), read, eof, more) == io::StatusCode::NotReady; ++i) {
+        ::usleep(1000);
+        proto.poll();
+    }
+    CHECK(proto.read_body(0, buf, sizeof(buf), read, eof, more) == io::StatusCode::IOError);
+
+    proto.close();
+    ::close(listener);
+}
+
 } // namespace fujinet::tests
 
 #else // !FN_PLATFORM_POSIX || !FN_WITH_OPENSSL
@@ -0,0 +1,130 @@
+#include "doctest.h"
+
+#include "fujinet/io/core/wait_set.h"
+
+#if defined(FN_PLATFORM_POSIX) && !defined(_WIN32)
+
+#include "fujinet/platform/posix/poll_reactor.h"
+
+#include <chrono>
+#include <cstdint>
+#include <unistd.h>
+
+using namespace std::chrono_literals;
+using fujinet::io::WaitSet;
+using fujinet::platform::posix::PollReactor;
+
+namespace {
+
+struct Pipe {
+    int r{-1};
+    int w{-1};
+    Pipe()
+    {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        r = fds[0];
+        w = fds[1];
+    }
+    ~Pipe()
+    {
+        if (r >= 0) ::close(r);
+        if (w >= 0) ::close(w);
+    }
+};
+
+} // namespace
+
+TEST_CASE("WaitSet: merges duplicate fds and ignores invalid ones")
+{
+    WaitSet ws;
+    ws.add_readable(5);
+    ws.add_writable(5);
+    ws.add_readable(-1);
+    ws.add_readable(7);
+
+    REQUIRE(ws.entries().size() == 2);
+    CHECK(ws.entries()[0].fd == 5);
+    CHECK(ws.entries()[0].readable);
+    CHECK(ws.entries()[0].writable);
+    CHECK(ws.entries()[1].fd == 7);
+    CHECK_FALSE(ws.entries()[1].writable);
+
+    ws.clear();
+    CHECK(ws.entries().empty());
+}
+
+TEST_CASE("WaitSet: timeout is the earliest deadline, capped by the idle heartbeat")
+{
+    WaitSet ws;
+    CHECK(ws.timeout(50ms) == 50ms);
+
+    ws.limit_timeout(30ms);
+    ws.limit_timeout(200ms);
+    CHECK(ws.timeout(50ms) == 30ms);
+    CHECK(ws.timeout(10ms) == 10ms);
+
+    ws.limit_timeout(-5ms);
+    CHECK(ws.timeout(50ms) == 0ms);
+
+    ws.clear();
+    ws.wake_now();
+    CHECK(ws.timeout(50ms) == 0ms);
+}
+
+TEST_CASE("PollReactor: sleeps out the timeout when nothing is ready")
+{
+    Pipe p;
+    WaitSet ws;
+    ws.add_readable(p.r);
+
+    PollReactor reactor;
+    const auto start = std::chrono::steady_clock::now();
+    CHECK_FALSE(reactor.wait(ws, 20ms));
+    CHECK(std::chrono::steady_clock::now() - start >= 15ms);
+}
+
+TEST_CASE("PollReactor: returns as soon as a registered fd is readable")
+{
+    Pipe p;
+    const std::uint8_t b = 0x42;
+    REQUIRE(::write(p.w, &b, 1) == 1);
+
+    WaitSet ws;
+    ws.add_readable(p.r);
+
+    PollReactor reactor;
+    const auto start = std::chrono::steady_clock::now();
+    CHECK(reactor.wait(ws, 5000ms));
+    CHECK(std::chrono::steady_clock::now() - start < 1000ms);
+}
+
+TEST_CASE("PollReactor: a source deadline shortens the wait")
+{
+    WaitSet ws;
+    ws.limit_timeout(0ms);
+
+    PollReactor reactor;
+    const auto start = std::chrono::steady_clock::now();
+    CHECK_FALSE(reactor.wait(ws, 5000ms));
+    CHECK(std::chrono::steady_clock::now() - start < 1000ms);
+}
+
+#if defined(__linux__)
+TEST_CASE("PollReactor: hangup-only fds do not count as ready")
+{
+    Pipe p;
+    ::close(p.w);
+    p.w = -1;
+
+    WaitSet ws;
+    ws.add_readable(p.r);
+
+    PollReactor reactor;
+    const auto start = std::chrono::steady_clock::now();
+    CHECK_FALSE(reactor.wait(ws, 20ms));
+    CHECK(std::chrono::steady_clock::now() - start >= 15ms);
+}
+#endif
+
+#endif
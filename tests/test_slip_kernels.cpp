@@ -0,0 +1,122 @@
+#include "doctest.h"
+
+#include "fujinet/io/protocol/fuji_bus_frame_decoder.h"
+#include "fujinet/io/protocol/fuji_bus_frame_encoder.h"
+#include "fujinet/io/protocol/fuji_bus_packet.h"
+#include "fujinet/io/protocol/slip_kernels.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace fujinet::io::protocol;
+
+namespace {
+
+constexpr SlipKernel kAllKernels[] = {
+    SlipKernel::Scalar, SlipKernel::Sse2, SlipKernel::Avx2, SlipKernel::Neon,
+};
+
+ByteBuffer random_bytes(std::size_t n, unsigned specialEvery, std::uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    ByteBuffer out(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        std::uint8_t b = static_cast<std::uint8_t>(rng());
+        if (b == 0xC0 || b == 0xDB) {
+            b = 0x00;
+        }
+        if (specialEvery != 0 && rng() % specialEvery == 0) {
+            b = (rng() & 1) ? 0xC0 : 0xDB;
+        }
+        out[i] = b;
+    }
+    return out;
+}
+
+std::uint16_t bytewise_checksum(std::uint16_t chk, const ByteBuffer& buf, std::size_t off, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        chk = checksum_step(chk, buf[off + i]);
+    }
+    return chk;
+}
+
+// Restore the startup kernel when a test overrides it.
+struct KernelGuard {
+    SlipKernel saved = active_slip_kernel();
+    ~KernelGuard() { set_slip_kernel(saved); }
+};
+
+} // namespace
+
+TEST_CASE("slip kernels: scalar is always available and an active kernel is selected")
+{
+    CHECK(slip_kernel_available(SlipKernel::Scalar));
+    CHECK(slip_kernel_available(active_slip_kernel()));
+}
+
+TEST_CASE("slip kernels: find_slip_special agrees with scalar on every offset/length")
+{
+    const ByteBuffer data = random_bytes(200, 23, 1234);
+    const std::uint8_t* base = data.data();
+
+    for (SlipKernel k : kAllKernels) {
+        if (!slip_kernel_available(k)) {
+            continue;
+        }
+        CAPTURE(to_string(k));
+        for (std::size_t off = 0; off < 40; ++off) {
+            for (std::size_t len = 0; off + len <= data.size(); len += 7) {
+                const auto* want = find_slip_special(SlipKernel::Scalar, base + off, base + off + len);
+                const auto* got  = find_slip_special(k, base + off, base + off + len);
+                REQUIRE(got == want);
+            }
+        }
+    }
+}
+
+TEST_CASE("slip kernels: wide checksum matches the byte-at-a-time fold")
+{
+    const ByteBuffer data = random_bytes(5000, 0, 99);
+    const ByteBuffer zeros(100, 0);
+    const ByteBuffer ones(300, 0xFF);
+
+    for (SlipKernel k : kAllKernels) {
+        if (!slip_kernel_available(k)) {
+            continue;
+        }
+        CAPTURE(to_string(k));
+        for (std::uint16_t seed : {std::uint16_t{0}, std::uint16_t{1}, std::uint16_t{0x80}, std::uint16_t{0xFF}}) {
+            for (std::size_t len : {0u, 1u, 15u, 16u, 17u, 31u, 32u, 33u, 255u, 4097u, 5000u}) {
+                REQUIRE(checksum_update(k, seed, data.data(), len) == bytewise_checksum(seed, data, 0, len));
+            }
+            REQUIRE(checksum_update(k, seed, zeros.data(), zeros.size()) == bytewise_checksum(seed, zeros, 0, zeros.size()));
+            REQUIRE(checksum_update(k, seed, ones.data(), ones.size()) == bytewise_checksum(seed, ones, 0, ones.size()));
+        }
+    }
+}
+
+TEST_CASE("slip kernels: encode/decode round-trip under every available kernel")
+{
+    KernelGuard guard;
+    const ByteBuffer payload = random_bytes(3000, 50, 7);
+    const PacketParam status{std::uint8_t{0}};
+
+    for (SlipKernel k : kAllKernels) {
+        if (!set_slip_kernel(k)) {
+            continue;
+        }
+        CAPTURE(to_string(k));
+
+        ByteBuffer wire;
+        REQUIRE(encode_frame(wire, static_cast<WireDeviceId>(0x70), 3, &status, 1,
+                             payload.data(), payload.size()));
+
+        FujiBusFrameDecoder dec;
+        dec.feed(wire.data(), wire.size());
+        FujiBusFrame frame;
+        REQUIRE(dec.next(frame));
+        CHECK(frame.payload == payload);
+    }
+}
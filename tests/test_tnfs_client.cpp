@@ -0,0 +1,548 @@
+#include "doctest.h"
+
+#include "fujinet/core/utils.h"
+#include "fujinet/io/core/channel.h"
+#include "fujinet/tnfs/tnfs_client_common.h"
+#include "fujinet/tnfs/tnfs_protocol.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fujinet::tnfs;
+
+namespace {
+
+// In-memory TNFS server speaking over a datagram-style Channel: each write()
+// is one request, each read() returns one reply. Serves a single file and
+// can drop or reorder READ replies, plus one flat directory "/dir" listable
+// with OPENDIRX/READDIRX or (legacyDir) only OPENDIR/READDIR/STAT.
+struct FakeTnfsServer {
+    struct Entry {
+        std::string name;
+        bool isDir;
+        std::uint32_t size;
+        std::uint32_t mtime;
+    };
+
+    std::vector<std::uint8_t> file;
+    std::uint32_t filePos{0};
+
+    std::vector<Entry> dir;
+    std::size_t dirCursor{0};
+    bool legacyDir{false};
+    int dirRequests{0}; // every request touching the listing (incl. STAT)
+
+    std::deque<std::vector<std::uint8_t>> replies;
+    std::deque<bool> replyIsRead;
+
+    int readRequests{0};
+    int lseekRequests{0};
+    int readsInFlight{0};
+    int maxReadsInFlight{0};
+
+    int processedReads{0};
+    int dropReadReply{-1}; // 1-based READ number whose reply is lost
+    int reorderRead{-1};   // READ number processed after the one following it
+    std::vector<std::uint8_t> heldRead;
+
+    // A slow server: replies are held back until release().
+    bool hold{false};
+    std::deque<std::vector<std::uint8_t>> heldReplies;
+
+    void release()
+    {
+        hold = false;
+        for (auto& r : heldReplies) {
+            replies.push_back(std::move(r));
+            replyIsRead.push_back(false);
+        }
+        heldReplies.clear();
+    }
+
+    static void put_u32(std::vector<std::uint8_t>& r, std::uint32_t v)
+    {
+        for (int i = 0; i < 4; ++i) r.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+    }
+
+    const Entry* find_entry(const std::string& path) const
+    {
+        for (const auto& e : dir) {
+            if (path == "/dir/" + e.name) return &e;
+        }
+        return nullptr;
+    }
+
+    void handle(const std::uint8_t* p, std::size_t len)
+    {
+        REQUIRE(len >= 4);
+        const std::uint8_t cmd = p[3];
+        if (cmd == CMD_READ) {
+            ++readRequests;
+            ++readsInFlight;
+            maxReadsInFlight = std::max(maxReadsInFlight, readsInFlight);
+            if (readRequests == reorderRead) {
+                heldRead.assign(p, p + len);
+                return;
+            }
+            process(p, len);
+            if (!heldRead.empty()) {
+                std::vector<std::uint8_t> held;
+                held.swap(heldRead);
+                process(held.data(), held.size());
+            }
+            return;
+        }
+        process(p, len);
+    }
+
+    void process(const std::uint8_t* p, std::size_t len)
+    {
+        const std::uint8_t cmd = p[3];
+        std::vector<std::uint8_t> r{0x34, 0x12, p[2], cmd};
+
+        switch (cmd) {
+        case CMD_MOUNT:
+            r.push_back(RESULT_SUCCESS);
+            r.push_back(0x00); // version
+            r.push_back(0x01);
+            break;
+        case CMD_OPEN:
+            r.push_back(RESULT_SUCCESS);
+            r.push_back(3); // handle
+            filePos = 0;
+            break;
+        case CMD_READ: {
+            const std::size_t want = static_cast<std::size_t>(p[5]) | (static_cast<std::size_t>(p[6]) << 8);
+            if (filePos >= file.size()) {
+                r.push_back(RESULT_END_OF_FILE);
+            } else {
+                const std::size_t n = std::min<std::size_t>(want, file.size() - filePos);
+                r.push_back(RESULT_SUCCESS);
+                r.push_back(static_cast<std::uint8_t>(n & 0xFF));
+                r.push_back(static_cast<std::uint8_t>(n >> 8));
+                r.insert(r.end(), file.begin() + filePos, file.begin() + filePos + n);
+                filePos += static_cast<std::uint32_t>(n);
+            }
+            break;
+        }
+        case CMD_WRITE: {
+            const std::size_t n = static_cast<std::size_t>(p[5]) | (static_cast<std::size_t>(p[6]) << 8);
+            REQUIRE(len >= 7 + n);
+            if (file.size() < filePos + n) file.resize(filePos + n);
+            std::memcpy(file.data() + filePos, p + 7, n);
+            filePos += static_cast<std::uint32_t>(n);
+            r.push_back(RESULT_SUCCESS);
+            r.push_back(static_cast<std::uint8_t>(n & 0xFF));
+            r.push_back(static_cast<std::uint8_t>(n >> 8));
+            break;
+        }
+        case CMD_LSEEK: {
+            ++lseekRequests;
+            const std::uint32_t off = static_cast<std::uint32_t>(p[6]) | (static_cast<std::uint32_t>(p[7]) << 8) |
+                                      (static_cast<std::uint32_t>(p[8]) << 16) | (static_cast<std::uint32_t>(p[9]) << 24);
+            if (p[5] == 0) filePos = off;
+            r.push_back(RESULT_SUCCESS);
+            for (int i = 0; i < 4; ++i) r.push_back(static_cast<std::uint8_t>(filePos >> (8 * i)));
+            break;
+        }
+        case CMD_OPENDIRX: {
+            ++dirRequests;
+            const char* pat = reinterpret_cast<const char*>(p + 8);
+            const std::string path(pat + std::strlen(pat) + 1);
+            if (legacyDir) {
+                r.push_back(RESULT_FUNCTION_UNIMPLEMENTED);
+            } else if (path != "/dir") {
+                r.push_back(RESULT_NOT_A_DIRECTORY);
+            } else {
+                dirCursor = 0;
+                r.push_back(RESULT_SUCCESS);
+                r.push_back(7); // handle
+                r.push_back(static_cast<std::uint8_t>(dir.size() & 0xFF));
+                r.push_back(static_cast<std::uint8_t>(dir.size() >> 8));
+            }
+            break;
+        }
+        case CMD_READDIRX: {
+            ++dirRequests;
+            if (dirCursor >= dir.size()) {
+                r.push_back(RESULT_END_OF_FILE);
+                break;
+            }
+            std::vector<std::uint8_t> body;
+            std::uint8_t count = 0;
+            const std::size_t first = dirCursor;
+            while (dirCursor < dir.size() && count < 255) {
+                const Entry& e = dir[dirCursor];
+                if (4 + 5 + body.size() + 13 + e.name.size() + 1 > 516) break;
+                body.push_back(e.isDir ? DIRENTRY_DIR : 0);
+                put_u32(body, e.size);
+                put_u32(body, e.mtime);
+                put_u32(body, e.mtime);
+                body.insert(body.end(), e.name.begin(), e.name.end());
+                body.push_back(0);
+                ++count;
+                ++dirCursor;
+            }
+            r.push_back(RESULT_SUCCESS);
+            r.push_back(count);
+            r.push_back(dirCursor >= dir.size() ? DIRSTATUS_EOF : 0);
+            r.push_back(static_cast<std::uint8_t>(first & 0xFF));
+            r.push_back(static_cast<std::uint8_t>(first >> 8));
+            r.insert(r.end(), body.begin(), body.end());
+            break;
+        }
+        case CMD_OPENDIR: {
+            ++dirRequests;
+            dirCursor = 0;
+            r.push_back(RESULT_SUCCESS);
+            r.push_back(7);
+            break;
+        }
+        case CMD_READDIR: {
+            ++dirRequests;
+            if (dirCursor >= dir.size()) {
+                r.push_back(RESULT_END_OF_FILE);
+                break;
+            }
+            const std::string& name = dir[dirCursor++].name;
+            r.push_back(RESULT_SUCCESS);
+            r.insert(r.end(), name.begin(), name.end());
+            r.push_back(0);
+            break;
+        }
+        case CMD_CLOSEDIR:
+            ++dirRequests;
+            r.push_back(RESULT_SUCCESS);
+            break;
+        case CMD_STAT: {
+            ++dirRequests;
+            const std::string path(reinterpret_cast<const char*>(p + 4));
+            const Entry* e = find_entry(path);
+            if (path != "/dir" && e == nullptr) {
+                r.push_back(RESULT_FILE_NOT_FOUND);
+                break;
+            }
+            const bool isDir = e == nullptr || e->isDir;
+            const std::uint16_t mode = isDir ? 0x41ED : 0x81A4;
+            r.push_back(RESULT_SUCCESS);
+            r.push_back(static_cast<std::uint8_t>(mode & 0xFF));
+            r.push_back(static_cast<std::uint8_t>(mode >> 8));
+            r.insert(r.end(), 4, 0); // uid, gid
+            put_u32(r, e ? e->size : 0);
+            put_u32(r, e ? e->mtime : 0);
+            put_u32(r, e ? e->mtime : 0);
+            put_u32(r, e ? e->mtime : 0);
+            break;
+        }
+        default:
+            r.push_back(RESULT_SUCCESS);
+            break;
+        }
+
+        const bool isRead = cmd == CMD_READ;
+        if (isRead && ++processedReads == dropReadReply) {
+            --readsInFlight;
+            return;
+        }
+        if (hold && !isRead) {
+            heldReplies.push_back(std::move(r));
+            return;
+        }
+        replies.push_back(std::move(r));
+        replyIsRead.push_back(isRead);
+    }
+};
+
+class FakeTnfsChannel final : public fujinet::io::Channel {
+public:
+    explicit FakeTnfsChannel(FakeTnfsServer& server) : _server(server) {}
+
+    bool available() override { return !_server.replies.empty(); }
+
+    std::size_t read(std::uint8_t* buffer, std::size_t maxLen) override
+    {
+        if (_server.replies.empty()) return 0;
+        auto r = std::move(_server.replies.front());
+        const bool isRead = _server.replyIsRead.front();
+        _server.replies.pop_front();
+        _server.replyIsRead.pop_front();
+        if (isRead) --_server.readsInFlight;
+        const std::size_t n = std::min(maxLen, r.size());
+        std::memcpy(buffer, r.data(), n);
+        return n;
+    }
+
+    void write(const std::uint8_t* buffer, std::size_t len) override { _server.handle(buffer, len); }
+
+private:
+    FakeTnfsServer& _server;
+};
+
+std::vector<std::uint8_t> pattern(std::size_t n)
+{
+    std::vector<std::uint8_t> v(n);
+    for (std::size_t i = 0; i < n; ++i) v[i] = static_cast<std::uint8_t>((i * 31u + (i >> 8)) & 0xFF);
+    return v;
+}
+
+std::vector<std::uint8_t> read_all(ITnfsClient& c, int h, std::size_t chunk)
+{
+    std::vector<std::uint8_t> out;
+    std::vector<std::uint8_t> buf(chunk);
+    for (;;) {
+        const std::size_t n = c.read(h, buf.data(), buf.size());
+        if (n == 0) break;
+        out.insert(out.end(), buf.begin(), buf.begin() + n);
+    }
+    return out;
+}
+
+void fill_dir(FakeTnfsServer& server, std::size_t n)
+{
+    // Already in tnfsd's default order: folders first, then by name.
+    server.dir.push_back({"games", true, 0, 100});
+    for (std::size_t i = 0; i < n; ++i) {
+        char name[40]; // room for any size_t
+        std::snprintf(name, sizeof(name), "disk_image_%04zu.atr", i);
+        server.dir.push_back({name, false, static_cast<std::uint32_t>(1000 + i), static_cast<std::uint32_t>(2000 + i)});
+    }
+}
+
+} // namespace
+
+TEST_CASE("TNFS UDP client: sequential reads keep a window of READs in flight")
+{
+    FakeTnfsServer server;
+    server.file = pattern(5000);
+    CommonTnfsClient client(std::make_unique<FakeTnfsChannel>(server), "UDP", 4);
+    REQUIRE(client.mount("/", "", ""));
+    const int h = client.open("/disk.atr", OPENMODE_READ, 0);
+    REQUIRE(h == 3);
+
+    const auto got = read_all(client, h, 256);
+    CHECK(got == server.file);
+    CHECK(server.maxReadsInFlight == 4);
+    CHECK(client.resync_count() == 0);
+    CHECK(client.tell(h) == 5000);
+    CHECK(server.lseekRequests == 0);
+}
+
+TEST_CASE("TNFS UDP client: seeks inside read-ahead are free, others re-position")
+{
+    FakeTnfsServer server;
+    server.file = pattern(8192);
+    CommonTnfsClient client(std::make_unique<FakeTnfsChannel>(server), "UDP", 4);
+    REQUIRE(client.mount("/", "", ""));
+    const int h = client.open("/disk.atr", OPENMODE_READ, 0);
+
+    std::uint8_t buf[128];
+    REQUIRE(client.read(h, buf, sizeof(buf)) == sizeof(buf));
+    REQUIRE(client.read(h, buf, sizeof(buf)) == sizeof(buf));
+
+    // Sector-style seek to where we already are / slightly ahead.
+    CHECK(client.seek(h, 256));
+    CHECK(client.seek(h, 300));
+    CHECK(server.lseekRequests == 0);
+    REQUIRE(client.read(h, buf, sizeof(buf)) == sizeof(buf));
+    CHECK(std::memcmp(buf, server.file.data() + 300, sizeof(buf)) == 0);
+
+    // Random access elsewhere.
+    CHECK(client.seek(h, 6000));
+    CHECK(server.lseekRequests == 1);
+    REQUIRE(client.read(h, buf, sizeof(buf)) == sizeof(buf));
+    CHECK(std::memcmp(buf, server.file.data() + 6000, sizeof(buf)) == 0);
+    CHECK(client.tell(h) == 6000 + sizeof(buf));
+}
+
+TEST_CASE("TNFS UDP client: out-of-order READ replies are detected and re-read")
+{
+    FakeTnfsServer server;
+    server.file = pattern(6000);
+    server.reorderRead = 4;
+    CommonTnfsClient client(std::make_unique<FakeTnfsChannel>(server), "UDP", 4);
+    REQUIRE(client.mount("/", "", ""));
+    const int h = client.open("/disk.atr", OPENMODE_READ, 0);
+
+    const auto got = read_all(client, h, 256);
+    CHECK(got == server.file);
+    CHECK(client.resync_count() >= 1);
+}
+
+TEST_CASE("TNFS UDP client: a lost READ reply is recovered by re-positioning")
+{
+    FakeTnfsServer server;
+    server.file = pattern(4000);
+    server.dropReadReply = 3;
+    CommonTnfsClient client(std::make_unique<FakeTnfsChannel>(server), "UDP", 4);
+    REQUIRE(client.mount("/", "", ""));
+    const int h = client.open("/disk.atr", OPENMODE_READ, 0);
+
+    const auto got = read_all(client, h, 512);
+    CHECK(got == server.file);
+    CHECK(client.resync_count() >= 1);
+}
+
+TEST_CASE("TNFS UDP client: write after read-ahead lands at the logical position")
+{
+    FakeTnfsServer server;
+    server.file = pattern(4096);
+    CommonTnfsClient client(std::make_unique<FakeTnfsChannel>(server), "UDP", 4);
+    REQUIRE(client.mount("/", "", ""));
+    const int h = client.open("/disk.atr", OPENMODE_READWRITE, 0);
+
+    std::uint8_t buf[100];
+    REQUIRE(client.read(h, buf, sizeof(buf)) == sizeof(buf));
+    REQUIRE(client.read(h, buf, sizeof(buf)) == sizeof(buf));
+    CHECK(server.filePos > 200); // server pointer ran ahead
+
+    const std::uint8_t data[4] = {0xDE, 0xAD, 0xBE, 0xEF};
+    REQUIRE(client.write(h, data, sizeof(data)) == sizeof(data));
+    CHECK(std::memcmp(server.file.data() + 200, data, sizeof(data)) == 0);
+    CHECK(client.tell(h) == 204);
+}
+
+TEST_CASE("TNFS TCP client: stays stop-and-wait")
+{
+    FakeTnfsServer server;
+    server.file = pattern(3000);
+    auto client = make_tcp_tnfs_client(std::make_unique<FakeTnfsChannel>(server));
+    REQUIRE(client->mount("/", "", ""));
+    const int h = client->open("/disk.atr", OPENMODE_READ, 0);
+
+    const auto got = read_all(*client, h, 256);
+    CHECK(got == server.file);
+    CHECK(server.maxReadsInFlight == 1);
+}
+
+TEST_CASE("TNFS client: OPENDIRX lists a large directory with metadata in a few packets")
+{
+    FakeTnfsServer server;
+    fill_dir(server, 500);
+    CommonTnfsClient client(std::make_unique<FakeTnfsChannel>(server), "UDP");
+    REQUIRE(client.mount("/", "", ""));
+
+    std::vector<TnfsDirEntry> entries;
+    REQUIRE(client.listDirectoryEntries("/dir", TnfsDirOptions{}, entries));
+    REQUIRE(entries.size() == server.dir.size());
+    CHECK(entries[0].name == "games");
+    CHECK(entries[0].isDir);
+    CHECK(entries[42].name == server.dir[42].name);
+    CHECK_FALSE(entries[42].isDir);
+    CHECK(entries[42].filesize == server.dir[42].size);
+    CHECK(entries[42].mTime == server.dir[42].mtime);
+
+    // ~20 names per READDIRX reply instead of READDIR + STAT per entry.
+    CHECK(server.dirRequests < 40);
+
+    CHECK_FALSE(client.listDirectoryEntries("/missing", TnfsDirOptions{}, entries));
+    CHECK(entries.empty());
+}
+
+TEST_CASE("TNFS client: falls back to READDIR+STAT on servers without OPENDIRX")
+{
+    FakeTnfsServer server;
+    server.legacyDir = true;
+    server.dir.push_back({"zeta.atr", false, 30, 3});
+    server.dir.push_back({"Alpha.atr", false, 10, 1});
+    server.dir.push_back({"utils", true, 0, 2});
+    server.dir.push_back({".hidden", false, 5, 4});
+    CommonTnfsClient client(std::make_unique<FakeTnfsChannel>(server), "UDP");
+    REQUIRE(client.mount("/", "", ""));
+
+    std::vector<TnfsDirEntry> entries;
+    REQUIRE(client.listDirectoryEntries("/dir", TnfsDirOptions{}, entries));
+    REQUIRE(entries.size() == 3); // hidden skipped, as tnfsd would
+    CHECK(entries[0].name == "utils");
+    CHECK(entries[1].name == "Alpha.atr");
+    CHECK(entries[1].filesize == 10);
+    CHECK(entries[2].name == "zeta.atr");
+
+    // The unsupported probe is remembered: the next listing goes straight to READDIR.
+    const int before = server.dirRequests;
+    TnfsDirOptions opts{};
+    opts.dirOptions = DIROPT_NO_SKIPHIDDEN;
+    opts.pattern = "*E*"; // directories aren't filtered without DIROPT_DIR_PATTERN
+    REQUIRE(client.listDirectoryEntries("/dir", opts, entries));
+    REQUIRE(entries.size() == 3);
+    CHECK(entries[0].name == "utils");
+    CHECK(entries[1].name == ".hidden");
+    CHECK(entries[2].name == "zeta.atr");
+    // STAT(/dir) + OPENDIR + 5 READDIR + CLOSEDIR + 4 STAT, no OPENDIRX.
+    CHECK(server.dirRequests - before == 12);
+}
+
+TEST_CASE("TNFS RTT estimator follows RFC 6298")
+{
+    using std::chrono::milliseconds;
+    RttEstimator rtt;
+    CHECK(rtt.rto() == RttEstimator::kInitialRto);
+
+    rtt.sample(milliseconds(200));
+    CHECK(rtt.srtt() == milliseconds(200));
+    CHECK(rtt.rttvar() == milliseconds(100));
+    CHECK(rtt.rto() == milliseconds(600));
+
+    rtt.sample(milliseconds(200));
+    CHECK(rtt.srtt() == milliseconds(200));
+    CHECK(rtt.rttvar() == milliseconds(75));
+    CHECK(rtt.rto() == milliseconds(500));
+
+    rtt.backoff();
+    CHECK(rtt.rto() == milliseconds(1000));
+    for (int i = 0; i < 5; ++i) rtt.backoff();
+    CHECK(rtt.rto() == RttEstimator::kMaxRto);
+
+    // A LAN answers in well under a millisecond; the floor still applies.
+    RttEstimator lan;
+    lan.sample(std::chrono::microseconds(300));
+    CHECK(lan.rto() == RttEstimator::kMinRto);
+}
+
+TEST_CASE("TNFS client: non-blocking requests park, refuse others and resume")
+{
+    FakeTnfsServer server;
+    fill_dir(server, 2);
+    CommonTnfsClient client(std::make_unique<FakeTnfsChannel>(server), "UDP", 4);
+    REQUIRE(client.mount("/", "", "")); // primes the RTT: RTO is at the floor
+    CHECK(client.rtt().rto() == RttEstimator::kMinRto);
+    client.set_nonblocking(true);
+
+    server.hold = true;
+    TnfsStat st{};
+    CHECK_FALSE(client.stat("/dir/games", st));
+    CHECK(client.would_block());
+    CHECK(server.dirRequests == 1);
+
+    // Another request has to wait for the parked one, without being sent.
+    CHECK_FALSE(client.stat("/dir/disk_image_0000.atr", st));
+    CHECK(client.would_block());
+    CHECK(server.dirRequests == 1);
+
+    server.release();
+    client.poll();
+
+    // Repeating the parked call picks up its reply instead of resending.
+    REQUIRE(client.stat("/dir/games", st));
+    CHECK_FALSE(client.would_block());
+    CHECK(st.isDir);
+    CHECK(server.dirRequests == 1);
+
+    REQUIRE(client.stat("/dir/disk_image_0000.atr", st));
+    CHECK(st.filesize == 1000);
+    CHECK(server.dirRequests == 2);
+}
+
+TEST_CASE("TNFS pattern match")
+{
+    CHECK(fujinet::core::glob_match("*.atr", "GAME.ATR"));
+    CHECK(fujinet::core::glob_match("g?me*", "game.xex"));
+    CHECK(fujinet::core::glob_match("*", ""));
+    CHECK_FALSE(fujinet::core::glob_match("*.atr", "game.xex"));
+    CHECK_FALSE(fujinet::core::glob_match("a?", "a"));
+}
@@ -0,0 +1,394 @@
+#include "doctest.h"
+
+#include "fujinet/fs/storage_manager.h"
+#include "fujinet/fs/tnfs_filesystem.h"
+#include "fujinet/fs/tnfs_session_pool.h"
+#include "fujinet/io/core/io_message.h"
+#include "fujinet/io/devices/file_commands.h"
+#include "fujinet/io/devices/file_device.h"
+#include "fujinet/tnfs/tnfs_protocol.h"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace fujinet::fs;
+using namespace fujinet::tnfs;
+using fujinet::io::FileDevice;
+using fujinet::io::IORequest;
+using fujinet::io::IOResponse;
+using fujinet::io::StatusCode;
+using fujinet::io::protocol::FileCommand;
+
+namespace {
+
+// A tiny TNFS "server": one file, a boot counter, and per-boot handles.
+// Restarting it invalidates every mounted session, like a real tnfsd.
+struct FakeServer {
+    std::vector<std::uint8_t> data = std::vector<std::uint8_t>(64, 0);
+    std::uint32_t boot{1};
+    int mounts{0};
+    int umounts{0};
+    int stats{0};
+    int opens{0};
+    bool slow{false}; // misses every RTO: non-blocking clients park
+
+    void restart() { ++boot; }
+};
+
+class FakeClient final : public ITnfsClient {
+public:
+    explicit FakeClient(FakeServer& server) : _server(server) {}
+
+    bool mount(const std::string&, const std::string&, const std::string&) override
+    {
+        if (park()) return false;
+        ++_server.mounts;
+        _boot = _server.boot;
+        _lost = false;
+        return true;
+    }
+
+    bool umount() override
+    {
+        ++_server.umounts;
+        _boot = 0;
+        return true;
+    }
+
+    bool stat(const std::string& path, TnfsStat& st) override
+    {
+        if (park()) return false;
+        ++_server.stats;
+        if (!alive()) return false;
+        st = TnfsStat{};
+        st.isDir = path == "/";
+        st.filesize = st.isDir ? 0 : static_cast<std::uint32_t>(_server.data.size());
+        return path == "/" || path == "/disk.atr";
+    }
+
+    bool exists(const std::string& path) override
+    {
+        TnfsStat st{};
+        return stat(path, st);
+    }
+
+    bool isDirectory(const std::string& path) override { return alive() && path == "/"; }
+    bool createDirectory(const std::string&) override { return alive(); }
+    bool removeDirectory(const std::string&) override { return alive(); }
+    bool removeFile(const std::string&) override { return alive(); }
+    bool rename(const std::string&, const std::string&) override { return alive(); }
+
+    std::vector<std::string> listDirectory(const std::string&) override
+    {
+        if (!alive()) return {};
+        return {"disk.atr"};
+    }
+
+    int open(const std::string& path, uint16_t, uint16_t) override
+    {
+        ++_server.opens;
+        if (!alive() || path != "/disk.atr") return -1;
+        _pos[7] = 0;
+        return 7;
+    }
+
+    bool close(int handle) override { return alive() && _pos.erase(handle) == 1; }
+
+    std::size_t read(int handle, void* buffer, std::size_t bytes) override
+    {
+        auto it = _pos.find(handle);
+        if (!alive() || it == _pos.end()) return 0;
+        std::size_t n = 0;
+        auto* out = static_cast<std::uint8_t*>(buffer);
+        while (n < bytes && it->second < _server.data.size()) {
+            out[n++] = _server.data[it->second++];
+        }
+        return n;
+    }
+
+    std::size_t write(int handle, const void* buffer, std::size_t bytes) override
+    {
+        auto it = _pos.find(handle);
+        if (!alive() || it == _pos.end()) return 0;
+        const auto* in = static_cast<const std::uint8_t*>(buffer);
+        for (std::size_t i = 0; i < bytes && it->second < _server.data.size(); ++i) {
+            _server.data[it->second++] = in[i];
+        }
+        return bytes;
+    }
+
+    bool seek(int handle, uint32_t offset) override
+    {
+        auto it = _pos.find(handle);
+        if (!alive() || it == _pos.end()) return false;
+        it->second = offset;
+        return true;
+    }
+
+    uint32_t tell(int handle) override
+    {
+        auto it = _pos.find(handle);
+        return it == _pos.end() ? 0 : static_cast<uint32_t>(it->second);
+    }
+
+    bool session_lost() const override { return _lost; }
+    void set_nonblocking(bool enabled) override { _nonBlocking = enabled; }
+    bool would_block() const override { return _wouldBlock; }
+
+private:
+    bool park()
+    {
+        _wouldBlock = _nonBlocking && _server.slow;
+        return _wouldBlock;
+    }
+
+    // A request to a restarted server goes unanswered: the session is lost.
+    bool alive()
+    {
+        if (_boot != 0 && _boot == _server.boot) return true;
+        _lost = true;
+        _pos.clear();
+        return false;
+    }
+
+    FakeServer& _server;
+    std::uint32_t _boot{0};
+    bool _lost{false};
+    bool _nonBlocking{false};
+    bool _wouldBlock{false};
+    std::map<int, std::size_t> _pos;
+};
+
+TnfsClientFactory factory_for(FakeServer& server, int& created)
+{
+    return [&server, &created](const TnfsEndpoint&) -> std::unique_ptr<ITnfsClient> {
+        ++created;
+        return std::make_unique<FakeClient>(server);
+    };
+}
+
+// FileDevice Stat payload: u8 version, u16 length, URI.
+std::vector<std::uint8_t> stat_payload(std::string_view uri)
+{
+    std::vector<std::uint8_t> payload{1,
+                                      static_cast<std::uint8_t>(uri.size() & 0xFF),
+                                      static_cast<std::uint8_t>(uri.size() >> 8)};
+    payload.insert(payload.end(), uri.begin(), uri.end());
+    return payload;
+}
+
+} // namespace
+
+TEST_CASE("TnfsFileSystem: requests to one endpoint share a single mount")
+{
+    FakeServer server;
+    int created = 0;
+    auto fs = make_tnfs_filesystem(factory_for(server, created));
+    REQUIRE(fs);
+
+    FileInfo info{};
+    CHECK(fs->stat("tnfs://server/disk.atr", info));
+    CHECK(fs->exists("tnfs://server/disk.atr"));
+    std::vector<FileInfo> entries;
+    CHECK(fs->listDirectory("tnfs://server/", entries));
+    auto file = fs->open("tnfs://server/disk.atr", "rb");
+    CHECK(file);
+
+    CHECK(created == 1);
+    CHECK(server.mounts == 1);
+
+    // Another server is another session.
+    CHECK(fs->exists("tnfs://other/disk.atr"));
+    CHECK(created == 2);
+}
+
+TEST_CASE("TnfsFileSystem: a lost session is remounted and the request retried")
+{
+    FakeServer server;
+    int created = 0;
+    auto fs = make_tnfs_filesystem(factory_for(server, created));
+
+    FileInfo info{};
+    REQUIRE(fs->stat("tnfs://server/disk.atr", info));
+    server.restart();
+
+    CHECK(fs->stat("tnfs://server/disk.atr", info));
+    CHECK(info.sizeBytes == 64);
+    CHECK(created == 2);
+    CHECK(server.mounts == 2);
+
+    // Ordinary failures are not mistaken for a lost session.
+    CHECK_FALSE(fs->stat("tnfs://server/missing.atr", info));
+    CHECK(server.mounts == 2);
+}
+
+TEST_CASE("TnfsFileSystem: an open file survives a server restart")
+{
+    FakeServer server;
+    for (std::size_t i = 0; i < server.data.size(); ++i) {
+        server.data[i] = static_cast<std::uint8_t>(i);
+    }
+    int created = 0;
+    auto fs = make_tnfs_filesystem(factory_for(server, created));
+
+    auto file = fs->open("tnfs://server/disk.atr", "r+b");
+    REQUIRE(file);
+    std::uint8_t buf[8]{};
+    REQUIRE(file->read(buf, 8) == 8);
+    CHECK(buf[7] == 7);
+
+    server.restart();
+
+    // Reopened on the new session and positioned where it left off.
+    REQUIRE(file->read(buf, 8) == 8);
+    CHECK(buf[0] == 8);
+    CHECK(file->tell() == 16);
+    CHECK(server.opens == 2);
+
+    const std::uint8_t patch[2]{0xEE, 0xFF};
+    CHECK(file->write(patch, 2) == 2);
+    CHECK(server.data[16] == 0xEE);
+
+    // Other requests see the already remounted session.
+    FileInfo info{};
+    CHECK(fs->stat("tnfs://server/disk.atr", info));
+    CHECK(server.mounts == 2);
+}
+
+TEST_CASE("TnfsSessionPool: idle sessions unmount, held ones are kept alive")
+{
+    FakeServer server;
+    TnfsSessionPoolConfig cfg;
+    cfg.idleTimeout = std::chrono::milliseconds(1000);
+    cfg.keepAlive = std::chrono::milliseconds(500);
+    TnfsSessionPool pool([&server](const TnfsEndpoint&) -> std::shared_ptr<ITnfsClient> {
+        return std::make_shared<FakeClient>(server);
+    }, cfg);
+
+    TnfsEndpoint a{};
+    a.host = "a";
+    TnfsEndpoint b{};
+    b.host = "b";
+
+    auto held = pool.acquire(a);
+    REQUIRE(held);
+    REQUIRE(pool.acquire(b));
+    CHECK(pool.acquire(a) == held);
+    CHECK(pool.size() == 2);
+    CHECK(pool.stats().mounts == 2);
+    CHECK(pool.stats().reuses == 1);
+
+    const auto later = std::chrono::steady_clock::now() + std::chrono::milliseconds(1500);
+    pool.poll(later);
+    CHECK(pool.size() == 1);
+    CHECK(pool.stats().unmounts == 1);
+    CHECK(pool.stats().pings == 1);
+    CHECK(server.umounts == 1);
+
+    // A ping that finds the server restarted remounts in the background.
+    server.restart();
+    pool.poll(later + std::chrono::milliseconds(1000));
+    CHECK(pool.stats().remounts == 1);
+    CHECK(held->generation() == 1);
+    TnfsStat st{};
+    CHECK(held->client().stat("/disk.atr", st));
+
+    held.reset();
+    pool.poll(later + std::chrono::milliseconds(5000));
+    CHECK(pool.size() == 0);
+}
+
+TEST_CASE("TnfsFileSystem: a slow server defers FileDevice requests instead of blocking")
+{
+    FakeServer server;
+    server.slow = true;
+    int created = 0;
+    TnfsSessionPoolConfig cfg;
+    cfg.nonBlocking = true;
+    StorageManager storage;
+    REQUIRE(storage.registerFileSystem(make_tnfs_filesystem(factory_for(server, created), cfg)));
+
+    FileDevice device(storage);
+    IORequest stat{};
+    stat.id = 3;
+    stat.command = static_cast<std::uint16_t>(FileCommand::Stat);
+    stat.payload = stat_payload("tnfs://server/disk.atr");
+
+    // The MOUNT itself is parked; a host that can't wait is told to retry.
+    CHECK(device.handle(stat).status == StatusCode::NotReady);
+    CHECK(server.mounts == 0);
+
+    stat.deferrable = true;
+    CHECK(device.handle(stat).status == StatusCode::Pending);
+    IOResponse done{};
+    device.poll();
+    CHECK_FALSE(device.take_completed(done));
+
+    server.slow = false;
+    device.poll();
+    REQUIRE(device.take_completed(done));
+    CHECK(done.id == 3);
+    CHECK(done.status == StatusCode::Ok);
+    REQUIRE(done.payload.size() >= 2);
+    CHECK(done.payload[1] == 0x02); // exists
+    CHECK(server.mounts == 1);
+    CHECK(created == 1); // the parked mount was resumed, not restarted
+
+    // Requests on a mounted session park the same way.
+    server.slow = true;
+    CHECK(device.handle(stat).status == StatusCode::Pending);
+    server.slow = false;
+    device.poll();
+    REQUIRE(device.take_completed(done));
+    CHECK(done.status == StatusCode::Ok);
+    CHECK(server.mounts == 1);
+}
+
+TEST_CASE("TnfsSessionPool: keep-alive pings are capped per poll and never block")
+{
+    FakeServer server;
+    TnfsSessionPoolConfig cfg;
+    cfg.keepAlive = std::chrono::milliseconds(500);
+    cfg.nonBlocking = true;
+    TnfsSessionPool pool([&server](const TnfsEndpoint&) -> std::shared_ptr<ITnfsClient> {
+        return std::make_shared<FakeClient>(server);
+    }, cfg);
+
+    TnfsEndpoint a{};
+    a.host = "a";
+    TnfsEndpoint b{};
+    b.host = "b";
+    auto heldA = pool.acquire(a);
+    auto heldB = pool.acquire(b);
+    REQUIRE(heldA);
+    REQUIRE(heldB);
+
+    const auto t = std::chrono::steady_clock::now() + std::chrono::milliseconds(1000);
+    pool.poll(t);
+    CHECK(pool.stats().pings == TnfsSessionPool::MAX_PINGS_PER_POLL);
+    pool.poll(t);
+    CHECK(pool.stats().pings == 2);
+    CHECK(server.stats == 2);
+
+    // A ping the server doesn't answer in time is parked, not waited for,
+    // and collected on a later poll() without counting as a new ping.
+    server.slow = true;
+    pool.poll(t);
+    CHECK(pool.stats().pings == 3);
+    CHECK(heldA->would_block());
+    pool.poll(t);
+    CHECK(pool.stats().pings == 4);
+    CHECK(server.stats == 2);
+
+    server.slow = false;
+    pool.poll(); // nothing is due yet
+    CHECK(server.stats == 4);
+    CHECK_FALSE(heldA->would_block());
+    CHECK_FALSE(heldB->would_block());
+    CHECK(pool.stats().pings == 4);
+    CHECK(pool.stats().remounts == 0);
+}
@@ -0,0 +1,182 @@
+#include "doctest.h"
+
+#include "fujinet/io/devices/xml_content_translator.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+using fujinet::io::ContentTranslationType;
+using fujinet::io::StatusCode;
+using fujinet::io::TranslationConfig;
+using fujinet::io::XmlContentTranslator;
+
+namespace {
+
+// Feeds `body` in `chunk`-byte pieces and returns the translated view.
+std::string translate(std::string_view body,
+                      std::string_view selector,
+                      std::size_t chunk = 4096,
+                      ContentTranslationType type = ContentTranslationType::Xml)
+{
+    XmlContentTranslator t;
+    TranslationConfig cfg;
+    cfg.type = type;
+    cfg.selector = std::string(selector);
+    REQUIRE(t.configure(cfg) == StatusCode::Ok);
+    CHECK_FALSE(t.needs_full_body());
+
+    for (std::size_t off = 0; off < body.size(); off += chunk) {
+        const std::size_t n = std::min(chunk, body.size() - off);
+        REQUIRE(t.append_body(reinterpret_cast<const std::uint8_t*>(body.data() + off), n) == StatusCode::Ok);
+    }
+    REQUIRE(t.finalize() == StatusCode::Ok);
+
+    std::string out(static_cast<std::size_t>(t.translated_size()), '\0');
+    std::uint16_t actual = 0;
+    bool eof = false;
+    REQUIRE(t.read(0, reinterpret_cast<std::uint8_t*>(out.data()), out.size(), actual, eof) == StatusCode::Ok);
+    CHECK(eof);
+    out.resize(actual);
+    return out;
+}
+
+std::string records(std::string_view body, std::string_view selector = "", std::size_t chunk = 4096)
+{
+    return translate(body, selector, chunk, ContentTranslationType::Rss);
+}
+
+} // namespace
+
+TEST_CASE("XmlContentTranslator: element paths select text and attributes")
+{
+    const std::string doc =
+        "\xEF\xBB\xBF<?xml version=\"1.0\"?>\n"
+        "<!DOCTYPE feed [ <!ENTITY x \"y\"> ]>\n"
+        "<!-- a comment with <tags> -->\n"
+        "<feed xmlns:dc=\"http://purl.org/dc/elements/1.1/\">\n"
+        "  <title>  Caf&#xE9;   &amp; <b>Bar</b>\n &lt;3 </title>\n"
+        "  <entry id='e0'><link href=\"http://a/0\"/><dc:creator>Ann</dc:creator></entry>\n"
+        "  <entry id='e1'><link rel=\"self\" href=\"http://a/1s\"/><link href=\"http://a/1?x=1&amp;y=2\"/>"
+        "<summary><![CDATA[<p>raw]]]></summary></entry>\n"
+        "  <entry id='e2' flag><note>a<!-- gone -->b &unknown; &#65;</note></entry>\n"
+        "</feed>";
+
+    for (std::size_t chunk : {std::size_t{1}, std::size_t{5}, std::size_t{4096}}) {
+        CAPTURE(chunk);
+        CHECK(translate(doc, "/feed/title", chunk) == "Caf\xC3\xA9 & Bar <3");
+        CHECK(translate(doc, "/feed/entry/@id", chunk) == "e0");
+        CHECK(translate(doc, "/feed/entry[1]/@id", chunk) == "e1");
+        CHECK(translate(doc, "/feed/entry[1]/link[1]/@href", chunk) == "http://a/1?x=1&y=2");
+        CHECK(translate(doc, "/feed/entry[1]/summary", chunk) == "<p>raw]");
+        CHECK(translate(doc, "/feed/entry[2]/note", chunk) == "ab &unknown; A");
+        CHECK(translate(doc, "/feed/entry[0]/creator", chunk) == "Ann");
+        CHECK(translate(doc, "/feed/entry[0]/dc:creator", chunk) == "Ann");
+    }
+
+    CHECK(translate(doc, "/FEED/Title") == "Caf\xC3\xA9 & Bar <3");
+    CHECK(translate("<a> x <b>y</b>z </a>", "") == "x y z");
+}
+
+TEST_CASE("XmlContentTranslator: misses and bad selectors")
+{
+    const std::string doc = "<r><a>1</a><a k=\"v\">2</a></r>";
+
+    CHECK(translate(doc, "/r/a[1]") == "2");
+    CHECK(translate(doc, "/r/a[2]").empty());
+    CHECK(translate(doc, "/r/a/@k").empty());
+    CHECK(translate(doc, "/r/a[1]/@k") == "v");
+    CHECK(translate(doc, "/x/a").empty());
+    CHECK(translate(doc, "/r/a/b").empty());
+
+    // Unbalanced markup: an end tag closes back to its start tag.
+    CHECK(translate("<r><p>one<br></p><p>two</p></r>", "/r/p[1]") == "two");
+    CHECK(translate("<r>a < b</r>", "/r") == "a < b");
+
+    XmlContentTranslator t;
+    TranslationConfig cfg;
+    cfg.type = ContentTranslationType::Xml;
+    for (const char* bad : {"/a/@b/c", "/a[x]", "/a[]", "/[1]", "/@"}) {
+        CAPTURE(bad);
+        cfg.selector = bad;
+        CHECK(t.configure(cfg) == StatusCode::InvalidRequest);
+    }
+    cfg.type = ContentTranslationType::Rss;
+    cfg.selector = "two";
+    CHECK(t.configure(cfg) == StatusCode::InvalidRequest);
+    cfg.type = ContentTranslationType::Json;
+    cfg.selector.clear();
+    CHECK(t.configure(cfg) == StatusCode::InvalidRequest);
+}
+
+TEST_CASE("XmlContentTranslator: RSS and Atom feeds flatten to records")
+{
+    const std::string rss =
+        "<?xml version=\"1.0\"?><rss version=\"2.0\"><channel><title>Chan</title>"
+        "<item><title>First &amp; best</title><link>http://x/1</link>"
+        "<pubDate>Mon, 01 Jan 2024 00:00:00 GMT</pubDate></item>"
+        "<item><title><![CDATA[Second]]></title><description>d</description>"
+        "<link>\n  http://x/2\n</link><dc:date>2024-01-02</dc:date></item>"
+        "<item><title>Cut";
+
+    for (std::size_t chunk : {std::size_t{1}, std::size_t{3}, std::size_t{4096}}) {
+        CAPTURE(chunk);
+        CHECK(records(rss, "", chunk) ==
+              "First & best\nhttp://x/1\nMon, 01 Jan 2024 00:00:00 GMT\n"
+              "Second\nhttp://x/2\n2024-01-02\n");
+    }
+    CHECK(records(rss, "1") == "First & best\nhttp://x/1\nMon, 01 Jan 2024 00:00:00 GMT\n");
+
+    const std::string atom =
+        "<feed xmlns=\"http://www.w3.org/2005/Atom\"><title>F</title>"
+        "<entry><title type=\"html\">A</title>"
+        "<link rel=\"self\" href=\"http://s/a\"/><link rel=\"alternate\" href=\"http://w/a\"/>"
+        "<updated>2024-02-01T00:00:00Z</updated><published>2023-12-31</published></entry>"
+        "<entry><title>B</title><link href=\"http://w/b\"/></entry></feed>";
+
+    CHECK(records(atom) == "A\nhttp://w/a\n2024-02-01T00:00:00Z\nB\nhttp://w/b\n\n");
+
+    // Fields are capped.
+    const std::string longTitle(1000, 'x');
+    CHECK(records("<rss><item><title>" + longTitle + "</title></item></rss>") == std::string(256, 'x') + "\n\n\n");
+}
+
+TEST_CASE("XmlContentTranslator: query() and reselect() rescan the body")
+{
+    const std::string doc = "<r><a>1</a><b x=\"2\"/></r>";
+
+    XmlContentTranslator t;
+    TranslationConfig cfg;
+    cfg.type = ContentTranslationType::Xml;
+    cfg.selector = "/r/a";
+    REQUIRE(t.configure(cfg) == StatusCode::Ok);
+    REQUIRE(t.append_body(reinterpret_cast<const std::uint8_t*>(doc.data()), doc.size()) == StatusCode::Ok);
+    REQUIRE(t.finalize() == StatusCode::Ok);
+    CHECK(t.translated_size() == 1);
+
+    std::string out;
+    bool found = false;
+    REQUIRE(t.query(doc, "/r/b/@x", out, found) == StatusCode::Ok);
+    CHECK(found);
+    CHECK(out == "2");
+    REQUIRE(t.query(doc, "/r/c", out, found) == StatusCode::Ok);
+    CHECK_FALSE(found);
+    CHECK(out.empty());
+
+    // The element exists but lacks the attribute.
+    REQUIRE(t.query("<feed><link href=\"x\"/></feed>", "/feed/link/@missing", out, found) == StatusCode::Ok);
+    CHECK_FALSE(found);
+    CHECK(out.empty());
+    REQUIRE(t.query("<feed><link href=\"\"/></feed>", "/feed/link/@href", out, found) == StatusCode::Ok);
+    CHECK(found);
+    CHECK(out.empty());
+    CHECK(t.query(doc, "/r/a[", out, found) == StatusCode::InvalidRequest);
+
+    cfg.selector = "/r/b/@x";
+    REQUIRE(t.reselect(doc, cfg) == StatusCode::Ok);
+    std::uint8_t buf[4]{};
+    std::uint16_t actual = 0;
+    bool eof = false;
+    REQUIRE(t.read(0, buf, sizeof(buf), actual, eof) == StatusCode::Ok);
+    CHECK(std::string(reinterpret_cast<const char*>(buf), actual) == "2");
+}